@@ -1,4059 +1,198 @@
-#include <iostream>
-#include <fstream>
-#include <iomanip>
-#include <string>
-#include <ctime>
+// Supplies the counting operator new/delete when built with -DRESTAURANT_COUNT_ALLOCATIONS
+#define RESTAURANT_ALLOCATION_HOOK_IMPLEMENTATION
+#include "RestaurantCore.h"
+#ifdef _WIN32
 #include <conio.h>
-#include <cstdlib>
-#include <sstream>
+#else
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <csignal>
+#include <cstring>
 
-using namespace std;
-
-/**
- * ValidationCheck class provides static methods for validating various inputs
- * This class contains utility methods for common validation tasks throughout the application
- */
-class ValidationCheck {
-public:
-    // Check if string length is within acceptable range
-    static bool isValidStringLength(const string& str, int minLength, int maxLength) {
-        int length = str.length();
-        return (length >= minLength && length <= maxLength);
-    }
-    
-    // Check if price is valid (minimum 1.00 and has exactly 2 decimal places)
-    static bool isValidPrice(double price) {
-        // Check minimum price
-        if (price < 1.0) {
-            return false;
-        }
-        
-        // Check if price has exactly 2 decimal places
-        // Convert to string and check decimal part
-        string priceStr = to_string(price);
-        size_t decimalPos = priceStr.find('.');
-        
-        if (decimalPos == string::npos) {
-            // No decimal point
-            return true;
-        }
-        
-        // Get decimal part and check its length after removing trailing zeros
-        string decimalPart = priceStr.substr(decimalPos + 1);
-        while (!decimalPart.empty() && decimalPart.back() == '0') {
-            decimalPart.pop_back();
-        }
-        
-        return decimalPart.length() <= 2;
-    }
-    
-    // Check if quantity is valid (between 1 and 999)
-    static bool isValidQuantity(int quantity) {
-        return (quantity >= 1 && quantity <= 999);
-    }
-    
-    // Check if ID follows the format of 1 character followed by 3 digits
-    static bool isValidID(const string& id) {
-        // Check length
-        if (id.length() != 4) {
-            return false;
-        }
-        
-        // Check first character is a letter
-        if (!isalpha(id[0])) {
-            return false;
-        }
-        
-        // Check remaining 3 characters are digits
-        for (int i = 1; i < 4; i++) {
-            if (!isdigit(id[i])) {
-                return false;
-            }
-        }
-        
-        return true;
-    }
-    
-    // Display validation error message
-    static void showError(const string& message) {
-        cout << "Error: " << message << endl;
-    }
-    
-    // Check if username is valid (between 5 and 20 characters, alphanumeric with underscore)
-    static bool isValidUsername(const string& username) {
-        // Check length
-        if (!isValidStringLength(username, 5, 20)) {
-            return false;
-        }
-        
-        // Check characters (only allow letters, numbers, and underscore)
-        for (char c : username) {
-            if (!isalnum(c) && c != '_') {
-                return false;
-            }
-        }
-        
-        return true;
-    }
-    
-    // Check if password is valid (between 6 and 20 characters, with at least one number and one letter)
-    static bool isValidPassword(const string& password) {
-        // Check length
-        if (!isValidStringLength(password, 6, 20)) {
-            return false;
-        }
-        
-        bool hasLetter = false;
-        bool hasDigit = false;
-        
-        // Check for at least one letter and one number
-        for (char c : password) {
-            if (isalpha(c)) {
-                hasLetter = true;
-            } else if (isdigit(c)) {
-                hasDigit = true;
-            }
-        }
-        
-        return hasLetter && hasDigit;
-    }
-    
-    // Check if Staff/Admin ID is valid (S/A followed by 3 digits)
-    static bool isValidStaffAdminID(const string& id, bool isAdmin) {
-        // Check length
-        if (id.length() != 4) {
-            return false;
-        }
-        
-        // Check first character (S for Staff, A for Admin)
-        if (isAdmin && id[0] != 'A') {
-            return false;
-        } else if (!isAdmin && id[0] != 'S') {
-            return false;
-        }
-        
-        // Check remaining 3 characters are digits
-        for (int i = 1; i < 4; i++) {
-            if (!isdigit(id[i])) {
-                return false;
-            }
-        }
-        
-        return true;
-    }
-};
-
-// Custom minimum function
-int min(int a, int b) {
-    return (a < b) ? a : b;
+// Waits for one key press without echoing it, like getch from conio.h on Windows
+// When input is not a terminal (a pipe or a file) it simply reads the next character
+int getch() {
+    termios saved;
+    if (tcgetattr(STDIN_FILENO, &saved) != 0) {
+        return getchar();
+    }
+    termios raw = saved;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    int key = getchar();
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    return key;
 }
+#endif
 
-double min(double a, double b) {
-    return (a < b) ? a : b;
+// Clears the console window
+void clearScreen() {
+#ifdef _WIN32
+    system("cls");
+#else
+    cout << "\033[2J\033[H" << flush;
+#endif
 }
 
 /**
- * Restaurant base class for the restaurant management system
- * Contains common functionality shared by inventory and menu subsystems
- * @time_complexity Varies by method
- * @space_complexity Varies by method
+ * Handle inventory management functionality
+ * This function encapsulates all inventory-related operations
+ * @param inventory Reference to the inventory system to manage
  */
-class Restaurant {
-protected:
-    int itemCount;                     // Total number of items in the system
-    
-    // Protected constructor to prevent direct instantiation
-    Restaurant() : itemCount(0) {}
-    
-    // Copy constructor
-    Restaurant(const Restaurant& other) : itemCount(other.itemCount) {}
-    
-public:
-    // Static utility methods for UI
-    // Clearscreen function
-    static void clearScreen() {
-        system("cls");
-    }
-    
-    // Print header for display
-    static void printHeader(const string& title) {
-        cout << "\n" << string(100, '=') << endl;
-        cout << string(35, ' ') << title << endl;
-        cout << string(100, '=') << endl;
-    }
-    
-    // Print footer for display
-    static void printFooter() {
-        cout << string(100, '-') << endl;
-    }
-
-    // Virtual destructor to ensure proper cleanup in derived classes
-    virtual ~Restaurant() {}
-    
-    // Get current number of items in the system
-    virtual int getItemCount() const {
-        return itemCount;
-    }
-    
-    // Pure virtual functions to be implemented by derived classes
-    virtual bool loadFromFile(const string& filename) = 0;
-    virtual bool saveToFile(const string& filename, bool sorted = false) = 0;
-    virtual void displayAll() = 0;
-    virtual void displaySorted(bool byName = true) = 0;
-
-    // Friend function to display system statistics
-    friend void displayRestaurantStats(const Restaurant& restaurant);
-};
-
-// Friend function implementation
-void displayRestaurantStats(const Restaurant& restaurant) {
-    Restaurant::printHeader("Restaurant System Statistics");
-    cout << "Total number of items: " << restaurant.itemCount << endl;
-    Restaurant::printFooter();
-}
-
-// Food item structure for restaurant inventory
-struct FoodItem {
-    string id;            // Unique identifier
-    string name;          // Food item name
-    double price;         // Price per unit
-    string category;      // Category (e.g., "Meat", "Vegetable", "Spice")
-    int quantity;         // Quantity in stock
-    string receiveDate;   // Date when item was received
-    
-    // Default constructor
-    FoodItem() : price(0.0), quantity(0) {
-        id = "";
-        name = "";
-        category = "";
-        receiveDate = "";
-    }
-    
-    // Parameterized constructor
-    FoodItem(const string& _id, const string& _name, double _price, const string& _category, int _quantity = 0) 
-        : id(_id), name(_name), price(_price), category(_category), quantity(_quantity) {
-        // Set receive date to current time
-        time_t now = time(0);
-        string dateStr = ctime(&now);
-        // Remove the newline character from ctime output
-        if (!dateStr.empty() && dateStr[dateStr.length()-1] == '\n') {
-            dateStr.erase(dateStr.length()-1);
-        }
-        receiveDate = dateStr;
-    }
-};
-
-// Food Menu Item structure for restaurant menu 
-struct MenuItem {
-    string id;            // Unique identifier
-    string name;          // Menu item name
-    double price;         // Price for this menu item
-    string description;   // Description of the menu item
-    string category;      // Category (e.g., "Appetizer", "Main Course", "Dessert")
-    
-    // Ingredients needed for this menu item - format: "foodItemId:quantity"
-    string* ingredients;  // Array of ingredient IDs with quantities
-    int ingredientCount;  // Number of ingredients
-    
-    // Default constructor - initializes empty menu item
-    MenuItem() : price(0.0), ingredientCount(0), ingredients(nullptr) {
-        id = "";
-        name = "";
-        description = "";
-        category = "";
-    }
-    
-    // Parameterized constructor - creates menu item with basic information
-    MenuItem(const string& _id, const string& _name, double _price, 
-             const string& _description, const string& _category)
-        : id(_id), name(_name), price(_price), description(_description), 
-          category(_category), ingredientCount(0), ingredients(nullptr) {}
-    
-    // Copy constructor - performs deep copy of other MenuItem including ingredients
-    MenuItem(const MenuItem& other) 
-        : id(other.id), name(other.name), price(other.price), 
-          description(other.description), category(other.category),
-          ingredientCount(other.ingredientCount) {
-        
-        // Deep copy of ingredients array
-        if (other.ingredientCount > 0 && other.ingredients != nullptr) {
-            ingredients = new string[other.ingredientCount];
-            for (int i = 0; i < other.ingredientCount; i++) {
-                ingredients[i] = other.ingredients[i];
-            }
-        } else {
-            ingredients = nullptr;
-        }
-    }
-    
-    // Assignment operator - handles proper deep copy during assignment
-    MenuItem& operator=(const MenuItem& other) {
-        // Self-assignment check to prevent issues
-        if (this == &other) {
-            return *this;
-        }
-        
-        // Copy basic properties
-        id = other.id;
-        name = other.name;
-        price = other.price;
-        description = other.description;
-        category = other.category;
-        
-        // Clean up existing ingredients to prevent memory leaks
-        if (ingredients != nullptr) {
-            delete[] ingredients;
-            ingredients = nullptr;
-        }
-        
-        ingredientCount = other.ingredientCount;
-        
-        // Deep copy the ingredients array
-        if (other.ingredientCount > 0 && other.ingredients != nullptr) {
-            ingredients = new string[other.ingredientCount];
-            for (int i = 0; i < other.ingredientCount; i++) {
-                ingredients[i] = other.ingredients[i];
-            }
-        }
-        
-        return *this;
-    }
-    
-    // Destructor - ensures proper cleanup of dynamically allocated memory
-    ~MenuItem() {
-        if (ingredients != nullptr) {
-            delete[] ingredients;
-            ingredients = nullptr;
-        }
-    }
-    
-    // Adds a new ingredient with specified quantity to the menu item
-    // Dynamically resizes the ingredients array
-    void addIngredient(const string& foodItemId, int quantity) {
-        // Format: "foodItemId:quantity"
-        string ingredient = foodItemId + ":" + to_string(quantity);
-        
-        // Create new array with increased size
-        string* newIngredients = new string[ingredientCount + 1];
+void manageInventory(RestaurantInventorySystem& inventory) {
+    int inventoryChoice;
+    do {
+        // Clear screen and display inventory management options
+        clearScreen();
+        cout << "\n==== Inventory Management ====" << endl;
         
-        // Copy existing ingredients to new array
-        for (int i = 0; i < ingredientCount; i++) {
-            newIngredients[i] = ingredients[i];
-        }
+        // Basic operations for viewing and adding inventory items
+        cout << "1. Display Unsorted Data" << endl;
+        cout << "2. Add New Food Item" << endl;
+        cout << "3. Add Existing Food Item" << endl;
+        cout << "4. Sort By Name" << endl;
+        cout << "5. Sort By Quantity" << endl;
+        cout << "6. Use Food Item / Prepare Menu Item" << endl;
+        // Update search options section
+        // Multiple search methods to find items efficiently
+        cout << "\n-- Search Options --" << endl;
+        cout << "7. Search By ID" << endl;
+        cout << "8. Search By Name" << endl;
+        cout << "9. Search By Price Range" << endl;
         
-        // Add new ingredient at the end
-        newIngredients[ingredientCount] = ingredient;
+        // Additional operations for advanced inventory management
+        cout << "\n-- Other Options --" << endl;
+        cout << "10. Save Sorted Data" << endl;
+        cout << "11. Display Queue Structure" << endl;
+        cout << "12. Display Specific Queue" << endl;
+        cout << "13. Display Usage History" << endl;
+        cout << "14. Sort By Receive Date" << endl;
+        cout << "15. Search By Age (days since received)" << endl;
+        cout << "16. Hash Table Diagnostics" << endl;
+        cout << "17. Low Stock Report" << endl;
+        cout << "18. Set Reorder Threshold" << endl;
         
-        // Delete old array to prevent memory leaks
-        if (ingredients != nullptr) {
-            delete[] ingredients;
+        // Items that reached their reorder threshold, counted by the reorder heap
+        int lowStockCount = inventory.getLowStockCount();
+        if (lowStockCount > 0) {
+            cout << "\n(!) " << lowStockCount << " food item(s) at or below their reorder threshold - see option 17" << endl;
         }
         
-        // Update member variables
-        ingredients = newIngredients;
-        ingredientCount++;
-    }
-    
-    // Removes an ingredient from the menu item by its food item ID
-    // Returns true if found and removed, false otherwise
-    bool removeIngredient(const string& foodItemId) {
-        if (ingredientCount == 0 || ingredients == nullptr) {
-            return false;
-        }
+        cout << "0. Back to Main Menu" << endl;
+        cout << "Enter your choice: ";
+        cin >> inventoryChoice;
         
-        int removeIndex = -1;
+        // Show what other terminal processes changed since the last action
+        inventory.syncShared();
         
-        // Find the ingredient to remove by matching food item ID
-        for (int i = 0; i < ingredientCount; i++) {
-            // Extract food item ID from "foodItemId:quantity"
-            size_t colonPos = ingredients[i].find(":");
-            if (colonPos != string::npos) {
-                string id = ingredients[i].substr(0, colonPos);
-                if (id == foodItemId) {
-                    removeIndex = i;
+        // Process inventory submenu selection
+        switch (inventoryChoice) {
+            case 1: {
+                // Display all inventory items in their original order
+                clearScreen();
+                inventory.displayAll();
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 2: {
+                // Add a new food item to inventory with user input
+                clearScreen();
+                string id, name, category;
+                double price;
+                int quantity;
+                bool isValid = false;
+                
+                // Collect all necessary information about the new food item
+                cout << "==== Add New Food Item ====" << endl;
+                
+                // Validate ID format
+                do {
+                    cout << "Enter ID (format: 1 letter followed by 3 digits): ";
+                    cin >> id;
+                    
+                    if (!ValidationCheck::isValidID(id)) {
+                        ValidationCheck::showError("ID must be 1 letter followed by 3 digits (e.g. F123)");
+                    } else {
+                        isValid = true;
+                    }
+                } while (!isValid);
+                
+                // check if the id already exists
+                if (!inventory.findFoodItem(id).isNull()) {
+                    ValidationCheck::showError("Food Item Id " + id + " already exists, please use another ID");
+                    cout << "\nPress any key to continue...";
+                    getch();
                     break;
                 }
-            }
-        }
-        
-        if (removeIndex == -1) {
-            return false; // Ingredient not found
-        }
-        
-        // Create new array with decreased size
-        string* newIngredients = nullptr;
-        if (ingredientCount > 1) {
-            newIngredients = new string[ingredientCount - 1];
-            
-            // Copy elements before the removal index
-            for (int i = 0; i < removeIndex; i++) {
-                newIngredients[i] = ingredients[i];
-            }
-            
-            // Copy elements after the removal index (skipping the removed element)
-            for (int i = removeIndex + 1; i < ingredientCount; i++) {
-                newIngredients[i - 1] = ingredients[i];
-            }
-        }
-        
-        // Delete old array to prevent memory leaks
-        delete[] ingredients;
-        
-        // Update member variables
-        ingredients = newIngredients;
-        ingredientCount--;
-        
-        return true;
-    }
-    
-    // Retrieves the required quantity of a specific ingredient
-    // Returns 0 if the ingredient is not found
-    int getIngredientQuantity(const string& foodItemId) const {
-        for (int i = 0; i < ingredientCount; i++) {
-            // Extract food item ID and quantity from "foodItemId:quantity"
-            size_t colonPos = ingredients[i].find(":");
-            if (colonPos != string::npos) {
-                string id = ingredients[i].substr(0, colonPos);
-                if (id == foodItemId) {
-                    string quantityStr = ingredients[i].substr(colonPos + 1);
-                    return stoi(quantityStr);
-                }
-            }
-        }
-        
-        return 0; // Ingredient not found
-    }
-};
-
-// Node structure for menu linked list
-// Used as building blocks for the ADTLinkedList class
-struct MenuNode {
-    MenuItem data;       // The menu item stored in this node
-    MenuNode* next;      // Pointer to the next node in the list
-    
-    // Constructor initializes node with a menu item and null next pointer
-    MenuNode(const MenuItem& item) : data(item), next(nullptr) {}
-};
-
-// Singly Linked List for menu items
-// Implements a dynamic list structure for storing and managing menu items
-class ADTLinkedList {
-private:
-    MenuNode* head;      // Pointer to the first node in the list
-    MenuNode* tail;      // Pointer to the last node in the list (for efficient append)
-    int size;            // Current number of elements in the list
-
-public:
-    // Constructor - initializes an empty linked list
-    ADTLinkedList() : head(nullptr), tail(nullptr), size(0) {}
-    
-    // Destructor - cleans up all dynamically allocated nodes to prevent memory leaks
-    ~ADTLinkedList() {
-        MenuNode* current = head;
-        while (current != nullptr) {
-            MenuNode* next = current->next;
-            delete current;
-            current = next;
-        }
-        head = nullptr;
-        tail = nullptr;
-    }
-    
-    // Returns the current number of elements in the list
-    int getSize() const {
-        return size;
-    }
-    
-    // Checks if the list contains no elements
-    bool isEmpty() const {
-        return head == nullptr;
-    }
-    
-    // Adds a new menu item to the end of the list in O(1) time
-    // Uses the tail pointer for efficient append operations
-    void append(const MenuItem& item) {
-        MenuNode* newNode = new MenuNode(item);
-        
-        if (head == nullptr) {
-            // List is empty, set both head and tail to the new node
-            head = tail = newNode;
-        } else {
-            // List has elements, append to the end
-            tail->next = newNode;
-            tail = newNode;
-        }
-        
-        size++;
-    }
-    
-    // Adds a new menu item to the beginning of the list in O(1) time
-    void prepend(const MenuItem& item) {
-        MenuNode* newNode = new MenuNode(item);
-        
-        if (head == nullptr) {
-            // List is empty, set both head and tail to the new node
-            head = tail = newNode;
-        } else {
-            // List has elements, prepend to the beginning
-            newNode->next = head;
-            head = newNode;
-        }
-        
-        size++;
-    }
-    
-    // Inserts a menu item at the specified position (0-based index)
-    // Returns true if successful, false if position is invalid
-    bool insertAt(int position, const MenuItem& item) {
-        // Check if position is valid
-        if (position < 0 || position > size) {
-            return false;
-        }
-        
-        // Special cases: insert at beginning or end
-        if (position == 0) {
-            prepend(item);
-            return true;
-        } else if (position == size) {
-            append(item);
-            return true;
-        }
-        
-        // Insert in the middle of the list
-        MenuNode* newNode = new MenuNode(item);
-        MenuNode* current = head;
-        
-        // Navigate to the node before the insertion point
-        for (int i = 0; i < position - 1; i++) {
-            current = current->next;
-        }
-        
-        // Insert the new node between current and current->next
-        newNode->next = current->next;
-        current->next = newNode;
-        size++;
-        
-        return true;
-    }
-    
-    // Removes a menu item by its ID
-    // Returns true if found and removed, false otherwise
-    bool removeById(const string& id) {
-        if (head == nullptr) {
-            return false;
-        }
-        
-        // Special case: if the head node contains the target ID
-        if (head->data.id == id) {
-            MenuNode* temp = head;
-            head = head->next;
-            
-            // Update tail if list becomes empty
-            if (head == nullptr) {
-                tail = nullptr;
-            }
-            
-            delete temp;
-            size--;
-            return true;
-        }
-        
-        // General case: search for the node with matching ID
-        MenuNode* current = head;
-        MenuNode* prev = nullptr;
-        
-        while (current != nullptr && current->data.id != id) {
-            prev = current;
-            current = current->next;
-        }
-        
-        // If ID not found in the list
-        if (current == nullptr) {
-            return false;
-        }
-        
-        // Link previous node to the node after current (bypass current)
-        prev->next = current->next;
-        
-        // Update tail pointer if we're removing the last node
-        if (current == tail) {
-            tail = prev;
-        }
-        
-        // Free memory and update size
-        delete current;
-        size--;
-        return true;
-    }
-    
-    // Searches for a menu item by ID and returns a copy if found
-    // Returns nullptr if no matching item exists
-    // Caller is responsible for deleting the returned pointer
-    MenuItem* findById(const string& id) const {
-        MenuNode* current = head;
-        
-        // Traverse the list looking for matching ID
-        while (current != nullptr) {
-            if (current->data.id == id) {
-                return new MenuItem(current->data);
-            }
-            current = current->next;
-        }
-        
-        return nullptr; // Item not found
-    }
-    
-    // Creates a dynamically allocated array containing all menu items
-    // Returns nullptr if the list is empty
-    // Caller is responsible for deleting the returned array
-    MenuItem* toArray() const {
-        if (isEmpty()) {
-            return nullptr;
-        }
-        
-        // Allocate an array of the exact size needed
-        MenuItem* items = new MenuItem[size];
-        MenuNode* current = head;
-        int index = 0;
-        
-        // Copy each menu item into the array
-        while (current != nullptr) {
-            items[index++] = current->data;
-            current = current->next;
-        }
-        
-        return items;
-    }
-};
-
-// Node structure for linked queue
-// Basic building block for the ADTLinkedQueue class
-struct Node {
-    FoodItem data;      // The food item stored in this node
-    Node* next;         // Pointer to the next node in the queue
-    
-    // Constructor initializes node with a food item and null next pointer
-    Node(const FoodItem& item) : data(item), next(nullptr) {}
-};
-
-// Linked Queue for processing inventory items with FIFO order
-// Implements a First-In-First-Out (FIFO) structure for food items
-class ADTLinkedQueue {
-private:
-    Node *front, *rear;  // Pointers to the front and rear of the queue
-    int size;            // Current number of elements in the queue
-
-public:
-    // Constructor - initializes an empty queue
-    ADTLinkedQueue() : front(nullptr), rear(nullptr), size(0) {}
-    
-    // Copy constructor - performs deep copy of another queue
-    ADTLinkedQueue(const ADTLinkedQueue& other) : front(nullptr), rear(nullptr), size(0) {
-        // Copy nodes from other queue in order
-        Node* current = other.front;
-        while (current != nullptr) {
-            enqueue(current->data);
-            current = current->next;
-        }
-    }
-    
-    // Destructor - cleans up all nodes to prevent memory leaks
-    ~ADTLinkedQueue() {
-        while (!isEmpty()) {
-            dequeue();
-        }
-    }
-    
-    // Checks if the queue is empty (contains no elements)
-    bool isEmpty() const {
-        return front == nullptr;
-    }
-    
-    // Returns the current number of elements in the queue
-    int getSize() const {
-        return size;
-    }
-    
-    // Adds a new food item to the end of the queue
-    // Time complexity: O(1)
-    void enqueue(const FoodItem& item) {
-        Node* newNode = new Node(item);
-        
-        if (rear == nullptr) {
-            // Queue is empty, set both front and rear to the new node
-            front = rear = newNode;
-        } else {
-            // Queue has elements, add to the end
-            rear->next = newNode;
-            rear = newNode;
-        }
-        
-        size++;
-    }
-    
-    // Removes and returns the food item from the front of the queue
-    // Returns an empty FoodItem if the queue is empty
-    // Time complexity: O(1)
-    FoodItem dequeue() {
-        FoodItem item;
-        
-        if (!isEmpty()) {
-            Node* temp = front;
-            item = temp->data;
-            
-            // Move front pointer to the next node
-            front = front->next;
-            
-            // If queue becomes empty, update rear pointer
-            if (front == nullptr) {
-                rear = nullptr;
-            }
-            
-            // Free memory and update size
-            delete temp;
-            size--;
-        }
-        
-        return item;
-    }
-    
-    // Returns the food item at the front without removing it
-    // Returns an empty FoodItem if the queue is empty
-    FoodItem peek() const {
-        if (!isEmpty()) {
-            return front->data;
-        }
-        return FoodItem(); // Return empty item if queue is empty
-    }
-    
-    // Creates a dynamically allocated array containing all food items in the queue
-    // Returns nullptr if the queue is empty
-    // Caller is responsible for deleting the returned array
-    FoodItem* toArray() const {
-        if (isEmpty()) {
-            return nullptr;
-        }
-        
-        // Allocate an array of the exact size needed
-        FoodItem* items = nullptr;
-        items = new FoodItem[size];
-        Node* current = front;
-        int index = 0;
-        
-        // Copy each food item into the array in queue order
-        while (current != nullptr) {
-            items[index++] = current->data;
-            current = current->next;
-        }
-        
-        return items;
-    }
-    
-    // Assignment operator - performs deep copy of another queue
-    // Properly handles self-assignment and memory management
-    ADTLinkedQueue& operator=(const ADTLinkedQueue& other) {
-        // Self-assignment check to prevent issues
-        if (this == &other) {
-            return *this; // if same then return same
-        }
-        
-        // Clear current queue contents
-        while (!isEmpty()) {
-            dequeue();
-        }
-        
-        // Copy nodes from other queue in order
-        Node* current = other.front;
-        while (current != nullptr) {
-            enqueue(current->data);
-            current = current->next;
-        }
-        
-        return *this;
-    }
-};
-
-// Universal Hash Function constants
-const int PRIME = 31;
-const int MAX_HASH_KEY = 101; // Prime number for hash table size
-
-// Restaurant Inventory System with Hash Table
-class RestaurantInventorySystem : public Restaurant {
-private:
-    // In practice it always turns out that it is better to have an index range that is a prime number.
-    // This way you do not get so many COLLISIONS.
-    static const int TABLE_SIZE = 101; // Prime number for better hash distribution
-    ADTLinkedQueue* hashTable;            // Array of linked queues (buckets)
-    
-    // Universal hash function for strings
-    // Implements a polynomial rolling hash
-    int universalHash(const string& key) {
-        unsigned long hash = 0;
-        int length = key.length();
-        
-        // Universal hash function: h(k) = ((a*k + b) mod p) mod m
-        // hash = ((hash * PRIME + key[i]) % MAX_HASH_KEY) % TABLE_SIZE;
-        // Using polynomial rolling hash: h(k) = sum(k[i]*PRIME^(n-i-1)) mod TABLE_SIZE
-        for (int i = 0; i < length; i++) {
-            hash = (hash * PRIME + key[i]) % MAX_HASH_KEY;
-        }
-        
-        return hash % TABLE_SIZE;
-    }
-    
-    // Quadratic probing function for collision resolution
-    int quadraticProbing(int hashValue, int attempt) {
-        // Quadratic probing formula: h'(k, i) = (h(k) + c1*i + c2*i^2) mod TABLE_SIZE
-        // Using c1=0, c2=1: h'(k, i) = (h(k) + i^2) mod TABLE_SIZE
-        return (hashValue + attempt * attempt) % TABLE_SIZE;
-    }
-    
-    // Find position using quadratic probing
-    int findPosition(const string& id) {
-        int hashValue = universalHash(id);
-        int attempt = 0;
-        
-        while (attempt < TABLE_SIZE) {
-            int position = quadraticProbing(hashValue, attempt);
-            ADTLinkedQueue queue = hashTable[position];
-            
-            if (queue.isEmpty()) {
-                return position; // Empty bucket found
-            }
-            
-            // Check if item exists in this bucket
-            FoodItem* items = queue.toArray();
-            bool found = false;
-            
-            for (int i = 0; i < queue.getSize(); i++) {
-                if (items[i].id == id) {
-                    found = true;
-                    delete[] items;
-                    return position;
-                }
-            }
-            
-            delete[] items;
-            
-            if (!found) {
-                attempt++;
-            } else {
-                return position;
-            }
-        }
-        
-        // If table is full, return -1
-        return -1;
-    }
-
-public:
-    // Make TABLE_SIZE accessible publicly
-    static const int MAX_BUCKETS = 101; // Prime number Same as TABLE_SIZE
-    
-    // Merge function for Tim Sort
-    // Parameters: array, left boundary, middle point, right boundary, and sort criteria
-    static void merge(FoodItem arr[], int left, int mid, int right, bool byName) {
-        int i, j, k;
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
-        
-        // Create temporary arrays
-        FoodItem* L = new FoodItem[n1];
-        FoodItem* R = new FoodItem[n2];
-        
-        // Copy data to temp arrays L[] and R[]
-        for (i = 0; i < n1; i++)
-            L[i] = arr[left + i];
-        for (j = 0; j < n2; j++)
-            R[j] = arr[mid + 1 + j];
-        
-        // Merge the temp arrays back into arr[l..r]
-        i = 0; // Initial index of first subarray
-        j = 0; // Initial index of second subarray
-        k = left; // Initial index of merged subarray
-        
-        while (i < n1 && j < n2) {
-            if (byName) {
-                // Sort by name (alphabetically)
-                // Case-insensitive comparison of names
-                string nameL = L[i].name;
-                string nameR = R[j].name;
-                
-                // Convert to lowercase for comparison without using transform
-                bool namesSame = true;
-                int minLen = (nameL.length() < nameR.length()) ? nameL.length() : nameR.length();
-                
-                for (int idx = 0; idx < minLen; idx++) {
-                    char cL = (nameL[idx] >= 'A' && nameL[idx] <= 'Z') ? nameL[idx] + 32 : nameL[idx];
-                    char cR = (nameR[idx] >= 'A' && nameR[idx] <= 'Z') ? nameR[idx] + 32 : nameR[idx];
-                    
-                    if (cL < cR) {
-                        // L comes before R
-                        namesSame = false;
-                        arr[k] = L[i];
-                        i++;
-                        break;
-                    } else if (cL > cR) {
-                        // R comes before L
-                        namesSame = false;
-                        arr[k] = R[j];
-                        j++;
-                        break;
-                    }
-                }
-                
-                // If all compared characters are the same, shorter string comes first
-                if (namesSame) {
-                    if (nameL.length() <= nameR.length()) {
-                        arr[k] = L[i];
-                        i++;
-                    } else {
-                        arr[k] = R[j];
-                        j++;
-                    }
-                }
-            } else {
-                // Sort by quantity (ascending)
-                if (L[i].quantity <= R[j].quantity) {
-                    arr[k] = L[i];
-                    i++;
-                } else {
-                    arr[k] = R[j];
-                    j++;
-                }
-            }
-            k++;
-        }
-        
-        // Copy the remaining elements of L[], if there are any
-        while (i < n1) {
-            arr[k] = L[i];
-            i++;
-            k++;
-        }
-        
-        // Copy the remaining elements of R[], if there are any
-        while (j < n2) {
-            arr[k] = R[j];
-            j++;
-            k++;
-        }
-        
-        // Free the allocated memory for temporary arrays
-        delete[] L;
-        delete[] R;
-    }
-    
-    // Insertion sort (part of Tim Sort)
-    // Efficiently sorts small subarrays using in-place insertion sort
-    // Parameters: array, left boundary, right boundary, and sort criteria
-    static void insertionSort(FoodItem arr[], int left, int right, bool byName) {
-        for (int i = left + 1; i <= right; i++) {
-            // Store current element as temporary
-            FoodItem temp = arr[i];
-            int j = i - 1;
-            
-            if (byName) {
-                // Sort by name (alphabetical order)
-                // Implement case-insensitive comparison
-                while (j >= left) {
-                    // Compare names case-insensitively
-                    string nameTemp = temp.name;
-                    string nameJ = arr[j].name;
-                    bool jGreater = false;
-                    
-                    // Compare characters one by one
-                    int minLen = (nameTemp.length() < nameJ.length()) ? nameTemp.length() : nameJ.length();
-                    for (int k = 0; k < minLen; k++) {
-                        char cTemp = (nameTemp[k] >= 'A' && nameTemp[k] <= 'Z') ? nameTemp[k] + 32 : nameTemp[k];
-                        char cJ = (nameJ[k] >= 'A' && nameJ[k] <= 'Z') ? nameJ[k] + 32 : nameJ[k];
-                        
-                        if (cJ > cTemp) {
-                            jGreater = true;
-                            break;
-                        } else if (cJ < cTemp) {
-                            jGreater = false;
-                            break;
-                        }
-                    }
-                    
-                    // If all compared characters are the same, longer string is "greater"
-                    if (!jGreater && nameJ.length() > nameTemp.length() && minLen == nameTemp.length()) {
-                        jGreater = true;
-                    }
-                    
-                    if (jGreater) {
-                        arr[j + 1] = arr[j];
-                        j--;
-                    } else {
-                        break;
-                    }
-                }
-            } else {
-                // Sort by quantity (numerical order)
-                // Move elements greater than temp to one position ahead
-                while (j >= left && arr[j].quantity > temp.quantity) {
-                    arr[j + 1] = arr[j];
-                    j--;
-                }
-            }
-            
-            // Place temp in its correct position
-            arr[j + 1] = temp;
-        }
-    }
-    
-    // Tim Sort main function
-    // A hybrid sorting algorithm combining insertion sort and merge sort
-    // Average time complexity: O(n log n)
-    static void timSort(FoodItem arr[], int n, bool byName = true) {
-        // Run size for insertion sort (optimal value based on typical array sizes)
-        const int RUN = 32;
-        
-        // First, sort individual subarrays of size RUN using insertion sort
-        // This is efficient for small arrays and creates sorted runs
-        for (int i = 0; i < n; i += RUN) {
-            insertionSort(arr, i, min(i + RUN - 1, n - 1), byName);
-        }
-        
-        // Start merging sorted runs from size RUN
-        // Each iteration doubles the size of subarrays being merged
-        for (int size = RUN; size < n; size = 2 * size) {
-            // Pick starting points of different subarrays of current size
-            for (int left = 0; left < n; left += 2 * size) {
-                // Find ending points of subarrays
-                int mid = left + size - 1;
-                int right = min(left + 2 * size - 1, n - 1);
-                
-                // Merge subarrays arr[left...mid] and arr[mid+1...right]
-                if (mid < right) {
-                    merge(arr, left, mid, right, byName);
-                }
-            }
-        }
-    }
-    
-    // Constructor - initializes the hash table for storing food items
-    // Creates an array of empty linked queues (buckets)
-    RestaurantInventorySystem() : Restaurant() {
-        hashTable = new ADTLinkedQueue[TABLE_SIZE];
-    }
-    
-    // Destructor - frees all memory allocated for the hash table
-    virtual ~RestaurantInventorySystem() override {
-        delete[] hashTable;
-    }
-    
-    // Loads food items from a TXT file into the inventory system
-    // Returns true if at least one item was successfully loaded
-    virtual bool loadFromFile(const string& filename) override {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Could not open file " << filename << endl;
-            return false;
-        }
-        
-        // Clear existing items to prevent duplicates
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            while (!hashTable[i].isEmpty()) {
-                hashTable[i].dequeue();
-            }
-        }
-        itemCount = 0;
-        
-        string line;
-        int itemsLoaded = 0;
-        
-        // Process each line in the file
-        while (getline(file, line)) {
-            string id, name, category, receiveDate;
-            double price;
-            int quantity;
-            
-            // Parse TXT line (format: id,name,price,category,quantity,receiveDate)
-            size_t pos = 0;
-            string token;
-            
-            // Extract ID
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            id = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Name
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            name = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Price
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            price = stod(line.substr(0, pos));
-            line.erase(0, pos + 1);
-            
-            // Extract Category
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            category = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Quantity and optional Receive Date
-            pos = line.find(",");
-            if (pos == string::npos) {
-                quantity = stoi(line);
-                receiveDate = ""; // No receive date in file
-            } else {
-                quantity = stoi(line.substr(0, pos));
-                line.erase(0, pos + 1);
-                // Extract Receive Date
-                receiveDate = line;
-            }
-            
-            // Create food item and insert into hash table
-            FoodItem item(id, name, price, category, quantity);
-            if (!receiveDate.empty()) {
-                item.receiveDate = receiveDate;
-            }
-            
-            // Always add as a new batch (like addExistingFoodItem does)
-            // This ensures all items from the file are loaded, including multiple batches of the same ID
-            int position = findPosition(id);
-            if (position != -1) {
-                // Add directly to the queue at the found position
-                hashTable[position].enqueue(item);
-                
-                // Increment item count only for new unique IDs
-                bool isNewId = true;
-                for (int i = 0; i < position; i++) {
-                    if (!hashTable[i].isEmpty()) {
-                        ADTLinkedQueue tempQueue = hashTable[i];
-                        FoodItem* queueItems = tempQueue.toArray();
-                        for (int j = 0; j < tempQueue.getSize(); j++) {
-                            if (queueItems[j].id == id) {
-                                isNewId = false;
-                                break;
-                            }
-                        }
-                        delete[] queueItems;
-                        if (!isNewId) break;
-                    }
-                }
-                
-                for (int i = position + 1; i < TABLE_SIZE && isNewId; i++) {
-                    if (!hashTable[i].isEmpty()) {
-                        ADTLinkedQueue tempQueue = hashTable[i];
-                        FoodItem* queueItems = tempQueue.toArray();
-                        for (int j = 0; j < tempQueue.getSize(); j++) {
-                            if (queueItems[j].id == id) {
-                                isNewId = false;
-                                break;
-                            }
-                        }
-                        delete[] queueItems;
-                        if (!isNewId) break;
-                    }
-                }
-                
-                if (isNewId) {
-                    this->itemCount++;
-                }
-                
-                itemsLoaded++;
-            }
-        }
-        
-        file.close();
-        cout << "Successfully loaded " << itemsLoaded << " food items from " << filename << endl;
-        return itemsLoaded > 0;
-    }
-    
-    // Saves all food items in the inventory to a TXT file
-    // Optional sorting by name can be applied before saving
-    virtual bool saveToFile(const string& filename, bool sorted = false) override {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Could not open file " << filename << " for writing" << endl;
-            return false;
-        }
-        
-        // First, count the total number of items across all buckets
-        int totalItems = 0;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (!hashTable[i].isEmpty()) {
-                totalItems += hashTable[i].getSize();
-            }
-        }
-        
-        // Get all food items as an array
-        FoodItem* items = getAllItems();
-        
-        // Check if items were properly allocated
-        if (items == nullptr && totalItems > 0) {
-            cout << "Error: Failed to allocate memory for food items." << endl;
-            file.close();
-            return false;
-        }
-        
-        // Sort items if requested
-        if (sorted && totalItems > 0 && items != nullptr) {
-            timSort(items, totalItems, true); // Sort by name
-        }
-        
-        // Write to file
-        if (totalItems > 0 && items != nullptr) {
-            for (int i = 0; i < totalItems; i++) {
-                file << items[i].id << ","
-                     << items[i].name << ","
-                     << items[i].price << ","
-                     << items[i].category << ","
-                     << items[i].quantity << ","
-                     << items[i].receiveDate << endl;
-            }
-            delete[] items;
-            cout << "Successfully saved " << totalItems << " food items to " << filename << endl;
-        } else {
-            // Write an empty file if no items
-            cout << "No items to save to file." << endl;
-        }
-        
-        file.close();
-        return true;
-    }
-    
-    // Insert a food item into the hash table
-    // Parameters: food item to insert
-    // Returns: true if successful, false if failed
-    bool insertFoodItem(const FoodItem& item) {
-        if (item.id.empty()) {
-            cout << "Error: Food item ID cannot be empty." << endl;
-            return false;
-        }
-        
-        // Find position using hash function and quadratic probing
-        int position = findPosition(item.id);
-        if (position == -1) {
-            cout << "Error: Hash table is full." << endl;
-            return false;
-        }
-        
-        // Check if item with this ID already exists
-        FoodItem* existingItem = findFoodItem(item.id);
-        if (existingItem != nullptr) {
-            // Update quantity if item exists (combine quantities)
-            FoodItem updated = *existingItem;
-            updated.quantity += item.quantity;
-            
-            // Remove existing item and add updated one to maintain consistency
-            removeFoodItem(item.id);
-            hashTable[position].enqueue(updated);
-            
-            delete existingItem;
-        } else {
-            // Add new item to the appropriate bucket
-            hashTable[position].enqueue(item);
-            this->itemCount++;
-        }
-        
-        return true;
-    }
-    
-    // Find a food item by ID
-    // Parameters: ID to search for
-    // Returns: pointer to a copy of the found item or nullptr if not found
-    // Note: Caller is responsible for deleting the returned pointer
-    FoodItem* findFoodItem(const string& id) {
-        // Start with initial hash position
-        int position = universalHash(id);
-        int attempt = 0;
-        
-        // Variables for aggregating quantities of items with the same ID
-        bool itemFound = false;
-        FoodItem* result = nullptr;
-        
-        // Try all possible positions using quadratic probing
-        while (attempt < TABLE_SIZE) {
-            int probePos = quadraticProbing(position, attempt);
-            
-            // If the bucket at this position is not empty
-            if (!hashTable[probePos].isEmpty()) {
-                // Search in the queue at this bucket
-                ADTLinkedQueue tempQueue = hashTable[probePos];
-                FoodItem* items = tempQueue.toArray();
-                int size = tempQueue.getSize();
-                
-                // Check all items in this bucket
-                for (int i = 0; i < size; i++) {
-                    if (items[i].id == id) {
-                        if (!itemFound) {
-                            // First time finding an item with this ID
-                            // Create a new FoodItem as the result
-                            result = new FoodItem(items[i]);
-                            itemFound = true;
-                        } else {
-                            // If we already found an item with this ID, 
-                            // update the quantity of the result
-                            result->quantity += items[i].quantity;
-                        }
-                    }
-                }
-                
-                // Clean up allocated memory
-                delete[] items;
-            }
-            
-            // Try next position using quadratic probing
-            attempt++;
-        }
-        
-        // Return the aggregated result or nullptr if not found
-        return result;
-    }
-    
-    // Remove a food item by ID
-    // Parameters: ID of the item to remove
-    // Returns: true if found and removed, false if item not found
-    bool removeFoodItem(const string& id) {
-        // Start with initial hash position
-        int position = universalHash(id);
-        int attempt = 0;
-        
-        // Try all possible bucket positions using quadratic probing
-        while (attempt < TABLE_SIZE) {
-            int probePos = quadraticProbing(position, attempt);
-            
-            // Found a non-empty bucket, check if our item is here
-            if (!hashTable[probePos].isEmpty()) {
-                // Create a new queue that will contain all items except the one to remove
-                ADTLinkedQueue tempQueue = hashTable[probePos];
-                ADTLinkedQueue newQueue;
-                bool found = false;
-                
-                // Process each item in the bucket
-                while (!tempQueue.isEmpty()) {
-                    FoodItem item = tempQueue.dequeue();
-                    
-                    // Keep all items except the one matching the ID we want to remove
-                    if (item.id != id) {
-                        newQueue.enqueue(item);
-                    } else {
-                        found = true;
-                        this->itemCount--;
-                    }
-                }
-                
-                // If item was found and removed, update the bucket with the new queue
-                if (found) {
-                    hashTable[probePos] = newQueue;
-                    return true;
-                }
-            }
-            
-            // Try next position
-            attempt++;
-        }
-        
-        return false; // Item not found after checking all possible positions
-    }
-    
-    // Display all food items (unsorted)
-    // Shows a formatted table of all items in the inventory
-    virtual void displayAll() override {
-        // Print table header with title
-        printHeader("Restaurant Inventory System - All Items");
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(15) << "Category" 
-             << setw(10) << "Quantity" 
-             << setw(25) << "Receive Date" << endl;
-        printFooter();
-        
-        // Count the total number of items across all buckets
-        int totalItems = 0;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (!hashTable[i].isEmpty()) {
-                totalItems += hashTable[i].getSize();
-            }
-        }
-        
-        // Get all items from the hash table
-        FoodItem* items = getAllItems();
-        
-        // Handle empty inventory case
-        if (totalItems == 0) {
-            cout << "No items in inventory." << endl;
-        } else {
-            // Display each item with formatted columns
-            for (int i = 0; i < totalItems; i++) {
-                cout << left << setw(10) << items[i].id 
-                     << setw(30) << items[i].name 
-                     << setw(10) << fixed << setprecision(2) << items[i].price
-                     << setw(15) << items[i].category
-                     << setw(10) << items[i].quantity 
-                     << setw(25) << items[i].receiveDate << endl;
-            }
-        }
-        
-        // Clean up allocated memory
-        delete[] items;
-    }
-    
-    // Display all food items sorted by name or quantity
-    // Parameter: byName - if true, sort by name; if false, sort by quantity
-    // use tim sort
-    virtual void displaySorted(bool byName = true) override {
-        // Print table header with appropriate title based on sort criteria
-        printHeader(byName ? "Restaurant Inventory System - Sorted by Name" 
-                           : "Restaurant Inventory System - Sorted by Quantity (Total)");
-        
-        // Print column headers
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(15) << "Category" 
-             << setw(10) << "Quantity" 
-             << setw(25) << "Receive Date" << endl;
-        printFooter();
-        
-        // Get all items as a array from the hash table
-        FoodItem* items = getAllItems();
-        
-        // Count the total number of items we got
-        int totalItemCount = 0;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (!hashTable[i].isEmpty()) {
-                totalItemCount += hashTable[i].getSize();
-            }
-        }
-        
-        // Handle empty inventory case
-        if (totalItemCount == 0) {
-            cout << "No items in inventory." << endl;
-        } else {
-            if (byName) {
-                // Create a copy of the items array for sorting (preserve original)
-                FoodItem* sortedItems = new FoodItem[totalItemCount];
-                for (int i = 0; i < totalItemCount; i++) {
-                    sortedItems[i] = items[i];
-                }
-                
-                // Sort using Tim Sort algorithm based on name
-                timSort(sortedItems, totalItemCount, true);
-                
-                // Display each item with formatted columns
-                for (int i = 0; i < totalItemCount; i++) {
-                    cout << left << setw(10) << sortedItems[i].id 
-                         << setw(30) << sortedItems[i].name 
-                         << setw(10) << fixed << setprecision(2) << sortedItems[i].price
-                         << setw(15) << sortedItems[i].category
-                         << setw(10) << sortedItems[i].quantity 
-                         << setw(25) << sortedItems[i].receiveDate << endl;
-                }
-                
-                // Clean up allocated memory for sorted array
-                delete[] sortedItems;
-            } else {
-                // When sorting by quantity, we need to aggregate quantities for items with the same ID
-
-                // First, identify all unique IDs
-                int uniqueCount = 0;
-                string* uniqueIds = new string[totalItemCount];
-                
-                // Find unique IDs
-                for (int i = 0; i < totalItemCount; i++) {
-                    bool isUnique = true;
-                    
-                    // Check if this ID is already in our uniqueIds array
-                    for (int j = 0; j < uniqueCount; j++) {
-                        if (uniqueIds[j] == items[i].id) {
-                            isUnique = false;
-                            break;
-                        }
-                    }
-                    
-                    // If it's a new ID, add it to our unique IDs array
-                    if (isUnique) {
-                        uniqueIds[uniqueCount++] = items[i].id;
-                    }
-                }
-                
-                // Create an array to hold the aggregated items
-                FoodItem* aggregatedItems = new FoodItem[uniqueCount];
-                
-                // Initialize the aggregated items array with the first occurrence of each ID
-                for (int i = 0; i < uniqueCount; i++) {
-                    for (int j = 0; j < totalItemCount; j++) {
-                        if (items[j].id == uniqueIds[i]) {
-                            aggregatedItems[i] = items[j];
-                            break;
-                        }
-                    }
-                }
-                
-                // Sum up quantities for items with the same ID
-                for (int i = 0; i < uniqueCount; i++) {
-                    int totalQuantity = 0;
-                    
-                    // Sum quantities of all items with this ID
-                    for (int j = 0; j < totalItemCount; j++) {
-                        if (items[j].id == uniqueIds[i]) {
-                            totalQuantity += items[j].quantity;
-                        }
-                    }
-                    
-                    // Update the quantity in our aggregated items array
-                    aggregatedItems[i].quantity = totalQuantity;
-                }
-                
-                // Sort using Tim Sort algorithm based on quantity
-                timSort(aggregatedItems, uniqueCount, false);
-                
-                // Display each item with formatted columns
-                for (int i = 0; i < uniqueCount; i++) {
-                    cout << left << setw(10) << aggregatedItems[i].id 
-                         << setw(30) << aggregatedItems[i].name 
-                         << setw(10) << fixed << setprecision(2) << aggregatedItems[i].price
-                         << setw(15) << aggregatedItems[i].category
-                         << setw(10) << aggregatedItems[i].quantity 
-                         << "(Total)" << endl;
-                }
-                
-                // Clean up allocated memory
-                delete[] uniqueIds;
-                delete[] aggregatedItems;
-            }
-        }
-        
-        // Clean up allocated memory for original array
-        delete[] items;
-    }
-    
-    // Get all food items as an array from across all hash table buckets
-    // Returns: dynamically allocated array of FoodItem objects
-    // Note: Caller is responsible for deleting the returned array
-    FoodItem* getAllItems() {
-        // First, count the total number of items across all buckets
-        int totalItems = 0;
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (!hashTable[i].isEmpty()) {
-                totalItems += hashTable[i].getSize();
-            }
-        }
-        
-        // Check if there are any items to return
-        if (totalItems <= 0) {
-            return nullptr;
-        }
-        
-        // Try to allocate memory with exception handling to prevent crashes
-        FoodItem* items = nullptr;
-        try {
-            // Allocate memory for the array to hold all items based on the actual count
-            items = new FoodItem[totalItems];
-            int index = 0;
-            
-            // Iterate through all hash table buckets
-            for (int i = 0; i < TABLE_SIZE; i++) {
-                // Process non-empty buckets only
-                if (!hashTable[i].isEmpty()) {
-                    // Get all items in the current bucket as an array
-                    ADTLinkedQueue tempQueue = hashTable[i];
-                    FoodItem* queueItems = tempQueue.toArray();
-                    
-                    // Copy each item from the bucket to the main array
-                    if (queueItems != nullptr) {
-                        for (int j = 0; j < tempQueue.getSize(); j++) {
-                            if (index < totalItems) {
-                                items[index++] = queueItems[j];
-                            }
-                        }
-                        
-                        // Clean up the temporary array
-                        delete[] queueItems;
-                    }
-                }
-            }
-        } catch (const bad_alloc&) {
-            // Handle memory allocation failure
-            cout << "Memory allocation failed in getAllItems()" << endl;
-            return nullptr;
-        }
-        
-        return items;
-    }
-    
-    // Search and display food item by ID
-    // Presents formatted information about all instances of the item if found
-    // search from the hash table
-    void searchById(const string& id) {
-        bool found = false;
-        int totalCount = 0;
-        int totalQuantity = 0;
-        string itemName = "";
-        string category = "";
-        double price = 0.0;
-        
-        // Print table header
-        printHeader("Search Result for ID: " + id);
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(15) << "Category" 
-             << setw(10) << "Quantity" 
-             << setw(25) << "Receive Date" << endl;
-        printFooter();
-        
-        // Iterate through all buckets to find all instances of this ID
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (hashTable[i].isEmpty()) continue;
-            
-            // Get all items in this bucket
-            ADTLinkedQueue tempQueue = hashTable[i];
-            FoodItem* items = tempQueue.toArray();
-            int size = tempQueue.getSize();
-            
-            // Check each item for matching ID
-            for (int j = 0; j < size; j++) {
-                if (items[j].id == id) {
-                    // Found a match, display it
-                    found = true;
-                    totalCount++;
-                    totalQuantity += items[j].quantity;
-                    
-                    // Store item details for summary
-                    if (itemName.empty()) {
-                        itemName = items[j].name;
-                        category = items[j].category;
-                        price = items[j].price;
-                    }
-                    
-                    // Format and display the item details
-                    cout << left << setw(10) << items[j].id 
-                         << setw(30) << items[j].name 
-                         << setw(10) << fixed << setprecision(2) << items[j].price
-                         << setw(15) << items[j].category
-                         << setw(10) << items[j].quantity 
-                         << setw(25) << items[j].receiveDate << endl;
-                }
-            }
-            
-            // Free allocated memory
-            delete[] items;
-        }
-        
-        // Show summary or not found message
-        if (found) {
-            cout << "\n----- Summary -----" << endl;
-            cout << "Found " << totalCount << " instance(s) of " << itemName << " (ID: " << id << ")" << endl;
-            cout << "Total quantity: " << totalQuantity << endl;
-        } else {
-            cout << "Item with ID " << id << " not found." << endl;
-        }
-    }
-    
-    // Get current number of items in the system
-    virtual int getItemCount() const override {
-        return Restaurant::getItemCount();
-    }
-
-    // Display queue contents for a specific bucket
-    // Parameters: bucketIndex - the index of the bucket to display
-    void displayQueue(int bucketIndex) {
-        // Validate bucket index
-        if (bucketIndex < 0 || bucketIndex >= TABLE_SIZE) {
-            cout << "Invalid bucket index." << endl;
-            return;
-        }
-        
-        // Get a copy of the queue at the specified bucket
-        ADTLinkedQueue tempQueue = hashTable[bucketIndex];
-        
-        // Check if the bucket is empty
-        if (tempQueue.isEmpty()) {
-            cout << "Bucket " << bucketIndex << " is empty." << endl;
-            return;
-        }
-        
-        // Get all items in the bucket as an array
-        FoodItem* items = tempQueue.toArray();
-        int queueSize = tempQueue.getSize();
-        
-        // Print table header
-        printHeader("Queue Contents for Bucket " + to_string(bucketIndex));
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(15) << "Category" 
-             << setw(10) << "Quantity" 
-             << setw(25) << "Receive Date" << endl;
-        printFooter();
-        
-        // Display all items in the bucket
-        for (int i = 0; i < queueSize; i++) {
-            cout << left << setw(10) << items[i].id 
-                 << setw(30) << items[i].name 
-                 << setw(10) << fixed << setprecision(2) << items[i].price
-                 << setw(15) << items[i].category
-                 << setw(10) << items[i].quantity 
-                 << setw(25) << items[i].receiveDate << endl;
-        }
-        
-        // Clean up allocated memory
-        delete[] items;
-    }
-
-    // Display all non-empty queues in the hash table
-    // Shows the contents of each bucket that contains at least one item
-    void displayAllQueues() {
-        printHeader("All Queues Contents");
-        
-        // Track if any non-empty queues were found
-        bool anyQueues = false;
-        
-        // Iterate through all buckets in the hash table
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            // Display only non-empty buckets
-            if (!hashTable[i].isEmpty()) {
-                // Print bucket header with index and size information
-                cout << "\nBucket " << i << " (Size: " << hashTable[i].getSize() << "):" << endl;
-                cout << left << setw(10) << "ID" 
-                     << setw(30) << "Name" 
-                     << setw(10) << "Price" 
-                     << setw(15) << "Category" 
-                     << setw(10) << "Quantity" 
-                     << setw(25) << "Receive Date" << endl;
-                cout << string(100, '-') << endl;
-                
-                // Get items in the current bucket
-                FoodItem* items = hashTable[i].toArray();
-                int queueSize = hashTable[i].getSize();
-                
-                // Display each item in the bucket
-                for (int j = 0; j < queueSize; j++) {
-                    cout << left << setw(10) << items[j].id 
-                         << setw(30) << items[j].name 
-                         << setw(10) << fixed << setprecision(2) << items[j].price
-                         << setw(15) << items[j].category
-                         << setw(10) << items[j].quantity 
-                         << setw(25) << items[j].receiveDate << endl;
-                }
-                
-                // Clean up allocated memory
-                delete[] items;
-                anyQueues = true;
-            }
-        }
-        
-        // Display message if all buckets are empty
-        if (!anyQueues) {
-            cout << "No non-empty queues found." << endl;
-        }
-    }
-
-    // Use (consume) a food item by ID - improved implementation for duplicate IDs
-    // Parameters: id - the ID of the food item to consume
-    //             amount - the quantity to consume (default: 1)
-    // Returns: true if successfully consumed, false if item not found or not enough quantity
-    bool useFoodItem(const string& id, int amount = 1) {
-        try {
-            // Ensure all inventory changes are saved before using items
-            this->saveToFile("food_items.txt");
-            
-            // Search for the item info first to verify it exists and has enough quantity
-            string itemName = "";
-            int totalQuantity = 0;
-            
-            // First pass: Find the item and calculate total quantity across all buckets
-            for (int i = 0; i < TABLE_SIZE; i++) {
-                if (hashTable[i].isEmpty()) continue;
-                
-                // Create a copy of the queue to inspect without modifying the original
-                ADTLinkedQueue tempQueue = hashTable[i];
-                int size = tempQueue.getSize();
-                FoodItem* items = tempQueue.toArray();
-                
-                // Check each item in the bucket
-                for (int j = 0; j < size; j++) {
-                    // If this is the item we're looking for, accumulate quantity info
-                    if (items[j].id == id) {
-                        totalQuantity += items[j].quantity;
-                        if (itemName.empty()) {
-                            itemName = items[j].name;
-                        }
-                    }
-                }
-                
-                // Free allocated memory
-                delete[] items;
-            }
-            
-            // Check if item exists
-            if (totalQuantity == 0) {
-                cout << "Error: Food item with ID " << id << " not found." << endl;
-                return false;
-            }
-            
-            // Check if enough quantity is available
-            if (totalQuantity < amount) {
-                cout << "Error: Not enough quantity available. Only " << totalQuantity << " units of " << itemName << " in stock." << endl;
-                return false;
-            }
-            
-            // Second pass: Now we'll consume the items using FIFO order
-            int remaining = amount;
-            
-            // Process each bucket until we've consumed the required amount
-            for (int i = 0; i < TABLE_SIZE && remaining > 0; i++) {
-                if (hashTable[i].isEmpty()) continue;
-                
-                // Use temporary queues to process the bucket
-                ADTLinkedQueue oldQueue;
-                ADTLinkedQueue newQueue;
-                int size = hashTable[i].getSize();
-                
-                // Move all items to temporary queue to process them
-                for (int j = 0; j < size; j++) {
-                    oldQueue.enqueue(hashTable[i].dequeue());
-                }
-                
-                // Process each item - either consume it or keep it
-                size = oldQueue.getSize();
-                for (int j = 0; j < size; j++) {
-                    FoodItem item = oldQueue.dequeue();
-                    
-                    // If this is our target item and we still need to consume more
-                    if (item.id == id && remaining > 0) {
-                        if (item.quantity > remaining) {
-                            // Partially consume this item (reduce quantity and keep in queue)
-                            item.quantity -= remaining;
-                            remaining = 0;
-                            newQueue.enqueue(item);
-                        } else {
-                            // Fully consume this item (don't add back to queue)
-                            remaining -= item.quantity;
-                            // Skip re-adding it to the queue
-                            // Only update item count if it's the last item with this ID
-                            bool otherInstancesExist = false;
-                            
-                            // Check if other instances of this ID exist in any bucket
-                            for (int k = 0; k < TABLE_SIZE; k++) {
-                                if (k == i) continue; // Skip current bucket
-                                
-                                ADTLinkedQueue checkQueue = hashTable[k];
-                                FoodItem* checkItems = checkQueue.toArray();
-                                int checkSize = checkQueue.getSize();
-                                
-                                for (int l = 0; l < checkSize; l++) {
-                                    if (checkItems[l].id == id) {
-                                        otherInstancesExist = true;
-                                        break;
-                                    }
-                                }
-                                
-                                delete[] checkItems;
-                                if (otherInstancesExist) break;
-                            }
-                            
-                            // Also check remaining items in the current bucket's new queue
-                            if (!otherInstancesExist) {
-                                FoodItem* newQueueItems = newQueue.toArray();
-                                int newQueueSize = newQueue.getSize();
-                                
-                                for (int l = 0; l < newQueueSize; l++) {
-                                    if (newQueueItems[l].id == id) {
-                                        otherInstancesExist = true;
-                                        break;
-                                    }
-                                }
-                                
-                                delete[] newQueueItems;
-                            }
-                            
-                            // Only decrement item count if this was the last instance
-                            if (!otherInstancesExist) {
-                                this->itemCount--;
-                            }
-                        }
-                    } else {
-                        // Not our target item or nothing left to consume, keep it as is
-                        newQueue.enqueue(item);
-                    }
-                }
-                
-                // Replace the bucket with the new queue containing updated items
-                hashTable[i] = newQueue;
-            }
-            
-            // Display success message with consumption details
-            cout << "Successfully used " << amount << " units of " << itemName << ". Remaining: " << (totalQuantity - amount) << endl;
-            return true;
-
-        } catch (const bad_alloc& e) {
-            // Handle memory allocation errors
-            cout << "Memory allocation error in useFoodItem: " << e.what() << endl;
-            return false;
-        } catch (const exception& e) {
-            // Handle standard exceptions
-            cout << "Error in useFoodItem: " << e.what() << endl;
-            return false;
-        } catch (...) {
-            // Handle any other unexpected errors
-            cout << "Unknown error in useFoodItem" << endl;
-            return false;
-        }
-    }
-    
-    // Log usage of food items to a history file
-    // Parameters: id - the ID of the food item that was used
-    //             amount - the quantity that was used
-    //             purpose - description of why the item was used
-    void logItemUsage(const string& id, int amount, const string& purpose) {
-        try {
-            // Retrieve the item details for complete logging
-            FoodItem* item = findFoodItem(id);
-            if (item == nullptr) {
-                cout << "Warning: Could not find item details for logging." << endl;
-                return;
-            }
-            
-            // Open the history file in append mode to maintain all previous logs
-            ofstream historyFile("usage_history.txt", ios::app);
-            if (historyFile.is_open()) {
-                // Get current time to timestamp the usage
-                time_t now = time(0);
-                string dateStr = ctime(&now);
-                // Remove the newline character from ctime output
-                if (!dateStr.empty() && dateStr[dateStr.length()-1] == '\n') {
-                    dateStr.erase(dateStr.length()-1);
-                }
-                
-                // Write entry in TXT format: timestamp,id,name,amount,purpose
-                historyFile << dateStr << ","
-                            << id << ","
-                            << item->name << ","
-                            << amount << ","
-                            << purpose << endl;
-                
-                historyFile.close();
-            } else {
-                cout << "Warning: Could not open usage history file for writing." << endl;
-            }
-            
-            // Clean up the dynamically allocated item
-            delete item;
-        } catch (const exception& e) {
-            // Handle standard exceptions
-            cout << "Error in logItemUsage: " << e.what() << endl;
-        } catch (...) {
-            // Handle any unexpected errors
-            cout << "Unknown error in logItemUsage" << endl;
-        }
-    }
-    
-    // Display usage history from log file
-    // Shows all recorded item usage in a formatted table
-    void displayUsageHistory() {
-        // Try to open the history file
-        ifstream historyFile("usage_history.txt");
-        if (!historyFile.is_open()) {
-            cout << "No usage history found." << endl;
-            return;
-        }
-        
-        // Display the table header
-        printHeader("Food Usage History");
-        cout << left << setw(25) << "Date/Time" 
-             << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Amount" 
-             << setw(30) << "Purpose" << endl;
-        printFooter();
-        
-        // Read and parse each line in the history file
-        string line;
-        while (getline(historyFile, line)) {
-            string dateTime, id, name, amount, purpose;
-            
-            // Parse TXT line format: timestamp,id,name,amount,purpose
-            size_t pos = 0;
-            
-            // Extract Date/Time
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            dateTime = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract ID
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            id = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Name
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            name = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Amount
-            pos = line.find(",");
-            if (pos == string::npos) continue; // Skip malformed lines
-            amount = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // The rest is purpose
-            purpose = line;
-            
-            // Display the entry in a formatted row
-            cout << left << setw(25) << dateTime 
-                 << setw(10) << id 
-                 << setw(30) << name 
-                 << setw(10) << amount 
-                 << setw(30) << purpose << endl;
-        }
-        
-        // Close the file when done
-        historyFile.close();
-    }
-
-    // Add an existing food item with its current state
-    // Unlike insertFoodItem, this doesn't try to merge quantities
-    // Parameters: item - the food item to add
-    // Returns: true if successful, false if failed
-    bool addExistingFoodItem(const FoodItem& item) {
-        // Validate the item ID
-        if (item.id.empty()) {
-            cout << "Error: Food item ID cannot be empty." << endl;
-            return false;
-        }
-        
-        // Find position in hash table using the hash function
-        int position = findPosition(item.id);
-        if (position == -1) {
-            cout << "Error: Hash table is full." << endl;
-            return false;
-        }
-        
-        // Check if this is a new item ID before adding it
-        bool isNewItem = true;
-        
-        // Scan all buckets to check if this ID already exists
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (hashTable[i].isEmpty()) continue;
-            
-            // Get all items in this bucket
-            ADTLinkedQueue tempQueue = hashTable[i];
-            FoodItem* items = tempQueue.toArray();
-            int size = tempQueue.getSize();
-            
-            // Check each item
-            for (int j = 0; j < size; j++) {
-                if (items[j].id == item.id) {
-                    isNewItem = false;
-                    break;
-                }
-            }
-            
-            // Free allocated memory
-            delete[] items;
-            
-            if (!isNewItem) break; // No need to check other buckets
-        }
-        
-        // Always add the new item to the queue with its own timestamp
-        // This ensures FIFO ordering when consuming items
-        hashTable[position].enqueue(item);
-        
-        // If this is a new item ID, increase the item count
-        if (isNewItem) {
-            this->itemCount++;
-        }
-        
-        return true;
-    }
-    
-    // Search and display food items by name
-    // Performs a partial string match and displays all matching items
-    // search from the hash table
-    void searchByName(const string& name) {
-        // Print table header
-        printHeader("Search Results by Name");
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(15) << "Category" 
-             << setw(10) << "Quantity" 
-             << setw(25) << "Receive Date" << endl;
-        printFooter();
-        
-        // Convert search name to lowercase for case-insensitive search
-        string searchNameLower = name;
-        for (size_t i = 0; i < searchNameLower.length(); i++) {
-            searchNameLower[i] = tolower(searchNameLower[i]);
-        }
-        
-        bool found = false;
-        int matchCount = 0;
-        
-        // Search directly in the hash table to see all instances
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (hashTable[i].isEmpty()) continue;
-            
-            // Get all items in this bucket
-            ADTLinkedQueue tempQueue = hashTable[i];
-            FoodItem* items = tempQueue.toArray();
-            int size = tempQueue.getSize();
-            
-            // Check each item
-            for (int j = 0; j < size; j++) {
-                // Convert item name to lowercase for comparison
-                string itemNameLower = items[j].name;
-                for (size_t k = 0; k < itemNameLower.length(); k++) {
-                    itemNameLower[k] = tolower(itemNameLower[k]);
-                }
-                
-                // Check if the item name contains the search string
-                if (itemNameLower.find(searchNameLower) != string::npos) {
-                    // Format and display the matching item details
-                    cout << left << setw(10) << items[j].id 
-                         << setw(30) << items[j].name 
-                         << setw(10) << fixed << setprecision(2) << items[j].price
-                         << setw(15) << items[j].category
-                         << setw(10) << items[j].quantity 
-                         << setw(25) << items[j].receiveDate << endl;
-                    found = true;
-                    matchCount++;
-                }
-            }
-            
-            // Clean up allocated memory
-            delete[] items;
-        }
-        
-        // Display message if no matches found
-        if (!found) {
-            cout << "No items found matching name \"" << name << "\"." << endl;
-        } else {
-            cout << "\nFound " << matchCount << " item(s) matching \"" << name << "\"." << endl;
-        }
-    }
-    
-    // Search and display food items by price range
-    // Shows all items with price between minPrice and maxPrice (inclusive)
-    // search from the hash table
-    void searchByPrice(double minPrice, double maxPrice) {
-        // Validate price range
-        if (minPrice < 0 || maxPrice < 0) {
-            cout << "Invalid price range. Prices must be non-negative." << endl;
-            return;
-        }
-        
-        // Swap if minPrice is greater than maxPrice
-        if (minPrice > maxPrice) {
-            double temp = minPrice;
-            minPrice = maxPrice;
-            maxPrice = temp;
-        }
-        
-        // Print table header
-        printHeader("Search Results by Price Range");
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(15) << "Category" 
-             << setw(10) << "Quantity" 
-             << setw(25) << "Receive Date" << endl;
-        printFooter();
-        
-        bool found = false;
-        int matchCount = 0;
-        
-        // Search directly in the hash table to see all instances
-        for (int i = 0; i < TABLE_SIZE; i++) {
-            if (hashTable[i].isEmpty()) continue;
-            
-            // Get all items in this bucket
-            ADTLinkedQueue tempQueue = hashTable[i];
-            FoodItem* items = tempQueue.toArray();
-            int size = tempQueue.getSize();
-            
-            // Check each item
-            for (int j = 0; j < size; j++) {
-                if (items[j].price >= minPrice && items[j].price <= maxPrice) {
-                    // Format and display the matching item details
-                    cout << left << setw(10) << items[j].id 
-                         << setw(30) << items[j].name 
-                         << setw(10) << fixed << setprecision(2) << items[j].price
-                         << setw(15) << items[j].category
-                         << setw(10) << items[j].quantity 
-                         << setw(25) << items[j].receiveDate << endl;
-                    found = true;
-                    matchCount++;
-                }
-            }
-            
-            // Clean up allocated memory
-            delete[] items;
-        }
-        
-        // Display message if no matches found
-        if (!found) {
-            cout << "No items found in the price range " << fixed << setprecision(2) 
-                 << minPrice << " - " << maxPrice << "." << endl;
-        } else {
-            cout << "\nFound " << matchCount << " item(s) in the price range " 
-                 << fixed << setprecision(2) << minPrice << " - " << maxPrice << "." << endl;
-        }
-    }
-};
-
-// Utility sorting and searching functions for restaurant menu system
-
-// Merge function (part of Tim Sort) for MenuItem objects
-// Merges two sorted subarrays into one sorted array
-// Parameters: array, left boundary, middle point, right boundary, sort criteria (name, price, or category)
-void mergeMenuItems(MenuItem arr[], int left, int mid, int right, const string& sortBy = "name") {
-    int len1 = mid - left + 1;
-    int len2 = right - mid;
-    
-    // Create temporary arrays to hold the two subarrays
-    MenuItem* leftArr = new MenuItem[len1];
-    MenuItem* rightArr = new MenuItem[len2];
-    
-    // Copy data to temporary arrays
-    for (int i = 0; i < len1; i++)
-        leftArr[i] = arr[left + i];
-    for (int i = 0; i < len2; i++)
-        rightArr[i] = arr[mid + 1 + i];
-    
-    // Merge the temporary arrays back into the original array
-    int i = 0, j = 0, k = left;
-    
-    while (i < len1 && j < len2) {
-        bool compareResult = false;
-        
-        // Compare based on the sort criteria
-        if (sortBy == "price") {
-            // Sort by price (ascending order)
-            compareResult = (leftArr[i].price <= rightArr[j].price);
-        } 
-        else if (sortBy == "category") {
-            // Sort by category (alphabetical order)
-            compareResult = (leftArr[i].category <= rightArr[j].category);
-        }
-        else if (sortBy == "id") {
-            // Sort by id (alphabetical order)
-            compareResult = (leftArr[i].id <= rightArr[j].id);
-        }
-        else {
-            // Default: Sort by name (alphabetical order)
-            compareResult = (leftArr[i].name <= rightArr[j].name);
-        }
-        
-        if (compareResult) {
-            arr[k] = leftArr[i];
-            i++;
-        } else {
-            arr[k] = rightArr[j];
-            j++;
-        }
-        k++;
-    }
-    
-    // Copy any remaining elements from the left subarray
-    while (i < len1) {
-        arr[k] = leftArr[i];
-        i++;
-        k++;
-    }
-    
-    // Copy any remaining elements from the right subarray
-    while (j < len2) {
-        arr[k] = rightArr[j];
-        j++;
-        k++;
-    }
-    
-    // Free allocated memory for temporary arrays
-    delete[] leftArr;
-    delete[] rightArr;
-}
-
-// Insertion sort (part of Tim Sort) for MenuItem objects
-// Efficiently sorts small subarrays using in-place insertion sort
-// Parameters: array, left boundary, right boundary, sort criteria (name, price, or category)
-void insertionSortMenuItems(MenuItem arr[], int left, int right, const string& sortBy = "name") {
-    for (int i = left + 1; i <= right; i++) {
-        // Store current element as temporary
-        MenuItem temp = arr[i];
-        int j = i - 1;
-        
-        if (sortBy == "price") {
-            // Sort by price (ascending order)
-            while (j >= left && arr[j].price > temp.price) {
-                arr[j + 1] = arr[j];
-                j--;
-            }
-        } 
-        else if (sortBy == "category") {
-            // Sort by category (alphabetical order)
-            while (j >= left && arr[j].category > temp.category) {
-                arr[j + 1] = arr[j];
-                j--;
-            }
-        }
-        else if (sortBy == "id") {
-            // Sort by id (alphabetical order)
-            while (j >= left && arr[j].id > temp.id) {
-                arr[j + 1] = arr[j];
-                j--;
-            }
-        }
-        else {
-            // Default: Sort by name (alphabetical order)
-            while (j >= left && arr[j].name > temp.name) {
-                arr[j + 1] = arr[j];
-                j--;
-            }
-        }
-        
-        // Place temp in its correct position
-        arr[j + 1] = temp;
-    }
-}
-
-// Tim Sort main function for MenuItem objects
-// A hybrid sorting algorithm combining insertion sort and merge sort
-// Average time complexity: O(n log n)
-// Parameters: array, array size, sort criteria (name, price, or category)
-void timSortMenuItems(MenuItem arr[], int n, const string& sortBy = "name") {
-    // Run size for insertion sort (optimal value based on typical array sizes)
-    const int RUN = 32;
-    
-    // First, sort individual subarrays of size RUN using insertion sort
-    // This is efficient for small arrays and creates sorted runs
-    for (int i = 0; i < n; i += RUN) {
-        insertionSortMenuItems(arr, i, min(i + RUN - 1, n - 1), sortBy);
-    }
-    
-    // Start merging sorted runs from size RUN
-    // Each iteration doubles the size of subarrays being merged
-    for (int size = RUN; size < n; size = 2 * size) {
-        // Pick starting points of different subarrays of current size
-        for (int left = 0; left < n; left += 2 * size) {
-            // Find ending points of subarrays
-            int mid = left + size - 1;
-            int right = min(left + 2 * size - 1, n - 1);
-            
-            // Merge subarrays arr[left...mid] and arr[mid+1...right]
-            if (mid < right) {
-                mergeMenuItems(arr, left, mid, right, sortBy);
-            }
-        }
-    }
-}
-
-// Interpolation Search for MenuItem objects - O(log log n) average case for uniformly distributed data
-// A searching algorithm that works on uniformly distributed sorted data
-// Parameters: sorted array, array size, and ID to search for
-int interpolationSearchMenuItems(MenuItem arr[], int n, const string& id) {
-    // Find indexes of two corners (boundary points)
-    int low = 0, high = n - 1;
-    
-    // While elements exist and key is within range of array
-    while (low <= high && id >= arr[low].id && id <= arr[high].id) {
-        // Probing the position with key value using interpolation formula
-        // This estimates where the element might be based on its value
-        double val1 = id.compare(arr[low].id);
-        double val2 = arr[high].id.compare(arr[low].id);
-        double val3 = high - low;
-        int pos = low + (int)(val3 * (val1 / val2));
-        
-        // If element is found at the estimated position
-        if (arr[pos].id == id)
-            return pos;
-            
-        // If element at pos is smaller, search in right subarray
-        if (arr[pos].id < id)
-            low = pos + 1;
-        else
-            // If element at pos is larger, search in left subarray
-            high = pos - 1;
-    }
-    
-    return -1; // Element not found
-}
-
-// Restaurant Menu System - manages the restaurant's food menu
-// Handles creation, editing, storage, and retrieval of menu items
-class RestaurantMenuSystem : public Restaurant {
-private:
-    ADTLinkedList menuList;  // Linked list to store menu items
-
-public:
-    // Constructor - initializes an empty menu system
-    RestaurantMenuSystem() : Restaurant() {}
-    
-    // Destructor - linked list handles its own memory cleanup
-    virtual ~RestaurantMenuSystem() override {}
-    
-    // Returns the current number of menu items in the system
-    virtual int getItemCount() const override {
-        return Restaurant::getItemCount();
-    }
-    
-    // Adds a new menu item to the system
-    // Parameters: item - the menu item to add
-    // Returns: true if successfully added, false if failed (e.g., duplicate ID)
-    bool addMenuItem(const MenuItem& item) {
-        // Validate menu item ID
-        if (item.id.empty()) {
-            cout << "Error: Menu item ID cannot be empty." << endl;
-            return false;
-        }
-        
-        // Check if item with this ID already exists (prevent duplicates)
-        MenuItem* existingItem = findMenuItem(item.id);
-        if (existingItem != nullptr) {
-            cout << "Error: Menu item with ID " << item.id << " already exists." << endl;
-            delete existingItem;
-            return false;
-        }
-        
-        // Add the item to the end of the linked list
-        menuList.append(item);
-        this->itemCount++;
-        
-        return true;
-    }
-    
-    // Finds a menu item by its ID
-    // Parameters: id - the ID to search for
-    // Returns: pointer to a copy of the found item or nullptr if not found
-    // Note: Caller is responsible for deleting the returned pointer
-    MenuItem* findMenuItem(const string& id) const {
-        return menuList.findById(id);
-    }
-    
-    // Removes a menu item by its ID
-    // Parameters: id - the ID of the item to remove
-    // Returns: true if found and removed, false if not found
-    bool removeMenuItem(const string& id) {
-        if (menuList.removeById(id)) {
-            this->itemCount--;
-            return true;
-        }
-        return false;
-    }
-    
-    // Updates an existing menu item with new data
-    // Parameters: item - the updated menu item (ID must match an existing item)
-    // Returns: true if found and updated, false if not found
-    bool updateMenuItem(const MenuItem& item) {
-        // Check if the item exists first
-        MenuItem* existingItem = findMenuItem(item.id);
-        if (existingItem == nullptr) {
-            cout << "Error: Menu item with ID " << item.id << " not found." << endl;
-            return false;
-        }
-        
-        // Remove the old item and add the updated one
-        // This is a simple approach that works because we're using a linked list
-        menuList.removeById(item.id);
-        menuList.append(item);
-        
-        // Clean up the allocated memory from findMenuItem
-        delete existingItem;
-        return true;
-    }
-    
-    // Loads menu items from a TXT file
-    // Parameters: filename - path to the file to load from
-    // Returns: true if successful, false if file couldn't be opened
-    virtual bool loadFromFile(const string& filename) override {
-        ifstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Could not open file " << filename << " for reading" << endl;
-            return false;
-        }
-        
-        string line;
-        int itemsLoaded = 0;
-        
-        // Read file line by line
-        while (getline(file, line)) {
-            string id, name, description, category, ingredientData;
-            double price;
-            
-            // Parse TXT line (format: id,name,price,description,category,ingredientData)
-            size_t pos = 0;
-            string token;
-            
-            // Extract ID
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            id = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Name
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            name = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Price
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            price = stod(line.substr(0, pos));
-            line.erase(0, pos + 1);
-            
-            // Extract Description
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            description = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            // Extract Category
-            pos = line.find(",");
-            if (pos == string::npos) {
-                category = line;
-                ingredientData = ""; // No ingredients in file
-            } else {
-                category = line.substr(0, pos);
-                line.erase(0, pos + 1);
-                // Extract Ingredient Data
-                ingredientData = line;
-            }
-            
-            // Create menu item
-            MenuItem item(id, name, price, description, category);
-            
-            // Process ingredients if present
-            if (!ingredientData.empty()) {
-                // Ingredients are in format "foodId1:qty1|foodId2:qty2|..."
-                size_t startPos = 0;
-                size_t pipePos = ingredientData.find("|");
-                
-                while (pipePos != string::npos || startPos < ingredientData.length()) {
-                    string ingredientPair;
-                    
-                    if (pipePos != string::npos) {
-                        ingredientPair = ingredientData.substr(startPos, pipePos - startPos);
-                        startPos = pipePos + 1;
-                    } else {
-                        ingredientPair = ingredientData.substr(startPos);
-                        startPos = ingredientData.length();
-                    }
-                    
-                    // Process each ingredient pair (foodId:qty)
-                    size_t colonPos = ingredientPair.find(":");
-                    if (colonPos != string::npos) {
-                        string foodId = ingredientPair.substr(0, colonPos);
-                        int quantity = stoi(ingredientPair.substr(colonPos + 1));
-                        item.addIngredient(foodId, quantity);
-                    }
-                    
-                    if (startPos < ingredientData.length()) {
-                        pipePos = ingredientData.find("|", startPos);
-                    } else {
-                        break;
-                    }
-                }
-            }
-            
-            // Add the menu item
-            if (addMenuItem(item)) {
-                itemsLoaded++;
-            }
-        }
-        
-        file.close();
-        cout << "Successfully loaded " << itemsLoaded << " menu items from " << filename << endl;
-        return itemsLoaded > 0;
-    }
-    
-    // Saves menu items to a TXT file
-    // Parameters: filename - path to the file to save to
-    //             sorted - if true, items will be sorted before saving
-    //             sortBy - criteria to sort by ("name", "price", or "category")
-    // Returns: true if successful, false if failed to open file
-    // Implementation of the pure virtual method from base class
-    virtual bool saveToFile(const string& filename, bool sorted = false) override {
-        return saveToFile(filename, sorted, "name");
-    }
-    
-    // Overloaded version with additional sortBy parameter
-    bool saveToFile(const string& filename, bool sorted, const string& sortBy) {
-        ofstream file(filename);
-        if (!file.is_open()) {
-            cout << "Error: Could not open file " << filename << " for writing" << endl;
-            return false;
-        }
-        
-        // Get all menu items as a array from the linked list
-        MenuItem* items = getAllItems();
-        
-        // Check if items were properly allocated
-        if (items == nullptr && this->itemCount > 0) {
-            cout << "Error: Failed to allocate memory for menu items." << endl;
-            file.close();
-            return false;
-        }
-        
-        // Sort items if requested
-        if (sorted && this->itemCount > 0 && items != nullptr) {
-            // Use Tim Sort with the specified sort criteria
-            timSortMenuItems(items, this->itemCount, sortBy);
-        }
-        
-        // Write items to file in TXT format
-        if (this->itemCount > 0 && items != nullptr) {
-            for (int i = 0; i < this->itemCount; i++) {
-                // Write basic properties in TXT format
-                file << items[i].id << ","
-                     << items[i].name << ","
-                     << items[i].price << ","
-                     << items[i].description << ","
-                     << items[i].category;
-                
-                // Add ingredients if any in our special format
-                if (items[i].ingredientCount > 0) {
-                    file << ",";
-                    for (int j = 0; j < items[i].ingredientCount; j++) {
-                        file << items[i].ingredients[j];
-                        if (j < items[i].ingredientCount - 1) {
-                            file << "|"; // Separate ingredients with pipe
-                        }
-                    }
-                }
-                
-                file << endl;
-            }
-            delete[] items;
-        } else {
-            // Write an empty file if no items
-            cout << "No menu items to save to file." << endl;
-        }
-        
-        file.close();
-        cout << "Successfully saved " << this->itemCount << " menu items to " << filename << endl;
-        return true;
-    }
-    
-    // Displays all menu items in a formatted table
-    // Shows ID, name, price, category, and description for each item
-    virtual void displayAll() override {
-        // Print table header using base class method
-        printHeader("Restaurant Menu System - All Items");
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Get all menu items from the linked list
-        MenuItem* items = getAllItems();
-        
-        // Handle empty menu case
-        if (this->itemCount == 0) {
-            cout << "No items in the menu." << endl;
-        } else {
-            // Display each item with formatted columns
-            for (int i = 0; i < this->itemCount; i++) {
-                cout << left << setw(10) << items[i].id 
-                     << setw(30) << items[i].name 
-                     << setw(10) << fixed << setprecision(2) << items[i].price
-                     << setw(20) << items[i].category
-                     << setw(30) << items[i].description << endl;
-            }
-        }
-        
-        // Clean up allocated memory
-        delete[] items;
-    }
-    
-    // Displays all menu items sorted by specified criteria
-    // Implementation of pure virtual method from base class
-    virtual void displaySorted(bool byName = true) override {
-        if (byName) {
-            displaySortedByName();
-        } else {
-            displaySortedByPrice();
-        }
-    }
-    
-    // Displays all menu items sorted by name
-    // Items are sorted alphabetically by name
-    void displaySortedByName() {
-        // Print table header using base class method
-        printHeader("Restaurant Menu System - Sorted by Name");
-        
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Get all menu items as a array from the linked list
-        MenuItem* items = getAllItems();
-        
-        // Handle empty menu case
-        if (this->itemCount == 0) {
-            cout << "No items in the menu." << endl;
-        } else {
-            // Sort items by name using Tim Sort algorithm
-            timSortMenuItems(items, this->itemCount, "name");
-            
-            // Display each item with formatted columns
-            for (int i = 0; i < this->itemCount; i++) {
-                cout << left << setw(10) << items[i].id 
-                     << setw(30) << items[i].name 
-                     << setw(10) << fixed << setprecision(2) << items[i].price
-                     << setw(20) << items[i].category
-                     << setw(30) << items[i].description << endl;
-            }
-        }
-        
-        // Clean up allocated memory
-        delete[] items;
-    }
-    
-    // Displays all menu items sorted by price (low to high)
-    // Items are sorted in ascending order by price
-    void displaySortedByPrice() {
-        // Print table header using base class method
-        printHeader("Restaurant Menu System - Sorted by Price (Low to High)");
-        
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Get all menu items from the linked list
-        MenuItem* items = getAllItems();
-        
-        // Handle empty menu case
-        if (this->itemCount == 0) {
-            cout << "No items in the menu." << endl;
-        } else {
-            // Sort items by price using Tim Sort algorithm
-            timSortMenuItems(items, this->itemCount, "price");
-            
-            // Display each item with formatted columns
-            for (int i = 0; i < this->itemCount; i++) {
-                cout << left << setw(10) << items[i].id 
-                     << setw(30) << items[i].name 
-                     << setw(10) << fixed << setprecision(2) << items[i].price
-                     << setw(20) << items[i].category
-                     << setw(30) << items[i].description << endl;
-            }
-        }
-        
-        // Clean up allocated memory
-        delete[] items;
-    }
-    
-    // Displays all menu items sorted by category
-    // Items are sorted alphabetically by category name
-    void displaySortedByCategory() {
-        // Print table header using base class method
-        printHeader("Restaurant Menu System - Sorted by Category");
-        
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Get all menu items from the linked list
-        MenuItem* items = getAllItems();
-        
-        // Handle empty menu case
-        if (this->itemCount == 0) {
-            cout << "No items in the menu." << endl;
-        } else {
-            // Sort items by category using Tim Sort algorithm
-            timSortMenuItems(items, this->itemCount, "category");
-            
-            // Display each item with formatted columns
-            for (int i = 0; i < this->itemCount; i++) {
-                cout << left << setw(10) << items[i].id 
-                     << setw(30) << items[i].name 
-                     << setw(10) << fixed << setprecision(2) << items[i].price
-                     << setw(20) << items[i].category
-                     << setw(30) << items[i].description << endl;
-            }
-        }
-        
-        // Clean up allocated memory
-        delete[] items;
-    }
-    
-    // Returns all menu items as a dynamically allocated array
-    // Caller is responsible for deleting the returned array
-    MenuItem* getAllItems() const {
-        return menuList.toArray();
-    }
-    
-    // Searches for and displays a menu item by its ID
-    // Parameters: id - the ID of the menu item to find
-    // using interpolation search
-    void searchById(const string& id) {
-        // Find the menu item
-        MenuItem* item = findMenuItem(id);
-        
-        // Print table header
-        RestaurantInventorySystem::printHeader("Menu Item Search Result");
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Display item if found, or show not found message
-        if (item != nullptr) {
-            // Display the basic menu item information
-            cout << left << setw(10) << item->id 
-                 << setw(30) << item->name 
-                 << setw(10) << fixed << setprecision(2) << item->price
-                 << setw(20) << item->category
-                 << setw(30) << item->description << endl;
-                 
-            // Display ingredients if any
-            if (item->ingredientCount > 0) {
-                cout << "\nIngredients Required:\n";
-                cout << left << setw(15) << "Food ID" << setw(10) << "Quantity" << endl;
-                cout << string(25, '-') << endl;
-                
-                // Parse and display each ingredient
-                for (int i = 0; i < item->ingredientCount; i++) {
-                    size_t colonPos = item->ingredients[i].find(":");
-                    if (colonPos != string::npos) {
-                        string foodId = item->ingredients[i].substr(0, colonPos);
-                        string quantity = item->ingredients[i].substr(colonPos + 1);
-                        cout << left << setw(15) << foodId << setw(10) << quantity << endl;
-                    }
-                }
-            }
-            
-            // Clean up allocated memory
-            delete item;
-        } else {
-            cout << "Menu item with ID " << id << " not found." << endl;
-        }
-    }
-    
-    /**
-     * Displays detailed information about a menu item including its ingredients
-     * This method provides a comprehensive view of a menu item with real-time inventory status
-     * Parameters: id - The unique identifier of the menu item to display
-     * Parameters: inventory - Reference to the inventory system to check ingredients availability
-     */
-    void displayMenuItem(const string& id, RestaurantInventorySystem& inventory) {
-        // Ensure inventory data is up-to-date
-        inventory.saveToFile("food_items.txt");
-        
-        // Retrieve the menu item by its ID
-        MenuItem* item = findMenuItem(id);
-        
-        // Validate if the item exists in the menu
-        if (item == nullptr) {
-            cout << "Menu item with ID " << id << " not found." << endl;
-            return;
-        }
-        
-        // Display the header and basic information about the menu item
-        RestaurantInventorySystem::printHeader("Menu Item Details");
-        cout << "ID: " << item->id << endl;
-        cout << "Name: " << item->name << endl;
-        cout << "Price: $" << fixed << setprecision(2) << item->price << endl;
-        cout << "Category: " << item->category << endl;
-        cout << "Description: " << item->description << endl;
-        
-        // Check if the menu item has ingredients and display them
-        if (item->ingredientCount > 0) {
-            cout << "\nIngredients Required:\n";
-            // Create a well-formatted table header for ingredients information
-            cout << left << setw(10) << "ID" 
-                 << setw(30) << "Name" 
-                 << setw(10) << "Quantity" 
-                 << setw(15) << "Available" 
-                 << setw(15) << "Status" << endl;
-            cout << string(80, '-') << endl;
-            
-            // Process and display each ingredient with its availability status
-            for (int i = 0; i < item->ingredientCount; i++) {
-                // Parse the ingredient string format "foodId:quantity"
-                size_t colonPos = item->ingredients[i].find(":");
-                if (colonPos != string::npos) {
-                    // Extract food ID and required quantity
-                    string foodId = item->ingredients[i].substr(0, colonPos);
-                    int quantity = stoi(item->ingredients[i].substr(colonPos + 1));
-                    
-                    // Query the inventory system for real-time information about this ingredient
-                    FoodItem* foodItem = inventory.findFoodItem(foodId);
-                    
-                    if (foodItem != nullptr) {
-                        // Ingredient exists in inventory - calculate availability status
-                        int available = foodItem->quantity;
-                        string status = (available >= quantity) ? "Sufficient" : "Insufficient";
-                        
-                        // Display formatted ingredient details with availability
-                        cout << left << setw(10) << foodId 
-                             << setw(30) << foodItem->name 
-                             << setw(10) << quantity 
-                             << setw(15) << available 
-                             << setw(15) << status << endl;
-                        
-                        // Clean up dynamically allocated memory
-                        delete foodItem;
-                    } else {
-                        // Ingredient not found in inventory - mark as missing
-                        cout << left << setw(10) << foodId 
-                             << setw(30) << "Not found" 
-                             << setw(10) << quantity 
-                             << setw(15) << "0" 
-                             << setw(15) << "Missing" << endl;
-                    }
-                }
-            }
-        } else {
-            // Handle the case when menu item has no ingredients defined
-            cout << "\nNo ingredients specified for this menu item." << endl;
-        }
-        
-        // Clean up dynamically allocated memory
-        delete item;
-    }
-    
-    /**
-     * Verifies if all ingredients for a menu item are available in sufficient quantities
-     * This method performs pre-checks before menu item preparation
-     * Parameters: id - The unique identifier of the menu item to check
-     * Parameters: inventory - Reference to the inventory system
-     * Return: true if all ingredients are available in sufficient quantities, false otherwise
-     */
-    bool checkIngredientsAvailability(const string& id, RestaurantInventorySystem& inventory) {
-        // Ensure inventory data is up-to-date
-        inventory.saveToFile("food_items.txt");
-        
-        // Retrieve the menu item by its ID
-        MenuItem* item = findMenuItem(id);
-        
-        // Validate if the item exists in the menu
-        if (item == nullptr) {
-            cout << "Menu item with ID " << id << " not found." << endl;
-            return false;
-        }
-        
-        // Flag to track overall availability status
-        bool allAvailable = true;
-        
-        // Iterate through each ingredient and check its availability
-        for (int i = 0; i < item->ingredientCount; i++) {
-            // Parse the ingredient string format "foodId:quantity"
-            size_t colonPos = item->ingredients[i].find(":");
-            if (colonPos != string::npos) {
-                // Extract food ID and required quantity
-                string foodId = item->ingredients[i].substr(0, colonPos);
-                int quantity = stoi(item->ingredients[i].substr(colonPos + 1));
-                
-                // Query the inventory system for real-time information about this ingredient
-                FoodItem* foodItem = inventory.findFoodItem(foodId);
-                
-                // Check if the ingredient exists and is available in sufficient quantity
-                if (foodItem == nullptr || foodItem->quantity < quantity) {
-                    allAvailable = false;
-                    // Provide detailed feedback about the missing or insufficient ingredient
-                    if (foodItem == nullptr) {
-                        cout << "Missing ingredient: " << foodId << endl;
-                    } else {
-                        cout << "Insufficient quantity of " << foodItem->name 
-                             << " (ID: " << foodId << "). Required: " << quantity 
-                             << ", Available: " << foodItem->quantity << endl;
-                    }
-                }
-                
-                // Clean up dynamically allocated memory
-                delete foodItem;
-            }
-        }
-        
-        // Clean up dynamically allocated memory
-        delete item;
-        return allAvailable;
-    }
-    
-    /**
-     * Prepares a menu item by consuming all required ingredients from inventory
-     * This method performs a transaction that updates inventory quantities
-     * Parameters: id - The unique identifier of the menu item to prepare
-     * Parameters: inventory - Reference to the inventory system for ingredient consumption
-     * Parameters: purpose - Description of why the item is being prepared (for logging)
-     * Return: true if preparation was successful, false otherwise
-     */
-    bool prepareMenuItem(const string& id, RestaurantInventorySystem& inventory, const string& purpose = "Menu Order") {
-        // Ensure inventory data is up-to-date
-        inventory.saveToFile("food_items.txt");
-        
-        // First perform a pre-check to ensure all ingredients are available
-        if (!checkIngredientsAvailability(id, inventory)) {
-            cout << "Cannot prepare menu item due to missing or insufficient ingredients." << endl;
-            return false;
-        }
-        
-        // Retrieve the menu item by its ID
-        MenuItem* item = findMenuItem(id);
-        if (item == nullptr) {
-            return false;
-        }
-        
-        // Transaction flag to track overall success
-        bool success = true;
-        
-        // Iterate through each ingredient and consume the required quantity
-        for (int i = 0; i < item->ingredientCount; i++) {
-            // Parse the ingredient string format "foodId:quantity"
-            size_t colonPos = item->ingredients[i].find(":");
-            if (colonPos != string::npos) {
-                // Extract food ID and required quantity
-                string foodId = item->ingredients[i].substr(0, colonPos);
-                int quantity = stoi(item->ingredients[i].substr(colonPos + 1));
-                
-                // Consume the ingredient from inventory
-                if (!inventory.useFoodItem(foodId, quantity)) {
-                    success = false;
-                } else {
-                    // Log the ingredient usage with meaningful context
-                    inventory.logItemUsage(foodId, quantity, purpose + ": " + item->name);
-                }
-            }
-        }
-        
-        // Provide feedback on the preparation outcome
-        if (success) {
-            cout << "Successfully prepared " << item->name << endl;
-        } else {
-            cout << "Error occurred while preparing " << item->name << endl;
-        }
-        
-        // Clean up dynamically allocated memory
-        delete item;
-        return success;
-    }
-    
-    /**
-     * Searches for menu items by name or description
-     * This utility method powers the text search functionality
-     * Parameters: query - The search term to look for in names and descriptions
-     * Parameters: resultCount - Output parameter that will contain the number of matches found
-     * Return: Dynamically allocated array of matching menu item IDs (caller must delete)
-     */
-    string* searchMenuItems(const string& query, int& resultCount) {
-        // Get all menu items for searching
-        MenuItem* allItems = getAllItems();
-        if (allItems == nullptr) {
-            resultCount = 0;
-            return nullptr;
-        }
-        
-        // For exact ID matches, we can use interpolation search for better performance
-        if (query.length() == 4 && ValidationCheck::isValidID(query)) {
-            // Sort the items by ID to prepare for interpolation search
-            MenuItem* sortedItems = new MenuItem[this->itemCount];
-            for (int i = 0; i < this->itemCount; i++) {
-                sortedItems[i] = allItems[i];
-            }
-            
-            // Use Tim Sort for efficient sorting
-            timSortMenuItems(sortedItems, this->itemCount, "id");
-            
-            // Apply interpolation search
-            int position = interpolationSearchMenuItems(sortedItems, this->itemCount, query);
-            
-            if (position != -1) {
-                // Found exactly one match
-                resultCount = 1;
-                string* results = new string[1];
-                results[0] = sortedItems[position].id;
-                
-                // Clean up
-                delete[] sortedItems;
-                delete[] allItems;
-                return results;
-            }
-            
-            // Clean up sorted items if no match found
-            delete[] sortedItems;
-        }
-        
-        // For non-ID searches or ID not found, use traditional search approach
-        // First pass: count matching items to allocate array of correct size
-        resultCount = 0;
-        for (int i = 0; i < itemCount; i++) {
-            // Case-sensitive search in both name and description fields
-            if (allItems[i].name.find(query) != string::npos || 
-                allItems[i].description.find(query) != string::npos) {
-                resultCount++;
-            }
-        }
-        
-        // Exit early if no matches found
-        if (resultCount == 0) {
-            delete[] allItems;
-            return nullptr;
-        }
-        
-        // Second pass: populate array with matching IDs
-        string* results = new string[resultCount];
-        int index = 0;
-        
-        for (int i = 0; i < itemCount; i++) {
-            if (allItems[i].name.find(query) != string::npos || 
-                allItems[i].description.find(query) != string::npos) {
-                results[index++] = allItems[i].id;
-            }
-        }
-        
-        // Clean up temporary array
-        delete[] allItems;
-        return results;
-    }
-    
-    /**
-     * Filters menu items by category
-     * This method is useful for menu organization and filtered views
-     * Parameters: category - The category to filter by (exact match)
-     * Parameters: resultCount - Output parameter that will contain the number of matches found
-     * Return: Dynamically allocated array of matching menu item IDs (caller must delete)
-     */
-    string* getMenuItemsByCategory(const string& category, int& resultCount) {
-        // Get all menu items for filtering
-        MenuItem* allItems = getAllItems();
-        if (allItems == nullptr) {
-            resultCount = 0;
-            return nullptr;
-        }
-        
-        // First pass: count matching items to allocate array of correct size
-        resultCount = 0;
-        for (int i = 0; i < itemCount; i++) {
-            // Exact category match (case sensitive)
-            if (allItems[i].category == category) {
-                resultCount++;
-            }
-        }
-        
-        // Exit early if no matches found
-        if (resultCount == 0) {
-            delete[] allItems;
-            return nullptr;
-        }
-        
-        // Second pass: populate array with matching IDs
-        string* results = new string[resultCount];
-        int index = 0;
-        
-        for (int i = 0; i < itemCount; i++) {
-            if (allItems[i].category == category) {
-                results[index++] = allItems[i].id;
-            }
-        }
-        
-        // Clean up temporary array
-        delete[] allItems;
-        return results;
-    }
-    
-    // Finds a menu item by its ID using Interpolation Search when possible
-    // This method is optimized for performance when searching in a sorted array
-    // Parameters: id - the ID to search for
-    // Returns: pointer to a copy of the found item or nullptr if not found
-    // Note: Caller is responsible for deleting the returned pointer
-    MenuItem* findMenuItemById(const string& id) const {
-        // First check if we have items to search
-        if (this->itemCount == 0) {
-            return nullptr;
-        }
-        
-        // Get all items as an array
-        MenuItem* items = getAllItems();
-        if (items == nullptr) {
-            return nullptr;
-        }
-        
-        // Create a copy of items that we can sort without affecting original data
-        MenuItem* sortedItems = new MenuItem[this->itemCount];
-        for (int i = 0; i < this->itemCount; i++) {
-            sortedItems[i] = items[i];
-        }
-        
-        // Sort the copy by ID to enable interpolation search using Tim Sort
-        // Much more efficient than bubble sort O(n log n) vs O(n²)
-        timSortMenuItems(sortedItems, this->itemCount, "id");
-        
-        // Apply interpolation search on the sorted array
-        int position = interpolationSearchMenuItems(sortedItems, this->itemCount, id);
-        
-        MenuItem* result = nullptr;
-        if (position != -1) {
-            // Found the item, create a copy to return
-            result = new MenuItem(sortedItems[position]);
-        }
-        
-        // Clean up temporary arrays to prevent memory leaks
-        delete[] items;
-        delete[] sortedItems;
-        
-        return result;
-    }
-    
-    /**
-     * Case-insensitive search for menu items by name (partial matching)
-     * This method provides a user-friendly search experience with fuzzy matching
-     * Using hash-based approach to improve performance
-     * Parameters: searchName - The partial or complete name to search for
-     */
-    void searchByName(const string& searchName) {
-        // For exact ID matches, we can use our optimized search
-        if (searchName.length() == 4 && ValidationCheck::isValidID(searchName)) {
-            searchById(searchName);
-            return;
-        }
-        
-        // Convert search term to lowercase for case-insensitive comparison
-        string searchLower = searchName;
-        for (size_t i = 0; i < searchLower.length(); i++) {
-            searchLower[i] = tolower(searchLower[i]);
-        }
-        
-        // Format and display results in a tabular format
-        RestaurantInventorySystem::printHeader("Menu Items Search Result - Name containing '" + searchName + "'");
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Get all menu items from the linked list
-        MenuItem* items = getAllItems();
-        int matchCount = 0;
-        
-        // Perform the search and display matching items
-        if (this->itemCount > 0 && items != nullptr) {
-            for (int i = 0; i < this->itemCount; i++) {
-                // Convert current item name to lowercase for case-insensitive comparison
-                string nameLower = items[i].name;
-                for (size_t j = 0; j < nameLower.length(); j++) {
-                    nameLower[j] = tolower(nameLower[j]);
-                }
-                
-                // Check if the current item name contains the search term (partial match)
-                if (nameLower.find(searchLower) != string::npos) {
-                    // Display the matching menu item in a formatted row
-                    cout << left << setw(10) << items[i].id 
-                         << setw(30) << items[i].name 
-                         << setw(10) << fixed << setprecision(2) << items[i].price
-                         << setw(20) << items[i].category
-                         << setw(30) << items[i].description << endl;
-                    matchCount++;
-                }
-            }
-            
-            // Display a summary of search results
-            if (matchCount == 0) {
-                cout << "No menu items found containing '" << searchName << "' in the name." << endl;
-            } else {
-                cout << "\nFound " << matchCount << " menu item(s) matching the search criteria." << endl;
-            }
-            
-            // Prevent memory leaks by releasing dynamically allocated memory
-            delete[] items;
-        } else {
-            cout << "No items in the menu." << endl;
-        }
-    }
-    
-    /**
-     * Searches for menu items within a specific price range
-     * This method facilitates price-based filtering of menu items using an optimized approach
-     * Parameters: minPrice - The minimum price in the range (inclusive)
-     * Parameters: maxPrice - The maximum price in the range (inclusive)
-     */
-    void searchByPriceRange(double minPrice, double maxPrice) {
-        // Ensure minimum is less than maximum by swapping if necessary
-        if (minPrice > maxPrice) {
-            swap(minPrice, maxPrice);
-        }
-        
-        // Format prices with 2 decimal places
-        stringstream ss1, ss2;
-        ss1 << fixed << setprecision(2) << minPrice;
-        ss2 << fixed << setprecision(2) << maxPrice;
-        
-        // Format and display results in a tabular format
-        RestaurantInventorySystem::printHeader("Menu Items Search Result - Price Range $" + 
-                                           ss1.str() + " to $" + ss2.str());
-        cout << left << setw(10) << "ID" 
-             << setw(30) << "Name" 
-             << setw(10) << "Price" 
-             << setw(20) << "Category" 
-             << setw(30) << "Description" << endl;
-        RestaurantInventorySystem::printFooter();
-        
-        // Get all menu items from the linked list
-        MenuItem* items = getAllItems();
-        int matchCount = 0;
-        
-        // If we have items, use an optimized approach with Tim Sort
-        if (this->itemCount > 0 && items != nullptr) {
-            // Create a sorted copy of all items by price
-            MenuItem* sortedItems = new MenuItem[this->itemCount];
-            for (int i = 0; i < this->itemCount; i++) {
-                sortedItems[i] = items[i];
-            }
-            
-            // Use Tim Sort to sort items by price
-            timSortMenuItems(sortedItems, this->itemCount, "price");
-            
-            // Interpolation search to find the lower and upper bounds of our price range
-            int lowerBound = -1;
-            int upperBound = -1;
-            
-            // Find lower bound (first item >= minPrice)
-            int low = 0;
-            int high = this->itemCount - 1;
-            
-            // First check if we have valid array and range
-            if (high >= 0 && sortedItems[high].price >= minPrice && sortedItems[low].price <= maxPrice) {
-                // Find lower bound using interpolation search
-                while (low <= high) {
-                    // Prevent division by zero and handle equal values
-                    if (sortedItems[high].price == sortedItems[low].price) {
-                        if (sortedItems[low].price >= minPrice) {
-                            lowerBound = low;
-                        }
-                        break;
-                    }
-                    
-                    // Calculate probe position using interpolation formula with float precision
-                    float ratio = (float)(minPrice - sortedItems[low].price) / 
-                                 (float)(sortedItems[high].price - sortedItems[low].price);
-                    int pos = low + (int)(ratio * (high - low));
-                    
-                    // Ensure pos is within bounds
-                    if (pos < low) pos = low;
-                    if (pos > high) pos = high;
-                    
-                    if (sortedItems[pos].price >= minPrice) {
-                        lowerBound = pos;
-                        high = pos - 1; // Look in lower portion
-                    } else {
-                        low = pos + 1; // Look in upper portion
-                    }
-                    
-                    // If positions don't change, break to avoid infinite loop
-                    if (low == high) break;
-                }
-            }
-            
-            // Reset for upper bound search
-            low = 0;
-            high = this->itemCount - 1;
-            
-            // Find upper bound (last item <= maxPrice)
-            if (high >= 0 && sortedItems[high].price >= minPrice && sortedItems[low].price <= maxPrice) {
-                while (low <= high) {
-                    // Prevent division by zero and handle equal values
-                    if (sortedItems[high].price == sortedItems[low].price) {
-                        if (sortedItems[high].price <= maxPrice) {
-                            upperBound = high;
-                        }
-                        break;
-                    }
-                    
-                    // Calculate probe position using interpolation formula with float precision
-                    float ratio = (float)(maxPrice - sortedItems[low].price) / 
-                                 (float)(sortedItems[high].price - sortedItems[low].price);
-                    int pos = low + (int)(ratio * (high - low));
-                    
-                    // Ensure pos is within bounds
-                    if (pos < low) pos = low;
-                    if (pos > high) pos = high;
-                    
-                    if (sortedItems[pos].price <= maxPrice) {
-                        upperBound = pos;
-                        low = pos + 1; // Look in upper portion
-                    } else {
-                        high = pos - 1; // Look in lower portion
-                    }
-                    
-                    // If positions don't change, break to avoid infinite loop
-                    if (low == high) break;
-                }
-            }
-            
-            // If we found valid bounds, display matching items
-            if (lowerBound != -1 && upperBound != -1 && lowerBound <= upperBound) {
-                for (int i = lowerBound; i <= upperBound; i++) {
-                    // Display the matching menu item in a formatted row
-                    cout << left << setw(10) << sortedItems[i].id 
-                         << setw(30) << sortedItems[i].name 
-                         << setw(10) << fixed << setprecision(2) << sortedItems[i].price
-                         << setw(20) << sortedItems[i].category
-                         << setw(30) << sortedItems[i].description << endl;
-                    matchCount++;
-                }
-            }
-            
-            // Clean up
-            delete[] sortedItems;
-        } else {
-            cout << "No items in the menu." << endl;
-        }
-    }
-};
-
-/**
- * Base User class for authentication and user management
- * Provides common functionality for all user types
- * @time_complexity Varies by method
- * @space_complexity Varies by method
- */
-class User {
-protected:
-    string username;
-    string password;
-    bool isLoggedIn;
-    
-    // Protected constructor to prevent direct instantiation
-    User(const string& _username = "", const string& _password = "") 
-        : username(_username), password(_password), isLoggedIn(false) {}
-    
-public:
-    // Virtual destructor for proper cleanup in derived classes
-    virtual ~User() {}
-    
-    // Getter for login status
-    bool getLoginStatus() const {
-        return isLoggedIn;
-    }
-    
-    // Getter for username 
-    string getUsername() const {
-        return username;
-    }
-    
-    // Virtual login function to be overridden by derived classes
-    virtual bool login(const string& _username, const string& _password) {
-        // Base implementation (will be overridden)
-        if (username == _username && password == _password) {
-            isLoggedIn = true;
-            return true;
-        }
-        return false;
-    }
-    
-    // Virtual logout function to be overridden by derived classes
-    virtual void logout() {
-        isLoggedIn = false;
-        cout << "Logged out successfully." << endl;
-    }
-    
-    // Virtual register account function to be overridden by derived classes
-    virtual bool registerAccount(const string& _username, const string& _password) {
-        // Base implementation (will be overridden)
-        username = _username;
-        password = _password;
-        return true;
-    }
-    
-    // Overloaded version of registerAccount that takes a role parameter
-    virtual bool registerAccount(const string& _username, const string& _password, const string& role) {
-        // Call the base version
-        return registerAccount(_username, _password);
-    }
-    
-    // Friend function declaration
-    friend void displayUserInfo(const User& user);
-};
-
-// Friend function implementation
-void displayUserInfo(const User& user) {
-    cout << "Username: " << user.username << endl;
-    cout << "Login Status: " << (user.isLoggedIn ? "Logged In" : "Logged Out") << endl;
-}
-
-/**
- * Staff class for regular staff users
- * Manages staff-specific functionality and authentication
- */
-class Staff : public User {
-private:
-    string staffId;
-    string position;
-    
-public:
-    // Constructor
-    Staff(const string& _username = "", const string& _password = "", 
-          const string& _staffId = "", const string& _position = "")
-        : User(_username, _password), staffId(_staffId), position(_position) {}
-    
-    // Getter for staff ID
-    string getStaffId() const {
-        return staffId;
-    }
-    
-    // Getter for position
-    string getPosition() const {
-        return position;
-    }
-    
-    // Setters
-    void setStaffId(const string& _staffId) {
-        staffId = _staffId;
-    }
-    
-    void setPosition(const string& _position) {
-        position = _position;
-    }
-    
-    // Override login to check against staff.txt file
-    virtual bool login(const string& _username, const string& _password) override {
-        ifstream file("staff.txt");
-        if (!file.is_open()) {
-            cout << "Error: Could not open staff credentials file." << endl;
-            return false;
-        }
-        
-        string line;
-        bool found = false;
-        
-        // Format: username,password,staffId,position
-        while (getline(file, line)) {
-            size_t pos = line.find(",");
-            if (pos == string::npos) continue;
-            
-            string fileUsername = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            
-            string filePassword = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            
-            string fileStaffId = line.substr(0, pos);
-            string filePosition = line.substr(pos + 1);
-            
-            if (fileUsername == _username && filePassword == _password) {
-                username = fileUsername;
-                password = filePassword;
-                staffId = fileStaffId;
-                position = filePosition;
-                isLoggedIn = true;
-                found = true;
-                break;
-            }
-        }
-        
-        file.close();
-        
-        if (!found) {
-            cout << "Invalid username or password for staff login." << endl;
-        } else {
-            cout << "Staff login successful. Welcome " << username << "!" << endl;
-        }
-        
-        return found;
-    }
-    
-    // Override logout with staff-specific message
-    virtual void logout() override {
-        isLoggedIn = false;
-        cout << "Staff member " << username << " logged out successfully." << endl;
-    }
-    
-    // Override register to save to staff.txt file
-    virtual bool registerAccount(const string& _username, const string& _password) override {
-        return registerAccount(_username, _password, "", "Default");
-    }
-    
-    // Override overloaded registerAccount with staff-specific parameters
-    virtual bool registerAccount(const string& _username, const string& _password, 
-                                const string& _staffId, const string& _position) {
-        // Check if username already exists
-        ifstream checkFile("staff.txt");
-        if (checkFile.is_open()) {
-            string line;
-            while (getline(checkFile, line)) {
-                size_t pos = line.find(",");
-                if (pos != string::npos) {
-                    string existingUsername = line.substr(0, pos);
-                    if (existingUsername == _username) {
-                        cout << "Error: Username already exists." << endl;
-                        checkFile.close();
-                        return false;
-                    }
-                }
-            }
-            checkFile.close();
-        }
-        
-        // Save to staff.txt
-        ofstream file("staff.txt", ios::app);
-        if (!file.is_open()) {
-            cout << "Error: Could not open staff credentials file for writing." << endl;
-            return false;
-        }
-        
-        // Update member variables
-        username = _username;
-        password = _password;
-        staffId = _staffId;
-        position = _position;
-        
-        // Write to file
-        file << username << "," << password << "," << staffId << "," << position << endl;
-        file.close();
-        
-        cout << "Staff account registered successfully." << endl;
-        return true;
-    }
-    
-    // Overload the original virtual registerAccount with role parameter
-    virtual bool registerAccount(const string& _username, const string& _password, const string& role) override {
-        // For staff, we ignore the role parameter and use default position
-        return registerAccount(_username, _password, "", "Default");
-    }
-};
-
-/**
- * Admin class for administrator users
- * Manages admin-specific functionality and authentication
- */
-class Admin : public User {
-private:
-    string adminId;
-    string accessLevel;
-    
-public:
-    // Constructor
-    Admin(const string& _username = "", const string& _password = "", 
-          const string& _adminId = "", const string& _accessLevel = "")
-        : User(_username, _password), adminId(_adminId), accessLevel(_accessLevel) {}
-    
-    // Getter for admin ID
-    string getAdminId() const {
-        return adminId;
-    }
-    
-    // Getter for access level
-    string getAccessLevel() const {
-        return accessLevel;
-    }
-    
-    // Setters
-    void setAdminId(const string& _adminId) {
-        adminId = _adminId;
-    }
-    
-    void setAccessLevel(const string& _accessLevel) {
-        accessLevel = _accessLevel;
-    }
-    
-    // Override login to check against admin.txt file
-    virtual bool login(const string& _username, const string& _password) override {
-        ifstream file("admin.txt");
-        if (!file.is_open()) {
-            cout << "Error: Could not open admin credentials file." << endl;
-            return false;
-        }
-        
-        string line;
-        bool found = false;
-        
-        // Format: username,password,adminId,accessLevel
-        while (getline(file, line)) {
-            size_t pos = line.find(",");
-            if (pos == string::npos) continue;
-            
-            string fileUsername = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            
-            string filePassword = line.substr(0, pos);
-            line.erase(0, pos + 1);
-            
-            pos = line.find(",");
-            if (pos == string::npos) continue;
-            
-            string fileAdminId = line.substr(0, pos);
-            string fileAccessLevel = line.substr(pos + 1);
-            
-            if (fileUsername == _username && filePassword == _password) {
-                username = fileUsername;
-                password = filePassword;
-                adminId = fileAdminId;
-                accessLevel = fileAccessLevel;
-                isLoggedIn = true;
-                found = true;
-                break;
-            }
-        }
-        
-        file.close();
-        
-        if (!found) {
-            cout << "Invalid username or password for admin login." << endl;
-        } else {
-            cout << "Admin login successful. Welcome " << username << "!" << endl;
-        }
-        
-        return found;
-    }
-    
-    // Override logout with admin-specific message
-    virtual void logout() override {
-        isLoggedIn = false;
-        cout << "Administrator " << username << " logged out successfully." << endl;
-    }
-    
-    // Override register to save to admin.txt file
-    virtual bool registerAccount(const string& _username, const string& _password) override {
-        return registerAccount(_username, _password, "", "Standard");
-    }
-    
-    // Override overloaded registerAccount with admin-specific parameters
-    virtual bool registerAccount(const string& _username, const string& _password, 
-                                const string& _adminId, const string& _accessLevel) {
-        // Check if username already exists
-        ifstream checkFile("admin.txt");
-        if (checkFile.is_open()) {
-            string line;
-            while (getline(checkFile, line)) {
-                size_t pos = line.find(",");
-                if (pos != string::npos) {
-                    string existingUsername = line.substr(0, pos);
-                    if (existingUsername == _username) {
-                        cout << "Error: Username already exists." << endl;
-                        checkFile.close();
-                        return false;
-                    }
-                }
-            }
-            checkFile.close();
-        }
-        
-        // Save to admin.txt
-        ofstream file("admin.txt", ios::app);
-        if (!file.is_open()) {
-            cout << "Error: Could not open admin credentials file for writing." << endl;
-            return false;
-        }
-        
-        // Update member variables
-        username = _username;
-        password = _password;
-        adminId = _adminId;
-        accessLevel = _accessLevel;
-        
-        // Write to file
-        file << username << "," << password << "," << adminId << "," << accessLevel << endl;
-        file.close();
-        
-        cout << "Admin account registered successfully." << endl;
-        return true;
-    }
-    
-    // Overload the original virtual registerAccount with role parameter
-    virtual bool registerAccount(const string& _username, const string& _password, const string& role) override {
-        // For admin, we ignore the role parameter and use default access level
-        return registerAccount(_username, _password, "", "Standard");
-    }
-    
-    // Friend function to display admin details with access to private members
-    friend void displayAdminDetails(const Admin& admin);
-};
-
-// Friend function implementation for Admin class
-void displayAdminDetails(const Admin& admin) {
-    cout << "=== Admin Details ===" << endl;
-    cout << "Username: " << admin.username << endl;
-    cout << "Admin ID: " << admin.adminId << endl;
-    cout << "Access Level: " << admin.accessLevel << endl;
-    cout << "Login Status: " << (admin.isLoggedIn ? "Logged In" : "Logged Out") << endl;
-}
-
-/**
- * Authentication Manager class to handle user login and registration
- * Manages both Staff and Admin users in a unified interface
- */
-class AuthManager {
-private:
-    Staff* currentStaff;
-    Admin* currentAdmin;
-    bool isAdminMode;
-    
-public:
-    // Constructor
-    AuthManager() : currentStaff(nullptr), currentAdmin(nullptr), isAdminMode(false) {}
-    
-    // Destructor - clean up dynamically allocated objects
-    ~AuthManager() {
-        if (currentStaff != nullptr) {
-            delete currentStaff;
-        }
-        if (currentAdmin != nullptr) {
-            delete currentAdmin;
-        }
-    }
-    
-    // Check if any user is logged in
-    bool isLoggedIn() const {
-        return (currentStaff != nullptr && currentStaff->getLoginStatus()) || 
-               (currentAdmin != nullptr && currentAdmin->getLoginStatus());
-    }
-    
-    // Check if current user is an admin
-    bool isAdminLoggedIn() const {
-        return isAdminMode && currentAdmin != nullptr && currentAdmin->getLoginStatus();
-    }
-    
-    // Get current user username
-    string getCurrentUsername() const {
-        if (isAdminMode && currentAdmin != nullptr) {
-            return currentAdmin->getUsername();
-        } else if (!isAdminMode && currentStaff != nullptr) {
-            return currentStaff->getUsername();
-        }
-        return "";
-    }
-    
-    // Handle login process
-    bool login(const string& username, const string& password, bool adminLogin) {
-        if (adminLogin) {
-            // Admin login
-            if (currentAdmin == nullptr) {
-                currentAdmin = new Admin();
-            }
-            if (currentAdmin->login(username, password)) {
-                isAdminMode = true;
-                return true;
-            }
-        } else {
-            // Staff login
-            if (currentStaff == nullptr) {
-                currentStaff = new Staff();
-            }
-            if (currentStaff->login(username, password)) {
-                isAdminMode = false;
-                return true;
-            }
-        }
-        return false;
-    }
-    
-    // Handle logout process
-    void logout() {
-        if (isAdminMode && currentAdmin != nullptr) {
-            currentAdmin->logout();
-        } else if (!isAdminMode && currentStaff != nullptr) {
-            currentStaff->logout();
-        } else {
-            cout << "No user is currently logged in." << endl;
-        }
-    }
-    
-    // Handle staff registration
-    bool registerStaff(const string& username, const string& password, 
-                      const string& staffId, const string& position) {
-        Staff staff;
-        return staff.registerAccount(username, password, staffId, position);
-    }
-    
-    // Handle admin registration
-    bool registerAdmin(const string& username, const string& password, 
-                       const string& adminId, const string& accessLevel) {
-        Admin admin;
-        return admin.registerAccount(username, password, adminId, accessLevel);
-    }
-    
-    // Overloaded function to register either staff or admin based on role
-    bool registerUser(const string& username, const string& password, const string& role) {
-        if (role == "admin") {
-            Admin admin;
-            return admin.registerAccount(username, password, role);
-        } else {
-            Staff staff;
-            return staff.registerAccount(username, password, role);
-        }
-    }
-
-    // Check if current user is a full admin
-    bool isFullAdmin() const {
-        return isAdminMode && currentAdmin != nullptr && currentAdmin->getAccessLevel() == "Full";
-    }
-};
-
-/**
- * Handle inventory management functionality
- * This function encapsulates all inventory-related operations
- * @param inventory Reference to the inventory system to manage
- */
-void manageInventory(RestaurantInventorySystem& inventory) {
-    int inventoryChoice;
-    do {
-        // Clear screen and display inventory management options
-        RestaurantInventorySystem::clearScreen();
-        cout << "\n==== Inventory Management ====" << endl;
-        
-        // Basic operations for viewing and adding inventory items
-        cout << "1. Display Unsorted Data" << endl;
-        cout << "2. Add New Food Item" << endl;
-        cout << "3. Add Existing Food Item" << endl;
-        cout << "4. Sort By Name" << endl;
-        cout << "5. Sort By Quantity" << endl;
-        cout << "6. Use Food Item / Prepare Menu Item" << endl;
-        // Update search options section
-        // Multiple search methods to find items efficiently
-        cout << "\n-- Search Options --" << endl;
-        cout << "7. Search By ID" << endl;
-        cout << "8. Search By Name" << endl;
-        cout << "9. Search By Price Range" << endl;
-        
-        // Additional operations for advanced inventory management
-        cout << "\n-- Other Options --" << endl;
-        cout << "10. Save Sorted Data" << endl;
-        cout << "11. Display Queue Structure" << endl;
-        cout << "12. Display Specific Queue" << endl;
-        cout << "13. Display Usage History" << endl;
-        
-        cout << "0. Back to Main Menu" << endl;
-        cout << "Enter your choice: ";
-        cin >> inventoryChoice;
-        
-        // Process inventory submenu selection
-        switch (inventoryChoice) {
-            case 1: {
-                // Display all inventory items in their original order
-                RestaurantInventorySystem::clearScreen();
-                inventory.displayAll();
-                cout << "\nPress any key to continue...";
-                getch();
-                break;
-            }
-            case 2: {
-                // Add a new food item to inventory with user input
-                RestaurantInventorySystem::clearScreen();
-                string id, name, category;
-                double price;
-                int quantity;
-                bool isValid = false;
-                
-                // Collect all necessary information about the new food item
-                cout << "==== Add New Food Item ====" << endl;
-                
-                // Validate ID format
-                do {
-                    cout << "Enter ID (format: 1 letter followed by 3 digits): ";
-                    cin >> id;
-                    
-                    if (!ValidationCheck::isValidID(id)) {
-                        ValidationCheck::showError("ID must be 1 letter followed by 3 digits (e.g. F123)");
-                    } else {
-                        isValid = true;
-                    }
-                } while (!isValid);
-                
-                // check if the id already exists
-                FoodItem* existingItem = inventory.findFoodItem(id);
-                if (existingItem != nullptr) {
-                    ValidationCheck::showError("Food Item Id " + id + " already exists, please use another ID");
-                    delete existingItem;
-                    cout << "\nPress any key to continue...";
-                    getch();
-                    break;
-                }
-                
-                cin.ignore();
-                
-                // Validate name length
-                isValid = false;
-                do {
-                    cout << "Enter Name (3-30 characters): ";
-                    getline(cin, name);
-                    
-                    if (!ValidationCheck::isValidStringLength(name, 3, 30)) {
-                        ValidationCheck::showError("Name length must be between 3 and 30 characters");
-                    } else {
-                        isValid = true;
-                    }
-                } while (!isValid);
-                
-                // Validate price
-                isValid = false;
-                do {
-                    cout << "Enter Price (minimum 1.00): ";
-                    cin >> price;
-                    
-                    if (!ValidationCheck::isValidPrice(price)) {
-                        ValidationCheck::showError("Price must be at least 1.00 with maximum 2 decimal places");
-                    } else {
-                        isValid = true;
-                    }
-                } while (!isValid);
-                
-                cout << "Enter Category: ";
-                cin.ignore();
-                getline(cin, category);
-                
-                // Validate quantity
-                isValid = false;
-                do {
-                    cout << "Enter Quantity (1-999): ";
-                    cin >> quantity;
-                    
-                    if (!ValidationCheck::isValidQuantity(quantity)) {
-                        ValidationCheck::showError("Quantity must be between 1 and 999");
-                    } else {
-                        isValid = true;
-                    }
-                } while (!isValid);
-                
-                // Create and insert the new food item into inventory
-                FoodItem item(id, name, price, category, quantity);
-                if (inventory.insertFoodItem(item)) {
-                    cout << "\nFood item added successfully!" << endl;
-                    
-                    // Save to file after adding to ensure data persistence
-                    if (!inventory.saveToFile("food_items.txt")) {
-                        cout << "Warning: Failed to save changes to file." << endl;
-                    }
-                } else {
-                    cout << "\nFailed to add food item." << endl;
-                }
-                
-                cout << "\nPress any key to continue...";
-                getch();
-                break;
+                
+                cin.ignore();
+                
+                // Validate name length
+                isValid = false;
+                do {
+                    cout << "Enter Name (3-30 characters): ";
+                    getline(cin, name);
+                    
+                    if (!ValidationCheck::isValidStringLength(name, 3, 30)) {
+                        ValidationCheck::showError("Name length must be between 3 and 30 characters");
+                    } else {
+                        isValid = true;
+                    }
+                } while (!isValid);
+                
+                // Validate price
+                isValid = false;
+                do {
+                    cout << "Enter Price (minimum 1.00): ";
+                    cin >> price;
+                    
+                    if (!ValidationCheck::isValidPrice(price)) {
+                        ValidationCheck::showError("Price must be at least 1.00 with maximum 2 decimal places");
+                    } else {
+                        isValid = true;
+                    }
+                } while (!isValid);
+                
+                cout << "Enter Category: ";
+                cin.ignore();
+                getline(cin, category);
+                
+                // Validate quantity
+                isValid = false;
+                do {
+                    cout << "Enter Quantity (1-999): ";
+                    cin >> quantity;
+                    
+                    if (!ValidationCheck::isValidQuantity(quantity)) {
+                        ValidationCheck::showError("Quantity must be between 1 and 999");
+                    } else {
+                        isValid = true;
+                    }
+                } while (!isValid);
+                
+                // Create and insert the new food item into inventory
+                FoodItem item(id, name, price, category, quantity);
+                if (inventory.insertFoodItem(item)) {
+                    cout << "\nFood item added successfully!" << endl;
+                    
+                    // Save to file after adding to ensure data persistence
+                    if (!inventory.saveToFile("food_items.txt")) {
+                        cout << "Warning: Failed to save changes to file." << endl;
+                    }
+                } else {
+                    cout << "\nFailed to add food item." << endl;
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
             }
             case 3: {
                 // Add quantity to an existing food item
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 string id;
                 int quantity;
                 bool isValid = false;
@@ -4063,11 +202,11 @@ void manageInventory(RestaurantInventorySystem& inventory) {
                 cin >> id;
                 
                 // Check if the item exists
-                FoodItem* existingItem = inventory.findFoodItem(id);
-                if (existingItem == nullptr) {
+                FoodItemView existingItem = inventory.findFoodItem(id);
+                if (existingItem.isNull()) {
                     cout << "\nError: Food item with ID " << id << " not found." << endl;
                 } else {
-                    cout << "Found: " << existingItem->name << " (Current quantity: " << existingItem->quantity << ")" << endl;
+                    cout << "Found: " << existingItem->name << " (Current quantity: " << existingItem.totalQuantity << ")" << endl;
                     
                     // Validate quantity
                     do {
@@ -4082,11 +221,12 @@ void manageInventory(RestaurantInventorySystem& inventory) {
                     } while (!isValid);
                     
                     // Create a new instance of the item with current timestamp
+                    // (the view is not used after this point, adding a batch invalidates it)
                     FoodItem newItem(existingItem->id, existingItem->name, existingItem->price, existingItem->category, quantity);
                     
                     if (inventory.addExistingFoodItem(newItem)) {
                         cout << "\nAdditional quantity added successfully!" << endl;
-                        cout << "New batch of " << quantity << " " << existingItem->name << " added with current timestamp." << endl;
+                        cout << "New batch of " << quantity << " " << newItem.name << " added with current timestamp." << endl;
                         
                         // Save to file after adding
                         if (!inventory.saveToFile("food_items.txt")) {
@@ -4095,8 +235,6 @@ void manageInventory(RestaurantInventorySystem& inventory) {
                     } else {
                         cout << "\nFailed to add additional quantity." << endl;
                     }
-                    
-                    delete existingItem;
                 }
                 
                 cout << "\nPress any key to continue...";
@@ -4105,7 +243,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 4: {
                 // Display inventory sorted alphabetically by name
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 inventory.displaySorted(true); // true = sort by name (alphabetical)
                 cout << "\nPress any key to continue...";
                 getch();
@@ -4113,7 +251,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 5: {
                 // Display inventory sorted by quantity (ascending)
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 inventory.displaySorted(false); // false = sort by quantity
                 cout << "\nPress any key to continue...";
                 getch();
@@ -4121,7 +259,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 6: {
                 // Consume inventory items (either directly or via menu item)
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 char choice;
                 
                 cout << "==== Use Food Item ====" << endl;
@@ -4136,7 +274,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
                     int amount;
                     bool isValid = false;
                     
-                    RestaurantInventorySystem::clearScreen();
+                    clearScreen();
                     cout << "==== Use Individual Food Item ====" << endl;
                     cout << "Enter ID of item to use: ";
                     cin >> id;
@@ -4159,8 +297,17 @@ void manageInventory(RestaurantInventorySystem& inventory) {
                     getline(cin, purpose);
                     
                     try {
+                        // Keep the name for the log, the last units may be used up below
+                        string itemName;
+                        {
+                            FoodItemView usedItem = inventory.findFoodItem(id);
+                            if (!usedItem.isNull()) {
+                                itemName = usedItem->name;
+                            }
+                        }
+                        
                         if (inventory.useFoodItem(id, amount)) {
-                            inventory.logItemUsage(id, amount, purpose);
+                            inventory.logItemUsage(id, itemName, amount, purpose);
                             cout << "\nUsage logged successfully!" << endl;
                             
                             // Save changes to file
@@ -4182,9 +329,10 @@ void manageInventory(RestaurantInventorySystem& inventory) {
                     if (!tempMenuSystem.loadFromFile("menu_items.txt")) {
                         cout << "\nError: Could not load menu items." << endl;
                     } else {
+                        tempMenuSystem.trackServings(inventory);
                         string id, purpose;
                         
-                        RestaurantInventorySystem::clearScreen();
+                        clearScreen();
                         cout << "==== Prepare Menu Item ====" << endl;
                         
                         // Display available menu items
@@ -4216,7 +364,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 7: {
                 // Search for a food item by its unique ID
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 string id;
                 cout << "==== Search Food Item ====" << endl;
                 cout << "Enter ID to search: ";
@@ -4229,7 +377,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 8: {
                 // Search for food items by name (partial match)
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 string name;
                 cout << "==== Search Food Item by Name ====" << endl;
                 cout << "Enter name to search: ";
@@ -4244,7 +392,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 9: {
                 // Search for food items within a price range
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 double minPrice, maxPrice;
                 cout << "==== Search Food Item by Price Range ====" << endl;
                 cout << "Enter minimum price: $";
@@ -4259,7 +407,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 10: {
                 // Save current inventory data to file (with sorting option)
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 inventory.saveToFile("sorted_information.txt", true);
                 cout << "\nPress any key to continue...";
                 getch();
@@ -4267,7 +415,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 11: {
                 // Display queue data structure with all buckets
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 inventory.displayAllQueues();
                 cout << "\nPress any key to continue...";
                 getch();
@@ -4275,7 +423,7 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 12: {
                 // Display a specific hash bucket (queue)
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 int bucketIndex;
                 cout << "==== Display Specific Queue ====" << endl;
                 cout << "Enter bucket index (0-" << RestaurantInventorySystem::MAX_BUCKETS - 1 << "): ";
@@ -4289,12 +437,90 @@ void manageInventory(RestaurantInventorySystem& inventory) {
             }
             case 13: {
                 // Display history of inventory usage
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 inventory.displayUsageHistory();
                 cout << "\nPress any key to continue...";
                 getch();
                 break;
             }
+            case 14: {
+                // Display inventory batches from oldest to newest
+                clearScreen();
+                inventory.displaySortedByDate();
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 15: {
+                // Find batches older than a given number of days
+                clearScreen();
+                int minDays;
+                cout << "==== Search Food Item by Age ====" << endl;
+                cout << "Enter minimum age in days: ";
+                cin >> minDays;
+                
+                inventory.searchByAge(minDays);
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 16: {
+                // Show how evenly the stored IDs are spread over the hash table
+                clearScreen();
+                inventory.displayHashDiagnostics();
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 17: {
+                // Items closest to their reorder threshold, read from the reorder heap
+                clearScreen();
+                int count;
+                cout << "==== Low Stock Report ====" << endl;
+                cout << "How many items to show (1-999): ";
+                cin >> count;
+                
+                if (!ValidationCheck::isValidQuantity(count)) {
+                    ValidationCheck::showError("Count must be between 1 and 999");
+                } else {
+                    inventory.displayLowStock(count);
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 18: {
+                clearScreen();
+                string id;
+                int threshold;
+                cout << "==== Set Reorder Threshold ====" << endl;
+                cout << "Enter Food Item ID: ";
+                cin >> id;
+                
+                if (!ValidationCheck::isValidID(id)) {
+                    ValidationCheck::showError("ID must be 1 letter followed by 3 digits (e.g. F123)");
+                } else {
+                    cout << "Current reorder threshold: " << inventory.getReorderThreshold(id) << endl;
+                    cout << "Enter new reorder threshold (0-999): ";
+                    cin >> threshold;
+                    
+                    if (threshold < 0 || threshold > 999) {
+                        ValidationCheck::showError("Threshold must be between 0 and 999");
+                    } else if (inventory.setReorderThreshold(id, threshold)) {
+                        cout << "\nReorder threshold updated successfully!" << endl;
+                        
+                        // Save the thresholds after every change
+                        if (!inventory.saveReorderThresholds("reorder_thresholds.txt")) {
+                            cout << "Warning: Failed to save reorder thresholds to file." << endl;
+                        }
+                    }
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
             case 0:
                 cout << "Returning to main menu..." << endl;
                 break;
@@ -4306,6 +532,148 @@ void manageInventory(RestaurantInventorySystem& inventory) {
     } while (inventoryChoice != 0);
 }
 
+/**
+ * Kitchen order queue: orders are taken here and prepared by kitchen worker threads
+ * The kitchen opens when this screen is entered and closes (after finishing every
+ * accepted order) when the user leaves it.
+ * @param menuSystem Reference to the menu system with the recipes
+ * @param inventory Reference to the inventory the ingredients are taken from
+ */
+void manageKitchenOrders(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inventory) {
+    // Most recent outcomes reported by the workers' completion callbacks
+    // Declared before the kitchen so it outlives the worker threads
+    const int RECENT_RESULTS = 10;
+    mutex resultsLock;
+    string recentResults[RECENT_RESULTS];
+    int resultCount = 0;
+    
+    OrderCallback recordResult = [&](const OrderTicket& ticket, bool success, const string& message) {
+        ostringstream line;
+        line << "Order #" << ticket.orderNumber << " (" << ticket.menuItemId << "): "
+             << (success ? "" : "FAILED - ") << message;
+        lock_guard<mutex> lock(resultsLock);
+        recentResults[resultCount % RECENT_RESULTS] = line.str();
+        resultCount++;
+    };
+    
+    // Two to four kitchen workers depending on the machine
+    int workerCount = (int)thread::hardware_concurrency();
+    if (workerCount < 2) workerCount = 2;
+    if (workerCount > 4) workerCount = 4;
+    KitchenWorkerPool kitchen(menuSystem, inventory, workerCount, 256);
+    
+    int menuChoice;
+    do {
+        clearScreen();
+        cout << "\n==== Kitchen Order Queue ====" << endl;
+        cout << "Kitchen workers: " << kitchen.getWorkerCount()
+             << ", queue capacity: " << kitchen.getQueueCapacity() << endl;
+        cout << "1. Submit Orders" << endl;
+        cout << "2. View Kitchen Status" << endl;
+        cout << "0. Close Kitchen and Return" << endl;
+        
+        cout << "\nEnter your choice: ";
+        cin >> menuChoice;
+        
+        switch (menuChoice) {
+            case 1: {
+                string id, purpose;
+                int quantity = 0;
+                
+                menuSystem.displayAll();
+                cout << "\nEnter ID of menu item to order: ";
+                cin >> id;
+                
+                if (menuSystem.findMenuItemById(id) == nullptr) {
+                    cout << "Menu item with ID " << id << " not found." << endl;
+                    cout << "\nPress any key to continue...";
+                    getch();
+                    break;
+                }
+                
+                // Validate quantity
+                bool isValid = false;
+                do {
+                    cout << "Enter number of servings (1-999): ";
+                    cin >> quantity;
+                    
+                    if (!ValidationCheck::isValidQuantity(quantity)) {
+                        ValidationCheck::showError("Quantity must be between 1 and 999");
+                    } else {
+                        isValid = true;
+                    }
+                } while (!isValid);
+                
+                cin.ignore();
+                cout << "Enter purpose (e.g., Table 5): ";
+                getline(cin, purpose);
+                
+                // Each serving is its own ticket, the kitchen rejects what it cannot queue
+                int queued = 0;
+                int rejected = 0;
+                for (int i = 0; i < quantity; i++) {
+                    if (kitchen.submit(id, purpose, recordResult) != 0) {
+                        queued++;
+                    } else {
+                        rejected++;
+                    }
+                }
+                
+                cout << "\nQueued " << queued << " order(s) for the kitchen." << endl;
+                if (rejected > 0) {
+                    cout << rejected << " order(s) rejected: the kitchen queue is full, please resubmit later." << endl;
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 2: {
+                clearScreen();
+                Restaurant::printHeader("Kitchen Status");
+                cout << left << setw(25) << "Accepted orders:" << kitchen.getAcceptedCount() << endl;
+                cout << left << setw(25) << "Prepared:" << kitchen.getCompletedCount() << endl;
+                cout << left << setw(25) << "Failed:" << kitchen.getFailedCount() << endl;
+                cout << left << setw(25) << "Rejected (queue full):" << kitchen.getRejectedCount() << endl;
+                cout << left << setw(25) << "Waiting in queue:" << kitchen.getQueueDepth() << endl;
+                Restaurant::printFooter();
+                
+                cout << "Recent results:" << endl;
+                {
+                    lock_guard<mutex> lock(resultsLock);
+                    if (resultCount == 0) {
+                        cout << "No orders completed yet." << endl;
+                    }
+                    int first = (resultCount > RECENT_RESULTS) ? resultCount - RECENT_RESULTS : 0;
+                    for (int i = first; i < resultCount; i++) {
+                        cout << recentResults[i % RECENT_RESULTS] << endl;
+                    }
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 0:
+                break;
+            default:
+                cout << "Invalid choice. Please try again." << endl;
+                cout << "\nPress any key to continue...";
+                getch();
+        }
+    } while (menuChoice != 0);
+    
+    // Finish every accepted order before leaving, then save the inventory
+    cout << "Closing kitchen, finishing remaining orders..." << endl;
+    kitchen.stop();
+    cout << "Kitchen closed: " << kitchen.getCompletedCount() << " prepared, "
+         << kitchen.getFailedCount() << " failed." << endl;
+    
+    if (!inventory.saveToFile("food_items.txt")) {
+        cout << "Warning: Failed to save inventory changes to file." << endl;
+    }
+}
+
 /**
  * Handle menu management functionality
  * This function encapsulates all menu-related operations
@@ -4316,7 +684,7 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
     int menuChoice;
     do {
         // Display menu management options
-        RestaurantInventorySystem::clearScreen();
+        clearScreen();
         cout << "\n==== Menu Management ====" << endl;
         
         // Basic menu display and management options
@@ -4342,37 +710,44 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
         cout << "11. Prepare Menu Item" << endl;
         cout << "12. Check Ingredients Availability" << endl;
         cout << "13. Display Menu Item Details" << endl;
+        cout << "14. Kitchen Order Queue" << endl;
+        cout << "15. Bulk Menu Checks" << endl;
+        cout << "16. Ingredient Impact" << endl;
+        cout << "17. Unavailable Menu Items (86'd)" << endl;
         cout << "0. Back to Main Menu" << endl;
         
         cout << "\nEnter your choice: ";
         cin >> menuChoice;
         
+        // Show what other terminal processes changed since the last action
+        inventory.syncShared();
+        
         // Process menu management submenu selection
         switch (menuChoice) {
             case 1: {
                 // Display all menu items in a formatted table
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 menuSystem.displayAll();
                 cout << "\nPress any key to continue...";
                 getch();
                 break;
             }
             case 2: {
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 menuSystem.displaySorted();
                 cout << "\nPress any key to continue...";
                 getch();
                 break;
             }
             case 3: {
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 menuSystem.displaySortedByPrice();
                 cout << "\nPress any key to continue...";
                 getch();
                 break;
             }
             case 4: {
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 menuSystem.displaySortedByCategory();
                 cout << "\nPress any key to continue...";
                 getch();
@@ -4380,7 +755,7 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
             }
             case 5: {
                 // Search for menu items by ID using optimized algorithm
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 string id;
                 cout << "==== Search Menu Item by ID ====" << endl;
                 cout << "Enter ID to search: ";
@@ -4393,7 +768,7 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
                 break;
             }
             case 6: {
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 string name;
                 cout << "==== Search Menu Item by Name ====" << endl;
                 cout << "Enter name (full or partial) to search: ";
@@ -4407,7 +782,7 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
                 break;
             }
             case 7: {
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 double minPrice, maxPrice;
                 cout << "==== Search Menu Item by Price Range ====" << endl;
                 cout << "Enter minimum price: $";
@@ -4423,7 +798,7 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
             }
             case 8: {
                 // Add a new menu item to the restaurant's menu
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 string id, name, description, category;
                 double price;
                 bool isValid = false;
@@ -4444,10 +819,8 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
                 } while (!isValid);
                 
                 // check if the id already exists
-                MenuItem* existingItem = menuSystem.findMenuItem(id);
-                if (existingItem != nullptr) {
+                if (menuSystem.findMenuItem(id) != nullptr) {
                     ValidationCheck::showError("Menu Item Id " + id + " already exists, please use another ID");
-                    delete existingItem;
                     cout << "\nPress any key to continue...";
                     getch();
                     break;
@@ -4541,8 +914,8 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
                         } while (!isValid);
                         
                         // Verify the food item exists
-                        FoodItem* foodItem = inventory.findFoodItem(foodId);
-                        if (foodItem == nullptr) {
+                        FoodItemView foodItem = inventory.findFoodItem(foodId);
+                        if (foodItem.isNull()) {
                             cout << "Error: Food item with ID " << foodId << " not found." << endl;
                         } else {
                             cout << "Found: " << foodItem->name << endl;
@@ -4562,8 +935,6 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
                             
                             item.addIngredient(foodId, quantity);
                             cout << "Ingredient added successfully!" << endl;
-                            
-                            delete foodItem;
                         }
                         
                         cout << "Add another ingredient? (Y/N): ";
@@ -4575,351 +946,1768 @@ void manageMenu(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inv
                 if (menuSystem.addMenuItem(item)) {
                     cout << "\nMenu item added successfully!" << endl;
                     
-                    // Save to file after adding
-                    if (!menuSystem.saveToFile("menu_items.txt")) {
-                        cout << "Warning: Failed to save menu changes to file." << endl;
+                    // Save to file after adding
+                    if (!menuSystem.saveToFile("menu_items.txt")) {
+                        cout << "Warning: Failed to save menu changes to file." << endl;
+                    }
+                } else {
+                    cout << "\nFailed to add menu item." << endl;
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 9: {
+                clearScreen();
+                string id;
+                cout << "==== Update Menu Item ====" << endl;
+                cout << "Enter ID of menu item to update: ";
+                cin >> id;
+                
+                // Check if the menu item exists (borrowed, valid until the menu changes)
+                const MenuItem* existingItem = menuSystem.findMenuItem(id);
+                if (existingItem == nullptr) {
+                    cout << "\nError: Menu item with ID " << id << " not found." << endl;
+                } else {
+                    // Show current details
+                    cout << "\nCurrent Details:" << endl;
+                    cout << "Name: " << existingItem->name << endl;
+                    cout << "Price: " << existingItem->price << endl;
+                    cout << "Description: " << existingItem->description << endl;
+                    cout << "Category: " << existingItem->category << endl;
+                    
+                    // Get new details
+                    string name, description, category;
+                    double price;
+                    bool isValid = false;
+                    
+                    cin.ignore();
+                    cout << "\nEnter New Name (3-30 characters, leave blank to keep current): ";
+                    getline(cin, name);
+                    
+                    if (!name.empty()) {
+                        // Validate name if provided
+                        if (!ValidationCheck::isValidStringLength(name, 3, 30)) {
+                            ValidationCheck::showError("Name length must be between 3 and 30 characters");
+                            name = existingItem->name; // Keep current if invalid
+                        }
+                    } else {
+                        name = existingItem->name;
+                    }
+                    
+                    cout << "Enter New Price (minimum 1.00, enter 0 to keep current): ";
+                    cin >> price;
+                    
+                    if (price != 0) {
+                        // Validate price if provided
+                        if (!ValidationCheck::isValidPrice(price)) {
+                            ValidationCheck::showError("Price must be at least 1.00 with maximum 2 decimal places");
+                            price = existingItem->price; // Keep current if invalid
+                        }
+                    } else {
+                        price = existingItem->price;
+                    }
+                    
+                    cin.ignore();
+                    cout << "Enter New Description (5-100 characters, leave blank to keep current): ";
+                    getline(cin, description);
+                    
+                    if (!description.empty()) {
+                        // Validate description if provided
+                        if (!ValidationCheck::isValidStringLength(description, 5, 100)) {
+                            ValidationCheck::showError("Description length must be between 5 and 100 characters");
+                            description = existingItem->description; // Keep current if invalid
+                        }
+                    } else {
+                        description = existingItem->description;
+                    }
+                    
+                    cout << "Enter New Category (3-20 characters, leave blank to keep current): ";
+                    getline(cin, category);
+                    
+                    if (!category.empty()) {
+                        // Validate category if provided
+                        if (!ValidationCheck::isValidStringLength(category, 3, 20)) {
+                            ValidationCheck::showError("Category length must be between 3 and 20 characters");
+                            category = existingItem->category; // Keep current if invalid
+                        }
+                    } else {
+                        category = existingItem->category;
+                    }
+                    
+                    // Create updated menu item
+                    MenuItem updatedItem(id, name, price, description, category);
+                    
+                    // Copy existing ingredients
+                    updatedItem.ingredients = existingItem->ingredients;
+                    
+                    // Update ingredients if needed
+                    char updateIngredients;
+                    cout << "\nDo you want to update ingredients? (Y/N): ";
+                    cin >> updateIngredients;
+                    
+                    if (toupper(updateIngredients) == 'Y') {
+                        // Clear existing ingredients
+                        updatedItem.ingredients.clear();
+                        
+                        // Show available food items for reference
+                        cout << "\nAvailable Food Items:" << endl;
+                        inventory.displayAll();
+                        
+                        char addMore = 'Y';
+                        while (toupper(addMore) == 'Y') {
+                            string foodId;
+                            int quantity;
+                            isValid = false;
+                            
+                            // Validate ingredient ID
+                            do {
+                                cout << "\nEnter Food Item ID to add as ingredient: ";
+                                cin >> foodId;
+                                
+                                if (!ValidationCheck::isValidID(foodId)) {
+                                    ValidationCheck::showError("Ingredient ID must be 1 letter followed by 3 digits (e.g. F001)");
+                                } else {
+                                    isValid = true;
+                                }
+                            } while (!isValid);
+                            
+                            // Verify the food item exists
+                            FoodItemView foodItem = inventory.findFoodItem(foodId);
+                            if (foodItem.isNull()) {
+                                cout << "Error: Food item with ID " << foodId << " not found." << endl;
+                            } else {
+                                cout << "Found: " << foodItem->name << endl;
+                                
+                                // Validate ingredient quantity
+                                isValid = false;
+                                do {
+                                    cout << "Enter quantity needed (1-999): ";
+                                    cin >> quantity;
+                                    
+                                    if (!ValidationCheck::isValidQuantity(quantity)) {
+                                        ValidationCheck::showError("Quantity must be between 1 and 999");
+                                    } else {
+                                        isValid = true;
+                                    }
+                                } while (!isValid);
+                                
+                                updatedItem.addIngredient(foodId, quantity);
+                                cout << "Ingredient added successfully!" << endl;
+                            }
+                            
+                            cout << "Add another ingredient? (Y/N): ";
+                            cin >> addMore;
+                        }
+                    }
+                    
+                    // Update the menu item
+                    if (menuSystem.updateMenuItem(updatedItem)) {
+                        cout << "\nMenu item updated successfully!" << endl;
+                        
+                        // Save to file after updating
+                        if (!menuSystem.saveToFile("menu_items.txt")) {
+                            cout << "Warning: Failed to save menu changes to file." << endl;
+                        }
+                    } else {
+                        cout << "\nFailed to update menu item." << endl;
                     }
-                } else {
-                    cout << "\nFailed to add menu item." << endl;
                 }
                 
                 cout << "\nPress any key to continue...";
                 getch();
                 break;
             }
-            case 9: {
-                RestaurantInventorySystem::clearScreen();
+            case 10: {
+                clearScreen();
                 string id;
-                cout << "==== Update Menu Item ====" << endl;
-                cout << "Enter ID of menu item to update: ";
+                cout << "==== Remove Menu Item ====" << endl;
+                cout << "Enter ID of menu item to remove: ";
                 cin >> id;
                 
-                // Check if the menu item exists
-                MenuItem* existingItem = menuSystem.findMenuItem(id);
+                // Check if the menu item exists (borrowed, valid until the menu changes)
+                const MenuItem* existingItem = menuSystem.findMenuItem(id);
                 if (existingItem == nullptr) {
                     cout << "\nError: Menu item with ID " << id << " not found." << endl;
                 } else {
-                    // Show current details
-                    cout << "\nCurrent Details:" << endl;
-                    cout << "Name: " << existingItem->name << endl;
-                    cout << "Price: " << existingItem->price << endl;
-                    cout << "Description: " << existingItem->description << endl;
-                    cout << "Category: " << existingItem->category << endl;
-                    
-                    // Get new details
-                    string name, description, category;
-                    double price;
-                    bool isValid = false;
-                    
-                    cin.ignore();
-                    cout << "\nEnter New Name (3-30 characters, leave blank to keep current): ";
-                    getline(cin, name);
+                    // Confirm deletion
+                    char confirm;
+                    cout << "Are you sure you want to remove \"" << existingItem->name << "\"? (Y/N): ";
+                    cin >> confirm;
                     
-                    if (!name.empty()) {
-                        // Validate name if provided
-                        if (!ValidationCheck::isValidStringLength(name, 3, 30)) {
-                            ValidationCheck::showError("Name length must be between 3 and 30 characters");
-                            name = existingItem->name; // Keep current if invalid
+                    if (toupper(confirm) == 'Y') {
+                        if (menuSystem.removeMenuItem(id)) {
+                            cout << "\nMenu item removed successfully!" << endl;
+                            
+                            // Save to file after removing
+                            if (!menuSystem.saveToFile("menu_items.txt")) {
+                                cout << "Warning: Failed to save menu changes to file." << endl;
+                            }
+                        } else {
+                            cout << "\nFailed to remove menu item." << endl;
                         }
                     } else {
-                        name = existingItem->name;
+                        cout << "\nDeletion cancelled." << endl;
                     }
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 11: {
+                clearScreen();
+                string id, purpose;
+                cout << "==== Prepare Menu Item ====" << endl;
+                
+                // Display available menu items
+                menuSystem.displayAll();
+                
+                cout << "\nEnter ID of menu item to prepare: ";
+                cin >> id;
+                cin.ignore();
+                
+                cout << "Enter purpose (e.g., Customer Order): ";
+                getline(cin, purpose);
+                
+                if (menuSystem.prepareMenuItem(id, inventory, purpose)) {
+                    cout << "\nMenu item prepared successfully!" << endl;
                     
-                    cout << "Enter New Price (minimum 1.00, enter 0 to keep current): ";
-                    cin >> price;
-                    
-                    if (price != 0) {
-                        // Validate price if provided
-                        if (!ValidationCheck::isValidPrice(price)) {
-                            ValidationCheck::showError("Price must be at least 1.00 with maximum 2 decimal places");
-                            price = existingItem->price; // Keep current if invalid
-                        }
-                    } else {
-                        price = existingItem->price;
+                    // Save inventory changes to file
+                    if (!inventory.saveToFile("food_items.txt")) {
+                        cout << "Warning: Failed to save inventory changes to file." << endl;
                     }
-                    
-                    cin.ignore();
-                    cout << "Enter New Description (5-100 characters, leave blank to keep current): ";
-                    getline(cin, description);
-                    
-                    if (!description.empty()) {
-                        // Validate description if provided
-                        if (!ValidationCheck::isValidStringLength(description, 5, 100)) {
-                            ValidationCheck::showError("Description length must be between 5 and 100 characters");
-                            description = existingItem->description; // Keep current if invalid
-                        }
-                    } else {
-                        description = existingItem->description;
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 12: {
+                clearScreen();
+                string id;
+                cout << "==== Check Ingredients Availability ====" << endl;
+                
+                // Display available menu items
+                menuSystem.displayAll();
+                
+                cout << "\nEnter ID of menu item to check: ";
+                cin >> id;
+                
+                bool available = menuSystem.checkIngredientsAvailability(id, inventory);
+                if (available) {
+                    cout << "\nAll ingredients are available for this menu item." << endl;
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 13: {
+                clearScreen();
+                string id;
+                cout << "==== Display Menu Item Details ====" << endl;
+                
+                // Display available menu items
+                menuSystem.displayAll();
+                
+                cout << "\nEnter ID of menu item to display: ";
+                cin >> id;
+                
+                menuSystem.displayMenuItem(id, inventory);
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 14: {
+                // Hand orders to the kitchen worker threads
+                manageKitchenOrders(menuSystem, inventory);
+                break;
+            }
+            case 15: {
+                // Availability, cost and ingredient references of the whole menu in one parallel pass
+                clearScreen();
+                menuSystem.displayBulkChecks(inventory);
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 16: {
+                // Which dishes depend on a food item, answered from the ingredient index
+                clearScreen();
+                string foodId;
+                cout << "==== Ingredient Impact ====" << endl;
+                cout << "Enter Food Item ID: ";
+                cin >> foodId;
+                
+                menuSystem.displayIngredientImpact(foodId);
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 17: {
+                // Dishes the current stock cannot cover
+                clearScreen();
+                menuSystem.displayUnavailableItems();
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 0:
+                cout << "Returning to main menu..." << endl;
+                break;
+            default:
+                cout << "Invalid choice. Please try again." << endl;
+                cout << "\nPress any key to continue...";
+                getch();
+        }
+    } while (menuChoice != 0);
+}
+
+/**
+ * Handle food and menu management functionality
+ * @param menuSystem Reference to the menu system to manage
+ * @param inventory Reference to the inventory system for ingredient validation
+ */
+void manageAll(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inventory) {
+    int menuChoice;
+    do {
+        // Display menu management options
+        clearScreen();
+        cout << "\n==== All Management ====" << endl;
+        
+        cout << "1. Inventory Management" << endl;
+        cout << "2. Menu Management" << endl;
+        cout << "3. Memory Usage Report" << endl;
+        cout << "4. Operation Latency Report" << endl;
+        cout << (TraceRecorder::isRecording() ? "5. Stop Trace Recording" : "5. Start Trace Recording") << endl;
+        cout << "6. Allocation Report" << endl;
+        cout << "0. Back to Main Menu" << endl;
+        
+        cout << "\nEnter your choice: ";
+        cin >> menuChoice;
+        
+        // Process menu management submenu selection
+        switch (menuChoice) {
+            case 1: {
+                manageInventory(inventory);
+                break;
+            }
+            case 2: {
+                manageMenu(menuSystem, inventory);
+                break;
+            }
+            case 3: {
+                // Show per-subsystem memory statistics and dump them for scripts
+                clearScreen();
+                MemoryTracker::displayReport();
+                
+                if (MemoryTracker::saveToFile("memory_stats.json")) {
+                    cout << "Memory statistics saved to memory_stats.json" << endl;
+                }
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 4: {
+                // Show latency percentiles of the instrumented operations and dump them for scripts
+                clearScreen();
+#ifndef RESTAURANT_NO_LATENCY_STATS
+                LatencyStats::displayReport();
+                
+                if (LatencyStats::saveToFile("latency_stats.json")) {
+                    cout << "Latency statistics saved to latency_stats.json" << endl;
+                }
+#else
+                cout << "Latency statistics are not available in this build (RESTAURANT_NO_LATENCY_STATS)." << endl;
+#endif
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 5: {
+                // Switch span recording on or off; stopping writes the trace file
+                if (!TraceRecorder::isRecording()) {
+                    TraceRecorder::start("trace.json");
+                    cout << "Trace recording started. Choose this option again to stop and write trace.json." << endl;
+                } else {
+                    int events = TraceRecorder::getEventCount();
+                    string filename = TraceRecorder::getFilename();
+                    if (TraceRecorder::stop()) {
+                        cout << "Trace with " << events << " spans written to " << filename
+                             << " (open it in chrome://tracing or ui.perfetto.dev)." << endl;
                     }
-                    
-                    cout << "Enter New Category (3-20 characters, leave blank to keep current): ";
-                    getline(cin, category);
-                    
-                    if (!category.empty()) {
-                        // Validate category if provided
-                        if (!ValidationCheck::isValidStringLength(category, 3, 20)) {
-                            ValidationCheck::showError("Category length must be between 3 and 20 characters");
-                            category = existingItem->category; // Keep current if invalid
+                }
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 6: {
+                // Show heap allocations per engine operation and dump them for scripts
+                clearScreen();
+#ifdef RESTAURANT_COUNT_ALLOCATIONS
+                AllocationStats::displayReport();
+                
+                if (AllocationStats::saveToFile("allocation_stats.json")) {
+                    cout << "Allocation statistics saved to allocation_stats.json" << endl;
+                }
+#else
+                cout << "Allocation counting is not enabled in this build (compile with -DRESTAURANT_COUNT_ALLOCATIONS)." << endl;
+#endif
+                
+                cout << "\nPress any key to continue...";
+                getch();
+                break;
+            }
+            case 0:
+                cout << "Returning to main menu..." << endl;
+                break;
+            default:
+                cout << "Invalid choice. Please try again." << endl;
+                cout << "\nPress any key to continue...";
+                getch();
+        }
+    } while (menuChoice != 0);
+}
+
+// Stream buffer that throws away everything written to it
+// Used to silence the engine's console messages while many threads are running
+class NullStreamBuffer : public streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+};
+
+/**
+ * Stress test for sharing one inventory between several POS terminals
+ * Runs many threads doing mixed inserts, batch adds, lookups, single uses and multi-ingredient
+ * orders on a private inventory (no files are touched), then checks that total stock is conserved:
+ * final stock = initial stock + everything added - everything successfully used.
+ * Also checks that the item count matches the number of IDs still in stock, and that snapshots
+ * taken while the threads run are consistent.
+ * Run with: restaurant --stress-test
+ * Return: 0 if all checks pass, 1 otherwise
+ */
+int runInventoryStressTest() {
+    const int ITEM_TYPES = 40;           // Distinct ingredient IDs
+    const int INITIAL_QUANTITY = 500;    // Starting stock of each ingredient
+    const int THREAD_COUNT = 8;          // Simulated terminals
+    const int OPERATIONS = 20000;        // Operations per terminal
+    
+    RestaurantInventorySystem inventory;
+    ItemID ids[ITEM_TYPES];
+    
+    cout << "Inventory stress test: " << THREAD_COUNT << " threads x " << OPERATIONS
+         << " operations on " << ITEM_TYPES << " ingredients" << endl;
+    
+    // Silence per-call messages while the threads run
+    NullStreamBuffer nullBuffer;
+    streambuf* consoleBuffer = cout.rdbuf(&nullBuffer);
+    
+    long long initialStock = 0;
+    for (int i = 0; i < ITEM_TYPES; i++) {
+        ostringstream idText;
+        idText << "S" << setw(3) << setfill('0') << i;
+        ids[i] = idText.str();
+        inventory.insertFoodItem(FoodItem(ids[i], "Stress Item " + to_string(i), 1.00, "Test", INITIAL_QUANTITY));
+        initialStock += INITIAL_QUANTITY;
+    }
+    
+    // Per-thread tallies, combined after the threads finish
+    long long added[THREAD_COUNT] = {0};
+    long long used[THREAD_COUNT] = {0};
+    atomic<int> negativeReads(0);
+    atomic<int> changedViews(0);
+    
+    thread* workers = new thread[THREAD_COUNT];
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        workers[t] = thread([&, t]() {
+            uint32_t seed = 2463534242u + (uint32_t)t * 7919u;
+            auto next = [&seed](int bound) {
+                // xorshift32, cheap and deterministic per thread
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                return (int)(seed % (uint32_t)bound);
+            };
+            
+            for (int op = 0; op < OPERATIONS; op++) {
+                const ItemID& id = ids[next(ITEM_TYPES)];
+                switch (next(6)) {
+                    case 0: {
+                        // Receive a new batch
+                        int amount = 1 + next(8);
+                        if (inventory.addExistingFoodItem(FoodItem(id, "Stress Item", 1.00, "Test", amount))) {
+                            added[t] += amount;
                         }
-                    } else {
-                        category = existingItem->category;
+                        break;
                     }
-                    
-                    // Create updated menu item
-                    MenuItem updatedItem(id, name, price, description, category);
-                    
-                    // Copy existing ingredients
-                    for (int i = 0; i < existingItem->ingredientCount; i++) {
-                        size_t colonPos = existingItem->ingredients[i].find(":");
-                        if (colonPos != string::npos) {
-                            string foodId = existingItem->ingredients[i].substr(0, colonPos);
-                            int quantity = stoi(existingItem->ingredients[i].substr(colonPos + 1));
-                            updatedItem.addIngredient(foodId, quantity);
+                    case 1: {
+                        // Restock by merging into one batch
+                        int amount = 1 + next(8);
+                        if (inventory.insertFoodItem(FoodItem(id, "Stress Item", 1.00, "Test", amount))) {
+                            added[t] += amount;
                         }
+                        break;
                     }
-                    
-                    // Update ingredients if needed
-                    char updateIngredients;
-                    cout << "\nDo you want to update ingredients? (Y/N): ";
-                    cin >> updateIngredients;
-                    
-                    if (toupper(updateIngredients) == 'Y') {
-                        // Clear existing ingredients
-                        for (int i = 0; i < updatedItem.ingredientCount; i++) {
-                            size_t colonPos = updatedItem.ingredients[i].find(":");
-                            if (colonPos != string::npos) {
-                                string foodId = updatedItem.ingredients[i].substr(0, colonPos);
-                                updatedItem.removeIngredient(foodId);
-                                i--; // Adjust index after removal
-                            }
+                    case 2: {
+                        // Look the item up, both as a view and as a copy
+                        FoodItemView view = inventory.findFoodItem(id);
+                        FoodItem* copy = inventory.copyFoodItem(id);
+                        if (view.totalQuantity < 0 || (copy != nullptr && copy->quantity <= 0)) {
+                            negativeReads++;
                         }
+                        delete copy;
                         
-                        // Show available food items for reference
-                        cout << "\nAvailable Food Items:" << endl;
-                        inventory.displayAll();
-                        
-                        char addMore = 'Y';
-                        while (toupper(addMore) == 'Y') {
-                            string foodId;
-                            int quantity;
-                            isValid = false;
-                            
-                            // Validate ingredient ID
-                            do {
-                                cout << "\nEnter Food Item ID to add as ingredient: ";
-                                cin >> foodId;
-                                
-                                if (!ValidationCheck::isValidID(foodId)) {
-                                    ValidationCheck::showError("Ingredient ID must be 1 letter followed by 3 digits (e.g. F001)");
-                                } else {
-                                    isValid = true;
+                        // Other terminals may have used or removed the item meanwhile, the view
+                        // must still show the batches it was taken from
+                        if (!view.isNull()) {
+                            int recounted = 0;
+                            for (const FoodItem& batch : *view.bucket) {
+                                if (batch.id == id) {
+                                    recounted += batch.quantity;
                                 }
-                            } while (!isValid);
-                            
-                            // Verify the food item exists
-                            FoodItem* foodItem = inventory.findFoodItem(foodId);
-                            if (foodItem == nullptr) {
-                                cout << "Error: Food item with ID " << foodId << " not found." << endl;
-                            } else {
-                                cout << "Found: " << foodItem->name << endl;
-                                
-                                // Validate ingredient quantity
-                                isValid = false;
-                                do {
-                                    cout << "Enter quantity needed (1-999): ";
-                                    cin >> quantity;
-                                    
-                                    if (!ValidationCheck::isValidQuantity(quantity)) {
-                                        ValidationCheck::showError("Quantity must be between 1 and 999");
-                                    } else {
-                                        isValid = true;
-                                    }
-                                } while (!isValid);
-                                
-                                updatedItem.addIngredient(foodId, quantity);
-                                cout << "Ingredient added successfully!" << endl;
-                                
-                                delete foodItem;
                             }
-                            
-                            cout << "Add another ingredient? (Y/N): ";
-                            cin >> addMore;
+                            if (recounted != view.totalQuantity || view->name.compare(0, 11, "Stress Item") != 0) {
+                                changedViews++;
+                            }
                         }
+                        break;
                     }
-                    
-                    // Update the menu item
-                    if (menuSystem.updateMenuItem(updatedItem)) {
-                        cout << "\nMenu item updated successfully!" << endl;
-                        
-                        // Save to file after updating
-                        if (!menuSystem.saveToFile("menu_items.txt")) {
-                            cout << "Warning: Failed to save menu changes to file." << endl;
+                    case 3:
+                    case 4: {
+                        // Use a single ingredient
+                        int amount = 1 + next(4);
+                        if (inventory.useFoodItem(id, amount)) {
+                            used[t] += amount;
                         }
-                    } else {
-                        cout << "\nFailed to update menu item." << endl;
+                        break;
+                    }
+                    default: {
+                        // Multi-ingredient order, sometimes repeating an ingredient
+                        IngredientList order;
+                        int ingredients = 2 + next(3);
+                        int total = 0;
+                        for (int k = 0; k < ingredients; k++) {
+                            int amount = 1 + next(2);
+                            order.add(ids[next(ITEM_TYPES)], amount);
+                            total += amount;
+                        }
+                        if (inventory.useFoodItems(order)) {
+                            used[t] += total;
+                        }
+                        break;
                     }
-                    
-                    delete existingItem;
                 }
-                
-                cout << "\nPress any key to continue...";
-                getch();
+            }
+        });
+    }
+    
+    // Meanwhile keep taking snapshots, as reports and saves would, and check each one is sound:
+    // no empty batches and every ID stored in a single bucket
+    atomic<bool> workersDone(false);
+    atomic<int> snapshotsTaken(0);
+    atomic<int> badSnapshots(0);
+    thread reporter([&]() {
+        while (!workersDone.load()) {
+            InventorySnapshot snapshot = inventory.takeSnapshot();
+            bool sound = true;
+            for (int b = 0; b < snapshot.getBucketCount() && sound; b++) {
+                const ADTLinkedQueue& bucket = snapshot.getBucket(b);
+                if (bucket.isEmpty()) continue;
+                ItemID owner = bucket.peek().id;
+                for (const FoodItem& item : bucket) {
+                    if (item.quantity <= 0 || item.id != owner) {
+                        sound = false;
+                    }
+                }
+                for (int other = b + 1; other < snapshot.getBucketCount() && sound; other++) {
+                    if (snapshot.getBucket(other).contains(owner)) {
+                        sound = false;
+                    }
+                }
+            }
+            if (!sound) {
+                badSnapshots++;
+            }
+            snapshotsTaken++;
+        }
+    });
+    
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        workers[t].join();
+    }
+    delete[] workers;
+    workersDone.store(true);
+    reporter.join();
+    
+    cout.rdbuf(consoleBuffer);
+    
+    // Compare the stock left in the inventory with the tallies
+    long long totalAdded = 0;
+    long long totalUsed = 0;
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        totalAdded += added[t];
+        totalUsed += used[t];
+    }
+    
+    long long finalStock = 0;
+    bool anyEmptyBatch = false;
+    InventorySnapshot finalSnapshot = inventory.takeSnapshot();
+    for (const FoodItem& item : finalSnapshot.getBatches()) {
+        finalStock += item.quantity;
+        if (item.quantity <= 0) {
+            anyEmptyBatch = true;
+        }
+    }
+    
+    int idsInStock = 0;
+    for (int i = 0; i < ITEM_TYPES; i++) {
+        if (!inventory.findFoodItem(ids[i]).isNull()) {
+            idsInStock++;
+        }
+    }
+    
+    long long expectedStock = initialStock + totalAdded - totalUsed;
+    bool stockConserved = (finalStock == expectedStock);
+    bool countConsistent = (inventory.getItemCount() == idsInStock);
+    
+    cout << "Initial stock:  " << initialStock << endl;
+    cout << "Added:          " << totalAdded << endl;
+    cout << "Used:           " << totalUsed << endl;
+    cout << "Expected stock: " << expectedStock << endl;
+    cout << "Final stock:    " << finalStock << endl;
+    cout << "Item count:     " << inventory.getItemCount() << " (IDs in stock: " << idsInStock << ")" << endl;
+    cout << "Snapshots:      " << snapshotsTaken.load() << " taken during the run, " << badSnapshots.load() << " inconsistent" << endl;
+    cout << "Lookups:        " << negativeReads.load() << " negative, " << changedViews.load() << " changed while held" << endl;
+    
+    bool passed = stockConserved && countConsistent && !anyEmptyBatch && negativeReads.load() == 0 &&
+                  changedViews.load() == 0 && badSnapshots.load() == 0;
+    cout << (passed ? "PASSED" : "FAILED") << endl;
+    return passed ? 0 : 1;
+}
+
+/**
+ * Self-check for the group-commit usage logger with a sync after every group
+ * Several threads log numbered records into a scratch file; the check then reads the file back
+ * and verifies that every record arrived exactly once and in order per thread, and that every
+ * group was synced to disk. The scratch file is removed afterwards. A second logger writes to a
+ * path that cannot be opened, and its flush must report the records as lost, not written.
+ * Run with: restaurant --usage-log-test
+ * Return: 0 if all checks pass, 1 otherwise
+ */
+int runUsageLogTest() {
+    const int THREAD_COUNT = 4;          // Simulated terminals
+    const int RECORDS = 3000;            // Records per terminal, several ring-fulls in total
+    const string TEST_FILE = "usage_log_test.txt";
+    
+    remove(TEST_FILE.c_str());
+    cout << "Usage log test: " << THREAD_COUNT << " threads x " << RECORDS << " records, synced" << endl;
+    
+    unsigned long long groups = 0;
+    unsigned long long synced = 0;
+    bool flushed = false;
+    {
+        UsageLogger logger(TEST_FILE);
+        logger.setSyncEachBatch(true);
+        
+        thread* workers = new thread[THREAD_COUNT];
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            workers[t] = thread([&logger, t]() {
+                ItemID id("T00" + to_string(t));
+                for (int r = 0; r < RECORDS; r++) {
+                    logger.log(id, "Test Item", r, "Test");
+                    if (r % 1000 == 999) {
+                        logger.flush();
+                    }
+                }
+            });
+        }
+        for (int t = 0; t < THREAD_COUNT; t++) {
+            workers[t].join();
+        }
+        delete[] workers;
+        
+        flushed = logger.flush();
+        groups = logger.getCommittedGroups();
+        synced = logger.getSyncedGroups();
+    }
+    
+    // A directory that does not exist: every group fails
+    const int LOST_RECORDS = 10;
+    bool lostFlushed = true;
+    unsigned long long lostCommitted = 0;
+    unsigned long long lostFailed = 0;
+    {
+        NullStreamBuffer nullBuffer;
+        streambuf* consoleBuffer = cout.rdbuf(&nullBuffer);
+        UsageLogger logger("usage_log_test_missing_dir/usage.txt");
+        for (int r = 0; r < LOST_RECORDS; r++) {
+            logger.log(ItemID("T000"), "Test Item", r, "Test");
+        }
+        lostFlushed = logger.flush();
+        lostCommitted = logger.getCommittedRecords();
+        lostFailed = logger.getFailedRecords();
+        cout.rdbuf(consoleBuffer);
+    }
+    
+    // Read the records back: date,id,name,amount,purpose with the amount counting up per thread
+    int nextRecord[THREAD_COUNT] = {0};
+    int lines = 0;
+    bool ordered = true;
+    ifstream file(TEST_FILE);
+    string line;
+    while (getline(file, line)) {
+        lines++;
+        size_t idStart = line.find(',');
+        size_t nameStart = (idStart == string::npos) ? string::npos : line.find(',', idStart + 1);
+        size_t amountStart = (nameStart == string::npos) ? string::npos : line.find(',', nameStart + 1);
+        if (amountStart == string::npos) {
+            ordered = false;
+            continue;
+        }
+        int t = line[nameStart - 1] - '0';
+        int amount = atoi(line.c_str() + amountStart + 1);
+        if (t < 0 || t >= THREAD_COUNT || amount != nextRecord[t]) {
+            ordered = false;
+            continue;
+        }
+        nextRecord[t]++;
+    }
+    file.close();
+    remove(TEST_FILE.c_str());
+    
+    bool complete = (lines == THREAD_COUNT * RECORDS);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        complete = complete && (nextRecord[t] == RECORDS);
+    }
+    
+    cout << "Records:        " << lines << " written, expected " << THREAD_COUNT * RECORDS << endl;
+    cout << "Groups:         " << groups << " written, " << synced << " synced" << endl;
+    cout << "Failed writes:  " << lostFailed << " of " << LOST_RECORDS << " records reported lost, "
+         << lostCommitted << " counted as written, flush " << (lostFlushed ? "succeeded" : "failed") << endl;
+    
+    bool passed = complete && ordered && flushed && groups > 0 && synced == groups &&
+                  !lostFlushed && lostCommitted == 0 && lostFailed == (unsigned long long)LOST_RECORDS;
+    cout << (passed ? "PASSED" : "FAILED") << endl;
+    return passed ? 0 : 1;
+}
+
+/**
+ * Self-check for servings and availability of recipes that list an ingredient more than once
+ * A dish needing F001 twice (2 + 3) must be limited by the total of 5 per serving, not by each
+ * line on its own. The check follows the stock through receiving and using on a private
+ * inventory and menu (no files are touched). It also checks that the menu cannot be changed
+ * while a kitchen is open on it.
+ * Run with: restaurant --servings-test
+ * Return: 0 if all checks pass, 1 otherwise
+ */
+int runServingsTest() {
+    RestaurantInventorySystem inventory;
+    RestaurantMenuSystem menuSystem;
+    
+    cout << "Servings test: recipe with a repeated ingredient (F001 x 2 + F001 x 3, F002 x 1)" << endl;
+    
+    // Silence per-call messages
+    NullStreamBuffer nullBuffer;
+    streambuf* consoleBuffer = cout.rdbuf(&nullBuffer);
+    
+    inventory.insertFoodItem(FoodItem("F001", "Rice", 1.00, "Grain", 12));
+    inventory.insertFoodItem(FoodItem("F002", "Egg", 1.00, "Protein", 10));
+    
+    MenuItem dish("M001", "Egg Fried Rice", 8.00, "Test dish", "Main");
+    dish.addIngredient("F001", 2);
+    dish.addIngredient("F002", 1);
+    dish.addIngredient("F001", 3);
+    menuSystem.addMenuItem(dish);
+    menuSystem.trackServings(inventory);
+    
+    // 12 / 5 = 2 servings (dividing per line would give 12 / 3 = 4)
+    int servingsAtStart = menuSystem.getMaxServings("M001");
+    bool availableAtStart = menuSystem.checkIngredientsAvailability("M001", inventory);
+    
+    // 4 left: each line alone would still fit, the dish does not
+    inventory.useFoodItem("F001", 8);
+    int servingsAfterUse = menuSystem.getMaxServings("M001");
+    bool availableAfterUse = menuSystem.checkIngredientsAvailability("M001", inventory);
+    
+    // A new batch brings 15 in stock: exactly 3 servings
+    inventory.addExistingFoodItem(FoodItem("F001", "Rice", 1.00, "Grain", 11));
+    int servingsAfterAdd = menuSystem.getMaxServings("M001");
+    
+    // The kitchen reads recipes without a lock, so the menu is frozen while it is open
+    bool changedWhileOpen;
+    {
+        KitchenWorkerPool kitchen(menuSystem, inventory, 1, 4);
+        changedWhileOpen = menuSystem.updateMenuItem(dish);
+    }
+    bool changedAfterClose = menuSystem.updateMenuItem(dish);
+    
+    menuSystem.stopTrackingServings();
+    cout.rdbuf(consoleBuffer);
+    
+    cout << "Servings:       " << servingsAtStart << " with 12, " << servingsAfterUse << " with 4, "
+         << servingsAfterAdd << " with 15 (expected 2, 0, 3)" << endl;
+    cout << "Availability:   " << (availableAtStart ? "yes" : "no") << " with 12, "
+         << (availableAfterUse ? "yes" : "no") << " with 4 (expected yes, no)" << endl;
+    cout << "Menu changes:   " << (changedWhileOpen ? "allowed" : "rejected") << " with the kitchen open, "
+         << (changedAfterClose ? "allowed" : "rejected") << " after closing (expected rejected, allowed)" << endl;
+    
+    bool passed = servingsAtStart == 2 && servingsAfterUse == 0 && servingsAfterAdd == 3 &&
+                  availableAtStart && !availableAfterUse && !changedWhileOpen && changedAfterClose;
+    cout << (passed ? "PASSED" : "FAILED") << endl;
+    return passed ? 0 : 1;
+}
+
+/**
+ * BatchCommandRunner executes inventory and menu commands from a script without any prompts
+ * One command per line, arguments separated by commas (like food_items.txt); blank lines and
+ * lines starting with # are skipped. Every command is timed, and a throughput summary per
+ * command type is printed at the end, so a day's activity can be replayed and measured.
+ *   insert id,name,price,category,quantity   Add stock, merged into the existing batch if the ID exists
+ *   add id,name,price,category,quantity      Receive a new batch (FIFO)
+ *   use id,amount[,purpose]                  Consume stock and log the usage
+ *   prepare menuId[,purpose]                 Prepare a menu item as one transaction
+ *   remove id                                Remove every batch of a food item
+ *   lookup id                                Show the total stock of a food item
+ *   search text                              Search food items by name
+ *   sort name|quantity|date                  Show the inventory sorted
+ *   list | menu                              Show the inventory / the menu
+ *   hashstats                                Show the hash table diagnostics of the inventory
+ *   allocstats                               Show heap allocations per operation (RESTAURANT_COUNT_ALLOCATIONS builds)
+ *   check menuId                             Check the ingredients of a menu item
+ *   impact foodId                            Show the menu items that use a food item
+ *   lowstock [count]                         Show the food items closest to their reorder threshold (default 10)
+ *   threshold id,value                       Set the reorder threshold of a food item
+ *   unavailable                              Show the menu items the current stock cannot cover
+ *   save [file] | load [file]                Save / load the inventory (default food_items.txt)
+ *   flush                                    Write pending usage history and stock alert records
+ *   quiet on|off                             Hide / show the output of the commands themselves
+ *   trace on[,file] | trace off              Record trace spans (default trace.json) / stop and write the file
+ *   repeat count command                     Run a command several times (each run counts as one command)
+ */
+class BatchCommandRunner {
+private:
+    static const int MAX_FIELDS = 8;
+    static const int MAX_COMMAND_TYPES = 24;
+    
+    // Timing totals of one command type
+    struct CommandStats {
+        string name;
+        long long count;
+        long long failures;
+        double totalMicros;
+    };
+    
+    RestaurantMenuSystem& menuSystem;
+    RestaurantInventorySystem& inventory;
+    ostream report;                  // Timing lines and summary, always shown even when quiet
+    streambuf* consoleBuffer;        // cout's own buffer, restored when quiet is turned off
+    NullStreamBuffer discard;
+    CommandStats stats[MAX_COMMAND_TYPES];
+    int statsCount;
+    
+    // Splits trimmed text into its first word and the rest, at the first run of spaces or tabs
+    static void splitWord(const string& text, string& word, string& rest) {
+        size_t end = text.find_first_of(" \t");
+        word = text.substr(0, end);
+        size_t next = (end == string::npos) ? string::npos : text.find_first_not_of(" \t", end);
+        rest = (next == string::npos) ? "" : text.substr(next);
+    }
+    
+    // Splits text at commas into at most MAX_FIELDS trimmed fields, the last field keeps any extra commas
+    static int splitFields(const string& text, string fields[]) {
+        int count = 0;
+        size_t start = 0;
+        while (count < MAX_FIELDS) {
+            size_t comma = (count == MAX_FIELDS - 1) ? string::npos : text.find(',', start);
+            string field = text.substr(start, comma == string::npos ? string::npos : comma - start);
+            size_t first = field.find_first_not_of(" \t");
+            size_t last = field.find_last_not_of(" \t\r");
+            fields[count++] = (first == string::npos) ? "" : field.substr(first, last - first + 1);
+            if (comma == string::npos) {
                 break;
             }
-            case 10: {
-                RestaurantInventorySystem::clearScreen();
-                string id;
-                cout << "==== Remove Menu Item ====" << endl;
-                cout << "Enter ID of menu item to remove: ";
-                cin >> id;
+            start = comma + 1;
+        }
+        return count;
+    }
+    
+    // Parses an integer field, rejecting trailing garbage
+    static bool parseInt(const string& text, int& value) {
+        try {
+            size_t used = 0;
+            value = stoi(text, &used);
+            return used == text.length();
+        } catch (const exception&) {
+            return false;
+        }
+    }
+    
+    // Parses the id,name,price,category,quantity fields of insert and add
+    static bool parseFoodItem(const string fields[], int count, FoodItem& item) {
+        int quantity;
+        if (count != 5 || !parseInt(fields[4], quantity)) {
+            return false;
+        }
+        try {
+            item = FoodItem(fields[0], fields[1], stod(fields[2]), fields[3], quantity);
+        } catch (const exception&) {
+            return false;
+        }
+        return item.id.isValid() && !item.id.empty();
+    }
+    
+    // Returns the statistics slot of a command type, adding it on first use
+    CommandStats& statsFor(const string& name) {
+        for (int i = 0; i < statsCount; i++) {
+            if (stats[i].name == name) {
+                return stats[i];
+            }
+        }
+        if (statsCount == MAX_COMMAND_TYPES) {
+            return stats[MAX_COMMAND_TYPES - 1];
+        }
+        CommandStats& slot = stats[statsCount++];
+        slot.name = name;
+        slot.count = 0;
+        slot.failures = 0;
+        slot.totalMicros = 0.0;
+        return slot;
+    }
+    
+    // Runs one command (without timing)
+    // Returns: true if it succeeded; error describes a failure that has no output of its own
+    bool execute(const string& command, const string& arguments, string& error) {
+        string fields[MAX_FIELDS];
+        int count = arguments.empty() ? 0 : splitFields(arguments, fields);
+        
+        // Under --shared-inventory every command starts from what the other processes published,
+        // including the menu reports, whose servings follow the stock through the stock listener
+        inventory.syncShared();
+        
+        if (command == "insert" || command == "add") {
+            FoodItem item;
+            if (!parseFoodItem(fields, count, item)) {
+                error = "expected id,name,price,category,quantity";
+                return false;
+            }
+            return (command == "insert") ? inventory.insertFoodItem(item) : inventory.addExistingFoodItem(item);
+        }
+        if (command == "use") {
+            int amount;
+            if (count < 2 || !parseInt(fields[1], amount) || amount <= 0) {
+                error = "expected id,amount[,purpose]";
+                return false;
+            }
+            // Read the name first (the last units may be used up) and drop the view before using
+            // the item, so the bucket is changed in place instead of copied
+            string name;
+            {
+                FoodItemView item = inventory.findFoodItem(fields[0]);
+                if (!item.isNull()) {
+                    name = item->name;
+                }
+            }
+            if (!inventory.useFoodItem(fields[0], amount)) {
+                return false;
+            }
+            inventory.logItemUsage(fields[0], name, amount, count > 2 ? fields[2] : "Batch Command");
+            return true;
+        }
+        if (command == "prepare") {
+            if (count < 1) {
+                error = "expected menuId[,purpose]";
+                return false;
+            }
+            string message;
+            bool prepared = menuSystem.prepareOrder(fields[0], inventory, count > 1 ? fields[1] : "Batch Command", message);
+            cout << message << endl;
+            return prepared;
+        }
+        if (command == "remove") {
+            if (count != 1) {
+                error = "expected id";
+                return false;
+            }
+            if (!inventory.removeFoodItem(fields[0])) {
+                error = "food item not found";
+                return false;
+            }
+            return true;
+        }
+        if (command == "lookup") {
+            if (count != 1) {
+                error = "expected id";
+                return false;
+            }
+            FoodItem* item = inventory.copyFoodItem(fields[0]);
+            if (item == nullptr) {
+                error = "food item not found";
+                return false;
+            }
+            cout << item->id << " " << item->name << ": " << item->quantity << " in stock" << endl;
+            delete item;
+            return true;
+        }
+        if (command == "search") {
+            inventory.searchByName(arguments);
+            return true;
+        }
+        if (command == "sort") {
+            if (arguments == "name" || arguments == "quantity") {
+                inventory.displaySorted(arguments == "name");
+            } else if (arguments == "date") {
+                inventory.displaySortedByDate();
+            } else {
+                error = "expected name, quantity or date";
+                return false;
+            }
+            return true;
+        }
+        if (command == "list") {
+            inventory.displayAll();
+            return true;
+        }
+        if (command == "menu") {
+            menuSystem.displayAll();
+            return true;
+        }
+        if (command == "trace") {
+            if (count >= 1 && fields[0] == "on") {
+                TraceRecorder::start(count >= 2 ? fields[1] : "trace.json");
+                return true;
+            }
+            if (count == 1 && fields[0] == "off") {
+                if (!TraceRecorder::stop()) {
+                    error = "no trace recording or file not written";
+                    return false;
+                }
+                return true;
+            }
+            error = "expected on [file] or off";
+            return false;
+        }
+        if (command == "hashstats") {
+            inventory.displayHashDiagnostics();
+            return true;
+        }
+        if (command == "allocstats") {
+#ifdef RESTAURANT_COUNT_ALLOCATIONS
+            AllocationStats::displayReport();
+            return true;
+#else
+            error = "allocation counting is not enabled in this build";
+            return false;
+#endif
+        }
+        if (command == "check") {
+            if (count != 1) {
+                error = "expected menuId";
+                return false;
+            }
+            return menuSystem.checkIngredientsAvailability(fields[0], inventory);
+        }
+        if (command == "impact") {
+            if (count != 1) {
+                error = "expected foodId";
+                return false;
+            }
+            menuSystem.displayIngredientImpact(fields[0]);
+            return true;
+        }
+        if (command == "unavailable") {
+            menuSystem.displayUnavailableItems();
+            return true;
+        }
+        if (command == "lowstock") {
+            int lowCount = 10;
+            if (count > 1 || (count == 1 && (!parseInt(fields[0], lowCount) || lowCount <= 0))) {
+                error = "expected [count]";
+                return false;
+            }
+            inventory.displayLowStock(lowCount);
+            return true;
+        }
+        if (command == "threshold") {
+            int threshold;
+            if (count != 2 || !parseInt(fields[1], threshold)) {
+                error = "expected id,value";
+                return false;
+            }
+            return inventory.setReorderThreshold(fields[0], threshold);
+        }
+        if (command == "save") {
+            return inventory.saveToFile(arguments.empty() ? "food_items.txt" : arguments);
+        }
+        if (command == "load") {
+            return inventory.loadFromFile(arguments.empty() ? "food_items.txt" : arguments);
+        }
+        if (command == "flush") {
+            bool usageWritten = inventory.flushUsageLog();
+            bool alertsWritten = inventory.flushStockAlerts();
+            if (!usageWritten || !alertsWritten) {
+                error = "some records could not be written";
+                return false;
+            }
+            return true;
+        }
+        
+        error = "unknown command";
+        return false;
+    }
+    
+    // Runs and times a command repeatCount times, then prints one timing line for the script line
+    // Returns: true if every run succeeded
+    bool runTimed(int lineNumber, const string& command, const string& arguments, int repeatCount) {
+        CommandStats& entry = statsFor(command);
+        string error;
+        int failures = 0;
+        double totalMicros = 0.0;
+        
+        for (int i = 0; i < repeatCount; i++) {
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            bool success = execute(command, arguments, error);
+            totalMicros += chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+            if (!success) {
+                failures++;
+            }
+        }
+        entry.count += repeatCount;
+        entry.failures += failures;
+        entry.totalMicros += totalMicros;
+        
+        report << "[" << lineNumber << "] " << command << (arguments.empty() ? "" : " ") << arguments << ": ";
+        if (repeatCount == 1) {
+            report << (failures == 0 ? "ok" : "FAILED");
+        } else {
+            report << (repeatCount - failures) << " of " << repeatCount << " ok";
+        }
+        report << (error.empty() ? "" : " (" + error + ")")
+               << " in " << fixed << setprecision(1) << totalMicros << " us";
+        if (repeatCount > 1) {
+            report << " (" << totalMicros / repeatCount << " us each)";
+        }
+        report << endl;
+        return failures == 0;
+    }
+    
+    // Prints the per-command-type totals and the overall throughput
+    void printSummary(double totalSeconds) {
+        report << string(80, '=') << endl;
+        report << left << setw(12) << "Command" 
+               << setw(12) << "Count" 
+               << setw(12) << "Failures" 
+               << setw(16) << "Avg (us)" 
+               << setw(16) << "Total (ms)" << endl;
+        report << string(80, '-') << endl;
+        
+        long long commands = 0;
+        long long failures = 0;
+        for (int i = 0; i < statsCount; i++) {
+            const CommandStats& entry = stats[i];
+            report << left << setw(12) << entry.name 
+                   << setw(12) << entry.count 
+                   << setw(12) << entry.failures 
+                   << setw(16) << fixed << setprecision(2) << entry.totalMicros / entry.count
+                   << setw(16) << entry.totalMicros / 1000.0 << endl;
+            commands += entry.count;
+            failures += entry.failures;
+        }
+        
+        report << string(80, '-') << endl;
+        report << commands << " commands, " << failures << " failed, in " << setprecision(3) << totalSeconds
+               << " s (" << setprecision(0) << (totalSeconds > 0 ? commands / totalSeconds : 0.0) << " commands/s)" << endl;
+    }
+
+public:
+    // Constructor - reports go to the console even while command output is hidden
+    BatchCommandRunner(RestaurantMenuSystem& _menuSystem, RestaurantInventorySystem& _inventory)
+        : menuSystem(_menuSystem), inventory(_inventory), report(cout.rdbuf()),
+          consoleBuffer(cout.rdbuf()), statsCount(0) {}
+    
+    // Restores the console if the script ended while quiet
+    ~BatchCommandRunner() {
+        cout.rdbuf(consoleBuffer);
+    }
+    
+    BatchCommandRunner(const BatchCommandRunner&) = delete;
+    BatchCommandRunner& operator=(const BatchCommandRunner&) = delete;
+    
+    /**
+     * Runs every command of a script
+     * Parameters: script - stream of command lines (a file or stdin)
+     * Return: 0 if every command succeeded, 1 otherwise
+     */
+    int run(istream& script) {
+        string line;
+        int lineNumber = 0;
+        bool allSucceeded = true;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        
+        while (getline(script, line)) {
+            lineNumber++;
+            size_t first = line.find_first_not_of(" \t");
+            if (first == string::npos || line[first] == '#') {
+                continue;
+            }
+            size_t last = line.find_last_not_of(" \t\r");
+            line = line.substr(first, last - first + 1);
+            
+            // Split off the command word; repeat wraps another command
+            int repeatCount = 1;
+            string command;
+            string arguments;
+            splitWord(line, command, arguments);
+            if (command == "repeat") {
+                string countText;
+                splitWord(arguments, countText, line);
+                if (line.empty() || !parseInt(countText, repeatCount) || repeatCount < 1) {
+                    report << "[" << lineNumber << "] repeat: FAILED (expected repeat count command)" << endl;
+                    allSucceeded = false;
+                    continue;
+                }
+                splitWord(line, command, arguments);
+            }
+            
+            if (command == "quiet") {
+                cout.rdbuf(arguments == "on" ? (streambuf*)&discard : consoleBuffer);
+                continue;
+            }
+            
+            if (!runTimed(lineNumber, command, arguments, repeatCount)) {
+                allSucceeded = false;
+            }
+        }
+        
+        double totalSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        printSummary(totalSeconds);
+        return allSucceeded ? 0 : 1;
+    }
+};
+
+#ifndef _WIN32
+/**
+ * InventoryServer exposes the inventory and menu engines on a Unix domain socket
+ * Kitchen displays and POS clients on the same machine talk to it with a compact binary protocol.
+ * All integers are big-endian; strings are a u16 length followed by the bytes; doubles are sent
+ * as their IEEE-754 bit pattern in a u64.
+ *   Request frame:  u32 length | u8 op     | u32 requestId | payload   (length counts op onwards)
+ *   Response frame: u32 length | u8 status | u32 requestId | payload
+ * Requests are pipelined: a client may send many frames without waiting, and responses come back
+ * in request order. All responses to the frames that arrived in one read are written with one send.
+ * The server is a single select() loop; the engines are thread-safe, so it can run next to other
+ * terminals sharing the same inventory (see --shared-inventory). Every lookup, search and listing
+ * reads through the inventory, which first pulls what the other processes published, so the
+ * answers reflect the live shared stock.
+ */
+class InventoryServer {
+public:
+    // Request operations
+    enum Op {
+        OP_PING = 0,       // (empty) -> (empty)
+        OP_LOOKUP = 1,     // id -> name, price, category, u32 totalQuantity, u32 batchCount
+        OP_CONSUME = 2,    // id, u32 amount, purpose -> u32 remaining
+        OP_PREPARE = 3,    // menu id, purpose -> message
+        OP_SEARCH = 4,     // name fragment -> u32 count, count x (id, name, u32 totalQuantity)
+        OP_LIST = 5        // u8 sort key (FoodSortKey), u32 limit (0 = all) ->
+                           //     u32 count, count x (id, name, price, u32 quantity, u64 receiveDate)
+    };
+    
+    // Response status codes
+    enum Status {
+        STATUS_OK = 0,
+        STATUS_NOT_FOUND = 1,      // Unknown food or menu ID
+        STATUS_REJECTED = 2,       // Valid request that could not be done (e.g. not enough stock), payload is a message
+        STATUS_BAD_REQUEST = 3     // Malformed payload or unknown op
+    };
+    
+    static const uint32_t MAX_FRAME = 64 * 1024;        // Largest request accepted (a bigger one closes the connection)
+
+private:
+    static const int MAX_CONNECTIONS = 256;
+    static const size_t READ_CHUNK = 64 * 1024;
+    static const size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;  // Stop reading from a client that does not read its responses
+    
+    // State of one client connection
+    struct Connection {
+        int fd;
+        string input;          // Bytes received but not yet parsed into frames
+        string output;         // Responses not yet sent
+        size_t outputSent;     // Bytes of output already sent
+    };
+    
+    // Sequential reader over a request payload; any read past the end marks it as failed
+    class PayloadReader {
+    private:
+        const unsigned char* data;
+        size_t size;
+        size_t position;
+        bool failed;
+        
+        bool take(size_t bytes) {
+            if (failed || size - position < bytes) {
+                failed = true;
+                return false;
+            }
+            return true;
+        }
+        
+    public:
+        PayloadReader(const char* _data, size_t _size)
+            : data(reinterpret_cast<const unsigned char*>(_data)), size(_size), position(0), failed(false) {}
+        
+        uint8_t readU8() {
+            return take(1) ? data[position++] : 0;
+        }
+        
+        uint32_t readU32() {
+            if (!take(4)) {
+                return 0;
+            }
+            uint32_t value = ((uint32_t)data[position] << 24) | ((uint32_t)data[position + 1] << 16) |
+                             ((uint32_t)data[position + 2] << 8) | (uint32_t)data[position + 3];
+            position += 4;
+            return value;
+        }
+        
+        string readString() {
+            if (!take(2)) {
+                return "";
+            }
+            size_t length = ((size_t)data[position] << 8) | data[position + 1];
+            position += 2;
+            if (!take(length)) {
+                return "";
+            }
+            string text(reinterpret_cast<const char*>(data + position), length);
+            position += length;
+            return text;
+        }
+        
+        // True if every read succeeded and the whole payload was consumed
+        bool isComplete() const {
+            return !failed && position == size;
+        }
+    };
+    
+    RestaurantMenuSystem& menuSystem;
+    RestaurantInventorySystem& inventory;
+    string socketPath;
+    int listenFd;
+    Connection* connections[MAX_CONNECTIONS];
+    int connectionCount;
+    long long requestsHandled;
+    long long responseWrites;
+    
+    static volatile sig_atomic_t stopRequested;
+    
+    static void onStopSignal(int) {
+        stopRequested = 1;
+    }
+    
+    // Encoding helpers, appending to a response
+    static void putU8(string& out, uint8_t value) {
+        out += (char)value;
+    }
+    
+    static void putU32(string& out, uint32_t value) {
+        out += (char)(value >> 24);
+        out += (char)(value >> 16);
+        out += (char)(value >> 8);
+        out += (char)value;
+    }
+    
+    static void putU64(string& out, uint64_t value) {
+        putU32(out, (uint32_t)(value >> 32));
+        putU32(out, (uint32_t)value);
+    }
+    
+    static void putDouble(string& out, double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        putU64(out, bits);
+    }
+    
+    static void putString(string& out, const string& text) {
+        size_t length = (text.length() < 0xFFFF) ? text.length() : 0xFFFF;
+        out += (char)(length >> 8);
+        out += (char)length;
+        out.append(text, 0, length);
+    }
+    
+    // Starts a response frame; finishResponse fills in its length once the payload is written
+    static size_t beginResponse(string& out, Status status, uint32_t requestId) {
+        size_t start = out.length();
+        putU32(out, 0);
+        putU8(out, (uint8_t)status);
+        putU32(out, requestId);
+        return start;
+    }
+    
+    static void finishResponse(string& out, size_t start) {
+        uint32_t length = (uint32_t)(out.length() - start - 4);
+        out[start] = (char)(length >> 24);
+        out[start + 1] = (char)(length >> 16);
+        out[start + 2] = (char)(length >> 8);
+        out[start + 3] = (char)length;
+    }
+    
+    // Writes a response that carries only a status (and an optional message)
+    static void respond(string& out, Status status, uint32_t requestId, const string& message = "") {
+        size_t start = beginResponse(out, status, requestId);
+        if (!message.empty()) {
+            putString(out, message);
+        }
+        finishResponse(out, start);
+    }
+    
+    // Runs one request and appends its response
+    void handleRequest(string& out, uint8_t op, uint32_t requestId, PayloadReader& payload) {
+        requestsHandled++;
+        
+        switch (op) {
+            case OP_PING: {
+                if (!payload.isComplete()) break;
+                respond(out, STATUS_OK, requestId);
+                return;
+            }
+            case OP_LOOKUP: {
+                ItemID id = payload.readString();
+                if (!payload.isComplete()) break;
                 
-                // Check if the menu item exists
-                MenuItem* existingItem = menuSystem.findMenuItem(id);
-                if (existingItem == nullptr) {
-                    cout << "\nError: Menu item with ID " << id << " not found." << endl;
-                } else {
-                    // Confirm deletion
-                    char confirm;
-                    cout << "Are you sure you want to remove \"" << existingItem->name << "\"? (Y/N): ";
-                    cin >> confirm;
-                    
-                    if (toupper(confirm) == 'Y') {
-                        if (menuSystem.removeMenuItem(id)) {
-                            cout << "\nMenu item removed successfully!" << endl;
-                            
-                            // Save to file after removing
-                            if (!menuSystem.saveToFile("menu_items.txt")) {
-                                cout << "Warning: Failed to save menu changes to file." << endl;
-                            }
-                        } else {
-                            cout << "\nFailed to remove menu item." << endl;
-                        }
-                    } else {
-                        cout << "\nDeletion cancelled." << endl;
-                    }
-                    
-                    delete existingItem;
+                // One view answers everything: it holds the bucket version it was read from,
+                // so the fields and both counts describe the same moment
+                FoodItemView item = inventory.findFoodItem(id);
+                if (item.isNull()) {
+                    respond(out, STATUS_NOT_FOUND, requestId);
+                    return;
                 }
-                
-                cout << "\nPress any key to continue...";
-                getch();
-                break;
+                size_t start = beginResponse(out, STATUS_OK, requestId);
+                putString(out, item.firstBatch->name);
+                putDouble(out, item.firstBatch->price);
+                putString(out, item.firstBatch->category);
+                putU32(out, (uint32_t)item.totalQuantity);
+                putU32(out, (uint32_t)item.batchCount);
+                finishResponse(out, start);
+                return;
             }
-            case 11: {
-                RestaurantInventorySystem::clearScreen();
-                string id, purpose;
-                cout << "==== Prepare Menu Item ====" << endl;
-                
-                // Display available menu items
-                menuSystem.displayAll();
+            case OP_CONSUME: {
+                ItemID id = payload.readString();
+                uint32_t amount = payload.readU32();
+                string purpose = payload.readString();
+                if (!payload.isComplete() || amount == 0 || amount > 0x7FFFFFFF) break;
                 
-                cout << "\nEnter ID of menu item to prepare: ";
-                cin >> id;
-                cin.ignore();
+                // Consumes quietly and hands back the name for the log and the stock left by this
+                // very change, so the answer cannot include another terminal's use
+                string name;
+                int remaining = 0;
+                UseResult result = inventory.consumeFoodItem(id, (int)amount, &remaining, &name);
+                if (result == USE_NOT_FOUND) {
+                    respond(out, STATUS_NOT_FOUND, requestId);
+                    return;
+                }
+                if (result == USE_OUT_OF_STOCK) {
+                    respond(out, STATUS_REJECTED, requestId, "Error: " + name + " (ID " + id.toString() + ") is out of stock.");
+                    return;
+                }
+                if (result == USE_NOT_ENOUGH) {
+                    respond(out, STATUS_REJECTED, requestId,
+                            "Error: Not enough quantity available. Only " + to_string(remaining) +
+                            " units of " + name + " in stock.");
+                    return;
+                }
+                inventory.logItemUsage(id, name, (int)amount, purpose);
                 
-                cout << "Enter purpose (e.g., Customer Order): ";
-                getline(cin, purpose);
+                size_t start = beginResponse(out, STATUS_OK, requestId);
+                putU32(out, (uint32_t)remaining);
+                finishResponse(out, start);
+                return;
+            }
+            case OP_PREPARE: {
+                ItemID id = payload.readString();
+                string purpose = payload.readString();
+                if (!payload.isComplete()) break;
                 
-                if (menuSystem.prepareMenuItem(id, inventory, purpose)) {
-                    cout << "\nMenu item prepared successfully!" << endl;
-                    
-                    // Save inventory changes to file
-                    if (!inventory.saveToFile("food_items.txt")) {
-                        cout << "Warning: Failed to save inventory changes to file." << endl;
+                if (menuSystem.findMenuItem(id) == nullptr) {
+                    respond(out, STATUS_NOT_FOUND, requestId);
+                    return;
+                }
+                string message;
+                bool prepared = menuSystem.prepareOrder(id, inventory, purpose, message);
+                respond(out, prepared ? STATUS_OK : STATUS_REJECTED, requestId, message);
+                return;
+            }
+            case OP_SEARCH: {
+                string query = payload.readString();
+                if (!payload.isComplete()) break;
+                
+                // Each bucket holds the batches of one ID, so one pass over the buckets gives per-ID totals
+                // Names match case-insensitively, like the console's search by name
+                string queryLower = RestaurantInventorySystem::lowerCaseName(query);
+                InventorySnapshot snapshot = inventory.takeSnapshot();
+                size_t start = beginResponse(out, STATUS_OK, requestId);
+                size_t countPosition = out.length();
+                putU32(out, 0);
+                uint32_t matches = 0;
+                for (int b = 0; b < snapshot.getBucketCount(); b++) {
+                    const ADTLinkedQueue& bucket = snapshot.getBucket(b);
+                    if (bucket.isEmpty()) continue;
+                    
+                    const FoodItem& first = *bucket.begin();
+                    if (!RestaurantInventorySystem::nameMatches(first.name, queryLower)) continue;
+                    
+                    int total = 0;
+                    for (const FoodItem& item : bucket) {
+                        total += item.quantity;
                     }
+                    putString(out, first.id.toString());
+                    putString(out, first.name);
+                    putU32(out, (uint32_t)total);
+                    matches++;
                 }
-                
-                cout << "\nPress any key to continue...";
-                getch();
-                break;
+                string count;
+                putU32(count, matches);
+                out.replace(countPosition, 4, count);
+                finishResponse(out, start);
+                return;
             }
-            case 12: {
-                RestaurantInventorySystem::clearScreen();
-                string id;
-                cout << "==== Check Ingredients Availability ====" << endl;
-                
-                // Display available menu items
-                menuSystem.displayAll();
+            case OP_LIST: {
+                uint8_t key = payload.readU8();
+                uint32_t limit = payload.readU32();
+                if (!payload.isComplete() || key > SORT_BY_DATE) break;
                 
-                cout << "\nEnter ID of menu item to check: ";
-                cin >> id;
-                
-                bool available = menuSystem.checkIngredientsAvailability(id, inventory);
-                if (available) {
-                    cout << "\nAll ingredients are available for this menu item." << endl;
+                InventorySnapshot snapshot = inventory.takeSnapshot();
+                int total = snapshot.getBatchCount();
+                FoodItem* items = inventory.copyAllItems(snapshot);
+                if (items != nullptr) {
+                    RestaurantInventorySystem::timSort(items, total, (FoodSortKey)key);
                 }
-                
-                cout << "\nPress any key to continue...";
-                getch();
-                break;
+                uint32_t count = (limit == 0 || limit > (uint32_t)total) ? (uint32_t)total : limit;
+                
+                size_t start = beginResponse(out, STATUS_OK, requestId);
+                putU32(out, items != nullptr ? count : 0);
+                for (uint32_t i = 0; items != nullptr && i < count; i++) {
+                    putString(out, items[i].id.toString());
+                    putString(out, items[i].name);
+                    putDouble(out, items[i].price);
+                    putU32(out, (uint32_t)items[i].quantity);
+                    putU64(out, (uint64_t)items[i].receiveDate);
+                }
+                finishResponse(out, start);
+                delete[] items;
+                return;
             }
-            case 13: {
-                RestaurantInventorySystem::clearScreen();
-                string id;
-                cout << "==== Display Menu Item Details ====" << endl;
-                
-                // Display available menu items
-                menuSystem.displayAll();
-                
-                cout << "\nEnter ID of menu item to display: ";
-                cin >> id;
-                
-                menuSystem.displayMenuItem(id, inventory);
-                
-                cout << "\nPress any key to continue...";
-                getch();
-                break;
+        }
+        
+        respond(out, STATUS_BAD_REQUEST, requestId);
+    }
+    
+    // Parses and runs every complete frame in the connection's input
+    // Returns: false if the client sent a frame that cannot be parsed (the connection is closed)
+    bool processInput(Connection& connection) {
+        size_t position = 0;
+        const string& input = connection.input;
+        
+        while (input.length() - position >= 4) {
+            const unsigned char* header = reinterpret_cast<const unsigned char*>(input.data() + position);
+            uint32_t length = ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) |
+                              ((uint32_t)header[2] << 8) | (uint32_t)header[3];
+            if (length < 5 || length > MAX_FRAME) {
+                return false;
             }
-            case 0:
-                cout << "Returning to main menu..." << endl;
-                break;
-            default:
-                cout << "Invalid choice. Please try again." << endl;
-                cout << "\nPress any key to continue...";
-                getch();
+            if (input.length() - position - 4 < length) {
+                break; // Frame not complete yet
+            }
+            
+            const char* frame = input.data() + position + 4;
+            PayloadReader frameHeader(frame, 5);
+            uint8_t op = frameHeader.readU8();
+            uint32_t requestId = frameHeader.readU32();
+            PayloadReader payload(frame + 5, length - 5);
+            handleRequest(connection.output, op, requestId, payload);
+            
+            position += 4 + length;
         }
-    } while (menuChoice != 0);
-}
-
-/**
- * Handle food and menu management functionality
- * @param menuSystem Reference to the menu system to manage
- * @param inventory Reference to the inventory system for ingredient validation
- */
-void manageAll(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inventory) {
-    int menuChoice;
-    do {
-        // Display menu management options
-        RestaurantInventorySystem::clearScreen();
-        cout << "\n==== All Management ====" << endl;
         
-        cout << "1. Inventory Management" << endl;
-        cout << "2. Menu Management" << endl;
-        cout << "0. Back to Main Menu" << endl;
+        connection.input.erase(0, position);
+        return true;
+    }
+    
+    // Sends as much pending output as the socket takes
+    // Returns: false if the connection failed
+    bool flushOutput(Connection& connection) {
+        while (connection.outputSent < connection.output.length()) {
+            ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent,
+                                connection.output.length() - connection.outputSent, 0);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            connection.outputSent += (size_t)sent;
+            responseWrites++;
+        }
+        connection.output.clear();
+        connection.outputSent = 0;
+        return true;
+    }
+    
+    void closeConnection(int index) {
+        close(connections[index]->fd);
+        delete connections[index];
+        connections[index] = connections[--connectionCount];
+    }
+    
+    void acceptConnection() {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        if (connectionCount == MAX_CONNECTIONS || fd >= FD_SETSIZE) {
+            close(fd);
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
         
-        cout << "\nEnter your choice: ";
-        cin >> menuChoice;
+        Connection* connection = new Connection();
+        connection->fd = fd;
+        connection->outputSent = 0;
+        connections[connectionCount++] = connection;
+    }
+    
+    // Reads what the client sent, runs the complete frames and sends all their responses at once
+    // Returns: false if the connection should be closed
+    bool serviceConnection(Connection& connection) {
+        char buffer[READ_CHUNK];
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received == 0) {
+            return false; // Client closed the connection
+        }
+        if (received < 0) {
+            return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+        }
         
-        // Process menu management submenu selection
-        switch (menuChoice) {
-            case 1: {
-                manageInventory(inventory);
-                break;
+        connection.input.append(buffer, (size_t)received);
+        if (!processInput(connection)) {
+            return false;
+        }
+        return flushOutput(connection);
+    }
+
+public:
+    // Constructor - the server is not listening until run is called
+    InventoryServer(RestaurantMenuSystem& _menuSystem, RestaurantInventorySystem& _inventory, const string& path)
+        : menuSystem(_menuSystem), inventory(_inventory), socketPath(path), listenFd(-1),
+          connectionCount(0), requestsHandled(0), responseWrites(0) {}
+    
+    ~InventoryServer() {
+        while (connectionCount > 0) {
+            closeConnection(connectionCount - 1);
+        }
+        if (listenFd != -1) {
+            close(listenFd);
+            unlink(socketPath.c_str());
+        }
+    }
+    
+    InventoryServer(const InventoryServer&) = delete;
+    InventoryServer& operator=(const InventoryServer&) = delete;
+    
+    /**
+     * Listens on the socket and serves clients until SIGINT or SIGTERM
+     * Return: 0 after a clean shutdown, 1 if the socket could not be set up
+     */
+    int run() {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socketPath.empty() || socketPath.length() >= sizeof(address.sun_path)) {
+            cout << "Error: Socket path must be 1-" << sizeof(address.sun_path) - 1 << " characters" << endl;
+            return 1;
+        }
+        socketPath.copy(address.sun_path, socketPath.length());
+        
+        listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenFd < 0) {
+            cout << "Error: Could not create socket: " << strerror(errno) << endl;
+            return 1;
+        }
+        unlink(socketPath.c_str()); // Remove a socket file left behind by an earlier run
+        if (bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 64) != 0) {
+            cout << "Error: Could not listen on " << socketPath << ": " << strerror(errno) << endl;
+            close(listenFd);
+            listenFd = -1;
+            return 1;
+        }
+        
+        stopRequested = 0;
+        signal(SIGINT, onStopSignal);
+        signal(SIGTERM, onStopSignal);
+        signal(SIGPIPE, SIG_IGN);
+        cout << "Serving inventory and menu on " << socketPath << " (Ctrl+C to stop)" << endl;
+        
+        while (!stopRequested) {
+            fd_set readable;
+            fd_set writable;
+            FD_ZERO(&readable);
+            FD_ZERO(&writable);
+            FD_SET(listenFd, &readable);
+            int highest = listenFd;
+            for (int i = 0; i < connectionCount; i++) {
+                Connection& connection = *connections[i];
+                // A client with a large backlog of unread responses is not read from until it catches up
+                if (connection.output.length() - connection.outputSent < MAX_PENDING_OUTPUT) {
+                    FD_SET(connection.fd, &readable);
+                }
+                if (connection.outputSent < connection.output.length()) {
+                    FD_SET(connection.fd, &writable);
+                }
+                if (connection.fd > highest) {
+                    highest = connection.fd;
+                }
             }
-            case 2: {
-                manageMenu(menuSystem, inventory);
-                break;
+            
+            // Wake up regularly to notice a stop request
+            timeval timeout;
+            timeout.tv_sec = 0;
+            timeout.tv_usec = 200 * 1000;
+            int ready = select(highest + 1, &readable, &writable, NULL, &timeout);
+            if (ready <= 0) {
+                continue;
+            }
+            
+            if (FD_ISSET(listenFd, &readable)) {
+                acceptConnection();
+            }
+            for (int i = connectionCount - 1; i >= 0; i--) {
+                Connection& connection = *connections[i];
+                bool open = true;
+                if (FD_ISSET(connection.fd, &writable)) {
+                    open = flushOutput(connection);
+                }
+                if (open && FD_ISSET(connection.fd, &readable)) {
+                    open = serviceConnection(connection);
+                }
+                if (!open) {
+                    closeConnection(i);
+                }
             }
-            case 0:
-                cout << "Returning to main menu..." << endl;
-                break;
-            default:
-                cout << "Invalid choice. Please try again." << endl;
-                cout << "\nPress any key to continue...";
-                getch();
         }
-    } while (menuChoice != 0);
-}
+        
+        cout << "\nServer stopped: " << requestsHandled << " requests answered with "
+             << responseWrites << " writes" << endl;
+        return 0;
+    }
+};
+
+volatile sig_atomic_t InventoryServer::stopRequested = 0;
+#endif
 
 /**
  * Main function - Entry point of the Restaurant Management System
@@ -4927,7 +2715,67 @@ void manageAll(RestaurantMenuSystem& menuSystem, RestaurantInventorySystem& inve
  * and provides the main navigation menu for the entire system
  * Return: 0 on successful program execution
  */
-int main() {
+int main(int argc, char* argv[]) {
+    // Self-check for the thread-safe inventory, runs without touching any data files
+    if (argc > 1 && string(argv[1]) == "--stress-test") {
+        return runInventoryStressTest();
+    }
+    if (argc > 1 && string(argv[1]) == "--usage-log-test") {
+        return runUsageLogTest();
+    }
+    if (argc > 1 && string(argv[1]) == "--servings-test") {
+        return runServingsTest();
+    }
+    
+    // Optional modes:
+    //   --shared-inventory [name]  share one live inventory between all terminal processes on this machine
+    //   --server <socket path>     serve the inventory and menu on a Unix domain socket instead of the console
+    //   --batch <file|->           run a command script (or stdin) without prompts and report timings
+    //   --latency-interval <secs>  how often latency_stats.json is rewritten (default 60, 0 = never)
+    //   --trace <file>             record trace spans from start to exit into a Chrome trace file
+    //   --sync-usage-log           sync usage_history.txt to disk after every group of records
+    string sharedInventoryName = "";
+    string serverSocketPath = "";
+    string batchScript = "";
+    int latencyInterval = 60;
+    bool syncUsageLog = false;
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--shared-inventory") {
+            sharedInventoryName = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : "restaurant_inventory";
+        } else if (option == "--server" && i + 1 < argc) {
+            serverSocketPath = argv[++i];
+        } else if (option == "--batch" && i + 1 < argc) {
+            batchScript = argv[++i];
+        } else if (option == "--latency-interval" && i + 1 < argc) {
+            latencyInterval = atoi(argv[++i]);
+        } else if (option == "--trace" && i + 1 < argc) {
+            TraceRecorder::start(argv[++i]);
+        } else if (option == "--sync-usage-log") {
+            syncUsageLog = true;
+        }
+    }
+    
+    // Writes the trace file of a recording still running when main returns (declared before the
+    // engines so the spans of their shutdown are included)
+    struct TraceFileGuard {
+        ~TraceFileGuard() {
+            if (TraceRecorder::isRecording()) {
+                TraceRecorder::stop();
+            }
+        }
+    } traceFileGuard;
+    
+#ifndef RESTAURANT_NO_LATENCY_STATS
+    // Keep latency_stats.json current while the program runs; it is written once more on exit
+    unique_ptr<LatencyDumpThread> latencyDump;
+    if (latencyInterval > 0) {
+        latencyDump.reset(new LatencyDumpThread("latency_stats.json", latencyInterval));
+    }
+#else
+    (void)latencyInterval;   // Latency statistics are compiled out
+#endif
+    
     // This program has been optimized with the following algorithms:
     // 1. Tim Sort - A hybrid sorting algorithm combining merge sort and insertion sort
     //    with average time complexity of O(n log n), better than bubble sort's O(n²)
@@ -4943,9 +2791,10 @@ int main() {
     // Initialize the core systems of the application
     // Inventory system uses hash table with queues for FIFO item tracking
     RestaurantInventorySystem inventory;    // Manages food ingredients inventory
-    // Menu system uses linked list for flexible menu item management
+    // Menu system uses a contiguous store with stable handles and an ID index
     RestaurantMenuSystem menuSystem;        // Manages restaurant menu items
     int choice;                             // Stores user menu selection
+    inventory.setUsageLogSync(syncUsageLog);
     
     // Data initialization phase - Load existing data or create sample data
     // This approach ensures data persistence between application runs
@@ -4981,6 +2830,28 @@ int main() {
         }
     }
     
+    // Join the shared inventory: the first process publishes what it loaded, the others adopt it
+    if (!sharedInventoryName.empty() && !inventory.attachSharedSegment(sharedInventoryName)) {
+        cout << "Warning: Continuing with a local inventory." << endl;
+    }
+    
+    // Watch the stock against the reorder thresholds; without a thresholds file every item
+    // alerts once it runs out
+    ifstream thresholdsFile("reorder_thresholds.txt");
+    if (thresholdsFile.is_open()) {
+        thresholdsFile.close();
+        inventory.loadReorderThresholds("reorder_thresholds.txt");
+    }
+    inventory.trackReorderLevels();
+    
+    // Tell whoever made the change when an item reaches its threshold (also kept in stock_alerts.txt)
+    inventory.addLowStockAlert([](const ReorderLevel& level, const string& name, bool low) {
+        if (low) {
+            engineOut() << "Reorder alert: " << level.id << " " << name << " is down to " << level.stock 
+                 << " (reorder threshold " << level.threshold << ")" << endl;
+        }
+    });
+    
     // Try to load menu items from file
     // If loading fails, create sample menu data with references to inventory items
     if (!menuSystem.loadFromFile("menu_items.txt")) {
@@ -5018,10 +2889,40 @@ int main() {
         }
     }
     
+    // Keep the servings of every menu item current as stock is received and used
+    menuSystem.trackServings(inventory);
+    
+    // Batch mode: no login, commands come from the script
+    if (!batchScript.empty()) {
+        BatchCommandRunner runner(menuSystem, inventory);
+        if (batchScript == "-") {
+            return runner.run(cin);
+        }
+        ifstream script(batchScript);
+        if (!script.is_open()) {
+            cout << "Error: Could not open file " << batchScript << endl;
+            return 1;
+        }
+        return runner.run(script);
+    }
+    
+    // Headless server mode: no login, clients talk to the engines over the socket
+    if (!serverSocketPath.empty()) {
+#ifdef _WIN32
+        cout << "Error: --server needs Unix domain sockets and is not available in this build." << endl;
+        return 1;
+#else
+        InventoryServer server(menuSystem, inventory, serverSocketPath);
+        int status = server.run();
+        inventory.saveToFile("food_items.txt");
+        return status;
+#endif
+    }
+    
     // First check for authentication
     do {
         // Clear screen for better UI experience
-        RestaurantInventorySystem::clearScreen();
+        clearScreen();
         
         // Check if user is already authenticated
         if (!isAuthenticated) {
@@ -5236,7 +3137,7 @@ int main() {
         }
         
         // Display main navigation menu with role-specific options
-        RestaurantInventorySystem::clearScreen();
+        clearScreen();
         cout << "\n==== Restaurant Management System ====" << endl;
         cout << "Logged in as: " << authManager.getCurrentUsername() << 
             (authManager.isAdminLoggedIn() ? " (Admin)" : " (Staff)") << endl;
@@ -5285,7 +3186,7 @@ int main() {
                 
             case 2:
                 // Logout functionality
-                RestaurantInventorySystem::clearScreen();
+                clearScreen();
                 cout << "==== Logout ====" << endl;
                 cout << "Logging out user: " << authManager.getCurrentUsername() << endl;
                 
@@ -0,0 +1,9568 @@
+#ifndef RESTAURANT_CORE_H
+#define RESTAURANT_CORE_H
+
+// Restaurant engine core: inventory, menu, accounts, sorting and searching
+// Header-only and free of console input, so the console app, the benchmarks and other
+// front ends can all include it. Engine messages and reports go to Restaurant::getOutput().
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <ctime>
+#include <cstdlib>
+#include <cmath>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <chrono>
+#include <memory>
+#include <condition_variable>
+#include <exception>
+#ifdef _WIN32
+#include <io.h>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// Target of engine output, the console until Restaurant::setOutput is called
+inline ostream*& engineOutputTarget() {
+    static ostream* target = &cout;
+    return target;
+}
+
+// Stream every engine message and report is written to
+inline ostream& engineOut() {
+    return *engineOutputTarget();
+}
+
+/**
+ * Memory accounting tags, one per subsystem
+ * Every tracked allocation is charged to exactly one of these
+ */
+enum MemoryTag {
+    MEM_INVENTORY,      // Hash table buckets and queue nodes
+    MEM_MENU,           // Menu store arrays, ID index and spilled ingredient lists
+    MEM_AUTH,           // Staff and admin account objects
+    MEM_SORT_SCRATCH,   // Temporary arrays and buffers used by sorting and reports
+    MEM_IO_BUFFERS,     // File stream buffers used when loading and saving
+    MEM_ORDER_QUEUE,    // Kitchen order intake ring buffer
+    MEM_SCHEDULER,      // Task scheduler work deques
+    MEM_TRACE,          // Trace events waiting to be written
+    MEM_TAG_COUNT       // Number of tags (not a real tag)
+};
+
+/**
+ * MemoryTracker keeps per-subsystem allocation statistics
+ * Tracks current bytes, peak bytes, and allocation/free counts for each MemoryTag.
+ * Counters are atomic so they stay correct if allocations happen on several threads.
+ * Only memory allocated through the tracked paths is counted: character buffers owned
+ * by std::string and copies handed to callers (e.g. copyMenuItem) are not included.
+ */
+class MemoryTracker {
+private:
+    struct Counters {
+        atomic<long long> currentBytes;
+        atomic<long long> peakBytes;
+        atomic<long long> allocations;
+        atomic<long long> frees;
+    };
+    
+    // Counter storage, zero-initialized before any allocation is recorded
+    // (function-local so the header can be included from several source files)
+    static Counters* counters() {
+        static Counters table[MEM_TAG_COUNT];
+        return table;
+    }
+
+public:
+    // Records an allocation of the given size against a subsystem
+    static void recordAllocation(MemoryTag tag, size_t bytes) {
+        Counters& c = counters()[tag];
+        long long current = c.currentBytes.fetch_add((long long)bytes) + (long long)bytes;
+        c.allocations.fetch_add(1);
+        
+        // Raise the peak if this allocation set a new high-water mark
+        long long peak = c.peakBytes.load();
+        while (current > peak && !c.peakBytes.compare_exchange_weak(peak, current)) {
+        }
+    }
+    
+    // Records that memory previously recorded with recordAllocation was freed
+    static void recordFree(MemoryTag tag, size_t bytes) {
+        counters()[tag].currentBytes.fetch_sub((long long)bytes);
+        counters()[tag].frees.fetch_add(1);
+    }
+    
+    // Allocates a tracked array of count elements
+    template <typename T>
+    static T* allocateArray(MemoryTag tag, size_t count) {
+        T* array = new T[count];
+        recordAllocation(tag, count * sizeof(T));
+        return array;
+    }
+    
+    // Frees an array allocated with allocateArray, count must match the allocation
+    template <typename T>
+    static void freeArray(MemoryTag tag, T* array, size_t count) {
+        if (array != nullptr) {
+            delete[] array;
+            recordFree(tag, count * sizeof(T));
+        }
+    }
+    
+    // Getters for the statistics of one subsystem
+    static long long getCurrentBytes(MemoryTag tag) { return counters()[tag].currentBytes.load(); }
+    static long long getPeakBytes(MemoryTag tag) { return counters()[tag].peakBytes.load(); }
+    static long long getAllocationCount(MemoryTag tag) { return counters()[tag].allocations.load(); }
+    static long long getFreeCount(MemoryTag tag) { return counters()[tag].frees.load(); }
+    
+    // Lowers every peak to the current usage, so the next high-water mark can be measured
+    static void resetPeaks() {
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            counters()[i].peakBytes.store(counters()[i].currentBytes.load());
+        }
+    }
+    
+    // Returns the display name of a subsystem
+    static const char* getTagName(MemoryTag tag) {
+        switch (tag) {
+            case MEM_INVENTORY:    return "inventory";
+            case MEM_MENU:         return "menu";
+            case MEM_AUTH:         return "auth";
+            case MEM_SORT_SCRATCH: return "sort_scratch";
+            case MEM_IO_BUFFERS:   return "io_buffers";
+            case MEM_ORDER_QUEUE:  return "order_queue";
+            case MEM_SCHEDULER:    return "scheduler";
+            case MEM_TRACE:        return "trace";
+            default:               return "unknown";
+        }
+    }
+    
+    // Displays the statistics of all subsystems as a table
+    static void displayReport() {
+        engineOut() << string(100, '=') << endl;
+        engineOut() << setw(35) << " " << "Memory Usage by Subsystem" << endl;
+        engineOut() << string(100, '=') << endl;
+        engineOut() << left << setw(20) << "Subsystem" 
+             << setw(20) << "Current (bytes)" 
+             << setw(20) << "Peak (bytes)" 
+             << setw(20) << "Allocations" 
+             << setw(20) << "Frees" << endl;
+        engineOut() << string(100, '-') << endl;
+        
+        long long totalCurrent = 0;
+        long long totalAllocations = 0;
+        long long totalFrees = 0;
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            MemoryTag tag = (MemoryTag)i;
+            engineOut() << left << setw(20) << getTagName(tag) 
+                 << setw(20) << getCurrentBytes(tag) 
+                 << setw(20) << getPeakBytes(tag) 
+                 << setw(20) << getAllocationCount(tag) 
+                 << setw(20) << getFreeCount(tag) << endl;
+            totalCurrent += getCurrentBytes(tag);
+            totalAllocations += getAllocationCount(tag);
+            totalFrees += getFreeCount(tag);
+        }
+        
+        engineOut() << string(100, '-') << endl;
+        engineOut() << left << setw(20) << "total" 
+             << setw(20) << totalCurrent 
+             << setw(20) << "-" 
+             << setw(20) << totalAllocations 
+             << setw(20) << totalFrees << endl;
+        engineOut() << "\nNote: string contents and caller-owned copies are not included." << endl;
+    }
+    
+    // Writes the statistics of all subsystems as JSON for scripts and monitoring
+    // Returns: true if the file was written, false if it could not be opened
+    static bool saveToFile(const string& filename) {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for writing" << endl;
+            return false;
+        }
+        
+        file << "{" << endl;
+        file << "  \"timestamp\": " << (long long)time(0) << "," << endl;
+        file << "  \"subsystems\": {" << endl;
+        for (int i = 0; i < MEM_TAG_COUNT; i++) {
+            MemoryTag tag = (MemoryTag)i;
+            file << "    \"" << getTagName(tag) << "\": {"
+                 << "\"current_bytes\": " << getCurrentBytes(tag) << ", "
+                 << "\"peak_bytes\": " << getPeakBytes(tag) << ", "
+                 << "\"allocations\": " << getAllocationCount(tag) << ", "
+                 << "\"frees\": " << getFreeCount(tag) << "}"
+                 << (i < MEM_TAG_COUNT - 1 ? "," : "") << endl;
+        }
+        file << "  }" << endl;
+        file << "}" << endl;
+        
+        file.close();
+        return true;
+    }
+};
+
+
+/**
+ * Operations whose latency is recorded, one histogram each
+ * Build with -DRESTAURANT_NO_LATENCY_STATS to compile the instrumentation out entirely
+ */
+enum LatencyOp {
+    LAT_FIND_FOOD,        // RestaurantInventorySystem::findFoodItem
+    LAT_USE_FOOD,         // RestaurantInventorySystem::useFoodItem
+    LAT_USE_ORDER,        // RestaurantInventorySystem::useFoodItems (all-or-nothing order)
+    LAT_INVENTORY_LOAD,   // RestaurantInventorySystem::loadFromFile
+    LAT_INVENTORY_SAVE,   // RestaurantInventorySystem::saveToFile
+    LAT_MENU_CHECK,       // RestaurantMenuSystem::checkIngredientsAvailability
+    LAT_MENU_PREPARE,     // RestaurantMenuSystem::prepareMenuItem
+    LAT_MENU_ORDER,       // RestaurantMenuSystem::prepareOrder (kitchen, server and batch orders)
+    LAT_MENU_SAVE,        // RestaurantMenuSystem::saveToFile
+    LAT_OP_COUNT          // Number of operations (not a real operation)
+};
+
+#ifndef RESTAURANT_NO_LATENCY_STATS
+
+/**
+ * LatencyHistogram counts latencies in nanoseconds with HDR-style log-linear buckets
+ * Values below 64 ns get a bucket each; above that every power of two is split into 32
+ * buckets, so any recorded value is known to within about 3% up to 2^48 ns (78 hours).
+ * Recording is a few relaxed atomic adds, so any thread can record without a lock.
+ */
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;                     // Buckets per power of two
+    static const int LINEAR_LIMIT = 2 * SUB_BUCKETS;                         // Values below this are exact
+    static const int MAX_BITS = 48;                                          // Largest value is 2^48 - 1
+    static const int BUCKET_COUNT = LINEAR_LIMIT + (MAX_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKETS;
+
+private:
+    atomic<unsigned long long> counts[BUCKET_COUNT];
+    atomic<unsigned long long> totalCount;
+    atomic<unsigned long long> totalNanos;
+    atomic<unsigned long long> maxNanos;
+
+    // Position of the highest set bit of a non-zero value
+    static int highestBit(unsigned long long value) {
+        int bit = 0;
+        if (value >> 32) { value >>= 32; bit += 32; }
+        if (value >> 16) { value >>= 16; bit += 16; }
+        if (value >> 8)  { value >>= 8;  bit += 8; }
+        if (value >> 4)  { value >>= 4;  bit += 4; }
+        if (value >> 2)  { value >>= 2;  bit += 2; }
+        if (value >> 1)  { bit += 1; }
+        return bit;
+    }
+
+public:
+    // Histograms live in static storage, which starts zeroed
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Returns the bucket that counts a value
+    static int bucketOf(unsigned long long nanos) {
+        if (nanos < (unsigned long long)LINEAR_LIMIT) {
+            return (int)nanos;
+        }
+        int bit = highestBit(nanos);
+        if (bit >= MAX_BITS) {
+            return BUCKET_COUNT - 1;
+        }
+        int shift = bit - SUB_BUCKET_BITS;
+        int subBucket = (int)(nanos >> shift) - SUB_BUCKETS;
+        return LINEAR_LIMIT + (bit - SUB_BUCKET_BITS - 1) * SUB_BUCKETS + subBucket;
+    }
+
+    // Returns the largest value counted by a bucket
+    static unsigned long long bucketUpperBound(int bucket) {
+        if (bucket < LINEAR_LIMIT) {
+            return (unsigned long long)bucket;
+        }
+        int bit = (bucket - LINEAR_LIMIT) / SUB_BUCKETS + SUB_BUCKET_BITS + 1;
+        int subBucket = (bucket - LINEAR_LIMIT) % SUB_BUCKETS;
+        int shift = bit - SUB_BUCKET_BITS;
+        return (((unsigned long long)(SUB_BUCKETS + subBucket + 1)) << shift) - 1;
+    }
+
+    // Records one operation that took the given time
+    void record(unsigned long long nanos) {
+        counts[bucketOf(nanos)].fetch_add(1, memory_order_relaxed);
+        totalCount.fetch_add(1, memory_order_relaxed);
+        totalNanos.fetch_add(nanos, memory_order_relaxed);
+        
+        unsigned long long highest = maxNanos.load(memory_order_relaxed);
+        while (nanos > highest && !maxNanos.compare_exchange_weak(highest, nanos, memory_order_relaxed)) {
+        }
+    }
+
+    // Getters for the totals
+    unsigned long long getCount() const { return totalCount.load(memory_order_relaxed); }
+    unsigned long long getMax() const { return maxNanos.load(memory_order_relaxed); }
+    double getMean() const {
+        unsigned long long count = getCount();
+        return (count == 0) ? 0.0 : (double)totalNanos.load(memory_order_relaxed) / count;
+    }
+
+    // Returns the latency that the given fraction of operations did not exceed (0.5 = median)
+    // The result is the upper bound of its bucket, capped at the largest recorded value
+    // Counts keep changing while other threads record, so a percentile is approximate by a few operations
+    unsigned long long getPercentile(double fraction) const {
+        unsigned long long total = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            total += counts[i].load(memory_order_relaxed);
+        }
+        if (total == 0) {
+            return 0;
+        }
+        
+        // Rank of the operation we are looking for (1-based), found by walking the buckets
+        unsigned long long rank = (unsigned long long)(fraction * total + 0.999999);
+        if (rank < 1) rank = 1;
+        if (rank > total) rank = total;
+        unsigned long long seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts[i].load(memory_order_relaxed);
+            if (seen >= rank) {
+                unsigned long long bound = bucketUpperBound(i);
+                unsigned long long highest = getMax();
+                return (bound < highest) ? bound : highest;
+            }
+        }
+        return getMax();
+    }
+
+    // Clears all counts (operations in progress on other threads may still be recorded afterwards)
+    void reset() {
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            counts[i].store(0, memory_order_relaxed);
+        }
+        totalCount.store(0, memory_order_relaxed);
+        totalNanos.store(0, memory_order_relaxed);
+        maxNanos.store(0, memory_order_relaxed);
+    }
+};
+
+/**
+ * LatencyStats holds one histogram per LatencyOp and reports them
+ * Mirrors MemoryTracker: a table for the stats screen and a JSON file for scripts.
+ */
+class LatencyStats {
+private:
+    // Histogram storage (function-local so the header can be included from several source files)
+    static LatencyHistogram* histograms() {
+        static LatencyHistogram table[LAT_OP_COUNT];
+        return table;
+    }
+
+    // Formats nanoseconds as microseconds with two decimals
+    static string formatMicros(double nanos) {
+        ostringstream text;
+        text << fixed << setprecision(2) << nanos / 1000.0;
+        return text.str();
+    }
+
+public:
+    // Returns the histogram of an operation
+    static LatencyHistogram& get(LatencyOp op) {
+        return histograms()[op];
+    }
+
+    // Records one operation
+    static void record(LatencyOp op, unsigned long long nanos) {
+        histograms()[op].record(nanos);
+    }
+
+    // Clears every histogram
+    static void reset() {
+        for (int i = 0; i < LAT_OP_COUNT; i++) {
+            histograms()[i].reset();
+        }
+    }
+
+    // Returns the display name of an operation
+    static const char* getOpName(LatencyOp op) {
+        switch (op) {
+            case LAT_FIND_FOOD:      return "inventory.find";
+            case LAT_USE_FOOD:       return "inventory.use";
+            case LAT_USE_ORDER:      return "inventory.use_order";
+            case LAT_INVENTORY_LOAD: return "inventory.load";
+            case LAT_INVENTORY_SAVE: return "inventory.save";
+            case LAT_MENU_CHECK:     return "menu.check";
+            case LAT_MENU_PREPARE:   return "menu.prepare";
+            case LAT_MENU_ORDER:     return "menu.order";
+            case LAT_MENU_SAVE:      return "menu.save";
+            default:                 return "unknown";
+        }
+    }
+
+    // Displays count, percentiles and maximum of every operation in microseconds
+    static void displayReport() {
+        engineOut() << string(110, '=') << endl;
+        engineOut() << setw(38) << " " << "Operation Latency (microseconds)" << endl;
+        engineOut() << string(110, '=') << endl;
+        engineOut() << left << setw(22) << "Operation"
+             << setw(12) << "Count"
+             << setw(12) << "Mean"
+             << setw(12) << "p50"
+             << setw(12) << "p90"
+             << setw(12) << "p99"
+             << setw(14) << "p99.9"
+             << setw(14) << "Max" << endl;
+        engineOut() << string(110, '-') << endl;
+        
+        for (int i = 0; i < LAT_OP_COUNT; i++) {
+            const LatencyHistogram& histogram = get((LatencyOp)i);
+            engineOut() << left << setw(22) << getOpName((LatencyOp)i)
+                 << setw(12) << histogram.getCount();
+            if (histogram.getCount() == 0) {
+                engineOut() << "-" << endl;
+                continue;
+            }
+            engineOut() << setw(12) << formatMicros(histogram.getMean())
+                 << setw(12) << formatMicros((double)histogram.getPercentile(0.50))
+                 << setw(12) << formatMicros((double)histogram.getPercentile(0.90))
+                 << setw(12) << formatMicros((double)histogram.getPercentile(0.99))
+                 << setw(14) << formatMicros((double)histogram.getPercentile(0.999))
+                 << setw(14) << formatMicros((double)histogram.getMax()) << endl;
+        }
+        
+        engineOut() << string(110, '-') << endl;
+        engineOut() << "Note: percentiles are accurate to about 3%; counts cover every thread since startup." << endl;
+    }
+    
+    // Writes the statistics of every operation as JSON (all values in nanoseconds)
+    // Returns: true if the file was written, false if it could not be opened
+    static bool saveToFile(const string& filename) {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for writing" << endl;
+            return false;
+        }
+        
+        file << "{" << endl;
+        file << "  \"timestamp\": " << (long long)time(0) << "," << endl;
+        file << "  \"unit\": \"ns\"," << endl;
+        file << "  \"operations\": {" << endl;
+        for (int i = 0; i < LAT_OP_COUNT; i++) {
+            const LatencyHistogram& histogram = get((LatencyOp)i);
+            file << "    \"" << getOpName((LatencyOp)i) << "\": {"
+                 << "\"count\": " << histogram.getCount() << ", "
+                 << "\"mean\": " << (unsigned long long)histogram.getMean() << ", "
+                 << "\"p50\": " << histogram.getPercentile(0.50) << ", "
+                 << "\"p90\": " << histogram.getPercentile(0.90) << ", "
+                 << "\"p99\": " << histogram.getPercentile(0.99) << ", "
+                 << "\"p999\": " << histogram.getPercentile(0.999) << ", "
+                 << "\"max\": " << histogram.getMax() << "}"
+                 << (i < LAT_OP_COUNT - 1 ? "," : "") << endl;
+        }
+        file << "  }" << endl;
+        file << "}" << endl;
+        
+        file.close();
+        return true;
+    }
+};
+
+/**
+ * LatencyTimer records the time from its construction to its destruction
+ * Declare one at the top of an instrumented function with RESTAURANT_LATENCY_SCOPE,
+ * so every return path and exception is measured.
+ */
+class LatencyTimer {
+private:
+    LatencyOp op;
+    chrono::steady_clock::time_point start;
+
+public:
+    explicit LatencyTimer(LatencyOp _op) : op(_op), start(chrono::steady_clock::now()) {}
+
+    ~LatencyTimer() {
+        LatencyStats::record(op, (unsigned long long)
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+    }
+
+    LatencyTimer(const LatencyTimer&) = delete;
+    LatencyTimer& operator=(const LatencyTimer&) = delete;
+};
+
+/**
+ * LatencyDumpThread writes the latency statistics to a file at a fixed interval
+ * The file is also written once more when the thread is stopped, so it ends up complete.
+ */
+class LatencyDumpThread {
+private:
+    string filename;
+    int intervalSeconds;
+    bool stopping;
+    mutex lock;
+    condition_variable wake;
+    thread dumper;
+
+    // Thread body: sleep for the interval (or until stopped), then write the file
+    void dumpLoop() {
+        unique_lock<mutex> guard(lock);
+        while (!stopping) {
+            wake.wait_for(guard, chrono::seconds(intervalSeconds), [this]() { return stopping; });
+            guard.unlock();
+            LatencyStats::saveToFile(filename);
+            guard.lock();
+        }
+    }
+
+public:
+    // Starts dumping to filename every intervalSeconds (at least one second)
+    LatencyDumpThread(const string& _filename, int _intervalSeconds)
+        : filename(_filename), intervalSeconds(_intervalSeconds < 1 ? 1 : _intervalSeconds), stopping(false) {
+        dumper = thread(&LatencyDumpThread::dumpLoop, this);
+    }
+
+    // Stops the thread after a final dump
+    ~LatencyDumpThread() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        dumper.join();
+    }
+
+    LatencyDumpThread(const LatencyDumpThread&) = delete;
+    LatencyDumpThread& operator=(const LatencyDumpThread&) = delete;
+};
+
+// Times the rest of the enclosing scope as one operation of the given kind
+#define RESTAURANT_LATENCY_SCOPE(op) LatencyTimer latencyTimer(op)
+
+#else
+
+#define RESTAURANT_LATENCY_SCOPE(op) ((void)0)
+
+#endif // RESTAURANT_NO_LATENCY_STATS
+
+
+#ifdef RESTAURANT_COUNT_ALLOCATIONS
+
+/**
+ * AllocationStats counts every heap allocation made through the global operator new
+ * Opt-in: build with -DRESTAURANT_COUNT_ALLOCATIONS, and define RESTAURANT_ALLOCATION_HOOK_IMPLEMENTATION
+ * before including this header in exactly one source file, which then supplies the replacement
+ * operator new/delete. Allocations are charged to the program totals and to every distinct
+ * RESTAURANT_ALLOCATION_SCOPE active on the allocating thread, so a scope's numbers include the
+ * methods it calls. Nothing here allocates, so the hook cannot recurse.
+ */
+class AllocationStats {
+public:
+    static const int MAX_SCOPES = 96;      // Distinct scope names
+    static const int MAX_DEPTH = 16;       // Nested scopes tracked per thread (deeper ones are not charged)
+
+private:
+    struct ScopeCounters {
+        const char* name;
+        atomic<unsigned long long> calls;
+        atomic<unsigned long long> allocations;
+        atomic<unsigned long long> bytes;
+    };
+    
+    struct Totals {
+        atomic<unsigned long long> allocations;
+        atomic<unsigned long long> bytes;
+        atomic<unsigned long long> frees;
+    };
+    
+    // Scopes open on one thread, innermost last
+    struct ThreadScopes {
+        int ids[MAX_DEPTH];
+        int depth;
+    };
+    
+    // Storage (function-local so the header can be included from several source files;
+    // all of it is zero-initialized, so none of it allocates on first use)
+    static ScopeCounters* scopes() {
+        static ScopeCounters table[MAX_SCOPES];
+        return table;
+    }
+    static atomic<int>& scopeCount() {
+        static atomic<int> count;
+        return count;
+    }
+    static Totals& totals() {
+        static Totals instance;
+        return instance;
+    }
+    static ThreadScopes& threadScopes() {
+        static thread_local ThreadScopes instance;
+        return instance;
+    }
+    static mutex& registryLock() {
+        static mutex lock;
+        return lock;
+    }
+
+public:
+    // Returns the index of a scope name, adding it on first use (-1 if the table is full)
+    static int registerScope(const char* name) {
+        lock_guard<mutex> guard(registryLock());
+        int count = scopeCount().load();
+        for (int i = 0; i < count; i++) {
+            if (strcmp(scopes()[i].name, name) == 0) {
+                return i;
+            }
+        }
+        if (count == MAX_SCOPES) {
+            return -1;
+        }
+        scopes()[count].name = name;
+        scopeCount().store(count + 1);
+        return count;
+    }
+    
+    // Opens a scope on this thread; returns false if it is already open (recursion or an
+    // overload calling another) or too deep, in which case the caller must not close it
+    static bool enterScope(int id) {
+        ThreadScopes& open = threadScopes();
+        if (id < 0 || open.depth == MAX_DEPTH) {
+            return false;
+        }
+        for (int i = 0; i < open.depth; i++) {
+            if (open.ids[i] == id) {
+                return false;
+            }
+        }
+        open.ids[open.depth++] = id;
+        scopes()[id].calls.fetch_add(1, memory_order_relaxed);
+        return true;
+    }
+    
+    // Closes the innermost scope of this thread
+    static void leaveScope() {
+        threadScopes().depth--;
+    }
+    
+    // Called by the replacement operator new for every allocation
+    static void onAllocate(size_t size) {
+        totals().allocations.fetch_add(1, memory_order_relaxed);
+        totals().bytes.fetch_add(size, memory_order_relaxed);
+        
+        ThreadScopes& open = threadScopes();
+        for (int i = 0; i < open.depth; i++) {
+            ScopeCounters& counters = scopes()[open.ids[i]];
+            counters.allocations.fetch_add(1, memory_order_relaxed);
+            counters.bytes.fetch_add(size, memory_order_relaxed);
+        }
+    }
+    
+    // Called by the replacement operator delete for every non-null pointer
+    static void onFree() {
+        totals().frees.fetch_add(1, memory_order_relaxed);
+    }
+    
+    // Program-wide totals since startup
+    static unsigned long long getTotalAllocations() { return totals().allocations.load(memory_order_relaxed); }
+    static unsigned long long getTotalBytes() { return totals().bytes.load(memory_order_relaxed); }
+    static unsigned long long getTotalFrees() { return totals().frees.load(memory_order_relaxed); }
+    
+    // Clears the per-scope counters (the scopes stay registered)
+    static void reset() {
+        int count = scopeCount().load();
+        for (int i = 0; i < count; i++) {
+            scopes()[i].calls.store(0);
+            scopes()[i].allocations.store(0);
+            scopes()[i].bytes.store(0);
+        }
+    }
+    
+    // Displays calls, allocations and bytes per call of every scope that has been called
+    static void displayReport() {
+        engineOut() << string(100, '=') << endl;
+        engineOut() << setw(35) << " " << "Heap Allocations by Operation" << endl;
+        engineOut() << string(100, '=') << endl;
+        engineOut() << left << setw(40) << "Operation"
+             << setw(12) << "Calls"
+             << setw(16) << "Allocations"
+             << setw(16) << "Allocs/call"
+             << setw(16) << "Bytes/call" << endl;
+        engineOut() << string(100, '-') << endl;
+        
+        int count = scopeCount().load();
+        for (int i = 0; i < count; i++) {
+            const ScopeCounters& counters = scopes()[i];
+            unsigned long long calls = counters.calls.load();
+            if (calls == 0) {
+                continue;
+            }
+            engineOut() << left << setw(40) << counters.name
+                 << setw(12) << calls
+                 << setw(16) << counters.allocations.load()
+                 << setw(16) << fixed << setprecision(2) << (double)counters.allocations.load() / calls
+                 << setw(16) << setprecision(0) << (double)counters.bytes.load() / calls << endl;
+        }
+        
+        engineOut() << string(100, '-') << endl;
+        engineOut() << "Program total: " << getTotalAllocations() << " allocations, " << getTotalBytes()
+             << " bytes, " << getTotalFrees() << " frees" << endl;
+        engineOut() << "Note: an operation's numbers include the operations it calls." << endl;
+    }
+    
+    // Writes the statistics of every scope as JSON
+    // Returns: true if the file was written, false if it could not be opened
+    static bool saveToFile(const string& filename) {
+        ofstream file(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for writing" << endl;
+            return false;
+        }
+        
+        file << "{" << endl;
+        file << "  \"timestamp\": " << (long long)time(0) << "," << endl;
+        file << "  \"total\": {\"allocations\": " << getTotalAllocations() << ", \"bytes\": " << getTotalBytes()
+             << ", \"frees\": " << getTotalFrees() << "}," << endl;
+        file << "  \"operations\": {" << endl;
+        int count = scopeCount().load();
+        for (int i = 0; i < count; i++) {
+            const ScopeCounters& counters = scopes()[i];
+            file << "    \"" << counters.name << "\": {"
+                 << "\"calls\": " << counters.calls.load() << ", "
+                 << "\"allocations\": " << counters.allocations.load() << ", "
+                 << "\"bytes\": " << counters.bytes.load() << "}"
+                 << (i < count - 1 ? "," : "") << endl;
+        }
+        file << "  }" << endl;
+        file << "}" << endl;
+        
+        file.close();
+        return true;
+    }
+};
+
+/**
+ * AllocationScope charges the allocations made while it exists to one named operation
+ * Declare it with RESTAURANT_ALLOCATION_SCOPE at the top of a method.
+ */
+class AllocationScope {
+private:
+    bool opened;
+
+public:
+    explicit AllocationScope(int id) : opened(AllocationStats::enterScope(id)) {}
+    
+    ~AllocationScope() {
+        if (opened) {
+            AllocationStats::leaveScope();
+        }
+    }
+    
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+// Charges the rest of the enclosing scope to the named operation (the name must be a string literal)
+#define RESTAURANT_ALLOCATION_SCOPE(name) \
+    static const int allocationScopeId = AllocationStats::registerScope(name); \
+    AllocationScope allocationScope(allocationScopeId)
+
+#else
+
+#define RESTAURANT_ALLOCATION_SCOPE(name) ((void)0)
+
+#endif // RESTAURANT_COUNT_ALLOCATIONS
+
+/**
+ * TrackedIOBuffer supplies the buffer of a file stream from tracked memory
+ * The buffer must outlive the stream and be attached before the file is opened;
+ * TrackedFileStream below takes care of both.
+ */
+class TrackedIOBuffer {
+private:
+    static const int BUFFER_SIZE = 64 * 1024;  // Large enough to read or write a data file in a few system calls
+    char* buffer;
+
+public:
+    TrackedIOBuffer() : buffer(MemoryTracker::allocateArray<char>(MEM_IO_BUFFERS, BUFFER_SIZE)) {}
+    
+    ~TrackedIOBuffer() {
+        MemoryTracker::freeArray(MEM_IO_BUFFERS, buffer, BUFFER_SIZE);
+    }
+    
+    // Copying would free the buffer twice
+    TrackedIOBuffer(const TrackedIOBuffer&) = delete;
+    TrackedIOBuffer& operator=(const TrackedIOBuffer&) = delete;
+    
+    // Makes the stream use this buffer (must be called before the stream is opened)
+    void attachTo(ios& stream) {
+        stream.rdbuf()->pubsetbuf(buffer, BUFFER_SIZE);
+    }
+};
+
+/**
+ * File stream (ifstream or ofstream) that reads and writes through a TrackedIOBuffer
+ * The buffer is a base class listed before the stream, so it is constructed first and destroyed
+ * last, and it is attached in the constructor, before any file can be opened.
+ * Use it like the plain stream: TrackedFileStream<ifstream> file; file.open(filename);
+ */
+template <typename FileStream>
+class TrackedFileStream : private TrackedIOBuffer, public FileStream {
+public:
+    TrackedFileStream() {
+        attachTo(*this);
+    }
+};
+
+/**
+ * TaskScheduler runs small tasks on a fixed set of worker threads using work stealing
+ * Every worker owns a deque: it pushes and pops its own tasks at the back (newest first, cache-warm),
+ * and idle workers steal from the front of other deques (oldest first, usually the biggest pieces).
+ * Tasks submitted from outside the pool go to a separate injection deque that every worker polls.
+ * parallel_for splits a range recursively, so work spreads over the workers without a central queue,
+ * and the calling thread helps run tasks while it waits instead of blocking.
+ */
+class TaskScheduler {
+private:
+    typedef function<void()> Task;
+    
+    // Growable circular deque of tasks protected by its own lock
+    struct WorkDeque {
+        mutex lock;
+        Task* tasks;      // Circular buffer of tasks
+        int capacity;     // Size of the buffer (power of two)
+        int head;         // Position of the oldest task
+        int count;        // Number of queued tasks
+        
+        WorkDeque() : tasks(nullptr), capacity(0), head(0), count(0) {}
+        
+        ~WorkDeque() {
+            MemoryTracker::freeArray(MEM_SCHEDULER, tasks, capacity);
+        }
+        
+        // Appends a task at the back, doubling the buffer when it is full
+        void pushBack(Task&& task) {
+            lock_guard<mutex> guard(lock);
+            if (count == capacity) {
+                int newCapacity = (capacity == 0) ? 64 : capacity * 2;
+                Task* newTasks = MemoryTracker::allocateArray<Task>(MEM_SCHEDULER, newCapacity);
+                for (int i = 0; i < count; i++) {
+                    newTasks[i] = std::move(tasks[(head + i) & (capacity - 1)]);
+                }
+                MemoryTracker::freeArray(MEM_SCHEDULER, tasks, capacity);
+                tasks = newTasks;
+                capacity = newCapacity;
+                head = 0;
+            }
+            tasks[(head + count) & (capacity - 1)] = std::move(task);
+            count++;
+        }
+        
+        // Removes the newest task (used by the owner)
+        bool popBack(Task& task) {
+            lock_guard<mutex> guard(lock);
+            if (count == 0) {
+                return false;
+            }
+            count--;
+            task = std::move(tasks[(head + count) & (capacity - 1)]);
+            return true;
+        }
+        
+        // Removes the oldest task (used by thieves and for the injection deque)
+        bool popFront(Task& task) {
+            lock_guard<mutex> guard(lock);
+            if (count == 0) {
+                return false;
+            }
+            task = std::move(tasks[head]);
+            head = (head + 1) & (capacity - 1);
+            count--;
+            return true;
+        }
+    };
+    
+    // Shared bookkeeping of one parallel_for call, lives on the caller's stack
+    struct ParallelForState {
+        const function<void(int, int)>* body;
+        int grain;
+        atomic<int> outstanding;       // Pieces not finished yet
+        atomic<bool> failed;           // Set once a piece has thrown
+        mutex errorLock;
+        exception_ptr error;           // First exception thrown by the body
+    };
+    
+    int workerCount;
+    WorkDeque* deques;                 // One deque per worker, plus the injection deque at [workerCount]
+    thread* workers;
+    atomic<int> queuedTasks;           // Tasks waiting in any deque, lets idle workers sleep
+    atomic<bool> stopping;
+    mutex sleepLock;
+    condition_variable wakeUp;
+    atomic<long long> tasksExecuted;
+    atomic<long long> tasksStolen;
+    
+    // Scheduler of the worker running on this thread (nullptr outside worker threads)
+    static TaskScheduler*& currentScheduler() {
+        static thread_local TaskScheduler* scheduler = nullptr;
+        return scheduler;
+    }
+    
+    // Index of the worker running on this thread (-1 outside worker threads)
+    static int& currentWorker() {
+        static thread_local int worker = -1;
+        return worker;
+    }
+    
+    // Returns the deque new tasks from this thread should go to
+    WorkDeque& localDeque() {
+        return (currentScheduler() == this) ? deques[currentWorker()] : deques[workerCount];
+    }
+    
+    // Queues a task and wakes one sleeping worker
+    void enqueue(Task&& task) {
+        localDeque().pushBack(std::move(task));
+        queuedTasks.fetch_add(1);
+        {
+            // Taking the lock orders the wake-up after a worker's check of queuedTasks
+            lock_guard<mutex> guard(sleepLock);
+        }
+        wakeUp.notify_one();
+    }
+    
+    // Finds one task: own deque first, then the injection deque, then the other workers
+    bool findTask(int self, Task& task) {
+        if (self >= 0 && deques[self].popBack(task)) {
+            queuedTasks.fetch_sub(1);
+            return true;
+        }
+        if (deques[workerCount].popFront(task)) {
+            queuedTasks.fetch_sub(1);
+            return true;
+        }
+        
+        // Start stealing at the neighbour so thieves do not all hit the same victim
+        int start = (self >= 0) ? self + 1 : 0;
+        for (int i = 0; i < workerCount; i++) {
+            int victim = (start + i) % workerCount;
+            if (victim != self && deques[victim].popFront(task)) {
+                queuedTasks.fetch_sub(1);
+                tasksStolen.fetch_add(1);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Runs one queued task on the calling thread if there is any
+    bool runOneTask() {
+        Task task;
+        int self = (currentScheduler() == this) ? currentWorker() : -1;
+        if (!findTask(self, task)) {
+            return false;
+        }
+        task();
+        tasksExecuted.fetch_add(1);
+        return true;
+    }
+    
+    // Main loop of a worker thread
+    void workerLoop(int index) {
+        currentScheduler() = this;
+        currentWorker() = index;
+        
+        while (true) {
+            if (runOneTask()) {
+                continue;
+            }
+            
+            unique_lock<mutex> guard(sleepLock);
+            if (stopping.load() && queuedTasks.load() == 0) {
+                break;
+            }
+            wakeUp.wait_for(guard, chrono::milliseconds(1), [this] {
+                return stopping.load() || queuedTasks.load() > 0;
+            });
+        }
+        
+        currentScheduler() = nullptr;
+        currentWorker() = -1;
+    }
+    
+    // Runs the range [begin, end): hands the upper halves to other workers until it is
+    // no bigger than the grain, then runs the rest here
+    void runRange(ParallelForState* state, int begin, int end) {
+        while (end - begin > state->grain) {
+            int middle = begin + (end - begin) / 2;
+            state->outstanding.fetch_add(1);
+            enqueue([this, state, middle, end] { runRange(state, middle, end); });
+            end = middle;
+        }
+        
+        // Once a piece has failed the remaining pieces are skipped
+        if (!state->failed.load()) {
+            try {
+                (*state->body)(begin, end);
+            } catch (...) {
+                lock_guard<mutex> guard(state->errorLock);
+                if (!state->failed.exchange(true)) {
+                    state->error = current_exception();
+                }
+            }
+        }
+        
+        // Must be the last access to state: the caller may return as soon as this reaches zero
+        state->outstanding.fetch_sub(1);
+    }
+
+public:
+    // Constructor - starts the worker threads
+    // Parameters: threadCount - number of workers, 0 picks one less than the number of cores
+    //             (the thread calling parallel_for works as well)
+    explicit TaskScheduler(int threadCount = 0)
+        : queuedTasks(0), stopping(false), tasksExecuted(0), tasksStolen(0) {
+        if (threadCount <= 0) {
+            threadCount = (int)thread::hardware_concurrency() - 1;
+            if (threadCount < 1) {
+                threadCount = 1;
+            }
+        }
+        workerCount = threadCount;
+        deques = new WorkDeque[workerCount + 1];
+        MemoryTracker::recordAllocation(MEM_SCHEDULER, (workerCount + 1) * sizeof(WorkDeque));
+        workers = new thread[workerCount];
+        for (int i = 0; i < workerCount; i++) {
+            workers[i] = thread(&TaskScheduler::workerLoop, this, i);
+        }
+    }
+    
+    // Destructor - runs every queued task, then joins the workers
+    ~TaskScheduler() {
+        {
+            lock_guard<mutex> guard(sleepLock);
+            stopping.store(true);
+        }
+        wakeUp.notify_all();
+        for (int i = 0; i < workerCount; i++) {
+            workers[i].join();
+        }
+        delete[] workers;
+        delete[] deques;
+        MemoryTracker::recordFree(MEM_SCHEDULER, (workerCount + 1) * sizeof(WorkDeque));
+    }
+    
+    // Workers and deques are tied to this object
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+    
+    // Returns the scheduler shared by all bulk operations, started on first use
+    static TaskScheduler& shared() {
+        static TaskScheduler instance;
+        return instance;
+    }
+    
+    // Queues a task to run on some worker, fire-and-forget
+    void submit(function<void()> task) {
+        enqueue(std::move(task));
+    }
+    
+    /**
+     * Calls body(chunkBegin, chunkEnd) over disjoint chunks covering [begin, end) in parallel
+     * Chunks hold at most grain indices. The call returns when every chunk has finished;
+     * if a chunk throws, the remaining chunks are skipped and the first exception is rethrown here.
+     * May be called from inside a task (nested parallel_for): the waiting thread keeps running tasks.
+     */
+    void parallel_for(int begin, int end, int grain, const function<void(int, int)>& body) {
+        if (end <= begin) {
+            return;
+        }
+        if (grain < 1) {
+            grain = 1;
+        }
+        
+        ParallelForState state;
+        state.body = &body;
+        state.grain = grain;
+        state.outstanding.store(1);
+        state.failed.store(false);
+        
+        runRange(&state, begin, end);
+        
+        // Help with queued work until every piece of this call is done
+        while (state.outstanding.load() > 0) {
+            if (!runOneTask()) {
+                this_thread::yield();
+            }
+        }
+        
+        if (state.error) {
+            rethrow_exception(state.error);
+        }
+    }
+    
+    // Picks a grain that gives each thread several chunks to balance uneven work
+    int suggestGrain(int count) const {
+        int grain = count / ((workerCount + 1) * 8);
+        return (grain < 1) ? 1 : grain;
+    }
+    
+    // Statistics getters
+    int getWorkerCount() const { return workerCount; }
+    long long getTasksExecuted() const { return tasksExecuted.load(); }
+    long long getTasksStolen() const { return tasksStolen.load(); }
+};
+
+
+/**
+ * ValidationCheck class provides static methods for validating various inputs
+ * This class contains utility methods for common validation tasks throughout the application
+ */
+class ValidationCheck {
+public:
+    // Check if string length is within acceptable range
+    static bool isValidStringLength(const string& str, int minLength, int maxLength) {
+        int length = str.length();
+        return (length >= minLength && length <= maxLength);
+    }
+    
+    // Check if price is valid (minimum 1.00 and has exactly 2 decimal places)
+    static bool isValidPrice(double price) {
+        // Check minimum price
+        if (price < 1.0) {
+            return false;
+        }
+        
+        // Check if price has exactly 2 decimal places
+        // Convert to string and check decimal part
+        string priceStr = to_string(price);
+        size_t decimalPos = priceStr.find('.');
+        
+        if (decimalPos == string::npos) {
+            // No decimal point
+            return true;
+        }
+        
+        // Get decimal part and check its length after removing trailing zeros
+        string decimalPart = priceStr.substr(decimalPos + 1);
+        while (!decimalPart.empty() && decimalPart.back() == '0') {
+            decimalPart.pop_back();
+        }
+        
+        return decimalPart.length() <= 2;
+    }
+    
+    // Check if quantity is valid (between 1 and 999)
+    static bool isValidQuantity(int quantity) {
+        return (quantity >= 1 && quantity <= 999);
+    }
+    
+    // Check if ID follows the format of 1 character followed by 3 digits
+    static bool isValidID(const string& id) {
+        // Check length
+        if (id.length() != 4) {
+            return false;
+        }
+        
+        // Check first character is a letter
+        if (!isalpha(id[0])) {
+            return false;
+        }
+        
+        // Check remaining 3 characters are digits
+        for (int i = 1; i < 4; i++) {
+            if (!isdigit(id[i])) {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    // Display validation error message
+    static void showError(const string& message) {
+        engineOut() << "Error: " << message << endl;
+    }
+    
+    // Check if username is valid (between 5 and 20 characters, alphanumeric with underscore)
+    static bool isValidUsername(const string& username) {
+        // Check length
+        if (!isValidStringLength(username, 5, 20)) {
+            return false;
+        }
+        
+        // Check characters (only allow letters, numbers, and underscore)
+        for (char c : username) {
+            if (!isalnum(c) && c != '_') {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
+    // Check if password is valid (between 6 and 20 characters, with at least one number and one letter)
+    static bool isValidPassword(const string& password) {
+        // Check length
+        if (!isValidStringLength(password, 6, 20)) {
+            return false;
+        }
+        
+        bool hasLetter = false;
+        bool hasDigit = false;
+        
+        // Check for at least one letter and one number
+        for (char c : password) {
+            if (isalpha(c)) {
+                hasLetter = true;
+            } else if (isdigit(c)) {
+                hasDigit = true;
+            }
+        }
+        
+        return hasLetter && hasDigit;
+    }
+    
+    // Check if Staff/Admin ID is valid (S/A followed by 3 digits)
+    static bool isValidStaffAdminID(const string& id, bool isAdmin) {
+        // Check length
+        if (id.length() != 4) {
+            return false;
+        }
+        
+        // Check first character (S for Staff, A for Admin)
+        if (isAdmin && id[0] != 'A') {
+            return false;
+        } else if (!isAdmin && id[0] != 'S') {
+            return false;
+        }
+        
+        // Check remaining 3 characters are digits
+        for (int i = 1; i < 4; i++) {
+            if (!isdigit(id[i])) {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+};
+
+/**
+ * ItemID is a packed fixed-width identifier used for food, menu, staff and admin records
+ * Every ID in the system is 4 characters (see ValidationCheck::isValidID and isValidStaffAdminID),
+ * so the characters are packed big-endian into one 32-bit integer. Equality and hashing are a
+ * single integer operation, and integer order matches alphabetical order of the text.
+ * Text longer than 4 characters packs to one shared invalid code; the inventory and menu reject
+ * such IDs on insert and report them as not found on lookup, so they never match a stored record.
+ */
+class ItemID {
+private:
+    static const int MAX_LENGTH = 4;
+    static const uint32_t INVALID_CODE = 0xFFFFFFFFu;  // Text that does not fit in 4 characters
+    uint32_t code;                                      // Packed characters, 0 means empty
+    
+    // Packs up to 4 characters big-endian, shorter IDs are padded with zero bytes
+    static uint32_t pack(const char* text, size_t length) {
+        if (length > (size_t)MAX_LENGTH) {
+            return INVALID_CODE;
+        }
+        
+        uint32_t packed = 0;
+        for (int i = 0; i < MAX_LENGTH; i++) {
+            unsigned char c = (i < (int)length) ? (unsigned char)text[i] : 0;
+            packed = (packed << 8) | c;
+        }
+        return packed;
+    }
+    
+public:
+    // Default constructor - empty ID
+    ItemID() : code(0) {}
+    
+    // Implicit conversion from text so existing string-based callers keep working
+    ItemID(const string& text) : code(pack(text.c_str(), text.length())) {}
+    
+    ItemID(const char* text) : code(0) {
+        size_t length = 0;
+        while (text[length] != '\0' && length <= (size_t)MAX_LENGTH) {
+            length++;
+        }
+        code = pack(text, length);
+    }
+    
+    // Returns the packed integer value
+    uint32_t getCode() const {
+        return code;
+    }
+    
+    // Rebuilds an ID from the value returned by getCode()
+    static ItemID fromCode(uint32_t packed) {
+        ItemID id;
+        id.code = packed;
+        return id;
+    }
+    
+    // Checks if this ID is empty
+    bool empty() const {
+        return code == 0;
+    }
+    
+    // Checks if the ID was built from text that fits in 4 characters
+    bool isValid() const {
+        return code != INVALID_CODE;
+    }
+    
+    // Returns the character at the given position (0 past the end of the ID)
+    char charAt(int index) const {
+        return (char)((code >> (8 * (MAX_LENGTH - 1 - index))) & 0xFF);
+    }
+    
+    // Returns the number of characters in the ID
+    int length() const {
+        if (!isValid()) {
+            return 0;
+        }
+        int len = 0;
+        while (len < MAX_LENGTH && charAt(len) != '\0') {
+            len++;
+        }
+        return len;
+    }
+    
+    // Converts the packed ID back to text
+    string toString() const {
+        string text;
+        int len = length();
+        for (int i = 0; i < len; i++) {
+            text += charAt(i);
+        }
+        return text;
+    }
+    
+    // Integer hash (Fibonacci hashing) for use in hash indexes
+    uint32_t hash() const {
+        return code * 2654435769u;
+    }
+    
+    // Comparison operators - one integer compare each
+    bool operator==(const ItemID& other) const { return code == other.code; }
+    bool operator!=(const ItemID& other) const { return code != other.code; }
+    bool operator<(const ItemID& other) const { return code < other.code; }
+    bool operator<=(const ItemID& other) const { return code <= other.code; }
+    bool operator>(const ItemID& other) const { return code > other.code; }
+    bool operator>=(const ItemID& other) const { return code >= other.code; }
+    
+    // Friend function to print the ID as text
+    friend ostream& operator<<(ostream& os, const ItemID& id);
+};
+
+// Friend function implementation
+inline ostream& operator<<(ostream& os, const ItemID& id) {
+    return os << id.toString();
+}
+
+/**
+ * TraceRecorder collects timed spans and writes them as a Chrome trace-event file
+ * The file opens in chrome://tracing or ui.perfetto.dev. Spans are recorded only between
+ * start() and stop(), so tracing can be switched on and off while the program runs; when it is
+ * off a span costs one relaxed atomic load. Spans on one thread nest by their timing, so the
+ * viewer shows the call structure (order -> dish -> consume -> ingredient -> log).
+ */
+class TraceRecorder {
+public:
+    static const int MAX_EVENTS = 1 << 20;    // Events kept per recording, later ones are counted as dropped
+
+private:
+    // One finished span
+    struct TraceEvent {
+        const char* name;
+        const char* category;
+        ItemID id;                  // Item the span worked on (empty if none)
+        int amount;                 // Quantity involved (0 if none)
+        int threadId;
+        long long startNs;          // Relative to the start of the recording
+        long long durationNs;
+    };
+    
+    struct State {
+        atomic<bool> recording;
+        mutex lock;                 // Guards everything below
+        TraceEvent* events;
+        int eventCount;
+        int capacity;
+        long long dropped;
+        long long epochNs;          // Clock reading when the recording started
+        string filename;
+        
+        State() : recording(false), events(nullptr), eventCount(0), capacity(0), dropped(0), epochNs(0) {}
+    };
+    
+    // Recording state (function-local so the header can be included from several source files)
+    static State& state() {
+        static State instance;
+        return instance;
+    }
+    
+    // Writes the events as trace-event JSON, the caller holds the lock
+    static bool writeFile(State& s) {
+        ofstream file(s.filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << s.filename << " for writing" << endl;
+            return false;
+        }
+        
+        // Complete ("X") events with microsecond timestamps
+        file << "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": " << s.dropped << "}," << endl;
+        file << "\"traceEvents\": [" << endl;
+        file << fixed << setprecision(3);
+        for (int i = 0; i < s.eventCount; i++) {
+            const TraceEvent& event = s.events[i];
+            file << "{\"name\": \"" << event.name << "\", \"cat\": \"" << event.category
+                 << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event.threadId
+                 << ", \"ts\": " << event.startNs / 1000.0 << ", \"dur\": " << event.durationNs / 1000.0;
+            if (!event.id.empty() || event.amount != 0) {
+                file << ", \"args\": {";
+                if (!event.id.empty()) {
+                    file << "\"id\": \"" << event.id << "\"" << (event.amount != 0 ? ", " : "");
+                }
+                if (event.amount != 0) {
+                    file << "\"amount\": " << event.amount;
+                }
+                file << "}";
+            }
+            file << "}" << (i < s.eventCount - 1 ? "," : "") << endl;
+        }
+        file << "]}" << endl;
+        
+        file.close();
+        return !file.fail();
+    }
+    
+public:
+    // Current clock reading in nanoseconds
+    static long long now() {
+        return (long long)chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // Small number for the calling thread, used as the trace's thread id
+    static int currentThreadId() {
+        static atomic<int> nextId(1);
+        static thread_local int id = nextId.fetch_add(1);
+        return id;
+    }
+    
+    // Checks if spans are being recorded
+    static bool isRecording() {
+        return state().recording.load(memory_order_relaxed);
+    }
+    
+    // Starts a new recording that stop() will write to filename (a running recording is discarded)
+    static void start(const string& filename) {
+        State& s = state();
+        lock_guard<mutex> guard(s.lock);
+        if (s.events == nullptr) {
+            s.capacity = 4096;
+            s.events = MemoryTracker::allocateArray<TraceEvent>(MEM_TRACE, s.capacity);
+        }
+        s.eventCount = 0;
+        s.dropped = 0;
+        s.filename = filename;
+        s.epochNs = now();
+        s.recording.store(true);
+    }
+    
+    // Ends the recording and writes the trace file
+    // Returns: true if the file was written, false if nothing was recording or it could not be written
+    static bool stop() {
+        State& s = state();
+        lock_guard<mutex> guard(s.lock);
+        if (!s.recording.load()) {
+            return false;
+        }
+        s.recording.store(false);
+        bool written = writeFile(s);
+        
+        MemoryTracker::freeArray(MEM_TRACE, s.events, s.capacity);
+        s.events = nullptr;
+        s.capacity = 0;
+        return written;
+    }
+    
+    // Getters for the current recording
+    static int getEventCount() {
+        lock_guard<mutex> guard(state().lock);
+        return state().eventCount;
+    }
+    static string getFilename() {
+        lock_guard<mutex> guard(state().lock);
+        return state().filename;
+    }
+    
+    // Adds a finished span (spans that started before the current recording are ignored)
+    static void record(const char* name, const char* category, const ItemID& id, int amount,
+                       long long startNs, long long endNs) {
+        State& s = state();
+        lock_guard<mutex> guard(s.lock);
+        if (!s.recording.load(memory_order_relaxed) || startNs < s.epochNs) {
+            return;
+        }
+        if (s.eventCount == s.capacity) {
+            if (s.capacity == MAX_EVENTS) {
+                s.dropped++;
+                return;
+            }
+            // Grow by doubling, up to MAX_EVENTS
+            int newCapacity = (s.capacity * 2 < MAX_EVENTS) ? s.capacity * 2 : MAX_EVENTS;
+            TraceEvent* grown = MemoryTracker::allocateArray<TraceEvent>(MEM_TRACE, newCapacity);
+            for (int i = 0; i < s.eventCount; i++) {
+                grown[i] = s.events[i];
+            }
+            MemoryTracker::freeArray(MEM_TRACE, s.events, s.capacity);
+            s.events = grown;
+            s.capacity = newCapacity;
+        }
+        
+        TraceEvent& event = s.events[s.eventCount++];
+        event.name = name;
+        event.category = category;
+        event.id = id;
+        event.amount = amount;
+        event.threadId = currentThreadId();
+        event.startNs = startNs - s.epochNs;
+        event.durationNs = endNs - startNs;
+    }
+};
+
+/**
+ * TraceSpan records the time from its construction to its destruction as one trace span
+ * Name and category must be string literals (only the pointers are kept).
+ * Does nothing unless TraceRecorder is recording when the span starts.
+ */
+class TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    ItemID id;
+    int amount;
+    long long startNs;
+    bool active;
+    
+public:
+    TraceSpan(const char* _name, const char* _category, const ItemID& _id = ItemID(), int _amount = 0)
+        : name(_name), category(_category), id(_id), amount(_amount), startNs(0),
+          active(TraceRecorder::isRecording()) {
+        if (active) {
+            startNs = TraceRecorder::now();
+        }
+    }
+    
+    ~TraceSpan() {
+        if (active) {
+            TraceRecorder::record(name, category, id, amount, startNs, TraceRecorder::now());
+        }
+    }
+    
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+// Custom minimum function
+inline int min(int a, int b) {
+    return (a < b) ? a : b;
+}
+
+inline double min(double a, double b) {
+    return (a < b) ? a : b;
+}
+
+/**
+ * Restaurant base class for the restaurant management system
+ * Contains common functionality shared by inventory and menu subsystems
+ * @time_complexity Varies by method
+ * @space_complexity Varies by method
+ */
+class Restaurant {
+protected:
+    atomic<int> itemCount;             // Total number of items in the system (atomic, the inventory can be shared by threads)
+    
+    // Protected constructor to prevent direct instantiation
+    Restaurant() : itemCount(0) {}
+    
+    // Copy constructor
+    Restaurant(const Restaurant& other) : itemCount(other.itemCount.load()) {}
+    
+public:
+    // Redirects all engine messages and reports (e.g. to a log file or a null stream)
+    // Set it before other threads use the engines
+    static void setOutput(ostream& stream) {
+        engineOutputTarget() = &stream;
+    }
+    
+    // Returns the stream engine messages and reports are written to
+    static ostream& getOutput() {
+        return engineOut();
+    }
+    
+    // Static utility methods for display
+    // Print header for display
+    static void printHeader(const string& title) {
+        engineOut() << "\n" << string(100, '=') << endl;
+        engineOut() << string(35, ' ') << title << endl;
+        engineOut() << string(100, '=') << endl;
+    }
+    
+    // Print footer for display
+    static void printFooter() {
+        engineOut() << string(100, '-') << endl;
+    }
+
+    // Virtual destructor to ensure proper cleanup in derived classes
+    virtual ~Restaurant() {}
+    
+    // Get current number of items in the system
+    virtual int getItemCount() const {
+        return itemCount.load();
+    }
+    
+    // Pure virtual functions to be implemented by derived classes
+    virtual bool loadFromFile(const string& filename) = 0;
+    virtual bool saveToFile(const string& filename, bool sorted = false) = 0;
+    virtual void displayAll() = 0;
+    virtual void displaySorted(bool byName = true) = 0;
+
+    // Friend function to display system statistics
+    friend void displayRestaurantStats(const Restaurant& restaurant);
+};
+
+// Friend function implementation
+inline void displayRestaurantStats(const Restaurant& restaurant) {
+    Restaurant::printHeader("Restaurant System Statistics");
+    engineOut() << "Total number of items: " << restaurant.itemCount.load() << endl;
+    Restaurant::printFooter();
+}
+
+// Food item structure for restaurant inventory
+struct FoodItem {
+    ItemID id;            // Unique identifier (packed 4-character ID)
+    string name;          // Food item name
+    double price;         // Price per unit
+    string category;      // Category (e.g., "Meat", "Vegetable", "Spice")
+    int quantity;         // Quantity in stock
+    int64_t receiveDate;  // Date when item was received (epoch seconds, rendered only for display)
+    
+    // Default constructor
+    FoodItem() : price(0.0), quantity(0), receiveDate(0) {
+        name = "";
+        category = "";
+    }
+    
+    // FoodItem arrays are only built as temporary copies for sorting and reports,
+    // so they are charged to the sort scratch subsystem
+    static void* operator new[](size_t bytes) {
+        void* memory = ::operator new[](bytes);
+        MemoryTracker::recordAllocation(MEM_SORT_SCRATCH, bytes);
+        return memory;
+    }
+    
+    static void operator delete[](void* memory, size_t bytes) {
+        MemoryTracker::recordFree(MEM_SORT_SCRATCH, bytes);
+        ::operator delete[](memory);
+    }
+    
+    // Parameterized constructor - stamps the batch with the current time
+    FoodItem(const ItemID& _id, const string& _name, double _price, const string& _category, int _quantity = 0) 
+        : id(_id), name(_name), price(_price), category(_category), quantity(_quantity),
+          receiveDate((int64_t)time(0)) {}
+    
+    // Parameterized constructor with a known receive date (e.g. when loading from file)
+    FoodItem(const ItemID& _id, const string& _name, double _price, const string& _category, int _quantity,
+             int64_t _receiveDate) 
+        : id(_id), name(_name), price(_price), category(_category), quantity(_quantity),
+          receiveDate(_receiveDate) {}
+    
+    // Returns the receive date in the familiar ctime() layout, e.g. "Sun Oct 18 13:14:14 2026"
+    string getReceiveDateString() const {
+        return formatDate(receiveDate);
+    }
+    
+    // Returns how many whole days ago this batch was received
+    int getAgeInDays(int64_t now) const {
+        if (now <= receiveDate) {
+            return 0;
+        }
+        return (int)((now - receiveDate) / 86400);
+    }
+    
+    // Formats epoch seconds like ctime() without the trailing newline, e.g. "Sun Oct 18 13:14:14 2026"
+    // Uses the reentrant localtime variant, so it is safe to call from the background logger thread
+    static string formatDate(int64_t epochSeconds) {
+        time_t t = (time_t)epochSeconds;
+        struct tm local;
+#ifdef _WIN32
+        if (localtime_s(&local, &t) != 0) {
+            return "";
+        }
+#else
+        if (localtime_r(&t, &local) == nullptr) {
+            return "";
+        }
+#endif
+        
+        char text[32];
+        size_t length = strftime(text, sizeof(text), "%a %b %e %H:%M:%S %Y", &local);
+        return string(text, length);
+    }
+    
+    // Parses a receive date from the data file
+    // Accepts epoch seconds (current format) or the legacy ctime() text, e.g. "Sun Oct 18 13:14:14 2026"
+    // Returns: true and sets epochSeconds if the text could be parsed
+    static bool parseDate(const string& text, int64_t& epochSeconds) {
+        if (text.empty()) {
+            return false;
+        }
+        
+        // Current format: plain epoch seconds
+        bool allDigits = true;
+        for (size_t i = 0; i < text.length(); i++) {
+            if (!isdigit((unsigned char)text[i])) {
+                allDigits = false;
+                break;
+            }
+        }
+        if (allDigits) {
+            // More digits than int64_t holds would make stoll throw
+            if (text.length() > 18) {
+                return false;
+            }
+            epochSeconds = stoll(text);
+            return true;
+        }
+        
+        // Legacy format: "Www Mmm dd hh:mm:ss yyyy" in local time
+        char weekday[4] = {0};
+        char month[4] = {0};
+        int day, hour, minute, second, year;
+        if (sscanf(text.c_str(), "%3s %3s %d %d:%d:%d %d", weekday, month, &day, &hour, &minute, &second, &year) != 7) {
+            return false;
+        }
+        
+        static const char* MONTHS[12] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                         "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+        int monthIndex = -1;
+        for (int i = 0; i < 12; i++) {
+            if (string(month) == MONTHS[i]) {
+                monthIndex = i;
+                break;
+            }
+        }
+        if (monthIndex == -1) {
+            return false;
+        }
+        
+        tm timeInfo = {};
+        timeInfo.tm_year = year - 1900;
+        timeInfo.tm_mon = monthIndex;
+        timeInfo.tm_mday = day;
+        timeInfo.tm_hour = hour;
+        timeInfo.tm_min = minute;
+        timeInfo.tm_sec = second;
+        timeInfo.tm_isdst = -1; // Let the C library work out daylight saving time
+        
+        time_t converted = mktime(&timeInfo);
+        if (converted == (time_t)-1) {
+            return false;
+        }
+        
+        epochSeconds = (int64_t)converted;
+        return true;
+    }
+};
+
+// Single ingredient requirement of a menu item
+struct Ingredient {
+    ItemID foodId;        // ID of the food item in the inventory
+    int quantity;         // Quantity needed for one serving
+    
+    // Default constructor
+    Ingredient() : quantity(0) {}
+    
+    // Parameterized constructor
+    Ingredient(const ItemID& _foodId, int _quantity) : foodId(_foodId), quantity(_quantity) {}
+};
+
+// Small-buffer list of ingredients for a menu item
+// Recipes with up to INLINE_CAPACITY ingredients are stored inside the object itself,
+// only larger recipes spill over to a heap array (grown by doubling)
+class IngredientList {
+private:
+    static const int INLINE_CAPACITY = 12;     // Most recipes fit without any allocation
+    Ingredient inlineItems[INLINE_CAPACITY];   // Inline storage for small recipes
+    Ingredient* heapItems;                     // Spill storage, nullptr while the recipe fits inline
+    int size;                                  // Number of ingredients stored
+    int capacity;                              // Current storage capacity
+    
+    // Returns the active storage (inline or heap)
+    Ingredient* data() {
+        return (heapItems != nullptr) ? heapItems : inlineItems;
+    }
+    
+    const Ingredient* data() const {
+        return (heapItems != nullptr) ? heapItems : inlineItems;
+    }
+    
+    // Makes room for at least minCapacity ingredients by moving to a bigger heap array
+    void reserve(int minCapacity) {
+        if (minCapacity <= capacity) {
+            return;
+        }
+        
+        int newCapacity = capacity * 2;
+        if (newCapacity < minCapacity) {
+            newCapacity = minCapacity;
+        }
+        
+        Ingredient* newItems = MemoryTracker::allocateArray<Ingredient>(MEM_MENU, newCapacity);
+        Ingredient* oldItems = data();
+        for (int i = 0; i < size; i++) {
+            newItems[i] = oldItems[i];
+        }
+        
+        MemoryTracker::freeArray(MEM_MENU, heapItems, capacity);
+        heapItems = newItems;
+        capacity = newCapacity;
+    }
+    
+public:
+    // Constructor - starts with the inline storage
+    IngredientList() : heapItems(nullptr), size(0), capacity(INLINE_CAPACITY) {}
+    
+    // Copy constructor - only allocates when the other list has spilled to the heap
+    IngredientList(const IngredientList& other) : heapItems(nullptr), size(0), capacity(INLINE_CAPACITY) {
+        reserve(other.size);
+        const Ingredient* source = other.data();
+        Ingredient* target = data();
+        for (int i = 0; i < other.size; i++) {
+            target[i] = source[i];
+        }
+        size = other.size;
+    }
+    
+    // Assignment operator - reuses the existing storage whenever it is large enough
+    IngredientList& operator=(const IngredientList& other) {
+        // Self-assignment check to prevent issues
+        if (this == &other) {
+            return *this;
+        }
+        
+        clear();
+        reserve(other.size);
+        const Ingredient* source = other.data();
+        Ingredient* target = data();
+        for (int i = 0; i < other.size; i++) {
+            target[i] = source[i];
+        }
+        size = other.size;
+        
+        return *this;
+    }
+    
+    // Destructor - frees the spill storage if it was ever used
+    ~IngredientList() {
+        MemoryTracker::freeArray(MEM_MENU, heapItems, capacity);
+    }
+    
+    // Returns the number of ingredients
+    int getSize() const {
+        return size;
+    }
+    
+    // Checks if the list contains no ingredients
+    bool isEmpty() const {
+        return size == 0;
+    }
+    
+    // Access ingredient by index (0-based, no bounds check like a plain array)
+    Ingredient& operator[](int index) {
+        return data()[index];
+    }
+    
+    const Ingredient& operator[](int index) const {
+        return data()[index];
+    }
+    
+    // Appends an ingredient, amortized O(1) and allocation-free for small recipes
+    void add(const ItemID& foodId, int quantity) {
+        reserve(size + 1);
+        Ingredient& slot = data()[size];
+        slot.foodId = foodId;
+        slot.quantity = quantity;
+        size++;
+    }
+    
+    // Returns the index of the ingredient with the given food ID, or -1 if not found
+    int indexOf(const ItemID& foodId) const {
+        const Ingredient* items = data();
+        for (int i = 0; i < size; i++) {
+            if (items[i].foodId == foodId) {
+                return i;
+            }
+        }
+        return -1;
+    }
+    
+    // Removes the ingredient at the given index, keeping the order of the others
+    void removeAt(int index) {
+        if (index < 0 || index >= size) {
+            return;
+        }
+        
+        Ingredient* items = data();
+        for (int i = index; i < size - 1; i++) {
+            items[i] = items[i + 1];
+        }
+        size--;
+    }
+    
+    // Removes all ingredients (storage is kept for reuse)
+    void clear() {
+        size = 0;
+    }
+};
+
+// Food Menu Item structure for restaurant menu 
+struct MenuItem {
+    ItemID id;            // Unique identifier (packed 4-character ID)
+    string name;          // Menu item name
+    double price;         // Price for this menu item
+    string description;   // Description of the menu item
+    string category;      // Category (e.g., "Appetizer", "Main Course", "Dessert")
+    
+    // Ingredients needed for this menu item as (foodItemId, quantity) entries
+    // IngredientList performs its own deep copy, so the default copy operations are sufficient
+    IngredientList ingredients;
+    
+    // Default constructor - initializes empty menu item
+    MenuItem() : price(0.0) {
+        name = "";
+        description = "";
+        category = "";
+    }
+    
+    // Parameterized constructor - creates menu item with basic information
+    MenuItem(const ItemID& _id, const string& _name, double _price, 
+             const string& _description, const string& _category)
+        : id(_id), name(_name), price(_price), description(_description), 
+          category(_category) {}
+    
+    // Returns the number of ingredients in the recipe
+    int getIngredientCount() const {
+        return ingredients.getSize();
+    }
+    
+    // Adds a new ingredient with specified quantity to the menu item
+    // No allocation happens until the recipe outgrows the inline storage
+    void addIngredient(const ItemID& foodItemId, int quantity) {
+        ingredients.add(foodItemId, quantity);
+    }
+    
+    // Removes an ingredient from the menu item by its food item ID
+    // Returns true if found and removed, false otherwise
+    bool removeIngredient(const ItemID& foodItemId) {
+        int removeIndex = ingredients.indexOf(foodItemId);
+        if (removeIndex == -1) {
+            return false; // Ingredient not found
+        }
+        
+        ingredients.removeAt(removeIndex);
+        return true;
+    }
+    
+    // Retrieves the required quantity of a specific ingredient
+    // Returns 0 if the ingredient is not found
+    int getIngredientQuantity(const ItemID& foodItemId) const {
+        int index = ingredients.indexOf(foodItemId);
+        if (index == -1) {
+            return 0; // Ingredient not found
+        }
+        return ingredients[index].quantity;
+    }
+    
+    // Quantity one serving needs of the ingredient at an index, summed over every line with its ID
+    // Returns 0 for a repeated line, so a recipe listing an ID twice is only counted once
+    int getRequiredQuantityAt(int index) const {
+        const ItemID& foodId = ingredients[index].foodId;
+        if (ingredients.indexOf(foodId) != index) {
+            return 0;
+        }
+        int required = 0;
+        for (int i = index; i < ingredients.getSize(); i++) {
+            if (ingredients[i].foodId == foodId) {
+                required += ingredients[i].quantity;
+            }
+        }
+        return required;
+    }
+};
+
+// Handle to a menu item stored in MenuStore
+// Stays valid while the item exists, even when other items are added or removed.
+// The generation number detects handles to items that were removed (and slots reused) since.
+struct MenuHandle {
+    int slot;              // Slot index inside the store, -1 for a null handle
+    uint32_t generation;   // Generation of the slot when the handle was issued
+    
+    // Default constructor - null handle
+    MenuHandle() : slot(-1), generation(0) {}
+    
+    // Parameterized constructor
+    MenuHandle(int _slot, uint32_t _generation) : slot(_slot), generation(_generation) {}
+    
+    // Checks if this is a null handle
+    bool isNull() const {
+        return slot < 0;
+    }
+};
+
+// Read-only view over a contiguous range of menu items
+// Valid until the next add or remove on the store it came from
+struct MenuItemSpan {
+    const MenuItem* items;   // First item in the range
+    int count;               // Number of items in the range
+    
+    // Constructor
+    MenuItemSpan(const MenuItem* _items = nullptr, int _count = 0) : items(_items), count(_count) {}
+    
+    int getSize() const {
+        return count;
+    }
+    
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    const MenuItem& operator[](int index) const {
+        return items[index];
+    }
+    
+    // Iterator support for range-based for loops
+    const MenuItem* begin() const {
+        return items;
+    }
+    
+    const MenuItem* end() const {
+        return items + count;
+    }
+};
+
+// Read-only view over a list of menu item pointers, e.g. search results
+// Valid until the next add or remove, or the next query on the menu system that produced it
+struct MenuItemRefSpan {
+    const MenuItem* const* refs;  // First pointer in the list
+    int count;                    // Number of pointers in the list
+
+    // Iterator that hands out references instead of pointers
+    class Iterator {
+    private:
+        const MenuItem* const* current;
+
+    public:
+        Iterator(const MenuItem* const* position) : current(position) {}
+
+        const MenuItem& operator*() const { return **current; }
+        const MenuItem* operator->() const { return *current; }
+
+        Iterator& operator++() {
+            ++current;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& other) const { return current != other.current; }
+    };
+
+    // Constructor
+    MenuItemRefSpan(const MenuItem* const* _refs = nullptr, int _count = 0) : refs(_refs), count(_count) {}
+
+    int getSize() const {
+        return count;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    const MenuItem& operator[](int index) const {
+        return *refs[index];
+    }
+
+    // Iterator support for range-based for loops
+    Iterator begin() const {
+        return Iterator(refs);
+    }
+
+    Iterator end() const {
+        return Iterator(refs + count);
+    }
+};
+
+// Contiguous, cache-friendly storage for menu items
+// Items live in one dense array kept in menu order, so displays and sorts can walk them directly.
+// Each item also owns a slot with a generation counter, which backs stable MenuHandles,
+// and an open-addressing index maps packed IDs to slots for O(1) lookup.
+class MenuStore {
+private:
+    MenuItem* items;            // Dense array of menu items in menu order
+    int* denseToSlot;           // Slot of the item at each dense position
+    int* slotToDense;           // Dense position of each slot, -1 while the slot is free
+    uint32_t* slotGeneration;   // Generation counter of each slot
+    int* freeSlots;             // Stack of free slot numbers for reuse
+    int freeCount;              // Number of entries on the free slot stack
+    int slotCount;              // Number of slots ever handed out
+    int size;                   // Number of items stored
+    int capacity;               // Capacity of all per-item arrays
+    
+    int* idIndex;               // Open-addressing table of slot numbers (-1 = empty), linear probing
+    int indexCapacity;          // Size of the index table (power of two)
+    
+    // Finds the index table position for an ID: either its entry or the empty cell to insert into
+    int indexPosition(const ItemID& id) const {
+        int mask = indexCapacity - 1;
+        int position = (int)(id.hash() >> 8) & mask;
+        while (idIndex[position] != -1) {
+            int dense = slotToDense[idIndex[position]];
+            if (items[dense].id == id) {
+                return position;
+            }
+            position = (position + 1) & mask;
+        }
+        return position;
+    }
+    
+    // Returns the slot of the item with the given ID, or -1 if not found
+    // Invalid IDs all share one code, so they are never looked up in the index
+    int slotOf(const ItemID& id) const {
+        if (!id.isValid()) {
+            return -1;
+        }
+        return idIndex[indexPosition(id)];
+    }
+    
+    // Rebuilds the ID index from scratch with the given table size
+    void rebuildIndex(int newIndexCapacity) {
+        MemoryTracker::freeArray(MEM_MENU, idIndex, indexCapacity);
+        indexCapacity = newIndexCapacity;
+        idIndex = MemoryTracker::allocateArray<int>(MEM_MENU, indexCapacity);
+        for (int i = 0; i < indexCapacity; i++) {
+            idIndex[i] = -1;
+        }
+        for (int i = 0; i < size; i++) {
+            idIndex[indexPosition(items[i].id)] = denseToSlot[i];
+        }
+    }
+    
+    // Frees all per-item arrays (sized by the current capacity)
+    void freeArrays() {
+        MemoryTracker::freeArray(MEM_MENU, items, capacity);
+        MemoryTracker::freeArray(MEM_MENU, denseToSlot, capacity);
+        MemoryTracker::freeArray(MEM_MENU, slotToDense, capacity);
+        MemoryTracker::freeArray(MEM_MENU, slotGeneration, capacity);
+        MemoryTracker::freeArray(MEM_MENU, freeSlots, capacity);
+    }
+    
+    // Grows all per-item arrays to hold at least minCapacity items
+    void reserve(int minCapacity) {
+        if (minCapacity <= capacity) {
+            return;
+        }
+        
+        int newCapacity = (capacity == 0) ? 16 : capacity * 2;
+        while (newCapacity < minCapacity) {
+            newCapacity *= 2;
+        }
+        
+        MenuItem* newItems = MemoryTracker::allocateArray<MenuItem>(MEM_MENU, newCapacity);
+        int* newDenseToSlot = MemoryTracker::allocateArray<int>(MEM_MENU, newCapacity);
+        int* newSlotToDense = MemoryTracker::allocateArray<int>(MEM_MENU, newCapacity);
+        uint32_t* newSlotGeneration = MemoryTracker::allocateArray<uint32_t>(MEM_MENU, newCapacity);
+        int* newFreeSlots = MemoryTracker::allocateArray<int>(MEM_MENU, newCapacity);
+        
+        // Move items instead of deep copying their strings and ingredient lists
+        for (int i = 0; i < size; i++) {
+            newItems[i] = std::move(items[i]);
+            newDenseToSlot[i] = denseToSlot[i];
+        }
+        for (int i = 0; i < slotCount; i++) {
+            newSlotToDense[i] = slotToDense[i];
+            newSlotGeneration[i] = slotGeneration[i];
+        }
+        for (int i = 0; i < freeCount; i++) {
+            newFreeSlots[i] = freeSlots[i];
+        }
+        
+        freeArrays();
+        
+        items = newItems;
+        denseToSlot = newDenseToSlot;
+        slotToDense = newSlotToDense;
+        slotGeneration = newSlotGeneration;
+        freeSlots = newFreeSlots;
+        capacity = newCapacity;
+        
+        // Keep the index at most half full
+        if (indexCapacity < capacity * 2) {
+            rebuildIndex(capacity * 2);
+        }
+    }
+    
+    // Returns the dense position for a handle, or -1 if the handle is null or stale
+    int denseIndexOf(MenuHandle handle) const {
+        if (handle.slot < 0 || handle.slot >= slotCount) {
+            return -1;
+        }
+        if (slotGeneration[handle.slot] != handle.generation) {
+            return -1;
+        }
+        return slotToDense[handle.slot];
+    }
+    
+public:
+    // Constructor - initializes an empty store
+    MenuStore() : items(nullptr), denseToSlot(nullptr), slotToDense(nullptr), slotGeneration(nullptr),
+                  freeSlots(nullptr), freeCount(0), slotCount(0), size(0), capacity(0),
+                  idIndex(nullptr), indexCapacity(0) {
+        rebuildIndex(16);
+    }
+    
+    // The store owns raw arrays, so copying is not allowed
+    MenuStore(const MenuStore&) = delete;
+    MenuStore& operator=(const MenuStore&) = delete;
+    
+    // Destructor - frees all arrays
+    ~MenuStore() {
+        freeArrays();
+        MemoryTracker::freeArray(MEM_MENU, idIndex, indexCapacity);
+    }
+    
+    // Returns the current number of menu items
+    int getSize() const {
+        return size;
+    }
+    
+    // Checks if the store contains no items
+    bool isEmpty() const {
+        return size == 0;
+    }
+    
+    // Adds a menu item at the end of the menu and returns its handle
+    // The caller is responsible for rejecting duplicate IDs first
+    MenuHandle add(const MenuItem& item) {
+        reserve(size + 1);
+        
+        // Reuse a free slot if possible, otherwise take a new one
+        int slot;
+        if (freeCount > 0) {
+            slot = freeSlots[--freeCount];
+        } else {
+            slot = slotCount++;
+            slotGeneration[slot] = 0;
+        }
+        
+        items[size] = item;
+        denseToSlot[size] = slot;
+        slotToDense[slot] = size;
+        idIndex[indexPosition(item.id)] = slot;
+        size++;
+        
+        return MenuHandle(slot, slotGeneration[slot]);
+    }
+    
+    // Returns the handle of the item with the given ID, or a null handle if not found
+    MenuHandle findHandle(const ItemID& id) const {
+        int slot = slotOf(id);
+        if (slot == -1) {
+            return MenuHandle();
+        }
+        return MenuHandle(slot, slotGeneration[slot]);
+    }
+    
+    // Returns the item for a handle, or nullptr if the item has been removed
+    // The pointer is valid until the next add or remove
+    const MenuItem* get(MenuHandle handle) const {
+        int dense = denseIndexOf(handle);
+        return (dense == -1) ? nullptr : &items[dense];
+    }
+    
+    // Returns the item with the given ID without copying it, or nullptr if not found
+    // The pointer is valid until the next add or remove
+    const MenuItem* findById(const ItemID& id) const {
+        int slot = slotOf(id);
+        return (slot == -1) ? nullptr : &items[slotToDense[slot]];
+    }
+    
+    // Replaces the item with the same ID in place, keeping its menu position and handle
+    // Returns true if found and updated, false if not found
+    bool update(const MenuItem& item) {
+        int slot = slotOf(item.id);
+        if (slot == -1) {
+            return false;
+        }
+        items[slotToDense[slot]] = item;
+        return true;
+    }
+    
+    // Removes the item with the given ID, keeping the order of the remaining items
+    // Handles to the removed item become stale, handles to all other items stay valid
+    // Returns true if found and removed, false if not found
+    bool remove(const ItemID& id) {
+        int slot = slotOf(id);
+        if (slot == -1) {
+            return false;
+        }
+        
+        // Shift the following items down by one position
+        for (int i = slotToDense[slot]; i < size - 1; i++) {
+            items[i] = std::move(items[i + 1]);
+            denseToSlot[i] = denseToSlot[i + 1];
+            slotToDense[denseToSlot[i]] = i;
+        }
+        size--;
+        items[size] = MenuItem(); // Release the strings of the vacated element
+        
+        // Retire the slot so outstanding handles no longer resolve
+        slotToDense[slot] = -1;
+        slotGeneration[slot]++;
+        freeSlots[freeCount++] = slot;
+        
+        // Linear probing has no simple delete, so rebuild the (small) index
+        rebuildIndex(indexCapacity);
+        return true;
+    }
+    
+    // Returns a read-only view of all items in menu order
+    MenuItemSpan getItems() const {
+        return MenuItemSpan(items, size);
+    }
+    
+    // Returns the handle of the item at a menu position (0 <= position < getSize())
+    MenuHandle handleAt(int position) const {
+        int slot = denseToSlot[position];
+        return MenuHandle(slot, slotGeneration[slot]);
+    }
+};
+
+// One use of a food item in a recipe, as recorded by IngredientIndex
+struct IngredientUse {
+    MenuHandle handle;   // Menu item whose recipe uses the food item
+    int quantity;        // Quantity the recipe needs for one serving
+    
+    // Default constructor
+    IngredientUse() : quantity(0) {}
+    
+    // Parameterized constructor
+    IngredientUse(MenuHandle _handle, int _quantity) : handle(_handle), quantity(_quantity) {}
+};
+
+// Read-only view over the uses of one food item
+// Valid until the next change to the index it came from
+struct IngredientUseSpan {
+    const IngredientUse* uses;   // First use in the range
+    int count;                   // Number of uses in the range
+    
+    // Constructor
+    IngredientUseSpan(const IngredientUse* _uses = nullptr, int _count = 0) : uses(_uses), count(_count) {}
+    
+    int getSize() const {
+        return count;
+    }
+    
+    bool isEmpty() const {
+        return count == 0;
+    }
+    
+    const IngredientUse& operator[](int index) const {
+        return uses[index];
+    }
+    
+    // Iterator support for range-based for loops
+    const IngredientUse* begin() const {
+        return uses;
+    }
+    
+    const IngredientUse* end() const {
+        return uses + count;
+    }
+};
+
+// Reverse index from food item IDs to the menu items whose recipes use them
+// Answers "which dishes need F006, and how much" without scanning every recipe.
+// Keys live in an open-addressing table (linear probing, at most half full); each key owns an
+// array of uses grown by doubling. Keys are never deleted: a food item that no recipe uses any
+// more simply keeps an empty list until clear().
+class IngredientIndex {
+private:
+    // Uses of one food item
+    struct UseList {
+        IngredientUse* uses;   // Array of uses, in no particular order
+        int size;              // Number of uses stored
+        int capacity;          // Capacity of uses
+    };
+    
+    uint32_t* keys;        // Packed food IDs (0 = empty cell)
+    UseList* lists;        // Uses of the food ID in the same cell
+    int tableCapacity;     // Size of the table (power of two)
+    int keyCount;          // Used cells of the table
+    
+    // Finds the table cell of a food ID: its entry or the empty cell to insert into
+    int position(uint32_t code) const {
+        int mask = tableCapacity - 1;
+        int cell = (int)((code * 2654435761u) >> 8) & mask;
+        while (keys[cell] != 0 && keys[cell] != code) {
+            cell = (cell + 1) & mask;
+        }
+        return cell;
+    }
+    
+    // Allocates an empty table of the given size
+    void allocateTable(int capacity) {
+        tableCapacity = capacity;
+        keys = MemoryTracker::allocateArray<uint32_t>(MEM_MENU, tableCapacity);
+        lists = MemoryTracker::allocateArray<UseList>(MEM_MENU, tableCapacity);
+        for (int i = 0; i < tableCapacity; i++) {
+            keys[i] = 0;
+            lists[i].uses = nullptr;
+            lists[i].size = 0;
+            lists[i].capacity = 0;
+        }
+    }
+    
+    // Frees the table and every use list
+    void freeTable() {
+        for (int i = 0; i < tableCapacity; i++) {
+            MemoryTracker::freeArray(MEM_MENU, lists[i].uses, lists[i].capacity);
+        }
+        MemoryTracker::freeArray(MEM_MENU, keys, tableCapacity);
+        MemoryTracker::freeArray(MEM_MENU, lists, tableCapacity);
+    }
+    
+    // Doubles the table, moving the use lists over without copying their entries
+    void grow() {
+        uint32_t* oldKeys = keys;
+        UseList* oldLists = lists;
+        int oldCapacity = tableCapacity;
+        
+        allocateTable(oldCapacity * 2);
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldKeys[i] != 0) {
+                int cell = position(oldKeys[i]);
+                keys[cell] = oldKeys[i];
+                lists[cell] = oldLists[i];
+            }
+        }
+        
+        MemoryTracker::freeArray(MEM_MENU, oldKeys, oldCapacity);
+        MemoryTracker::freeArray(MEM_MENU, oldLists, oldCapacity);
+    }
+    
+    // Appends one use to the list of a food ID, adding the key if needed
+    void addUse(const ItemID& foodId, MenuHandle handle, int quantity) {
+        uint32_t code = foodId.getCode();
+        if (code == 0) {
+            return; // Empty ingredient IDs are not indexed
+        }
+        int cell = position(code);
+        if (keys[cell] == 0) {
+            if ((keyCount + 1) * 2 > tableCapacity) {
+                grow();
+                cell = position(code);
+            }
+            keys[cell] = code;
+            keyCount++;
+        }
+        
+        UseList& list = lists[cell];
+        if (list.size == list.capacity) {
+            int newCapacity = (list.capacity == 0) ? 4 : list.capacity * 2;
+            IngredientUse* newUses = MemoryTracker::allocateArray<IngredientUse>(MEM_MENU, newCapacity);
+            for (int i = 0; i < list.size; i++) {
+                newUses[i] = list.uses[i];
+            }
+            MemoryTracker::freeArray(MEM_MENU, list.uses, list.capacity);
+            list.uses = newUses;
+            list.capacity = newCapacity;
+        }
+        list.uses[list.size++] = IngredientUse(handle, quantity);
+    }
+    
+    // Removes every use by the given handle from the list of a food ID (swap with the last entry)
+    void removeUses(const ItemID& foodId, MenuHandle handle) {
+        int cell = position(foodId.getCode());
+        if (keys[cell] == 0) {
+            return;
+        }
+        UseList& list = lists[cell];
+        int i = 0;
+        while (i < list.size) {
+            if (list.uses[i].handle.slot == handle.slot) {
+                list.uses[i] = list.uses[--list.size];
+            } else {
+                i++;
+            }
+        }
+    }
+    
+public:
+    // Constructor - initializes an empty index
+    IngredientIndex() : keys(nullptr), lists(nullptr), tableCapacity(0), keyCount(0) {
+        allocateTable(64);
+    }
+    
+    // The index owns raw arrays, so copying is not allowed
+    IngredientIndex(const IngredientIndex&) = delete;
+    IngredientIndex& operator=(const IngredientIndex&) = delete;
+    
+    // Destructor - frees the table and all use lists
+    ~IngredientIndex() {
+        freeTable();
+    }
+    
+    // Records every ingredient of a menu item under its handle
+    // A food ID listed more than once in the recipe is recorded once with the summed quantity
+    void addItem(MenuHandle handle, const MenuItem& item) {
+        int count = item.getIngredientCount();
+        for (int i = 0; i < count; i++) {
+            const ItemID& foodId = item.ingredients[i].foodId;
+            if (item.ingredients.indexOf(foodId) != i) {
+                continue;
+            }
+            addUse(foodId, handle, item.getRequiredQuantityAt(i));
+        }
+    }
+    
+    // Forgets the ingredients of a menu item; item must be the recipe that was indexed
+    // Cost is proportional to the number of dishes sharing its ingredients, not the menu size
+    void removeItem(MenuHandle handle, const MenuItem& item) {
+        for (int i = 0; i < item.getIngredientCount(); i++) {
+            removeUses(item.ingredients[i].foodId, handle);
+        }
+    }
+    
+    // Returns the menu items that use a food item with their quantities
+    IngredientUseSpan getUses(const ItemID& foodId) const {
+        int cell = position(foodId.getCode());
+        if (keys[cell] == 0) {
+            return IngredientUseSpan();
+        }
+        return IngredientUseSpan(lists[cell].uses, lists[cell].size);
+    }
+    
+    // Returns the number of distinct food IDs ever indexed since the last clear
+    int getKeyCount() const {
+        return keyCount;
+    }
+    
+    // Removes all keys and uses
+    void clear() {
+        freeTable();
+        keyCount = 0;
+        allocateTable(64);
+    }
+};
+
+// Node structure for linked queue
+// Basic building block for the ADTLinkedQueue class
+struct Node {
+    FoodItem data;      // The food item stored in this node
+    Node* next;         // Pointer to the next node in the queue
+    
+    // Constructor initializes node with a food item and null next pointer
+    Node(const FoodItem& item) : data(item), next(nullptr) {}
+    
+    // Queue nodes make up the inventory, so their memory is charged to it
+    static void* operator new(size_t bytes) {
+        void* memory = ::operator new(bytes);
+        MemoryTracker::recordAllocation(MEM_INVENTORY, bytes);
+        return memory;
+    }
+    
+    static void operator delete(void* memory, size_t bytes) {
+        MemoryTracker::recordFree(MEM_INVENTORY, bytes);
+        ::operator delete(memory);
+    }
+};
+
+// Linked Queue for processing inventory items with FIFO order
+// Implements a First-In-First-Out (FIFO) structure for food items
+class ADTLinkedQueue {
+private:
+    Node *front, *rear;  // Pointers to the front and rear of the queue
+    int size;            // Current number of elements in the queue
+    int totalQuantity;   // Quantity summed over all elements, kept up to date by every change
+
+public:
+    // Constructor - initializes an empty queue
+    ADTLinkedQueue() : front(nullptr), rear(nullptr), size(0), totalQuantity(0) {}
+    
+    // Copy constructor - performs deep copy of another queue
+    ADTLinkedQueue(const ADTLinkedQueue& other) : front(nullptr), rear(nullptr), size(0), totalQuantity(0) {
+        // Copy nodes from other queue in order
+        Node* current = other.front;
+        while (current != nullptr) {
+            enqueue(current->data);
+            current = current->next;
+        }
+    }
+    
+    // Destructor - cleans up all nodes to prevent memory leaks
+    ~ADTLinkedQueue() {
+        while (!isEmpty()) {
+            dequeue();
+        }
+    }
+    
+    // Bucket versions are allocated one queue at a time, charged to the inventory like their nodes
+    static void* operator new(size_t bytes) {
+        void* memory = ::operator new(bytes);
+        MemoryTracker::recordAllocation(MEM_INVENTORY, bytes);
+        return memory;
+    }
+    
+    static void operator delete(void* memory, size_t bytes) {
+        MemoryTracker::recordFree(MEM_INVENTORY, bytes);
+        ::operator delete(memory);
+    }
+    
+    // Checks if the queue is empty (contains no elements)
+    bool isEmpty() const {
+        return front == nullptr;
+    }
+    
+    // Returns the current number of elements in the queue
+    int getSize() const {
+        return size;
+    }
+    
+    // Returns the quantity summed over all elements in O(1)
+    int getTotalQuantity() const {
+        return totalQuantity;
+    }
+    
+    // Adds a new food item to the end of the queue
+    // Time complexity: O(1)
+    void enqueue(const FoodItem& item) {
+        Node* newNode = new Node(item);
+        
+        if (rear == nullptr) {
+            // Queue is empty, set both front and rear to the new node
+            front = rear = newNode;
+        } else {
+            // Queue has elements, add to the end
+            rear->next = newNode;
+            rear = newNode;
+        }
+        
+        size++;
+        totalQuantity += item.quantity;
+    }
+    
+    // Removes and returns the food item from the front of the queue
+    // Returns an empty FoodItem if the queue is empty
+    // Time complexity: O(1)
+    FoodItem dequeue() {
+        FoodItem item;
+        
+        if (!isEmpty()) {
+            Node* temp = front;
+            item = temp->data;
+            
+            // Move front pointer to the next node
+            front = front->next;
+            
+            // If queue becomes empty, update rear pointer
+            if (front == nullptr) {
+                rear = nullptr;
+            }
+            
+            // Free memory and update size
+            delete temp;
+            size--;
+            totalQuantity -= item.quantity;
+        }
+        
+        return item;
+    }
+    
+    // Returns the food item at the front without removing it
+    // Returns an empty FoodItem if the queue is empty
+    FoodItem peek() const {
+        if (!isEmpty()) {
+            return front->data;
+        }
+        return FoodItem(); // Return empty item if queue is empty
+    }
+
+    // Checks if any batch in the queue has the given ID
+    bool contains(const ItemID& id) const {
+        for (Node* current = front; current != nullptr; current = current->next) {
+            if (current->data.id == id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Consumes up to amount units of the given ID in FIFO order, in place
+    // Batches that are used up are unlinked, other nodes are left untouched
+    // Returns the number of units actually consumed
+    int consume(const ItemID& id, int amount) {
+        int remaining = amount;
+        Node* previous = nullptr;
+        Node* current = front;
+
+        while (current != nullptr && remaining > 0) {
+            Node* next = current->next;
+
+            if (current->data.id != id) {
+                previous = current;
+            } else if (current->data.quantity > remaining) {
+                // Partially consume this batch
+                current->data.quantity -= remaining;
+                remaining = 0;
+                previous = current;
+            } else {
+                // Fully consume this batch and unlink it
+                remaining -= current->data.quantity;
+                if (previous == nullptr) {
+                    front = next;
+                } else {
+                    previous->next = next;
+                }
+                if (rear == current) {
+                    rear = previous;
+                }
+                delete current;
+                size--;
+            }
+
+            current = next;
+        }
+
+        totalQuantity -= amount - remaining;
+        return amount - remaining;
+    }
+
+    // Unlinks every batch with the given ID, keeping the order of the others
+    // Returns the number of batches removed
+    int removeAll(const ItemID& id) {
+        int removed = 0;
+        Node* previous = nullptr;
+        Node* current = front;
+
+        while (current != nullptr) {
+            Node* next = current->next;
+
+            if (current->data.id == id) {
+                if (previous == nullptr) {
+                    front = next;
+                } else {
+                    previous->next = next;
+                }
+                if (rear == current) {
+                    rear = previous;
+                }
+                totalQuantity -= current->data.quantity;
+                delete current;
+                size--;
+                removed++;
+            } else {
+                previous = current;
+            }
+
+            current = next;
+        }
+
+        return removed;
+    }
+
+    // Read-only forward iterator over the queue, from front (oldest) to rear (newest)
+    // Valid until the queue is modified
+    class ConstIterator {
+    private:
+        const Node* current;  // Node the iterator is positioned on, nullptr at the end
+
+    public:
+        ConstIterator(const Node* node = nullptr) : current(node) {}
+
+        const FoodItem& operator*() const { return current->data; }
+        const FoodItem* operator->() const { return &current->data; }
+
+        ConstIterator& operator++() {
+            current = current->next;
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const { return current == other.current; }
+        bool operator!=(const ConstIterator& other) const { return current != other.current; }
+    };
+
+    // Iterators for walking the queue in place without copying it
+    ConstIterator begin() const { return ConstIterator(front); }
+    ConstIterator end() const { return ConstIterator(nullptr); }
+
+    // Creates a dynamically allocated array containing all food items in the queue
+    // Returns nullptr if the queue is empty
+    // Caller is responsible for deleting the returned array
+    FoodItem* toArray() const {
+        if (isEmpty()) {
+            return nullptr;
+        }
+        
+        // Allocate an array of the exact size needed
+        FoodItem* items = nullptr;
+        items = new FoodItem[size];
+        Node* current = front;
+        int index = 0;
+        
+        // Copy each food item into the array in queue order
+        while (current != nullptr) {
+            items[index++] = current->data;
+            current = current->next;
+        }
+        
+        return items;
+    }
+    
+    // Assignment operator - performs deep copy of another queue
+    // Properly handles self-assignment and memory management
+    ADTLinkedQueue& operator=(const ADTLinkedQueue& other) {
+        // Self-assignment check to prevent issues
+        if (this == &other) {
+            return *this; // if same then return same
+        }
+        
+        // Clear current queue contents
+        while (!isEmpty()) {
+            dequeue();
+        }
+        
+        // Copy nodes from other queue in order
+        Node* current = other.front;
+        while (current != nullptr) {
+            enqueue(current->data);
+            current = current->next;
+        }
+        
+        return *this;
+    }
+};
+
+// Sort criteria for food items
+enum FoodSortKey {
+    SORT_BY_NAME,        // Alphabetical, case-insensitive
+    SORT_BY_QUANTITY,    // Ascending quantity
+    SORT_BY_DATE         // Oldest receive date first
+};
+
+// Outcome of consuming one food item (see RestaurantInventorySystem::consumeFoodItem)
+enum UseResult {
+    USE_OK,              // Consumed
+    USE_NOT_FOUND,       // No batch with this ID is stored
+    USE_OUT_OF_STOCK,    // The ID is stored but its batches hold nothing
+    USE_NOT_ENOUGH       // Less in stock than asked for, nothing was consumed
+};
+
+// One published version of a bucket, shared by the inventory and any snapshots still reading it
+typedef shared_ptr<const ADTLinkedQueue> BucketVersion;
+
+// Read-only result of an inventory lookup by ID
+// Points at the oldest batch of the item and carries the quantity summed over all its batches.
+// A view from the live inventory holds the bucket version it read, so it stays valid (showing the
+// item as it was at the lookup) while other threads change or remove the item.
+struct FoodItemView {
+    const FoodItem* firstBatch;  // Oldest batch with this ID, nullptr if the item was not found
+    int totalQuantity;           // Quantity summed across all batches
+    int batchCount;              // Number of batches with this ID
+    BucketVersion bucket;        // Keeps firstBatch alive (empty for views into a snapshot)
+
+    FoodItemView() : firstBatch(nullptr), totalQuantity(0), batchCount(0) {}
+
+    // Checks if the lookup found nothing
+    bool isNull() const {
+        return firstBatch == nullptr;
+    }
+
+    // Shortcut to the details shared by all batches (name, price, category)
+    const FoodItem* operator->() const {
+        return firstBatch;
+    }
+};
+
+// Read-only range over every batch of an inventory snapshot, bucket by bucket
+// Valid as long as the snapshot it came from
+class InventoryBatchRange {
+private:
+    const ADTLinkedQueue* const* buckets;  // The bucket versions of the snapshot
+    int bucketCount;                       // Number of buckets
+
+public:
+    // Iterator that walks each bucket's queue in turn, skipping empty buckets
+    class Iterator {
+    private:
+        const ADTLinkedQueue* const* buckets;
+        int bucketCount;
+        int bucket;                          // Current bucket index, bucketCount at the end
+        ADTLinkedQueue::ConstIterator node;  // Position inside the current bucket
+
+        // Moves forward to the next non-empty bucket if the current one is exhausted
+        void skipEmpty() {
+            while (bucket < bucketCount && node == buckets[bucket]->end()) {
+                bucket++;
+                if (bucket < bucketCount) {
+                    node = buckets[bucket]->begin();
+                }
+            }
+        }
+
+    public:
+        Iterator(const ADTLinkedQueue* const* table, int count, int start)
+            : buckets(table), bucketCount(count), bucket(start) {
+            if (bucket < bucketCount) {
+                node = buckets[bucket]->begin();
+                skipEmpty();
+            }
+        }
+
+        const FoodItem& operator*() const { return *node; }
+        const FoodItem* operator->() const { return &*node; }
+
+        // Returns the bucket the current batch is stored in
+        int getBucket() const { return bucket; }
+
+        Iterator& operator++() {
+            ++node;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return bucket == other.bucket && node == other.node; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    InventoryBatchRange(const ADTLinkedQueue* const* table, int count) : buckets(table), bucketCount(count) {}
+
+    Iterator begin() const { return Iterator(buckets, bucketCount, 0); }
+    Iterator end() const { return Iterator(buckets, bucketCount, bucketCount); }
+};
+
+// Point-in-time, read-only view of the whole inventory (see RestaurantInventorySystem::takeSnapshot)
+// Changes to the inventory publish new bucket versions and never modify the ones held here,
+// so a snapshot can be read for as long as needed without locks. Old versions are freed by
+// reference counting when the last snapshot using them is destroyed.
+class InventorySnapshot {
+private:
+    BucketVersion* versions;         // Version of each bucket at the time of the snapshot
+    const ADTLinkedQueue** queues;   // The same queues as plain pointers, for batch ranges
+    uint32_t* owners;                // Packed ID stored in each bucket, 0 when empty
+    int bucketCount;                 // Number of buckets
+    int batchCount;                  // Total batches across all buckets
+    unsigned long long version;      // Inventory change counter when the snapshot was taken
+    
+    friend class RestaurantInventorySystem;
+    
+    // Empty snapshot with room for count buckets, filled in by the inventory
+    explicit InventorySnapshot(int count) : bucketCount(count), batchCount(0), version(0) {
+        versions = MemoryTracker::allocateArray<BucketVersion>(MEM_SORT_SCRATCH, count);
+        queues = MemoryTracker::allocateArray<const ADTLinkedQueue*>(MEM_SORT_SCRATCH, count);
+        owners = MemoryTracker::allocateArray<uint32_t>(MEM_SORT_SCRATCH, count);
+    }
+    
+    // Records the version of one bucket and the ID stored in it
+    void setBucket(int bucket, const BucketVersion& bucketVersion, uint32_t ownerCode) {
+        versions[bucket] = bucketVersion;
+        queues[bucket] = bucketVersion.get();
+        owners[bucket] = ownerCode;
+        batchCount += bucketVersion->getSize();
+    }
+    
+public:
+    // Snapshots are moved, not copied
+    InventorySnapshot(InventorySnapshot&& other)
+        : versions(other.versions), queues(other.queues), owners(other.owners), bucketCount(other.bucketCount),
+          batchCount(other.batchCount), version(other.version) {
+        other.versions = nullptr;
+        other.queues = nullptr;
+        other.owners = nullptr;
+        other.bucketCount = 0;
+        other.batchCount = 0;
+    }
+    InventorySnapshot(const InventorySnapshot&) = delete;
+    InventorySnapshot& operator=(const InventorySnapshot&) = delete;
+    
+    // Releases this snapshot's hold on the bucket versions
+    ~InventorySnapshot() {
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, versions, bucketCount);
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, queues, bucketCount);
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, owners, bucketCount);
+    }
+    
+    // Read-only range over every batch, bucket by bucket
+    InventoryBatchRange getBatches() const {
+        return InventoryBatchRange(queues, bucketCount);
+    }
+    
+    // Contents of one bucket
+    const ADTLinkedQueue& getBucket(int bucket) const {
+        return *queues[bucket];
+    }
+    
+    int getBucketCount() const { return bucketCount; }
+    int getBatchCount() const { return batchCount; }
+    unsigned long long getVersion() const { return version; }
+    
+    // Looks up an ID in the snapshot
+    // Returns: a view of the oldest batch with the quantity summed over all batches, or a null view
+    // Note: Scans the compact owner array, so it is cheap and safe to call from many threads at once;
+    //       the view is valid as long as the snapshot
+    FoodItemView findFoodItem(const ItemID& id) const {
+        FoodItemView result;
+        uint32_t code = id.getCode();
+        
+        for (int b = 0; b < bucketCount; b++) {
+            if (owners[b] != code) continue;
+            
+            for (const FoodItem& item : *queues[b]) {
+                if (item.id == id) {
+                    if (result.isNull()) {
+                        result.firstBatch = &item;
+                    }
+                    result.totalQuantity += item.quantity;
+                    result.batchCount++;
+                }
+            }
+            break;
+        }
+        
+        return result;
+    }
+};
+
+/**
+ * Background logger for usage_history.txt with group commit
+ * Callers only copy a record into a bounded in-memory ring; a background thread collects
+ * whatever has accumulated, formats it and appends the whole group with one write (and an
+ * optional fsync). When the ring is full, callers wait for the next commit instead of using
+ * more memory. Every accepted record is written before the logger is destroyed.
+ */
+class UsageLogger {
+private:
+    // One usage record, formatted only when its group is committed
+    struct UsageRecord {
+        int64_t timestamp;   // When the usage happened (epoch seconds)
+        ItemID id;           // Food item used
+        string name;         // Food item name at the time of use
+        int amount;          // Quantity used
+        string purpose;      // Why it was used
+        
+        UsageRecord() : timestamp(0), amount(0) {}
+    };
+    
+    static const int RING_CAPACITY = 1024;                 // Most records waiting at any time
+    static const int COMMIT_INTERVAL_MS = 50;              // Longest a record waits before its group is written
+    static const int EAGER_COMMIT_RECORDS = RING_CAPACITY / 4;  // Commit early once this many are waiting
+    
+    string filename;
+    bool syncEachBatch;          // fsync after every group, for durability across power loss (guarded by lock)
+    FILE* file;                  // Opened on the first commit, so an unused logger creates no file
+    
+    UsageRecord* ring;           // Waiting records (circular)
+    UsageRecord* batch;          // Records being committed, owned by the writer thread
+    int head;                    // Index of the oldest waiting record
+    int count;                   // Number of waiting records
+    
+    unsigned long long acceptedRecords;   // Records handed to log so far
+    unsigned long long committedRecords;  // Records written so far
+    unsigned long long committedGroups;   // Writes issued so far
+    unsigned long long failedRecords;     // Records lost because their group could not be written
+    unsigned long long syncedGroups;      // Groups that were also synced to disk
+    bool stopping;
+    bool flushRequested;
+    
+    mutex lock;
+    condition_variable writerWake;   // Signals the writer that records are waiting or it must stop
+    condition_variable spaceFreed;   // Signals callers that a group was taken out of the ring
+    condition_variable committed;    // Signals flush callers that a group was written
+    thread writer;
+    
+    // Formats and writes one group (synced to disk if sync is set)
+    // Returns false if the file could not be written or synced
+    bool commit(int records, bool sync) {
+        TraceSpan span("writeUsageGroup", "usage_log", ItemID(), records);
+        if (file == nullptr) {
+            file = fopen(filename.c_str(), "a");
+            if (file == nullptr) {
+                return false;
+            }
+        }
+        
+        // Format the whole group in memory, then write it with a single call
+        string text;
+        text.reserve((size_t)records * 96);
+        for (int i = 0; i < records; i++) {
+            const UsageRecord& record = batch[i];
+            text += FoodItem::formatDate(record.timestamp);
+            text += ',';
+            text += record.id.toString();
+            text += ',';
+            text += record.name;
+            text += ',';
+            text += to_string(record.amount);
+            text += ',';
+            text += record.purpose;
+            text += '\n';
+        }
+        
+        bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+        written = (fflush(file) == 0) && written;
+        if (sync) {
+#ifdef _WIN32
+            written = (_commit(_fileno(file)) == 0) && written;
+#else
+            written = (fsync(fileno(file)) == 0) && written;
+#endif
+        }
+        return written;
+    }
+    
+    // Writer thread body: wait for records, take them all as one group and commit it
+    void writerLoop() {
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            // The constant is copied first: milliseconds binds its argument by reference
+            writerWake.wait_for(guard, chrono::milliseconds((int)COMMIT_INTERVAL_MS), [this]() {
+                return stopping || flushRequested || count >= EAGER_COMMIT_RECORDS;
+            });
+            
+            if (count == 0) {
+                flushRequested = false;
+                if (stopping) {
+                    break;
+                }
+                continue;
+            }
+            
+            // Move the waiting records out so callers can refill the ring while we write
+            int records = count;
+            for (int i = 0; i < records; i++) {
+                batch[i] = move(ring[(head + i) % RING_CAPACITY]);
+            }
+            head = (head + records) % RING_CAPACITY;
+            count = 0;
+            flushRequested = false;
+            bool sync = syncEachBatch;
+            spaceFreed.notify_all();
+            
+            guard.unlock();
+            bool written = commit(records, sync);
+            guard.lock();
+            
+            if (!written) {
+                engineOut() << "Warning: Could not write " << records << " record(s) to " << filename << endl;
+                failedRecords += records;
+            } else {
+                if (sync) {
+                    syncedGroups++;
+                }
+                committedRecords += records;
+                committedGroups++;
+            }
+            committed.notify_all();
+        }
+    }
+    
+public:
+    explicit UsageLogger(const string& historyFile, bool fsyncEachBatch = false)
+        : filename(historyFile), syncEachBatch(fsyncEachBatch), file(nullptr), head(0), count(0),
+          acceptedRecords(0), committedRecords(0), committedGroups(0), failedRecords(0), syncedGroups(0), stopping(false),
+          flushRequested(false) {
+        ring = MemoryTracker::allocateArray<UsageRecord>(MEM_IO_BUFFERS, RING_CAPACITY);
+        batch = MemoryTracker::allocateArray<UsageRecord>(MEM_IO_BUFFERS, RING_CAPACITY);
+        writer = thread(&UsageLogger::writerLoop, this);
+    }
+    
+    // Writes every accepted record, then stops the writer
+    ~UsageLogger() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        writerWake.notify_one();
+        writer.join();
+        
+        if (file != nullptr) {
+            fclose(file);
+        }
+        MemoryTracker::freeArray(MEM_IO_BUFFERS, ring, RING_CAPACITY);
+        MemoryTracker::freeArray(MEM_IO_BUFFERS, batch, RING_CAPACITY);
+    }
+    
+    UsageLogger(const UsageLogger&) = delete;
+    UsageLogger& operator=(const UsageLogger&) = delete;
+    
+    // Queues one usage record, waiting only if the ring is full
+    void log(const ItemID& id, const string& name, int amount, const string& purpose) {
+        unique_lock<mutex> guard(lock);
+        spaceFreed.wait(guard, [this]() { return count < RING_CAPACITY; });
+        
+        UsageRecord& record = ring[(head + count) % RING_CAPACITY];
+        record.timestamp = (int64_t)time(0);
+        record.id = id;
+        record.name = name;
+        record.amount = amount;
+        record.purpose = purpose;
+        count++;
+        acceptedRecords++;
+        
+        if (count >= EAGER_COMMIT_RECORDS) {
+            writerWake.notify_one();
+        }
+    }
+    
+    // Waits until every record logged so far has been handled by the writer
+    // Returns: true if they were all written, false if a group failed while waiting (those
+    //          records are lost, see getFailedRecords); a failure is never reported as written
+    bool flush() {
+        unique_lock<mutex> guard(lock);
+        unsigned long long target = acceptedRecords;
+        unsigned long long failedBefore = failedRecords;
+        if (committedRecords + failedRecords >= target) {
+            return true;
+        }
+        flushRequested = true;
+        writerWake.notify_one();
+        committed.wait(guard, [this, target]() { return committedRecords + failedRecords >= target; });
+        return failedRecords == failedBefore;
+    }
+    
+    // Number of records written and number of writes used for them
+    unsigned long long getCommittedRecords() {
+        lock_guard<mutex> guard(lock);
+        return committedRecords;
+    }
+    
+    unsigned long long getCommittedGroups() {
+        lock_guard<mutex> guard(lock);
+        return committedGroups;
+    }
+    
+    // Turns the fsync after every group on or off, from the next group on
+    void setSyncEachBatch(bool enabled) {
+        lock_guard<mutex> guard(lock);
+        syncEachBatch = enabled;
+    }
+    
+    // Number of groups that were synced to disk
+    unsigned long long getSyncedGroups() {
+        lock_guard<mutex> guard(lock);
+        return syncedGroups;
+    }
+    
+    // Number of records that could not be written (they are not counted as committed)
+    unsigned long long getFailedRecords() {
+        lock_guard<mutex> guard(lock);
+        return failedRecords;
+    }
+};
+
+
+/**
+ * SharedInventorySegment holds a copy of the inventory in named shared memory
+ * Several terminal processes on the same machine attach to one segment, so they all work on
+ * one live inventory instead of each loading food_items.txt and overwriting the others' saves.
+ * The segment mirrors the inventory hash table bucket by bucket: a directory entry per bucket
+ * records its owner, its block of plain batch records (no pointers) and the version of its last
+ * publish. It is guarded by a process-shared mutex, and the segment version changes on every publish.
+ * Each process keeps its in-memory inventory and uses the segment as the source of truth:
+ * under the segment lock it reloads the buckets whose version moved, makes its change, and
+ * publishes only the buckets it changed, so updates from different processes are never lost
+ * and a change costs the size of the buckets it touched, not of the whole inventory.
+ * Linux uses shm_open/mmap with a robust pthread mutex; Windows uses a named file mapping
+ * and a named mutex. In both cases a process that dies holding the lock is detected.
+ */
+class SharedInventorySegment {
+public:
+    static const int BUCKET_COUNT = 101;       // Buckets of the inventory table, mirrored one to one
+    static const int MIN_CAPACITY = 8192;      // Smallest record area, in batches
+    
+    // One inventory batch in a form that can live in shared memory
+    struct BatchRecord {
+        char id[8];
+        char name[64];
+        char category[32];
+        double price;
+        int32_t quantity;
+        int64_t receiveDate;
+    };
+
+private:
+    static const uint32_t MAGIC = 0x524E5632;  // "RNV2", also identifies the layout version
+    
+    // Directory entry of one bucket
+    struct BucketEntry {
+        uint32_t owner;                        // Packed ID stored in the bucket, 0 when empty
+        int32_t offset;                        // First record of the bucket's block
+        int32_t capacity;                      // Records the block can hold
+        int32_t count;                         // Batches stored
+        uint64_t version;                      // Segment version of the bucket's last publish, 0 if never
+        int32_t writing;                       // Set while the block is being rewritten
+    };
+    
+    // Start of the segment, followed by recordCapacity batch records
+    struct Header {
+        atomic<uint32_t> magic;                // Written last by the creator once the segment is ready
+#ifndef _WIN32
+        pthread_mutex_t lock;                  // Process-shared, robust
+#endif
+        atomic<unsigned long long> version;    // Bumped by every publish
+        int32_t recordCapacity;                // Records in the record area
+        int32_t recordsUsed;                   // Records handed out to bucket blocks so far
+        int32_t batchCount;                    // Batches across all buckets
+        atomic<int32_t> attachedProcesses;     // Processes currently attached
+        BucketEntry buckets[BUCKET_COUNT];
+    };
+    
+    string name;
+    Header* header;
+    BatchRecord* records;
+    size_t mappedSize;
+    bool created;                              // This process created (and initialised) the segment
+#ifdef _WIN32
+    HANDLE mapping;
+    HANDLE mutexHandle;
+#endif
+    
+    static size_t segmentSize(int recordCapacity) {
+        return sizeof(Header) + (size_t)recordCapacity * sizeof(BatchRecord);
+    }
+    
+    // Block size for a bucket of the given batch count, with room to grow
+    static int blockSizeFor(int count) {
+        return count + count / 2 + 4;
+    }
+    
+    // Copies text into a fixed field, truncating if needed
+    static void copyText(char* field, size_t fieldSize, const string& text) {
+        size_t length = (text.length() < fieldSize - 1) ? text.length() : fieldSize - 1;
+        text.copy(field, length);
+        field[length] = '\0';
+    }
+    
+    // Maps the named segment, creating it with room for recordCapacity batches if it does not exist yet
+    bool map(int recordCapacity) {
+#ifdef _WIN32
+        size_t requested = segmentSize(recordCapacity);
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)requested, name.c_str());
+        if (mapping == NULL) {
+            return false;
+        }
+        created = (GetLastError() != ERROR_ALREADY_EXISTS);
+        // An existing mapping keeps the size its creator chose, so map all of it
+        void* memory = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, created ? requested : 0);
+        if (memory == NULL) {
+            CloseHandle(mapping);
+            mapping = NULL;
+            return false;
+        }
+        mutexHandle = CreateMutexA(NULL, FALSE, (name + "_lock").c_str());
+        if (mutexHandle == NULL) {
+            UnmapViewOfFile(memory);
+            CloseHandle(mapping);
+            mapping = NULL;
+            return false;
+        }
+        mappedSize = requested;
+#else
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0660);
+        created = (fd != -1);
+        if (!created) {
+            if (errno != EEXIST) {
+                return false;
+            }
+            fd = shm_open(name.c_str(), O_RDWR, 0660);
+            if (fd == -1) {
+                return false;
+            }
+            // The creator may not have sized the segment yet; it chose the size, so map all of it
+            struct stat info;
+            for (int attempt = 0; attempt < 100; attempt++) {
+                if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(Header)) {
+                    break;
+                }
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+            if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Header)) {
+                close(fd);
+                return false;
+            }
+            mappedSize = (size_t)info.st_size;
+        } else {
+            mappedSize = segmentSize(recordCapacity);
+            if (ftruncate(fd, (off_t)mappedSize) != 0) {
+                close(fd);
+                shm_unlink(name.c_str());
+                return false;
+            }
+        }
+        void* memory = mmap(NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);  // The mapping stays valid without the descriptor
+        if (memory == MAP_FAILED) {
+            if (created) {
+                shm_unlink(name.c_str());
+            }
+            return false;
+        }
+#endif
+        header = static_cast<Header*>(memory);
+        records = reinterpret_cast<BatchRecord*>(static_cast<char*>(memory) + sizeof(Header));
+        return true;
+    }
+    
+    // Unmaps the segment; the last process to leave removes it
+    void unmap() {
+        if (header == nullptr) {
+            return;
+        }
+        bool last = (header->attachedProcesses.fetch_sub(1) == 1);
+#ifdef _WIN32
+        (void)last;  // Windows removes the mapping when its last handle is closed
+        UnmapViewOfFile(header);
+        CloseHandle(mutexHandle);
+        CloseHandle(mapping);
+#else
+        munmap(header, mappedSize);
+        if (last) {
+            shm_unlink(name.c_str());
+        }
+#endif
+        header = nullptr;
+        records = nullptr;
+    }
+    
+    // Writes a bucket's batches into its block (hold the lock, the block must be big enough)
+    void writeBucket(int bucket, const ADTLinkedQueue& queue, uint32_t owner, uint64_t version) {
+        BucketEntry& entry = header->buckets[bucket];
+        entry.writing = 1;
+        int count = 0;
+        for (const FoodItem& item : queue) {
+            BatchRecord& record = records[entry.offset + count++];
+            copyText(record.id, sizeof(record.id), item.id.toString());
+            copyText(record.name, sizeof(record.name), item.name);
+            copyText(record.category, sizeof(record.category), item.category);
+            record.price = item.price;
+            record.quantity = item.quantity;
+            record.receiveDate = item.receiveDate;
+        }
+        header->batchCount += count - entry.count;
+        entry.count = count;
+        entry.owner = (count == 0) ? 0 : owner;
+        entry.version = version;
+        entry.writing = 0;
+    }
+    
+    // Packs the blocks of the buckets not being published to the start of the record area and
+    // gives each of them exactly the room it uses; the published buckets are left without a block
+    // Returns the first free record after the packed blocks
+    int compact(const bool* publishing) {
+        // Buckets in the order of their blocks, so each block only ever moves down
+        int order[BUCKET_COUNT];
+        int ordered = 0;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            int position = ordered++;
+            while (position > 0 && header->buckets[order[position - 1]].offset > header->buckets[b].offset) {
+                order[position] = order[position - 1];
+                position--;
+            }
+            order[position] = b;
+        }
+        
+        int cursor = 0;
+        for (int i = 0; i < ordered; i++) {
+            BucketEntry& entry = header->buckets[order[i]];
+            if (publishing[order[i]]) {
+                // Its records are gone until publish rewrites it, which clears the flag
+                entry.writing = 1;
+                entry.offset = 0;
+                entry.capacity = 0;
+                continue;
+            }
+            entry.writing = 1;
+            memmove(&records[cursor], &records[entry.offset], (size_t)entry.count * sizeof(BatchRecord));
+            entry.offset = cursor;
+            entry.capacity = entry.count;
+            cursor += entry.count;
+            entry.writing = 0;
+        }
+        return cursor;
+    }
+
+public:
+    // Constructor - nothing is mapped until attach is called
+    SharedInventorySegment() : header(nullptr), records(nullptr), mappedSize(0), created(false) {
+#ifdef _WIN32
+        mapping = NULL;
+        mutexHandle = NULL;
+#endif
+    }
+    
+    // Destructor - detaches from the segment
+    ~SharedInventorySegment() {
+        unmap();
+    }
+    
+    // The mapping is tied to this object
+    SharedInventorySegment(const SharedInventorySegment&) = delete;
+    SharedInventorySegment& operator=(const SharedInventorySegment&) = delete;
+    
+    // Attaches to the named segment, creating and initialising it if this is the first process
+    // Parameters: segmentName - short name shared by all processes, e.g. "restaurant_inventory"
+    //             expectedBatches - batches the creator is about to publish; the record area is
+    //                               sized to four times that (at least MIN_CAPACITY)
+    // Returns: true if attached, false if the segment could not be created or is not compatible
+    bool attach(const string& segmentName, int expectedBatches) {
+#ifdef _WIN32
+        name = "Local\\" + segmentName;
+#else
+        name = "/" + segmentName;
+#endif
+        int capacity = MIN_CAPACITY;
+        if (expectedBatches > MIN_CAPACITY / 4) {
+            capacity = expectedBatches * 4;
+        }
+        if (!map(capacity)) {
+            engineOut() << "Error: Could not open shared inventory segment " << segmentName << endl;
+            return false;
+        }
+        
+        if (created) {
+#ifndef _WIN32
+            pthread_mutexattr_t attributes;
+            pthread_mutexattr_init(&attributes);
+            pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+            pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+            pthread_mutex_init(&header->lock, &attributes);
+            pthread_mutexattr_destroy(&attributes);
+#endif
+            header->version.store(0);
+            header->recordCapacity = capacity;
+            header->recordsUsed = 0;
+            header->batchCount = 0;
+            header->attachedProcesses.store(0);
+            for (int b = 0; b < BUCKET_COUNT; b++) {
+                BucketEntry& entry = header->buckets[b];
+                entry.owner = 0;
+                entry.offset = 0;
+                entry.capacity = 0;
+                entry.count = 0;
+                entry.version = 0;
+                entry.writing = 0;
+            }
+            header->magic.store(MAGIC, memory_order_release);
+        } else {
+            // Wait for the creator to finish initialising
+            for (int attempt = 0; attempt < 100 && header->magic.load(memory_order_acquire) == 0; attempt++) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+            if (header->magic.load(memory_order_acquire) != MAGIC) {
+                engineOut() << "Error: Shared inventory segment " << segmentName << " has an unknown layout" << endl;
+                header->attachedProcesses.fetch_add(1);
+                unmap();
+                return false;
+            }
+#ifndef _WIN32
+            if (mappedSize < segmentSize(header->recordCapacity)) {
+                engineOut() << "Error: Shared inventory segment " << segmentName << " is truncated" << endl;
+                header->attachedProcesses.fetch_add(1);
+                unmap();
+                return false;
+            }
+#endif
+        }
+        
+        header->attachedProcesses.fetch_add(1);
+        return true;
+    }
+    
+    // Checks if this process created the segment (and should fill it)
+    bool isCreator() const {
+        return created;
+    }
+    
+    // Acquires the segment lock
+    // Returns: false if the lock was held by a process that died; the segment version is then
+    //          brought up to date with the buckets it finished, and the buckets it was halfway
+    //          through report isTorn until the caller publishes them again
+    bool lock() {
+#ifdef _WIN32
+        bool ownerDied = (WaitForSingleObject(mutexHandle, INFINITE) == WAIT_ABANDONED);
+#else
+        bool ownerDied = (pthread_mutex_lock(&header->lock) == EOWNERDEAD);
+        if (ownerDied) {
+            pthread_mutex_consistent(&header->lock);
+        }
+#endif
+        if (ownerDied) {
+            // The dead process may have published buckets without bumping the segment version
+            unsigned long long newest = header->version.load();
+            int batches = 0;
+            for (int b = 0; b < BUCKET_COUNT; b++) {
+                if (header->buckets[b].version > newest) {
+                    newest = header->buckets[b].version;
+                }
+                batches += header->buckets[b].count;
+            }
+            header->batchCount = batches;
+            header->version.store(newest, memory_order_release);
+        }
+        return !ownerDied;
+    }
+    
+    // Releases the segment lock
+    void unlock() {
+#ifdef _WIN32
+        ReleaseMutex(mutexHandle);
+#else
+        pthread_mutex_unlock(&header->lock);
+#endif
+    }
+    
+    // Returns the version of the published records (readable without the lock)
+    unsigned long long getVersion() const {
+        return header->version.load(memory_order_acquire);
+    }
+    
+    // Returns the number of attached processes
+    int getAttachedProcesses() const {
+        return header->attachedProcesses.load();
+    }
+    
+    // Returns the number of published batches (hold the lock)
+    int getBatchCount() const {
+        return header->batchCount;
+    }
+    
+    // Returns the number of batches the record area can hold
+    int getCapacity() const {
+        return header->recordCapacity;
+    }
+    
+    // Directory of one bucket (hold the lock)
+    unsigned long long getBucketVersion(int bucket) const { return header->buckets[bucket].version; }
+    uint32_t getBucketOwner(int bucket) const { return header->buckets[bucket].owner; }
+    int getBucketBatchCount(int bucket) const { return header->buckets[bucket].count; }
+    
+    // Checks if a process died while rewriting this bucket, leaving its records incomplete (hold the lock)
+    bool isTorn(int bucket) const {
+        return header->buckets[bucket].writing != 0;
+    }
+    
+    // Rebuilds batch number index of a bucket from its record (hold the lock)
+    FoodItem readBatch(int bucket, int index) const {
+        const BatchRecord& record = records[header->buckets[bucket].offset + index];
+        return FoodItem(ItemID(record.id), record.name, record.price, record.category,
+                        record.quantity, record.receiveDate);
+    }
+    
+    /**
+     * Publishes new contents for some buckets and bumps the version (hold the lock)
+     * A bucket that outgrows its block gets a new one at the end of the record area; when the
+     * area is used up, the other buckets' blocks are packed together first.
+     * Parameters: bucketList, listSize - the buckets to publish
+     *             queues, owners - contents and owner of every bucket, indexed by bucket
+     * Returns: the new version, or 0 if the buckets do not fit (nothing is changed)
+     */
+    unsigned long long publish(const int* bucketList, int listSize, const ADTLinkedQueue* const* queues,
+                               const uint32_t* owners) {
+        // Room needed by buckets that outgrow their blocks
+        long long needed = 0;
+        for (int i = 0; i < listSize; i++) {
+            int b = bucketList[i];
+            if (queues[b]->getSize() > header->buckets[b].capacity) {
+                needed += blockSizeFor(queues[b]->getSize());
+            }
+        }
+        
+        bool exactBlocks = false;   // Give new blocks no room to grow
+        if (header->recordsUsed + needed > header->recordCapacity) {
+            // Pack the other buckets first; the published ones then all need new blocks
+            bool publishing[BUCKET_COUNT] = {false};
+            long long live = 0;
+            for (int i = 0; i < listSize; i++) {
+                publishing[bucketList[i]] = true;
+                live += queues[bucketList[i]]->getSize();
+            }
+            for (int b = 0; b < BUCKET_COUNT; b++) {
+                if (!publishing[b]) {
+                    live += header->buckets[b].count;
+                }
+            }
+            if (live > header->recordCapacity) {
+                return 0;
+            }
+            header->recordsUsed = compact(publishing);
+            
+            long long withRoom = 0;
+            for (int i = 0; i < listSize; i++) {
+                int count = queues[bucketList[i]]->getSize();
+                withRoom += (count > 0) ? blockSizeFor(count) : 0;
+            }
+            exactBlocks = (header->recordsUsed + withRoom > header->recordCapacity);
+        }
+        
+        unsigned long long version = header->version.load() + 1;
+        for (int i = 0; i < listSize; i++) {
+            int b = bucketList[i];
+            BucketEntry& entry = header->buckets[b];
+            int count = queues[b]->getSize();
+            entry.writing = 1;
+            if (count > entry.capacity) {
+                int block = exactBlocks ? count : blockSizeFor(count);
+                entry.offset = header->recordsUsed;
+                entry.capacity = block;
+                header->recordsUsed += block;
+            }
+            writeBucket(b, *queues[b], owners[b], version);
+        }
+        header->version.store(version, memory_order_release);
+        return version;
+    }
+};
+
+// Universal Hash Function constants
+const int PRIME = 31;
+const int MAX_HASH_KEY = 101; // Prime number for hash table size
+
+// Quality of the inventory hash table on the data currently loaded (see computeHashDiagnostics)
+struct HashDiagnostics {
+    static const int PROBE_HISTOGRAM = 5;     // Probe lengths 1, 2, 3, 4 and 5 or more
+    static const int CHAIN_HISTOGRAM = 6;     // Batches per bucket 1, 2-4, 5-16, 17-64, 65-256, 257+
+    
+    int tableSize;                  // Number of buckets
+    int idCount;                    // Occupied buckets (one ID each)
+    int batchCount;                 // Batches across all buckets
+    double loadFactor;              // idCount / tableSize
+    
+    // Successful lookups: buckets findHome examines before it reaches an ID's home
+    double averageProbeLength;
+    int maxProbeLength;
+    int displacedIds;               // IDs not stored in the bucket they hash to
+    int probeLengthCounts[PROBE_HISTOGRAM];
+    double expectedProbeLength;     // Quadratic probing with an ideal hash at this load factor
+    
+    // Unsuccessful lookups
+    int missProbeLength;            // Buckets findHome examines for an ID that is not stored
+    double missProbeIfStopAtEmpty;  // Average if lookups could stop at the first empty bucket
+    int reachableBuckets;           // Distinct buckets on one probe sequence
+    
+    // Hash values
+    int distinctHashValues;         // Different home buckets the stored IDs hash to
+    int observedCollisions;         // IDs whose hash value an earlier ID already has
+    double expectedCollisions;      // For idCount keys hashed uniformly into tableSize buckets
+    int maxIdsPerHashValue;
+    
+    // Chains (the batch queue of each occupied bucket)
+    int minChainLength;
+    int maxChainLength;
+    double averageChainLength;
+    int chainLengthCounts[CHAIN_HISTOGRAM];
+    
+    // Placement invariant: every batch of an ID lives in its home bucket
+    int splitIds;                   // IDs with batches outside their home bucket
+    int strayBatches;               // Batches stored in a bucket that belongs to another (or no) ID
+    
+    // Primary clustering: runs of adjacent occupied buckets (wrapping around)
+    int clusterCount;
+    int longestCluster;
+    
+    // Default constructor - all zero
+    HashDiagnostics() : tableSize(0), idCount(0), batchCount(0), loadFactor(0.0), averageProbeLength(0.0),
+        maxProbeLength(0), displacedIds(0), expectedProbeLength(0.0), missProbeLength(0),
+        missProbeIfStopAtEmpty(0.0), reachableBuckets(0), distinctHashValues(0), observedCollisions(0),
+        expectedCollisions(0.0), maxIdsPerHashValue(0), minChainLength(0), maxChainLength(0),
+        averageChainLength(0.0), splitIds(0), strayBatches(0), clusterCount(0), longestCluster(0) {
+        for (int i = 0; i < PROBE_HISTOGRAM; i++) probeLengthCounts[i] = 0;
+        for (int i = 0; i < CHAIN_HISTOGRAM; i++) chainLengthCounts[i] = 0;
+    }
+};
+
+// Stock of one food item measured against its reorder threshold
+struct ReorderLevel {
+    ItemID id;        // Food item
+    int stock;        // Total quantity across its batches
+    int threshold;    // Reorder once the stock is at or below this level
+    
+    // Default constructor
+    ReorderLevel() : stock(0), threshold(0) {}
+    
+    // Parameterized constructor
+    ReorderLevel(const ItemID& _id, int _stock, int _threshold) : id(_id), stock(_stock), threshold(_threshold) {}
+    
+    // Units above the threshold (0 or less means it is time to reorder)
+    int getMargin() const {
+        return stock - threshold;
+    }
+    
+    // Checks if the item has reached its reorder threshold
+    bool isLow() const {
+        return stock <= threshold;
+    }
+};
+
+/**
+ * ReorderHeap keeps food items ordered by stock minus reorder threshold
+ * An indexed binary min-heap: every entry knows its heap position, so a stock or threshold change
+ * moves one entry up or down in O(log n) instead of re-sorting the inventory, and the k items
+ * closest to (or furthest below) their threshold are read in O(k log k) without touching the heap.
+ * Entries are found through an open-addressing table keyed by the packed ID.
+ * Each entry also remembers whether it was last announced as low, so callers report only real
+ * crossings of the threshold and can hold announcements back (e.g. during a load) without losing them.
+ */
+class ReorderHeap {
+public:
+    static const int DEFAULT_THRESHOLD = 0;   // Without a threshold an item is low once it runs out
+    
+    // Change of an item's state relative to what was last announced
+    enum Crossing {
+        CROSS_NONE,       // Nothing to announce
+        CROSS_LOW,        // Reached its threshold
+        CROSS_RESTOCKED   // Back above its threshold
+    };
+    
+private:
+    // One food item
+    struct Entry {
+        ItemID id;
+        int stock;
+        int threshold;
+        bool hasThreshold;    // Threshold was set explicitly (saved with the thresholds)
+        bool announcedLow;    // Low state last announced
+        int heapPosition;     // Index of this entry in heap
+        string name;          // Last known name, kept for items that ran out
+        
+        Entry() : stock(0), threshold(DEFAULT_THRESHOLD), hasThreshold(false), announcedLow(false), heapPosition(-1) {}
+    };
+    
+    Entry* entries;       // Entries in the order they were added
+    int entryCount;       // Number of entries
+    int entryCapacity;    // Capacity of entries and heap
+    int* heap;            // Entry indices, ordered as a binary min-heap
+    int* slots;           // Open-addressing table of entry indices (-1 = empty), linear probing
+    int slotCapacity;     // Size of slots (power of two, kept at most half full)
+    int lowCount;         // Entries currently at or below their threshold
+    
+    // Finds the table cell of an ID: its entry or the empty cell to insert into
+    int slotPosition(const ItemID& id) const {
+        int mask = slotCapacity - 1;
+        int position = (int)(id.hash() >> 8) & mask;
+        while (slots[position] != -1 && !(entries[slots[position]].id == id)) {
+            position = (position + 1) & mask;
+        }
+        return position;
+    }
+    
+    // Heap order: smaller margin first, ties broken by ID so the order is stable
+    bool before(int a, int b) const {
+        int marginA = entries[a].stock - entries[a].threshold;
+        int marginB = entries[b].stock - entries[b].threshold;
+        if (marginA != marginB) {
+            return marginA < marginB;
+        }
+        return entries[a].id.getCode() < entries[b].id.getCode();
+    }
+    
+    // Places an entry at a heap position and records the position in the entry
+    void place(int position, int entry) {
+        heap[position] = entry;
+        entries[entry].heapPosition = position;
+    }
+    
+    void siftUp(int position) {
+        int entry = heap[position];
+        while (position > 0) {
+            int parent = (position - 1) / 2;
+            if (!before(entry, heap[parent])) {
+                break;
+            }
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, entry);
+    }
+    
+    void siftDown(int position) {
+        int entry = heap[position];
+        while (true) {
+            int child = position * 2 + 1;
+            if (child >= entryCount) {
+                break;
+            }
+            if (child + 1 < entryCount && before(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!before(heap[child], entry)) {
+                break;
+            }
+            place(position, heap[child]);
+            position = child;
+        }
+        place(position, entry);
+    }
+    
+    // Rebuilds the ID table with the given size
+    void rebuildSlots(int newSlotCapacity) {
+        MemoryTracker::freeArray(MEM_INVENTORY, slots, slotCapacity);
+        slotCapacity = newSlotCapacity;
+        slots = MemoryTracker::allocateArray<int>(MEM_INVENTORY, slotCapacity);
+        for (int i = 0; i < slotCapacity; i++) {
+            slots[i] = -1;
+        }
+        for (int i = 0; i < entryCount; i++) {
+            slots[slotPosition(entries[i].id)] = i;
+        }
+    }
+    
+    // Returns the entry of an ID, adding it (stock 0, default threshold) if it is new
+    int findOrAdd(const ItemID& id) {
+        int position = slotPosition(id);
+        if (slots[position] != -1) {
+            return slots[position];
+        }
+        
+        if (entryCount == entryCapacity) {
+            int newCapacity = (entryCapacity == 0) ? 16 : entryCapacity * 2;
+            Entry* newEntries = MemoryTracker::allocateArray<Entry>(MEM_INVENTORY, newCapacity);
+            int* newHeap = MemoryTracker::allocateArray<int>(MEM_INVENTORY, newCapacity);
+            for (int i = 0; i < entryCount; i++) {
+                newEntries[i] = std::move(entries[i]);
+                newHeap[i] = heap[i];
+            }
+            MemoryTracker::freeArray(MEM_INVENTORY, entries, entryCapacity);
+            MemoryTracker::freeArray(MEM_INVENTORY, heap, entryCapacity);
+            entries = newEntries;
+            heap = newHeap;
+            entryCapacity = newCapacity;
+            if (slotCapacity < entryCapacity * 2) {
+                rebuildSlots(entryCapacity * 2);
+                position = slotPosition(id);
+            }
+        }
+        
+        int entry = entryCount++;
+        entries[entry] = Entry();
+        entries[entry].id = id;
+        slots[position] = entry;
+        place(entry, entry);
+        lowCount++; // Stock 0 is at or below any threshold
+        siftUp(entry);
+        return entry;
+    }
+    
+    // Applies a new stock or threshold to an entry: restores the heap order, updates the low
+    // count and, if announce is set, returns (and records) a crossing of the threshold
+    Crossing settle(int entry, int oldStock, int oldThreshold, bool announce) {
+        Entry& item = entries[entry];
+        bool wasLow = oldStock <= oldThreshold;
+        bool low = item.stock <= item.threshold;
+        if (wasLow != low) {
+            lowCount += low ? 1 : -1;
+        }
+        
+        int oldMargin = oldStock - oldThreshold;
+        int margin = item.stock - item.threshold;
+        if (margin < oldMargin) {
+            siftUp(item.heapPosition);
+        } else if (margin > oldMargin) {
+            siftDown(item.heapPosition);
+        }
+        
+        if (!announce || item.announcedLow == low) {
+            return CROSS_NONE;
+        }
+        item.announcedLow = low;
+        return low ? CROSS_LOW : CROSS_RESTOCKED;
+    }
+    
+    // Fills a level from an entry
+    ReorderLevel levelOf(int entry) const {
+        return ReorderLevel(entries[entry].id, entries[entry].stock, entries[entry].threshold);
+    }
+    
+public:
+    // Constructor - initializes an empty heap
+    ReorderHeap() : entries(nullptr), entryCount(0), entryCapacity(0), heap(nullptr),
+                    slots(nullptr), slotCapacity(0), lowCount(0) {
+        rebuildSlots(32);
+    }
+    
+    // The heap owns raw arrays, so copying is not allowed
+    ReorderHeap(const ReorderHeap&) = delete;
+    ReorderHeap& operator=(const ReorderHeap&) = delete;
+    
+    // Destructor - frees all arrays
+    ~ReorderHeap() {
+        MemoryTracker::freeArray(MEM_INVENTORY, entries, entryCapacity);
+        MemoryTracker::freeArray(MEM_INVENTORY, heap, entryCapacity);
+        MemoryTracker::freeArray(MEM_INVENTORY, slots, slotCapacity);
+    }
+    
+    // Returns the number of food items in the heap
+    int getSize() const {
+        return entryCount;
+    }
+    
+    // Returns the number of food items at or below their threshold
+    int getLowCount() const {
+        return lowCount;
+    }
+    
+    /**
+     * Records the current stock of a food item in O(log n)
+     * Parameters: id - Food item (added if new)
+     *             stock - Its total stock
+     *             name - Its name, or nullptr if not known (the last known name is kept)
+     *             announce - false to leave the announced state alone, so a later call or
+     *             announcePending reports the crossing instead
+     *             level - Receives the item's stock and threshold
+     * Return: The threshold crossing to announce, if any
+     */
+    Crossing updateStock(const ItemID& id, int stock, const string* name, bool announce, ReorderLevel& level) {
+        int entry = findOrAdd(id);
+        Entry& item = entries[entry];
+        if (name != nullptr && item.name != *name) {
+            item.name = *name;
+        }
+        int oldStock = item.stock;
+        item.stock = stock;
+        Crossing crossing = settle(entry, oldStock, item.threshold, announce);
+        level = levelOf(entry);
+        return crossing;
+    }
+    
+    // Sets the reorder threshold of a food item in O(log n), see updateStock for the parameters
+    Crossing setThreshold(const ItemID& id, int threshold, bool announce, ReorderLevel& level) {
+        int entry = findOrAdd(id);
+        Entry& item = entries[entry];
+        int oldThreshold = item.threshold;
+        item.threshold = threshold;
+        item.hasThreshold = true;
+        Crossing crossing = settle(entry, item.stock, oldThreshold, announce);
+        level = levelOf(entry);
+        return crossing;
+    }
+    
+    // Looks up a food item; returns false if it is not in the heap
+    bool find(const ItemID& id, ReorderLevel& level) const {
+        int entry = slots[slotPosition(id)];
+        if (entry == -1) {
+            return false;
+        }
+        level = levelOf(entry);
+        return true;
+    }
+    
+    // Returns the last known name of a food item (empty if never seen in stock)
+    const string& getName(const ItemID& id) const {
+        static const string unknown;
+        int entry = slots[slotPosition(id)];
+        return (entry == -1) ? unknown : entries[entry].name;
+    }
+    
+    /**
+     * Copies the k items with the smallest margin (stock - threshold), smallest first
+     * Walks the heap with a small candidate heap: each step takes the best candidate and offers
+     * its two children, so only O(k) heap nodes are visited and the heap itself is not modified.
+     * Parameters: k - Number of items wanted
+     *             results - Array with room for k levels
+     * Return: Number of levels copied (less than k if the heap is smaller)
+     */
+    int lowest(int k, ReorderLevel* results) const {
+        if (k > entryCount) {
+            k = entryCount;
+        }
+        if (k <= 0) {
+            return 0;
+        }
+        
+        // Candidate heap of heap positions, ordered by their entries
+        int* candidates = MemoryTracker::allocateArray<int>(MEM_SORT_SCRATCH, k + 1);
+        int candidateCount = 0;
+        candidates[candidateCount++] = 0;
+        
+        int found = 0;
+        while (found < k) {
+            // Take the best candidate
+            int position = candidates[0];
+            results[found++] = levelOf(heap[position]);
+            
+            // Replace it with its first child (or the last candidate) and sift down
+            int child = position * 2 + 1;
+            int replacement = (child < entryCount) ? child : candidates[--candidateCount];
+            int hole = 0;
+            while (true) {
+                int next = hole * 2 + 1;
+                if (next >= candidateCount) {
+                    break;
+                }
+                if (next + 1 < candidateCount && before(heap[candidates[next + 1]], heap[candidates[next]])) {
+                    next++;
+                }
+                if (!before(heap[candidates[next]], heap[replacement])) {
+                    break;
+                }
+                candidates[hole] = candidates[next];
+                hole = next;
+            }
+            if (candidateCount > 0) {
+                candidates[hole] = replacement;
+            }
+            
+            // Offer the second child
+            if (child + 1 < entryCount && candidateCount < k + 1) {
+                int slot = candidateCount++;
+                while (slot > 0 && before(heap[child + 1], heap[candidates[(slot - 1) / 2]])) {
+                    candidates[slot] = candidates[(slot - 1) / 2];
+                    slot = (slot - 1) / 2;
+                }
+                candidates[slot] = child + 1;
+            }
+            if (candidateCount == 0) {
+                break;
+            }
+        }
+        
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, candidates, k + 1);
+        return found;
+    }
+    
+    // Copies the items with an explicitly set threshold (results needs room for getSize() levels)
+    // Returns the number of levels copied
+    int getThresholds(ReorderLevel* results) const {
+        int count = 0;
+        for (int i = 0; i < entryCount; i++) {
+            if (entries[i].hasThreshold) {
+                results[count++] = levelOf(i);
+            }
+        }
+        return count;
+    }
+    
+    // Sets the stock of every item to 0, e.g. before the stock is reported again from scratch
+    void resetStock() {
+        lowCount = 0;
+        for (int i = 0; i < entryCount; i++) {
+            entries[i].stock = 0;
+            if (entries[i].stock <= entries[i].threshold) {
+                lowCount++;
+            }
+        }
+        // Rebuild the heap bottom-up in O(n)
+        for (int i = entryCount / 2 - 1; i >= 0; i--) {
+            siftDown(i);
+        }
+    }
+    
+    // Marks the current state of every item as announced, without reporting anything
+    void acceptAll() {
+        for (int i = 0; i < entryCount; i++) {
+            entries[i].announcedLow = entries[i].stock <= entries[i].threshold;
+        }
+    }
+    
+    // Reports every item whose state differs from the announced one and marks it as announced
+    // callback(const ReorderLevel& level, const string& name, bool low) is called once per item
+    template <typename Callback>
+    void announcePending(Callback callback) {
+        for (int i = 0; i < entryCount; i++) {
+            bool low = entries[i].stock <= entries[i].threshold;
+            if (entries[i].announcedLow != low) {
+                entries[i].announcedLow = low;
+                callback(levelOf(i), entries[i].name, low);
+            }
+        }
+    }
+};
+
+// Stock change listener: called with an ID and its new total stock whenever the stock of the ID
+// changes (0 once it is used up or removed). Runs on the thread that made the change while the
+// ID's bucket is locked, so it must be quick and must not call back into the inventory.
+typedef function<void(const ItemID& id, int stock)> StockListener;
+
+// Low-stock alert: called when an item reaches its reorder threshold (low = true) or is restocked
+// above it (low = false). Runs while the inventory is locked, so it must be quick and must not call
+// back into the inventory.
+typedef function<void(const ReorderLevel& level, const string& name, bool low)> LowStockAlert;
+
+// Restaurant Inventory System with Hash Table
+class RestaurantInventorySystem : public Restaurant {
+private:
+    // In practice it always turns out that it is better to have an index range that is a prime number.
+    // This way you do not get so many COLLISIONS.
+    static const int TABLE_SIZE = 101; // Prime number for better hash distribution
+    BucketVersion* hashTable;             // Current published version of each bucket (a linked queue)
+    BucketVersion emptyBucket;            // Shared by every empty bucket
+    atomic<unsigned long long> changeCount;  // Number of bucket versions published so far
+    string usageHistoryFile;              // Usage history file, usage_history.txt unless given to the constructor
+    UsageLogger usageLogger;              // Appends usage records to usageHistoryFile in the background
+    
+    // Thread safety: all batches of an ID live in a single bucket (its home), and each bucket
+    // belongs to at most one ID, recorded in bucketOwner. Lookups and usage of one ingredient only
+    // lock its home bucket, so calls on different ingredients never share a lock.
+    // Shard locks serialise the few operations that give an ID a home (insert, add, load), so one
+    // ID can never end up in two buckets. Lock order is shard first, then bucket; orders spanning
+    // several ingredients lock their buckets in ascending index order.
+    // Buckets are copy-on-write: a change builds a new version of the bucket and publishes it under
+    // the bucket lock, so reports, searches and saves read a point-in-time snapshot without locks
+    // (see takeSnapshot) while usage carries on.
+    static const int SHARD_COUNT = 64;                // Number of ID shards (top 6 bits of the ID hash)
+    mutable mutex bucketLocks[TABLE_SIZE];            // Guards each bucket's queue and owner
+    mutable mutex shardLocks[SHARD_COUNT];            // Serialises placement of the IDs in each shard
+    atomic<uint32_t> bucketOwner[TABLE_SIZE];         // Packed ID stored in each bucket, 0 when empty
+    
+    // Optional shared-memory copy used by all terminal processes on this machine
+    // Lock order: segment first, then shard, then bucket
+    SharedInventorySegment* sharedSegment;            // nullptr unless attachSharedSegment succeeded
+    atomic<unsigned long long> sharedVersion;         // Segment version the local buckets reflect (read by pullShared without the lock)
+    unsigned long long sharedBucketVersions[TABLE_SIZE];  // Segment version each local bucket reflects
+    bool sharedDirty[TABLE_SIZE];                     // Buckets changed since the last publish
+    int sharedDirtyBuckets[TABLE_SIZE];               // The changed buckets, in the order they changed
+    int sharedDirtyCount;                             // Entries in sharedDirtyBuckets
+    
+    // Stock change listeners (see addStockListener)
+    // Lock order: bucket first, then listenerLock
+    static const int MAX_STOCK_LISTENERS = 4;
+    mutable mutex listenerLock;                       // Guards the listener slots while calling them
+    StockListener stockListeners[MAX_STOCK_LISTENERS];  // Empty slots hold no target
+    atomic<int> stockListenerCount;                   // Lets changes skip the lock when nobody listens
+    atomic<bool> stockNotificationsPaused;            // Set while a load replaces the contents
+    
+    // Reorder alerts (see trackReorderLevels)
+    // A stock listener keeps reorderHeap current; alerts are held back while a load is running.
+    // Lock order: bucket, listenerLock, then reorderLock
+    static const int MAX_LOW_STOCK_ALERTS = 4;
+    mutable mutex reorderLock;                        // Guards everything below
+    ReorderHeap reorderHeap;                          // Every known ID ordered by stock - threshold
+    LowStockAlert lowStockAlerts[MAX_LOW_STOCK_ALERTS];  // Empty slots hold no target
+    int reorderListenerId;                            // Stock listener feeding reorderHeap, -1 when not tracking
+    bool reorderQuiet;                                // Set while tracking starts, so the current state is not reported
+    UsageLogger* alertLog;                            // Appends alerts to stock_alerts.txt, created by trackReorderLevels
+    
+    // Nesting of SharedScope on the calling thread
+    static int& sharedDepth() {
+        static thread_local int depth = 0;
+        return depth;
+    }
+    
+    /**
+     * SharedScope makes one inventory operation a transaction on the shared segment
+     * On entry it takes the segment lock and reloads the buckets other processes published
+     * since; on exit it publishes the buckets the operation changed, then unlocks.
+     * Does nothing when no segment is attached; nested scopes on one thread join the outer one.
+     */
+    class SharedScope {
+    private:
+        RestaurantInventorySystem& inventory;
+        bool active;
+        
+    public:
+        explicit SharedScope(RestaurantInventorySystem& _inventory)
+            : inventory(_inventory), active(false) {
+            if (inventory.sharedSegment == nullptr || sharedDepth()++ > 0) {
+                return;
+            }
+            active = true;
+            bool consistent = inventory.sharedSegment->lock();
+            if (!consistent || inventory.sharedSegment->getVersion() != inventory.sharedVersion) {
+                inventory.syncFromShared();
+            }
+            if (!consistent) {
+                inventory.repairTornBuckets();
+            }
+        }
+        
+        ~SharedScope() {
+            if (inventory.sharedSegment == nullptr) {
+                return;
+            }
+            sharedDepth()--;
+            if (!active) {
+                return;
+            }
+            inventory.publishShared();
+            inventory.sharedSegment->unlock();
+        }
+        
+        SharedScope(const SharedScope&) = delete;
+        SharedScope& operator=(const SharedScope&) = delete;
+    };
+    
+    // Tells every listener the stock of the ID held in a bucket, the caller must hold the bucket lock
+    void notifyStockChange(int bucket) {
+        if (stockListenerCount.load(memory_order_acquire) == 0) {
+            return;
+        }
+        const ADTLinkedQueue& queue = *hashTable[bucket];
+        int stock = queue.getTotalQuantity();
+        // While a load is running only IDs that run out are reported, the rest once it finishes
+        if (stock > 0 && stockNotificationsPaused.load()) {
+            return;
+        }
+        uint32_t code = queue.isEmpty() ? bucketOwner[bucket].load(memory_order_relaxed) : queue.begin()->id.getCode();
+        if (code == 0) {
+            return;
+        }
+        
+        lock_guard<mutex> guard(listenerLock);
+        for (int i = 0; i < MAX_STOCK_LISTENERS; i++) {
+            if (stockListeners[i]) {
+                stockListeners[i](ItemID::fromCode(code), stock);
+            }
+        }
+    }
+    
+    // Calls one listener (or all of them, listener = -1) with the stock of every stored ID
+    // Takes every bucket lock, then the listener lock, so no change can slip in between
+    void replayStock(int listener) {
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            bucketLocks[i].lock();
+        }
+        {
+            lock_guard<mutex> guard(listenerLock);
+            for (int b = 0; b < TABLE_SIZE; b++) {
+                uint32_t code = bucketOwner[b].load(memory_order_relaxed);
+                if (code == 0) {
+                    continue;
+                }
+                int stock = hashTable[b]->getTotalQuantity();
+                for (int i = 0; i < MAX_STOCK_LISTENERS; i++) {
+                    if ((listener == -1 || listener == i) && stockListeners[i]) {
+                        stockListeners[i](ItemID::fromCode(code), stock);
+                    }
+                }
+            }
+        }
+        for (int i = TABLE_SIZE - 1; i >= 0; i--) {
+            bucketLocks[i].unlock();
+        }
+    }
+    
+    // Logs a reorder alert and passes it to the alert callbacks, hold reorderLock
+    void reportReorder(const ReorderLevel& level, const string& name, bool low) {
+        if (alertLog != nullptr) {
+            alertLog->log(level.id, name, level.stock, (low ? "Low stock (reorder threshold " : "Restocked (reorder threshold ") +
+                          to_string(level.threshold) + ")");
+        }
+        for (int i = 0; i < MAX_LOW_STOCK_ALERTS; i++) {
+            if (lowStockAlerts[i]) {
+                lowStockAlerts[i](level, name, low);
+            }
+        }
+    }
+    
+    // Stock listener behind trackReorderLevels, called with the ID's bucket locked
+    void onReorderStock(const ItemID& id, int stock) {
+        // The bucket lock is held, so the name can be read from the ID's batches
+        const string* name = nullptr;
+        int home = findHome(id);
+        if (home != -1 && !hashTable[home]->isEmpty()) {
+            name = &hashTable[home]->begin()->name;
+        }
+        
+        lock_guard<mutex> guard(reorderLock);
+        bool announce = !reorderQuiet && !stockNotificationsPaused.load();
+        ReorderLevel level;
+        ReorderHeap::Crossing crossing = reorderHeap.updateStock(id, stock, name, announce, level);
+        if (crossing != ReorderHeap::CROSS_NONE) {
+            reportReorder(level, reorderHeap.getName(id), crossing == ReorderHeap::CROSS_LOW);
+        }
+    }
+    
+    // Sends the reorder alerts held back while notifications were paused
+    void announcePendingReorders() {
+        lock_guard<mutex> guard(reorderLock);
+        if (reorderListenerId == -1) {
+            return;
+        }
+        reorderHeap.announcePending([this](const ReorderLevel& level, const string& name, bool low) {
+            reportReorder(level, name, low);
+        });
+    }
+    
+    /**
+     * StockNotificationPause holds back stock notifications while a load places its batches
+     * A load adds one batch at a time, so listeners would otherwise hear about every batch.
+     * On exit each stored ID is reported once with its final stock, and reorder alerts held back
+     * meanwhile are sent.
+     */
+    class StockNotificationPause {
+    private:
+        RestaurantInventorySystem& inventory;
+        bool wasPaused;
+        
+    public:
+        explicit StockNotificationPause(RestaurantInventorySystem& _inventory)
+            : inventory(_inventory), wasPaused(_inventory.stockNotificationsPaused.exchange(true)) {}
+        
+        ~StockNotificationPause() {
+            if (!wasPaused) {
+                inventory.stockNotificationsPaused.store(false);
+                if (inventory.stockListenerCount.load() > 0) {
+                    inventory.replayStock(-1);
+                }
+                inventory.announcePendingReorders();
+            }
+        }
+        
+        StockNotificationPause(const StockNotificationPause&) = delete;
+        StockNotificationPause& operator=(const StockNotificationPause&) = delete;
+    };
+    
+    // Empties every bucket (callers then place the new batches)
+    void clearAllBuckets() {
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            lock_guard<mutex> bucketLock(bucketLocks[i]);
+            if (!hashTable[i]->isEmpty()) {
+                hashTable[i] = emptyBucket;
+                changeCount++;
+                notifyStockChange(i);
+            }
+            if (bucketOwner[i].load(memory_order_relaxed) != 0) {
+                markSharedDirty(i);
+            }
+            bucketOwner[i].store(0);
+        }
+        itemCount = 0;
+    }
+    
+    // Remembers that a bucket changed, so the enclosing SharedScope publishes it
+    // Only the thread holding the segment lock changes buckets while a segment is attached
+    void markSharedDirty(int bucket) {
+        if (sharedSegment == nullptr || sharedDirty[bucket]) {
+            return;
+        }
+        sharedDirty[bucket] = true;
+        sharedDirtyBuckets[sharedDirtyCount++] = bucket;
+    }
+    
+    // Brings the local buckets up to date before a read when another process published since
+    // Costs one atomic load when nothing changed. The local buckets are a cache of the segment,
+    // so reads stay const. Must not be called while holding a shard or bucket lock (lock order).
+    void pullShared() const {
+        if (sharedSegment != nullptr && sharedSegment->getVersion() != sharedVersion.load()) {
+            const_cast<RestaurantInventorySystem*>(this)->syncShared();
+        }
+    }
+    
+    // Replaces one bucket with its records in the shared segment (hold the segment lock)
+    // The bucket index is the same in every process, so the owner is taken over as is
+    void reloadSharedBucket(int bucket) {
+        uint32_t owner = sharedSegment->getBucketOwner(bucket);
+        int count = sharedSegment->getBucketBatchCount(bucket);
+        ADTLinkedQueue* queue = nullptr;
+        if (count > 0) {
+            queue = new ADTLinkedQueue();
+            for (int i = 0; i < count; i++) {
+                queue->enqueue(sharedSegment->readBatch(bucket, i));
+            }
+        }
+        
+        lock_guard<mutex> bucketLock(bucketLocks[bucket]);
+        uint32_t previous = bucketOwner[bucket].load(memory_order_relaxed);
+        if (previous != 0 && (previous != owner || queue == nullptr)) {
+            // The ID held here is gone (another ID may have taken the bucket over)
+            hashTable[bucket] = emptyBucket;
+            notifyStockChange(bucket);
+            bucketOwner[bucket].store(0, memory_order_release);
+            this->itemCount--;
+        }
+        if (queue != nullptr) {
+            if (bucketOwner[bucket].load(memory_order_relaxed) == 0) {
+                bucketOwner[bucket].store(owner, memory_order_release);
+                this->itemCount++;
+            }
+            hashTable[bucket] = BucketVersion(queue);
+            notifyStockChange(bucket);
+        }
+        changeCount++;
+        sharedBucketVersions[bucket] = sharedSegment->getBucketVersion(bucket);
+    }
+    
+    // Reloads the buckets other processes published since this process last saw them (hold the segment lock)
+    // Buckets a dead process left half written are skipped, see repairTornBuckets
+    void syncFromShared() {
+        for (int b = 0; b < TABLE_SIZE; b++) {
+            if (!sharedSegment->isTorn(b) && sharedSegment->getBucketVersion(b) != sharedBucketVersions[b]) {
+                reloadSharedBucket(b);
+            }
+        }
+        sharedVersion = sharedSegment->getVersion();
+    }
+    
+    // Publishes this process's copy of the buckets a dead process left half written (hold the segment lock)
+    // The copy is exact when this process had seen the bucket's last complete version. An older
+    // copy is used only if its ID is not stored in another bucket meanwhile; otherwise, or without
+    // any copy, the bucket is emptied.
+    void repairTornBuckets() {
+        for (int b = 0; b < TABLE_SIZE; b++) {
+            if (!sharedSegment->isTorn(b)) {
+                continue;
+            }
+            
+            bool usable = (sharedBucketVersions[b] != 0);
+            uint32_t owner = bucketOwner[b].load(memory_order_relaxed);
+            if (usable && sharedBucketVersions[b] != sharedSegment->getBucketVersion(b)) {
+                for (int other = 0; other < TABLE_SIZE && usable; other++) {
+                    usable = (other == b || owner == 0 || sharedSegment->getBucketOwner(other) != owner);
+                }
+                if (usable) {
+                    engineOut() << "Warning: Shared inventory bucket " << b << " was restored from an older copy" << endl;
+                }
+            }
+            if (!usable) {
+                lock_guard<mutex> bucketLock(bucketLocks[b]);
+                if (owner != 0) {
+                    hashTable[b] = emptyBucket;
+                    notifyStockChange(b);
+                    bucketOwner[b].store(0, memory_order_release);
+                    this->itemCount--;
+                }
+                engineOut() << "Warning: Shared inventory bucket " << b << " could not be restored and was emptied" << endl;
+            }
+            markSharedDirty(b);
+        }
+        publishShared();
+    }
+    
+    // Publishes the buckets changed since the last publish (hold the segment lock)
+    // If the segment has no room for them, the changes are undone by reloading those buckets,
+    // so this process never keeps changes the other processes cannot see
+    void publishShared() {
+        if (sharedDirtyCount == 0) {
+            return;
+        }
+        
+        // Hold the versions being written, so they cannot change underneath the copy
+        BucketVersion held[TABLE_SIZE];
+        const ADTLinkedQueue* queues[TABLE_SIZE] = {nullptr};
+        uint32_t owners[TABLE_SIZE] = {0};
+        for (int i = 0; i < sharedDirtyCount; i++) {
+            int b = sharedDirtyBuckets[i];
+            lock_guard<mutex> bucketLock(bucketLocks[b]);
+            held[b] = hashTable[b];
+            queues[b] = held[b].get();
+            owners[b] = bucketOwner[b].load(memory_order_relaxed);
+        }
+        
+        int count = sharedDirtyCount;
+        sharedDirtyCount = 0;
+        for (int i = 0; i < count; i++) {
+            sharedDirty[sharedDirtyBuckets[i]] = false;
+        }
+        
+        unsigned long long version = sharedSegment->publish(sharedDirtyBuckets, count, queues, owners);
+        if (version != 0) {
+            for (int i = 0; i < count; i++) {
+                sharedBucketVersions[sharedDirtyBuckets[i]] = version;
+            }
+            sharedVersion = version;
+            return;
+        }
+        
+        engineOut() << "Error: Shared inventory segment is full (" << sharedSegment->getCapacity()
+             << " batches), the change was undone" << endl;
+        for (int i = 0; i < count; i++) {
+            held[sharedDirtyBuckets[i]].reset();
+            reloadSharedBucket(sharedDirtyBuckets[i]);
+        }
+    }
+    
+    // Maps an ID to its lock shard
+    static int shardOf(const ItemID& id) {
+        return (int)(id.hash() >> 26);
+    }
+    
+    // Universal hash function for packed IDs
+    // Implements a polynomial rolling hash over the ID characters, read straight from the packed integer
+    int universalHash(const ItemID& key) const {
+        unsigned long hash = 0;
+        int length = key.length();
+        
+        // Universal hash function: h(k) = ((a*k + b) mod p) mod m
+        // hash = ((hash * PRIME + key[i]) % MAX_HASH_KEY) % TABLE_SIZE;
+        // Using polynomial rolling hash: h(k) = sum(k[i]*PRIME^(n-i-1)) mod TABLE_SIZE
+        for (int i = 0; i < length; i++) {
+            hash = (hash * PRIME + key.charAt(i)) % MAX_HASH_KEY;
+        }
+        
+        return hash % TABLE_SIZE;
+    }
+    
+    // Quadratic probing function for collision resolution
+    int quadraticProbing(int hashValue, int attempt) const {
+        // Quadratic probing formula: h'(k, i) = (h(k) + c1*i + c2*i^2) mod TABLE_SIZE
+        // Using c1=0, c2=1: h'(k, i) = (h(k) + i^2) mod TABLE_SIZE
+        return (hashValue + attempt * attempt) % TABLE_SIZE;
+    }
+    
+    // Returns the bucket that currently holds this ID, or -1 if the ID is not stored
+    // Reads only the bucket owners, so it takes no locks and never touches another item's batches
+    int findHome(const ItemID& id) const {
+        // Invalid IDs all share one code, and no stored item can have it
+        if (!id.isValid()) {
+            return -1;
+        }
+        int hashValue = universalHash(id);
+        
+        for (int attempt = 0; attempt < TABLE_SIZE; attempt++) {
+            int position = quadraticProbing(hashValue, attempt);
+            if (bucketOwner[position].load(memory_order_acquire) == id.getCode()) {
+                return position;
+            }
+        }
+        
+        return -1;
+    }
+    
+    // Adds a batch to the bucket that holds its ID, or claims the first empty bucket on its probe sequence
+    // The caller must hold the ID's shard lock, so no other thread can place the same ID meanwhile
+    // Returns the bucket used, or -1 if the table is full
+    int placeBatch(const FoodItem& item) {
+        uint32_t code = item.id.getCode();
+        int hashValue = universalHash(item.id);
+        
+        while (true) {
+            // Existing ID: append to its home bucket
+            int home = findHome(item.id);
+            if (home != -1) {
+                lock_guard<mutex> bucketLock(bucketLocks[home]);
+                if (bucketOwner[home].load(memory_order_relaxed) == code) {
+                    ADTLinkedQueue* queue = editBucket(home);
+                    queue->enqueue(item);
+                    commitBucket(home, queue);
+                    return home;
+                }
+                // The last batch was used up before we got the lock, place it as a new ID
+                continue;
+            }
+            
+            // New ID: claim the first empty bucket, checking again under its lock
+            for (int attempt = 0; attempt < TABLE_SIZE; attempt++) {
+                int position = quadraticProbing(hashValue, attempt);
+                if (bucketOwner[position].load(memory_order_acquire) != 0) {
+                    continue;
+                }
+                
+                lock_guard<mutex> bucketLock(bucketLocks[position]);
+                if (bucketOwner[position].load(memory_order_relaxed) == 0) {
+                    ADTLinkedQueue* draft = draftBucket(position);
+                    draft->enqueue(item);
+                    publishBucket(position, draft);
+                    bucketOwner[position].store(code, memory_order_release);
+                    this->itemCount++;
+                    return position;
+                }
+            }
+            
+            return -1;
+        }
+    }
+    
+    // Starts a new version of a bucket as a private copy of its current contents
+    // The caller must hold the bucket lock and pass the draft to publishBucket (or delete it)
+    ADTLinkedQueue* draftBucket(int bucket) const {
+        TraceSpan span("copyBucket", "inventory", ItemID(), hashTable[bucket]->getSize());
+        return new ADTLinkedQueue(*hashTable[bucket]);
+    }
+    
+    // Returns the queue to change for a bucket (caller holds the bucket lock), pass it to commitBucket
+    // New references to a version are only taken under its bucket lock, so a version that only
+    // the table refers to cannot gain a reader while we hold the lock: it is changed in place,
+    // which keeps receiving and using batches independent of how many batches the bucket holds.
+    // A version a snapshot still holds is copied as usual (draftBucket).
+    ADTLinkedQueue* editBucket(int bucket) {
+        // Taking a reference updates the count with a read-modify-write, and together with the
+        // fence it orders our changes after a snapshot that just let go of this version
+        BucketVersion probe = hashTable[bucket];
+        if (probe.use_count() == 2) {
+            atomic_thread_fence(memory_order_acquire);
+            return const_cast<ADTLinkedQueue*>(probe.get());
+        }
+        return draftBucket(bucket);
+    }
+    
+    // Finishes a change started with editBucket, the caller must hold the bucket lock
+    void commitBucket(int bucket, ADTLinkedQueue* edited) {
+        if (edited != hashTable[bucket].get()) {
+            publishBucket(bucket, edited);
+            return;
+        }
+        if (edited->isEmpty()) {
+            hashTable[bucket] = emptyBucket;
+        }
+        changeCount++;
+        markSharedDirty(bucket);
+        notifyStockChange(bucket);
+    }
+    
+    // Makes a draft the current version of a bucket, the caller must hold the bucket lock
+    // Snapshots holding the previous version keep it alive until they are destroyed
+    void publishBucket(int bucket, ADTLinkedQueue* draft) {
+        if (draft->isEmpty()) {
+            delete draft;
+            hashTable[bucket] = emptyBucket;
+        } else {
+            hashTable[bucket] = BucketVersion(draft);
+        }
+        changeCount++;
+        markSharedDirty(bucket);
+        notifyStockChange(bucket);
+    }
+    
+    // Releases a bucket once its last batch is gone, the caller must hold the bucket lock
+    void releaseIfEmpty(int bucket) {
+        if (hashTable[bucket]->isEmpty() && bucketOwner[bucket].load(memory_order_relaxed) != 0) {
+            bucketOwner[bucket].store(0, memory_order_release);
+            this->itemCount--;
+        }
+    }
+    
+    // Checks if any batch with this ID is stored in the inventory
+    bool containsId(const ItemID& id) const {
+        return findHome(id) != -1;
+    }
+
+public:
+    // Make TABLE_SIZE accessible publicly
+    static const int MAX_BUCKETS = 101; // Prime number Same as TABLE_SIZE
+    
+    // Merge function for Tim Sort
+    // Parameters: array, left boundary, middle point, right boundary, and sort criteria
+    static void merge(FoodItem arr[], int left, int mid, int right, FoodSortKey sortKey) {
+        int i, j, k;
+        int n1 = mid - left + 1;
+        int n2 = right - mid;
+        
+        // Create temporary arrays
+        FoodItem* L = new FoodItem[n1];
+        FoodItem* R = new FoodItem[n2];
+        
+        // Copy data to temp arrays L[] and R[]
+        for (i = 0; i < n1; i++)
+            L[i] = arr[left + i];
+        for (j = 0; j < n2; j++)
+            R[j] = arr[mid + 1 + j];
+        
+        // Merge the temp arrays back into arr[l..r]
+        i = 0; // Initial index of first subarray
+        j = 0; // Initial index of second subarray
+        k = left; // Initial index of merged subarray
+        
+        while (i < n1 && j < n2) {
+            if (sortKey == SORT_BY_NAME) {
+                // Sort by name (alphabetically)
+                // Case-insensitive comparison of names
+                string nameL = L[i].name;
+                string nameR = R[j].name;
+                
+                // Convert to lowercase for comparison without using transform
+                bool namesSame = true;
+                int minLen = (nameL.length() < nameR.length()) ? nameL.length() : nameR.length();
+                
+                for (int idx = 0; idx < minLen; idx++) {
+                    char cL = (nameL[idx] >= 'A' && nameL[idx] <= 'Z') ? nameL[idx] + 32 : nameL[idx];
+                    char cR = (nameR[idx] >= 'A' && nameR[idx] <= 'Z') ? nameR[idx] + 32 : nameR[idx];
+                    
+                    if (cL < cR) {
+                        // L comes before R
+                        namesSame = false;
+                        arr[k] = L[i];
+                        i++;
+                        break;
+                    } else if (cL > cR) {
+                        // R comes before L
+                        namesSame = false;
+                        arr[k] = R[j];
+                        j++;
+                        break;
+                    }
+                }
+                
+                // If all compared characters are the same, shorter string comes first
+                if (namesSame) {
+                    if (nameL.length() <= nameR.length()) {
+                        arr[k] = L[i];
+                        i++;
+                    } else {
+                        arr[k] = R[j];
+                        j++;
+                    }
+                }
+            } else if (sortKey == SORT_BY_DATE) {
+                // Sort by receive date (oldest first), a single integer compare
+                if (L[i].receiveDate <= R[j].receiveDate) {
+                    arr[k] = L[i];
+                    i++;
+                } else {
+                    arr[k] = R[j];
+                    j++;
+                }
+            } else {
+                // Sort by quantity (ascending)
+                if (L[i].quantity <= R[j].quantity) {
+                    arr[k] = L[i];
+                    i++;
+                } else {
+                    arr[k] = R[j];
+                    j++;
+                }
+            }
+            k++;
+        }
+        
+        // Copy the remaining elements of L[], if there are any
+        while (i < n1) {
+            arr[k] = L[i];
+            i++;
+            k++;
+        }
+        
+        // Copy the remaining elements of R[], if there are any
+        while (j < n2) {
+            arr[k] = R[j];
+            j++;
+            k++;
+        }
+        
+        // Free the allocated memory for temporary arrays
+        delete[] L;
+        delete[] R;
+    }
+    
+    // Insertion sort (part of Tim Sort)
+    // Efficiently sorts small subarrays using in-place insertion sort
+    // Parameters: array, left boundary, right boundary, and sort criteria
+    static void insertionSort(FoodItem arr[], int left, int right, FoodSortKey sortKey) {
+        for (int i = left + 1; i <= right; i++) {
+            // Store current element as temporary
+            FoodItem temp = arr[i];
+            int j = i - 1;
+            
+            if (sortKey == SORT_BY_NAME) {
+                // Sort by name (alphabetical order)
+                // Implement case-insensitive comparison
+                while (j >= left) {
+                    // Compare names case-insensitively
+                    string nameTemp = temp.name;
+                    string nameJ = arr[j].name;
+                    bool jGreater = false;
+                    
+                    // Compare characters one by one
+                    int minLen = (nameTemp.length() < nameJ.length()) ? nameTemp.length() : nameJ.length();
+                    for (int k = 0; k < minLen; k++) {
+                        char cTemp = (nameTemp[k] >= 'A' && nameTemp[k] <= 'Z') ? nameTemp[k] + 32 : nameTemp[k];
+                        char cJ = (nameJ[k] >= 'A' && nameJ[k] <= 'Z') ? nameJ[k] + 32 : nameJ[k];
+                        
+                        if (cJ > cTemp) {
+                            jGreater = true;
+                            break;
+                        } else if (cJ < cTemp) {
+                            jGreater = false;
+                            break;
+                        }
+                    }
+                    
+                    // If all compared characters are the same, longer string is "greater"
+                    if (!jGreater && nameJ.length() > nameTemp.length() && minLen == nameTemp.length()) {
+                        jGreater = true;
+                    }
+                    
+                    if (jGreater) {
+                        arr[j + 1] = arr[j];
+                        j--;
+                    } else {
+                        break;
+                    }
+                }
+            } else if (sortKey == SORT_BY_DATE) {
+                // Sort by receive date (oldest first)
+                while (j >= left && arr[j].receiveDate > temp.receiveDate) {
+                    arr[j + 1] = arr[j];
+                    j--;
+                }
+            } else {
+                // Sort by quantity (numerical order)
+                // Move elements greater than temp to one position ahead
+                while (j >= left && arr[j].quantity > temp.quantity) {
+                    arr[j + 1] = arr[j];
+                    j--;
+                }
+            }
+            
+            // Place temp in its correct position
+            arr[j + 1] = temp;
+        }
+    }
+    
+    // Tim Sort main function
+    // A hybrid sorting algorithm combining insertion sort and merge sort
+    // Average time complexity: O(n log n)
+    static void timSort(FoodItem arr[], int n, bool byName = true) {
+        timSort(arr, n, byName ? SORT_BY_NAME : SORT_BY_QUANTITY);
+    }
+    
+    // Overloaded Tim Sort taking an explicit sort criteria (name, quantity or receive date)
+    static void timSort(FoodItem arr[], int n, FoodSortKey sortKey) {
+        // Run size for insertion sort (optimal value based on typical array sizes)
+        const int RUN = 32;
+        
+        // First, sort individual subarrays of size RUN using insertion sort
+        // This is efficient for small arrays and creates sorted runs
+        for (int i = 0; i < n; i += RUN) {
+            insertionSort(arr, i, min(i + RUN - 1, n - 1), sortKey);
+        }
+        
+        // Start merging sorted runs from size RUN
+        // Each iteration doubles the size of subarrays being merged
+        for (int size = RUN; size < n; size = 2 * size) {
+            // Pick starting points of different subarrays of current size
+            for (int left = 0; left < n; left += 2 * size) {
+                // Find ending points of subarrays
+                int mid = left + size - 1;
+                int right = min(left + 2 * size - 1, n - 1);
+                
+                // Merge subarrays arr[left...mid] and arr[mid+1...right]
+                if (mid < right) {
+                    merge(arr, left, mid, right, sortKey);
+                }
+            }
+        }
+    }
+    
+    // Constructor - initializes the hash table for storing food items
+    // Creates an array of empty linked queues (buckets)
+    // Parameters: historyFile - file the usage history is appended to (the benchmark uses a scratch file)
+    explicit RestaurantInventorySystem(const string& historyFile = "usage_history.txt")
+        : Restaurant(), emptyBucket(new ADTLinkedQueue()), changeCount(0),
+          usageHistoryFile(historyFile), usageLogger(historyFile), sharedSegment(nullptr), sharedVersion(0),
+          sharedDirtyCount(0), stockListenerCount(0), stockNotificationsPaused(false),
+          reorderListenerId(-1), reorderQuiet(false), alertLog(nullptr) {
+        hashTable = MemoryTracker::allocateArray<BucketVersion>(MEM_INVENTORY, TABLE_SIZE);
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            hashTable[i] = emptyBucket;
+            bucketOwner[i].store(0);
+            sharedBucketVersions[i] = 0;
+            sharedDirty[i] = false;
+        }
+    }
+    
+    // Destructor - frees all memory allocated for the hash table
+    virtual ~RestaurantInventorySystem() override {
+        stopTrackingReorderLevels();
+        delete alertLog;
+        delete sharedSegment;
+        MemoryTracker::freeArray(MEM_INVENTORY, hashTable, TABLE_SIZE);
+    }
+    
+    /**
+     * Moves this inventory onto a shared-memory segment used by every local terminal process
+     * The first process to attach publishes its current (loaded) inventory; later processes
+     * replace theirs with the shared one. From then on every change is published to the segment,
+     * and each change first picks up the changes other processes made.
+     * Parameters: segmentName - name shared by the processes
+     * Returns: true if attached, false if the segment could not be opened (the inventory stays local)
+     */
+    bool attachSharedSegment(const string& segmentName) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.attachSharedSegment");
+        if (sharedSegment != nullptr) {
+            return true;
+        }
+        
+        SharedInventorySegment* segment = new SharedInventorySegment();
+        if (!segment->attach(segmentName, takeSnapshot().getBatchCount())) {
+            delete segment;
+            return false;
+        }
+        
+        bool consistent = segment->lock();
+        sharedSegment = segment;
+        if (segment->isCreator()) {
+            // The segment was sized for this inventory, so every bucket fits
+            for (int b = 0; b < TABLE_SIZE; b++) {
+                if (bucketOwner[b].load() != 0) {
+                    markSharedDirty(b);
+                }
+            }
+            publishShared();
+        } else {
+            // Adopt the shared buckets in place of the ones loaded from the file
+            StockNotificationPause pause(*this);
+            for (int b = 0; b < TABLE_SIZE; b++) {
+                if (!segment->isTorn(b)) {
+                    reloadSharedBucket(b);
+                }
+            }
+            sharedVersion = segment->getVersion();
+            if (!consistent) {
+                repairTornBuckets();
+            }
+        }
+        segment->unlock();
+        
+        engineOut() << "Attached to shared inventory " << segmentName << " ("
+             << segment->getAttachedProcesses() << " process(es))" << endl;
+        return true;
+    }
+    
+    // Registers a stock change listener (see StockListener)
+    // The listener is first called once for every ID in stock, so it starts from the current
+    // state, and then on every change. Remove it before whatever it refers to is destroyed.
+    // Returns: an ID for removeStockListener, or -1 if all listener slots are taken
+    int addStockListener(const StockListener& listener) {
+        int slot = -1;
+        {
+            lock_guard<mutex> guard(listenerLock);
+            for (int i = 0; i < MAX_STOCK_LISTENERS && slot == -1; i++) {
+                if (!stockListeners[i]) {
+                    stockListeners[i] = listener;
+                    slot = i;
+                }
+            }
+        }
+        if (slot == -1) {
+            engineOut() << "Error: Too many stock listeners." << endl;
+            return -1;
+        }
+        stockListenerCount++;
+        replayStock(slot);
+        return slot;
+    }
+    
+    // Unregisters a listener; once this returns the listener is not running and will not be called again
+    void removeStockListener(int listenerId) {
+        if (listenerId < 0 || listenerId >= MAX_STOCK_LISTENERS) {
+            return;
+        }
+        lock_guard<mutex> guard(listenerLock);
+        if (stockListeners[listenerId]) {
+            stockListeners[listenerId] = StockListener();
+            stockListenerCount--;
+        }
+    }
+    
+    /**
+     * Keeps every food item's stock measured against its reorder threshold
+     * A stock listener moves the item in a min-heap of (stock - threshold) on every receive, use,
+     * removal and load, in O(log n). Items reaching their threshold, and items restocked above it,
+     * are appended to stock_alerts.txt and passed to the callbacks from addLowStockAlert.
+     * Items without a threshold use ReorderHeap::DEFAULT_THRESHOLD, so they alert once they run out.
+     * Items already at or below their threshold when tracking starts are not announced.
+     * Return: true if tracking is active
+     */
+    bool trackReorderLevels() {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.trackReorderLevels");
+        {
+            lock_guard<mutex> guard(reorderLock);
+            if (reorderListenerId != -1) {
+                return true;
+            }
+            if (alertLog == nullptr) {
+                alertLog = new UsageLogger("stock_alerts.txt");
+            }
+            // Stock reported by the replay below starts from scratch
+            reorderHeap.resetStock();
+            reorderQuiet = true;
+        }
+        
+        // Registering replays the current stock of every ID through the listener
+        int listenerId = addStockListener([this](const ItemID& id, int stock) {
+            onReorderStock(id, stock);
+        });
+        lock_guard<mutex> guard(reorderLock);
+        reorderQuiet = false;
+        reorderHeap.acceptAll();
+        reorderListenerId = listenerId;
+        return listenerId != -1;
+    }
+    
+    // Stops updating the reorder levels (thresholds are kept)
+    void stopTrackingReorderLevels() {
+        int listenerId;
+        {
+            lock_guard<mutex> guard(reorderLock);
+            listenerId = reorderListenerId;
+            reorderListenerId = -1;
+        }
+        removeStockListener(listenerId);
+    }
+    
+    // Registers a low-stock alert callback (see LowStockAlert)
+    // Returns: an ID for removeLowStockAlert, or -1 if all alert slots are taken
+    int addLowStockAlert(const LowStockAlert& alert) {
+        lock_guard<mutex> guard(reorderLock);
+        for (int i = 0; i < MAX_LOW_STOCK_ALERTS; i++) {
+            if (!lowStockAlerts[i]) {
+                lowStockAlerts[i] = alert;
+                return i;
+            }
+        }
+        engineOut() << "Error: Too many low-stock alerts." << endl;
+        return -1;
+    }
+    
+    // Unregisters an alert callback; once this returns it is not running and will not be called again
+    void removeLowStockAlert(int alertId) {
+        if (alertId < 0 || alertId >= MAX_LOW_STOCK_ALERTS) {
+            return;
+        }
+        lock_guard<mutex> guard(reorderLock);
+        lowStockAlerts[alertId] = LowStockAlert();
+    }
+    
+    /**
+     * Sets the reorder threshold of a food item
+     * The item is reported at once if the new threshold moves it across (and tracking is active).
+     * Parameters: id - Food item, which does not need to be in stock yet
+     *             threshold - Reorder once the stock is at or below this level (0 or more)
+     * Return: true if the threshold was set
+     */
+    bool setReorderThreshold(const ItemID& id, int threshold) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.setReorderThreshold");
+        if (id.empty() || !id.isValid()) {
+            engineOut() << "Error: Invalid food item ID." << endl;
+            return false;
+        }
+        if (threshold < 0) {
+            engineOut() << "Error: Reorder threshold cannot be negative." << endl;
+            return false;
+        }
+        
+        lock_guard<mutex> guard(reorderLock);
+        bool announce = reorderListenerId != -1 && !stockNotificationsPaused.load();
+        ReorderLevel level;
+        ReorderHeap::Crossing crossing = reorderHeap.setThreshold(id, threshold, announce, level);
+        if (crossing != ReorderHeap::CROSS_NONE) {
+            reportReorder(level, reorderHeap.getName(id), crossing == ReorderHeap::CROSS_LOW);
+        }
+        return true;
+    }
+    
+    // Returns the reorder threshold of a food item (ReorderHeap::DEFAULT_THRESHOLD if none was set)
+    int getReorderThreshold(const ItemID& id) const {
+        lock_guard<mutex> guard(reorderLock);
+        ReorderLevel level;
+        if (!reorderHeap.find(id, level)) {
+            return ReorderHeap::DEFAULT_THRESHOLD;
+        }
+        return level.threshold;
+    }
+    
+    // Returns the number of food items at or below their reorder threshold
+    int getLowStockCount() const {
+        pullShared();
+        lock_guard<mutex> guard(reorderLock);
+        return (reorderListenerId == -1) ? 0 : reorderHeap.getLowCount();
+    }
+    
+    /**
+     * Copies the k food items with the least stock above their reorder threshold, lowest first
+     * Reads the reorder heap in O(k log k); the inventory is not scanned or sorted.
+     * Parameters: k - Number of items wanted
+     *             results - Array with room for k levels
+     * Return: Number of levels copied (0 while reorder levels are not tracked)
+     */
+    int getLowestStock(int k, ReorderLevel* results) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.getLowestStock");
+        pullShared();
+        lock_guard<mutex> guard(reorderLock);
+        if (reorderListenerId == -1) {
+            return 0;
+        }
+        return reorderHeap.lowest(k, results);
+    }
+    
+    /**
+     * Displays the k food items closest to (or furthest below) their reorder threshold
+     * Parameters: k - Number of items to show
+     */
+    void displayLowStock(int k) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displayLowStock");
+        pullShared();
+        lock_guard<mutex> guard(reorderLock);
+        if (reorderListenerId == -1) {
+            engineOut() << "Reorder levels are not being tracked." << endl;
+            return;
+        }
+        if (k > reorderHeap.getSize()) {
+            k = reorderHeap.getSize();
+        }
+        
+        printHeader("Low Stock Report");
+        if (k <= 0) {
+            engineOut() << "No food items to report." << endl;
+            return;
+        }
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Stock" 
+             << setw(12) << "Threshold" 
+             << setw(10) << "Margin" 
+             << setw(10) << "Status" << endl;
+        printFooter();
+        
+        ReorderLevel* levels = MemoryTracker::allocateArray<ReorderLevel>(MEM_SORT_SCRATCH, k);
+        int count = reorderHeap.lowest(k, levels);
+        for (int i = 0; i < count; i++) {
+            const ReorderLevel& level = levels[i];
+            const string& name = reorderHeap.getName(level.id);
+            engineOut() << left << setw(10) << level.id 
+                 << setw(30) << (name.empty() ? "-" : name) 
+                 << setw(10) << level.stock 
+                 << setw(12) << level.threshold 
+                 << setw(10) << level.getMargin() 
+                 << setw(10) << (level.isLow() ? "REORDER" : "OK") << endl;
+        }
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, levels, k);
+        
+        printFooter();
+        engineOut() << reorderHeap.getLowCount() << " of " << reorderHeap.getSize() 
+             << " food items are at or below their reorder threshold." << endl;
+    }
+    
+    // Loads reorder thresholds from a TXT file (format: id,threshold per line)
+    // Returns true if at least one threshold was loaded
+    bool loadReorderThresholds(const string& filename) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.loadReorderThresholds");
+        ifstream file(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << endl;
+            return false;
+        }
+        
+        string line;
+        int thresholdsLoaded = 0;
+        while (getline(file, line)) {
+            size_t pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            ItemID id = line.substr(0, pos);
+            int threshold;
+            try {
+                threshold = stoi(line.substr(pos + 1));
+            } catch (const exception&) {
+                continue; // Skip lines without a number
+            }
+            if (setReorderThreshold(id, threshold)) {
+                thresholdsLoaded++;
+            }
+        }
+        
+        file.close();
+        engineOut() << "Successfully loaded " << thresholdsLoaded << " reorder thresholds from " << filename << endl;
+        return thresholdsLoaded > 0;
+    }
+    
+    // Saves the thresholds set with setReorderThreshold to a TXT file (format: id,threshold per line)
+    // Returns true if successful, false if failed to open file
+    bool saveReorderThresholds(const string& filename) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.saveReorderThresholds");
+        ofstream file(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for writing" << endl;
+            return false;
+        }
+        
+        lock_guard<mutex> guard(reorderLock);
+        int size = reorderHeap.getSize();
+        ReorderLevel* levels = MemoryTracker::allocateArray<ReorderLevel>(MEM_SORT_SCRATCH, size > 0 ? size : 1);
+        int count = reorderHeap.getThresholds(levels);
+        for (int i = 0; i < count; i++) {
+            file << levels[i].id << "," << levels[i].threshold << endl;
+        }
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, levels, size > 0 ? size : 1);
+        
+        file.close();
+        return true;
+    }
+    
+    // Waits until every reorder alert so far has been written to stock_alerts.txt
+    // Returns: false if some alerts could not be written
+    bool flushStockAlerts() {
+        UsageLogger* log;
+        {
+            // The log is never replaced once created, so it can be flushed without the lock
+            lock_guard<mutex> guard(reorderLock);
+            log = alertLog;
+        }
+        return (log == nullptr) || log->flush();
+    }
+    
+    // Checks if the inventory lives in a shared segment
+    bool isShared() const {
+        return sharedSegment != nullptr;
+    }
+    
+    // Picks up changes published by other processes (no-op when not shared or already current)
+    // Changes do this on their own, and so do the reads: findFoodItem, copyFoodItem, takeSnapshot
+    // (which every report, search and save reads from) and the low-stock queries, so readers see
+    // the live shared inventory
+    void syncShared() {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.syncShared");
+        if (sharedSegment == nullptr || sharedSegment->getVersion() == sharedVersion) {
+            return;
+        }
+        SharedScope scope(*this);
+    }
+    
+    // Loads food items from a TXT file into the inventory system
+    // Returns true if at least one item was successfully loaded
+    virtual bool loadFromFile(const string& filename) override {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.loadFromFile");
+        RESTAURANT_LATENCY_SCOPE(LAT_INVENTORY_LOAD);
+        TraceSpan span("loadFromFile", "inventory");
+        TrackedFileStream<ifstream> file;
+        file.open(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << endl;
+            return false;
+        }
+        
+        // Clear existing items to prevent duplicates
+        SharedScope scope(*this);
+        StockNotificationPause pause(*this);
+        clearAllBuckets();
+        
+        string line;
+        int itemsLoaded = 0;
+        
+        // Process each line in the file
+        while (getline(file, line)) {
+            ItemID id;
+            string name, category, receiveDate;
+            double price;
+            int quantity;
+            
+            // Parse TXT line (format: id,name,price,category,quantity,receiveDate)
+            // receiveDate is epoch seconds, older files store the ctime() text instead
+            size_t pos = 0;
+            string token;
+            
+            // Extract ID
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            id = line.substr(0, pos);
+            if (id.empty() || !id.isValid()) continue; // Skip IDs that do not fit the 4-character format
+            line.erase(0, pos + 1);
+            
+            // Extract Name
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            name = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Price
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            price = stod(line.substr(0, pos));
+            line.erase(0, pos + 1);
+            
+            // Extract Category
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            category = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Quantity and optional Receive Date
+            pos = line.find(",");
+            if (pos == string::npos) {
+                quantity = stoi(line);
+                receiveDate = ""; // No receive date in file
+            } else {
+                quantity = stoi(line.substr(0, pos));
+                line.erase(0, pos + 1);
+                // Extract Receive Date
+                receiveDate = line;
+            }
+            
+            // Parse the receive date once, falling back to the current time if it is missing
+            int64_t receivedAt;
+            while (!receiveDate.empty() && isspace((unsigned char)receiveDate[receiveDate.length() - 1])) {
+                receiveDate.erase(receiveDate.length() - 1); // Files saved on Windows end lines with \r
+            }
+            if (receiveDate.empty()) {
+                receivedAt = (int64_t)time(0);
+            } else if (!FoodItem::parseDate(receiveDate, receivedAt)) {
+                continue; // Skip malformed lines
+            }
+            
+            // Create food item and insert into hash table
+            FoodItem item(id, name, price, category, quantity, receivedAt);
+            
+            // Always add as a new batch (like addExistingFoodItem does)
+            // This ensures all items from the file are loaded, including multiple batches of the same ID
+            // (placeBatch counts each new unique ID)
+            lock_guard<mutex> shardLock(shardLocks[shardOf(id)]);
+            if (placeBatch(item) != -1) {
+                itemsLoaded++;
+            }
+        }
+        
+        file.close();
+        engineOut() << "Successfully loaded " << itemsLoaded << " food items from " << filename << endl;
+        return itemsLoaded > 0;
+    }
+    
+    // Writes one batch as a line of food_items.txt (id,name,price,category,quantity,receiveDate)
+    static void writeBatch(ostream& out, const FoodItem& item) {
+        out << item.id << ","
+            << item.name << ","
+            << item.price << ","
+            << item.category << ","
+            << item.quantity << ","
+            << item.receiveDate << endl;
+    }
+    
+    // Saves all food items in the inventory to a TXT file
+    // Optional sorting by name can be applied before saving
+    virtual bool saveToFile(const string& filename, bool sorted = false) override {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.saveToFile");
+        RESTAURANT_LATENCY_SCOPE(LAT_INVENTORY_SAVE);
+        TraceSpan span("saveToFile", "inventory");
+        TrackedFileStream<ofstream> file;
+        file.open(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for writing" << endl;
+            return false;
+        }
+        
+        // Write a consistent point-in-time view, usage can carry on while the file is written
+        InventorySnapshot snapshot = takeSnapshot();
+        int totalItems = snapshot.getBatchCount();
+        
+        // Write to file
+        if (totalItems > 0) {
+            if (sorted) {
+                // Sorting needs its own copy of the batches
+                FoodItem* items = copyAllItems(snapshot);
+                if (items == nullptr) {
+                    engineOut() << "Error: Failed to allocate memory for food items." << endl;
+                    file.close();
+                    return false;
+                }
+                
+                timSort(items, totalItems, true); // Sort by name
+                for (int i = 0; i < totalItems; i++) {
+                    writeBatch(file, items[i]);
+                }
+                delete[] items;
+            } else {
+                // Unsorted saves stream straight from the snapshot's buckets
+                for (const FoodItem& item : snapshot.getBatches()) {
+                    writeBatch(file, item);
+                }
+            }
+            engineOut() << "Successfully saved " << totalItems << " food items to " << filename << endl;
+        } else {
+            // Write an empty file if no items
+            engineOut() << "No items to save to file." << endl;
+        }
+        
+        file.close();
+        return true;
+    }
+    
+    // Insert a food item into the hash table
+    // Parameters: food item to insert
+    // Returns: true if successful, false if failed
+    bool insertFoodItem(const FoodItem& item) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.insertFoodItem");
+        if (item.id.empty()) {
+            engineOut() << "Error: Food item ID cannot be empty." << endl;
+            return false;
+        }
+        if (!item.id.isValid()) {
+            engineOut() << "Error: Food item ID must be at most 4 characters." << endl;
+            return false;
+        }
+        
+        SharedScope scope(*this);
+        
+        // Hold the ID's shard so nobody else can place this ID while we decide where it goes
+        lock_guard<mutex> shardLock(shardLocks[shardOf(item.id)]);
+        
+        // Check if item with this ID already exists
+        int home = findHome(item.id);
+        if (home != -1) {
+            lock_guard<mutex> bucketLock(bucketLocks[home]);
+            const ADTLinkedQueue& queue = *hashTable[home];
+            if (bucketOwner[home].load(memory_order_relaxed) == item.id.getCode()) {
+                // Update quantity if item exists (combine quantities)
+                // The oldest batch keeps its details, the quantity is the total of all batches plus the new one
+                FoodItem updated = queue.peek();
+                updated.quantity = item.quantity;
+                for (const FoodItem& batch : queue) {
+                    updated.quantity += batch.quantity;
+                }
+                
+                // Replace the batches with the combined one inside the same bucket
+                ADTLinkedQueue* edited = editBucket(home);
+                edited->removeAll(item.id);
+                edited->enqueue(updated);
+                commitBucket(home, edited);
+                return true;
+            }
+        }
+        
+        // Add new item to the first free bucket on its probe sequence
+        if (placeBatch(item) == -1) {
+            engineOut() << "Error: Hash table is full." << endl;
+            return false;
+        }
+        
+        return true;
+    }
+    
+    // Find a food item by ID
+    // Parameters: ID to search for
+    // Returns: a view of the oldest batch with the quantity summed over all batches,
+    //          or a null view if not found
+    // Note: The view holds the bucket version it read, so it is safe to keep while other threads
+    //       change the item; a change to the bucket copies it while the view is held, so drop
+    //       views before changing the same item in a loop.
+    FoodItemView findFoodItem(const ItemID& id) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.findFoodItem");
+        RESTAURANT_LATENCY_SCOPE(LAT_FIND_FOOD);
+        TraceSpan span("findFoodItem", "inventory", id);
+        pullShared();
+        // Aggregates the quantities of all batches with the same ID
+        FoodItemView result;
+        
+        // All batches of an ID are kept in its home bucket
+        int home = findHome(id);
+        if (home == -1) {
+            return result;
+        }
+        
+        // Take a reference to the current version under the bucket lock (see editBucket),
+        // after which it can be read in place without the lock
+        {
+            lock_guard<mutex> bucketLock(bucketLocks[home]);
+            result.bucket = hashTable[home];
+        }
+        for (const FoodItem& item : *result.bucket) {
+            if (item.id == id) {
+                if (result.isNull()) {
+                    // First time finding an item with this ID
+                    result.firstBatch = &item;
+                }
+                result.totalQuantity += item.quantity;
+                result.batchCount++;
+            }
+        }
+        
+        return result;
+    }
+    
+    // Find a food item by ID and return an owning copy
+    // Parameters: ID to search for
+    // Returns: pointer to a copy of the oldest batch holding the total quantity, or nullptr if not found
+    // Note: Caller is responsible for deleting the returned pointer. Safe to call from any thread.
+    FoodItem* copyFoodItem(const ItemID& id) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.copyFoodItem");
+        pullShared();
+        int home = findHome(id);
+        if (home == -1) {
+            return nullptr;
+        }
+        
+        // Copy while the bucket is locked so the batches cannot change underneath us
+        lock_guard<mutex> bucketLock(bucketLocks[home]);
+        FoodItem* copy = nullptr;
+        for (const FoodItem& item : *hashTable[home]) {
+            if (item.id != id) continue;
+            if (copy == nullptr) {
+                copy = new FoodItem(item);
+            } else {
+                copy->quantity += item.quantity;
+            }
+        }
+        return copy;
+    }
+    
+    // Remove a food item by ID
+    // Parameters: ID of the item to remove
+    // Returns: true if found and removed, false if item not found
+    bool removeFoodItem(const ItemID& id) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.removeFoodItem");
+        SharedScope scope(*this);
+        int home = findHome(id);
+        if (home == -1) {
+            return false; // Item not found
+        }
+        
+        // Publish the bucket without this ID's batches and free the bucket
+        lock_guard<mutex> bucketLock(bucketLocks[home]);
+        if (!hashTable[home]->contains(id)) {
+            return false; // Removed by another thread before we got the lock
+        }
+        ADTLinkedQueue* edited = editBucket(home);
+        edited->removeAll(id);
+        commitBucket(home, edited);
+        releaseIfEmpty(home);
+        return true;
+    }
+    
+    // Display all food items (unsorted)
+    // Shows a formatted table of all items in the inventory
+    virtual void displayAll() override {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displayAll");
+        // Print table header with title
+        printHeader("Restaurant Inventory System - All Items");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        // Read a point-in-time snapshot, usage on other threads is not held up
+        InventorySnapshot snapshot = takeSnapshot();
+        int totalItems = snapshot.getBatchCount();
+        
+        // Handle empty inventory case
+        if (totalItems == 0) {
+            engineOut() << "No items in inventory." << endl;
+        } else {
+            // Display each batch straight from the snapshot
+            for (const FoodItem& item : snapshot.getBatches()) {
+                engineOut() << left << setw(10) << item.id 
+                     << setw(30) << item.name 
+                     << setw(10) << fixed << setprecision(2) << item.price
+                     << setw(15) << item.category
+                     << setw(10) << item.quantity 
+                     << setw(25) << item.getReceiveDateString() << endl;
+            }
+        }
+    }
+    
+    // Display all food items sorted by name or quantity
+    // Parameter: byName - if true, sort by name; if false, sort by quantity
+    // use tim sort
+    virtual void displaySorted(bool byName = true) override {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displaySorted");
+        // Print table header with appropriate title based on sort criteria
+        printHeader(byName ? "Restaurant Inventory System - Sorted by Name" 
+                           : "Restaurant Inventory System - Sorted by Quantity (Total)");
+        
+        // Print column headers
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        // Sort from a point-in-time snapshot
+        InventorySnapshot snapshot = takeSnapshot();
+        
+        // Count the total number of items we got
+        int totalItemCount = snapshot.getBatchCount();
+        
+        // Handle empty inventory case
+        if (totalItemCount == 0) {
+            engineOut() << "No items in inventory." << endl;
+        } else if (byName) {
+            // Sort a copy of every batch using Tim Sort algorithm based on name
+            FoodItem* items = copyAllItems(snapshot);
+            timSort(items, totalItemCount, true);
+            
+            // Display each item with formatted columns
+            for (int i = 0; i < totalItemCount; i++) {
+                engineOut() << left << setw(10) << items[i].id 
+                     << setw(30) << items[i].name 
+                     << setw(10) << fixed << setprecision(2) << items[i].price
+                     << setw(15) << items[i].category
+                     << setw(10) << items[i].quantity 
+                     << setw(25) << items[i].getReceiveDateString() << endl;
+            }
+            delete[] items;
+        } else {
+            // When sorting by quantity, we need one row per ID with the quantities added up.
+            // Every batch of an ID lives in its home bucket, whose queue keeps the running total,
+            // so the rows come straight from the buckets in O(buckets) instead of matching IDs
+            int bucketCount = snapshot.getBucketCount();
+            FoodItem* aggregatedItems = MemoryTracker::allocateArray<FoodItem>(MEM_SORT_SCRATCH, bucketCount);
+            int uniqueCount = 0;
+            for (int b = 0; b < bucketCount; b++) {
+                const ADTLinkedQueue& bucket = snapshot.getBucket(b);
+                if (bucket.isEmpty()) {
+                    continue;
+                }
+                // The oldest batch supplies the name, price and category
+                FoodItem& row = aggregatedItems[uniqueCount++];
+                row = bucket.peek();
+                row.quantity = bucket.getTotalQuantity();
+            }
+            
+            // Sort using Tim Sort algorithm based on quantity
+            timSort(aggregatedItems, uniqueCount, false);
+            
+            // Display each item with formatted columns
+            for (int i = 0; i < uniqueCount; i++) {
+                engineOut() << left << setw(10) << aggregatedItems[i].id 
+                     << setw(30) << aggregatedItems[i].name 
+                     << setw(10) << fixed << setprecision(2) << aggregatedItems[i].price
+                     << setw(15) << aggregatedItems[i].category
+                     << setw(10) << aggregatedItems[i].quantity 
+                     << "(Total)" << endl;
+            }
+            
+            // Clean up allocated memory
+            MemoryTracker::freeArray(MEM_SORT_SCRATCH, aggregatedItems, bucketCount);
+        }
+    }
+    
+    // Display all batches sorted by receive date (oldest first)
+    // Useful for checking freshness since batches are consumed in FIFO order
+    void displaySortedByDate() {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displaySortedByDate");
+        printHeader("Restaurant Inventory System - Sorted by Receive Date (Oldest First)");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        // Count the total number of batches in a point-in-time snapshot
+        InventorySnapshot snapshot = takeSnapshot();
+        int totalItems = snapshot.getBatchCount();
+        
+        if (totalItems == 0) {
+            engineOut() << "No items in inventory." << endl;
+            return;
+        }
+        
+        // Sort a copy using Tim Sort on the integer receive dates
+        FoodItem* items = copyAllItems(snapshot);
+        timSort(items, totalItems, SORT_BY_DATE);
+        
+        for (int i = 0; i < totalItems; i++) {
+            engineOut() << left << setw(10) << items[i].id 
+                 << setw(30) << items[i].name 
+                 << setw(10) << fixed << setprecision(2) << items[i].price
+                 << setw(15) << items[i].category
+                 << setw(10) << items[i].quantity 
+                 << setw(25) << items[i].getReceiveDateString() << endl;
+        }
+        
+        // Clean up allocated memory
+        delete[] items;
+    }
+    
+    // Search and display batches received at least minDays days ago
+    // Ageing query on the epoch receive dates, oldest batches are listed first
+    void searchByAge(int minDays) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.searchByAge");
+        if (minDays < 0) {
+            engineOut() << "Invalid number of days. It must be non-negative." << endl;
+            return;
+        }
+        
+        printHeader("Batches Received " + to_string(minDays) + " or More Days Ago");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Quantity" 
+             << setw(10) << "Age" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        InventorySnapshot snapshot = takeSnapshot();
+        int totalItems = snapshot.getBatchCount();
+        
+        int matchCount = 0;
+        if (totalItems > 0) {
+            int64_t now = (int64_t)time(0);
+            int64_t cutoff = now - (int64_t)minDays * 86400;
+            
+            FoodItem* items = copyAllItems(snapshot);
+            timSort(items, totalItems, SORT_BY_DATE);
+            
+            // Items are sorted by date, so stop at the first batch newer than the cutoff
+            for (int i = 0; i < totalItems && items[i].receiveDate <= cutoff; i++) {
+                engineOut() << left << setw(10) << items[i].id 
+                     << setw(30) << items[i].name 
+                     << setw(10) << items[i].quantity 
+                     << setw(10) << (to_string(items[i].getAgeInDays(now)) + "d")
+                     << setw(25) << items[i].getReceiveDateString() << endl;
+                matchCount++;
+            }
+            
+            delete[] items;
+        }
+        
+        if (matchCount == 0) {
+            engineOut() << "No batches received " << minDays << " or more days ago." << endl;
+        } else {
+            engineOut() << "\nFound " << matchCount << " batch(es) received " << minDays << " or more days ago." << endl;
+        }
+    }
+    
+    // Takes a consistent point-in-time snapshot of every bucket
+    // All bucket locks are held (in ascending order) only while the bucket versions are collected,
+    // which is one pointer copy per bucket; reading the snapshot afterwards takes no locks at all.
+    InventorySnapshot takeSnapshot() const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.takeSnapshot");
+        pullShared();
+        InventorySnapshot snapshot(TABLE_SIZE);
+        
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            bucketLocks[i].lock();
+        }
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            snapshot.setBucket(i, hashTable[i], bucketOwner[i].load(memory_order_relaxed));
+        }
+        snapshot.version = changeCount.load();
+        for (int i = TABLE_SIZE - 1; i >= 0; i--) {
+            bucketLocks[i].unlock();
+        }
+        
+        return snapshot;
+    }
+    
+    // Totals the stock value (price x quantity of every batch) of a snapshot in parallel
+    // Each task sums a run of buckets into its own slot, so the tasks share nothing while running
+    double computeStockValue(const InventorySnapshot& snapshot, TaskScheduler& scheduler) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.computeStockValue");
+        int bucketCount = snapshot.getBucketCount();
+        double* partial = MemoryTracker::allocateArray<double>(MEM_SORT_SCRATCH, bucketCount);
+        
+        scheduler.parallel_for(0, bucketCount, 8, [&](int first, int last) {
+            for (int b = first; b < last; b++) {
+                double sum = 0.0;
+                for (const FoodItem& item : snapshot.getBucket(b)) {
+                    sum += item.price * item.quantity;
+                }
+                partial[b] = sum;
+            }
+        });
+        
+        double total = 0.0;
+        for (int b = 0; b < bucketCount; b++) {
+            total += partial[b];
+        }
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, partial, bucketCount);
+        return total;
+    }
+    
+    // Copy all food items of a snapshot into an array
+    // Use this only when the caller needs to own or reorder the items (e.g. for sorting)
+    // Returns: dynamically allocated array of snapshot.getBatchCount() FoodItem objects
+    // Note: Caller is responsible for deleting the returned array
+    FoodItem* copyAllItems(const InventorySnapshot& snapshot) const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.copyAllItems");
+        int totalItems = snapshot.getBatchCount();
+        
+        // Check if there are any items to return
+        if (totalItems <= 0) {
+            return nullptr;
+        }
+        
+        // Try to allocate memory with exception handling to prevent crashes
+        FoodItem* items = nullptr;
+        try {
+            // Allocate memory for the array to hold all items based on the actual count
+            items = new FoodItem[totalItems];
+            int index = 0;
+            
+            // Copy each batch straight from the snapshot's buckets into the array
+            for (const FoodItem& item : snapshot.getBatches()) {
+                if (index < totalItems) {
+                    items[index++] = item;
+                }
+            }
+        } catch (const bad_alloc&) {
+            // Handle memory allocation failure
+            engineOut() << "Memory allocation failed in copyAllItems()" << endl;
+            return nullptr;
+        }
+        
+        return items;
+    }
+    
+    // Search and display food item by ID
+    // Presents formatted information about all instances of the item if found
+    // search from the hash table
+    void searchById(const ItemID& id) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.searchById");
+        bool found = false;
+        int totalCount = 0;
+        int totalQuantity = 0;
+        string itemName = "";
+        string category = "";
+        double price = 0.0;
+        
+        // Print table header
+        printHeader("Search Result for ID: " + id.toString());
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        // Iterate through all buckets of a snapshot to find all instances of this ID
+        InventorySnapshot snapshot = takeSnapshot();
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            const ADTLinkedQueue& bucket = snapshot.getBucket(i);
+            if (bucket.isEmpty()) continue;
+            
+            // Check each item in this bucket in place for matching ID
+            for (const FoodItem& item : bucket) {
+                if (item.id == id) {
+                    // Found a match, display it
+                    found = true;
+                    totalCount++;
+                    totalQuantity += item.quantity;
+                    
+                    // Store item details for summary
+                    if (itemName.empty()) {
+                        itemName = item.name;
+                        category = item.category;
+                        price = item.price;
+                    }
+                    
+                    // Format and display the item details
+                    engineOut() << left << setw(10) << item.id 
+                         << setw(30) << item.name 
+                         << setw(10) << fixed << setprecision(2) << item.price
+                         << setw(15) << item.category
+                         << setw(10) << item.quantity 
+                         << setw(25) << item.getReceiveDateString() << endl;
+                }
+            }
+
+        }
+        
+        // Show summary or not found message
+        if (found) {
+            engineOut() << "\n----- Summary -----" << endl;
+            engineOut() << "Found " << totalCount << " instance(s) of " << itemName << " (ID: " << id << ")" << endl;
+            engineOut() << "Total quantity: " << totalQuantity << endl;
+        } else {
+            engineOut() << "Item with ID " << id << " not found." << endl;
+        }
+    }
+    
+    // Get current number of items in the system
+    virtual int getItemCount() const override {
+        return Restaurant::getItemCount();
+    }
+
+    // Display queue contents for a specific bucket
+    // Parameters: bucketIndex - the index of the bucket to display
+    void displayQueue(int bucketIndex) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displayQueue");
+        // Validate bucket index
+        if (bucketIndex < 0 || bucketIndex >= TABLE_SIZE) {
+            engineOut() << "Invalid bucket index." << endl;
+            return;
+        }
+        
+        // Hold the current version of the bucket while it is displayed
+        BucketVersion version;
+        {
+            lock_guard<mutex> bucketLock(bucketLocks[bucketIndex]);
+            version = hashTable[bucketIndex];
+        }
+        const ADTLinkedQueue& queue = *version;
+        
+        // Check if the bucket is empty
+        if (queue.isEmpty()) {
+            engineOut() << "Bucket " << bucketIndex << " is empty." << endl;
+            return;
+        }
+        
+        // Print table header
+        printHeader("Queue Contents for Bucket " + to_string(bucketIndex));
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        // Display all items in the bucket
+        for (const FoodItem& item : queue) {
+            engineOut() << left << setw(10) << item.id 
+                 << setw(30) << item.name 
+                 << setw(10) << fixed << setprecision(2) << item.price
+                 << setw(15) << item.category
+                 << setw(10) << item.quantity 
+                 << setw(25) << item.getReceiveDateString() << endl;
+        }
+    }
+
+    // Display all non-empty queues in the hash table
+    // Shows the contents of each bucket that contains at least one item
+    void displayAllQueues() {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displayAllQueues");
+        printHeader("All Queues Contents");
+        
+        // Track if any non-empty queues were found
+        bool anyQueues = false;
+        
+        // Iterate through all buckets of a snapshot of the hash table
+        InventorySnapshot snapshot = takeSnapshot();
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            const ADTLinkedQueue& bucket = snapshot.getBucket(i);
+            
+            // Display only non-empty buckets
+            if (!bucket.isEmpty()) {
+                // Print bucket header with index and size information
+                engineOut() << "\nBucket " << i << " (Size: " << bucket.getSize() << "):" << endl;
+                engineOut() << left << setw(10) << "ID" 
+                     << setw(30) << "Name" 
+                     << setw(10) << "Price" 
+                     << setw(15) << "Category" 
+                     << setw(10) << "Quantity" 
+                     << setw(25) << "Receive Date" << endl;
+                engineOut() << string(100, '-') << endl;
+                
+                // Display each item in the current bucket
+                for (const FoodItem& item : bucket) {
+                    engineOut() << left << setw(10) << item.id 
+                         << setw(30) << item.name 
+                         << setw(10) << fixed << setprecision(2) << item.price
+                         << setw(15) << item.category
+                         << setw(10) << item.quantity 
+                         << setw(25) << item.getReceiveDateString() << endl;
+                }
+                
+                anyQueues = true;
+            }
+        }
+        
+        // Display message if all buckets are empty
+        if (!anyQueues) {
+            engineOut() << "No non-empty queues found." << endl;
+        }
+    }
+
+    /**
+     * Measures how well universalHash and quadraticProbing behave on the stored IDs
+     * Works on a snapshot, so it can run on any loaded dataset while orders continue.
+     * Probe lengths count the buckets findHome examines, starting at 1 for an ID in its own bucket.
+     */
+    HashDiagnostics computeHashDiagnostics() const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.computeHashDiagnostics");
+        HashDiagnostics result;
+        InventorySnapshot snapshot = takeSnapshot();
+        result.tableSize = TABLE_SIZE;
+        result.batchCount = snapshot.getBatchCount();
+        
+        int idsPerHashValue[TABLE_SIZE] = {0};
+        bool split[TABLE_SIZE] = {false};
+        long long totalProbes = 0;
+        
+        for (int b = 0; b < TABLE_SIZE; b++) {
+            const ADTLinkedQueue& bucket = snapshot.getBucket(b);
+            uint32_t owner = snapshot.owners[b];
+            
+            // Batches of any other ID break the one-ID-per-bucket invariant
+            for (const FoodItem& item : bucket) {
+                uint32_t code = item.id.getCode();
+                if (code == owner) {
+                    continue;
+                }
+                result.strayBatches++;
+                for (int o = 0; o < TABLE_SIZE; o++) {
+                    if (snapshot.owners[o] == code) {
+                        split[o] = true;
+                        break;
+                    }
+                }
+            }
+            
+            if (owner == 0 || bucket.isEmpty()) {
+                continue;
+            }
+            
+            // Probe length of the owner: position of this bucket on its probe sequence
+            result.idCount++;
+            int hashValue = universalHash(bucket.peek().id);
+            idsPerHashValue[hashValue]++;
+            int probes = TABLE_SIZE;
+            for (int attempt = 0; attempt < TABLE_SIZE; attempt++) {
+                if (quadraticProbing(hashValue, attempt) == b) {
+                    probes = attempt + 1;
+                    break;
+                }
+            }
+            totalProbes += probes;
+            if (probes > result.maxProbeLength) result.maxProbeLength = probes;
+            if (probes > 1) result.displacedIds++;
+            result.probeLengthCounts[(probes < HashDiagnostics::PROBE_HISTOGRAM) ? probes - 1 : HashDiagnostics::PROBE_HISTOGRAM - 1]++;
+            
+            // Chain length of the bucket
+            int chain = bucket.getSize();
+            if (result.minChainLength == 0 || chain < result.minChainLength) result.minChainLength = chain;
+            if (chain > result.maxChainLength) result.maxChainLength = chain;
+            int chainSlot = (chain <= 1) ? 0 : (chain <= 4) ? 1 : (chain <= 16) ? 2 : (chain <= 64) ? 3 : (chain <= 256) ? 4 : 5;
+            result.chainLengthCounts[chainSlot]++;
+        }
+        
+        for (int b = 0; b < TABLE_SIZE; b++) {
+            if (split[b]) result.splitIds++;
+            if (idsPerHashValue[b] > 0) result.distinctHashValues++;
+            if (idsPerHashValue[b] > result.maxIdsPerHashValue) result.maxIdsPerHashValue = idsPerHashValue[b];
+        }
+        
+        double n = result.idCount;
+        double m = TABLE_SIZE;
+        result.loadFactor = n / m;
+        if (result.idCount > 0) {
+            result.averageProbeLength = (double)totalProbes / result.idCount;
+            result.averageChainLength = (double)result.batchCount / result.idCount;
+        }
+        
+        // Quadratic probing with an ideal hash: 1 - ln(1 - a) - a/2 probes per successful lookup (Knuth)
+        if (result.loadFactor < 1.0) {
+            result.expectedProbeLength = 1.0 - log(1.0 - result.loadFactor) - result.loadFactor / 2.0;
+        }
+        result.observedCollisions = result.idCount - result.distinctHashValues;
+        result.expectedCollisions = n - m * (1.0 - pow(1.0 - 1.0 / m, n));
+        
+        // findHome cannot stop at an empty bucket (removing an ID frees its bucket without a marker),
+        // so a miss walks the whole probe sequence
+        result.missProbeLength = TABLE_SIZE;
+        bool reachable[TABLE_SIZE] = {false};
+        for (int attempt = 0; attempt < TABLE_SIZE; attempt++) {
+            int position = quadraticProbing(0, attempt);
+            if (!reachable[position]) {
+                reachable[position] = true;
+                result.reachableBuckets++;
+            }
+        }
+        long long stopProbes = 0;
+        for (int hashValue = 0; hashValue < TABLE_SIZE; hashValue++) {
+            int probes = TABLE_SIZE;
+            for (int attempt = 0; attempt < TABLE_SIZE; attempt++) {
+                if (snapshot.owners[quadraticProbing(hashValue, attempt)] == 0) {
+                    probes = attempt + 1;
+                    break;
+                }
+            }
+            stopProbes += probes;
+        }
+        result.missProbeIfStopAtEmpty = (double)stopProbes / TABLE_SIZE;
+        
+        // Runs of adjacent occupied buckets, starting after an empty bucket so a run is not cut at the wrap
+        int start = -1;
+        for (int b = 0; b < TABLE_SIZE; b++) {
+            if (snapshot.owners[b] == 0) {
+                start = b;
+                break;
+            }
+        }
+        if (start == -1) {
+            result.clusterCount = 1;
+            result.longestCluster = TABLE_SIZE;
+        } else {
+            int run = 0;
+            for (int step = 1; step <= TABLE_SIZE; step++) {
+                int b = (start + step) % TABLE_SIZE;
+                if (snapshot.owners[b] != 0) {
+                    if (run == 0) result.clusterCount++;
+                    run++;
+                    if (run > result.longestCluster) result.longestCluster = run;
+                } else {
+                    run = 0;
+                }
+            }
+        }
+        
+        return result;
+    }
+    
+    // Displays the hash table diagnostics report
+    void displayHashDiagnostics() const {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displayHashDiagnostics");
+        HashDiagnostics d = computeHashDiagnostics();
+        
+        printHeader("Hash Table Diagnostics");
+        engineOut() << fixed << setprecision(2);
+        engineOut() << left << setw(40) << "Buckets" << d.tableSize << endl;
+        engineOut() << left << setw(40) << "IDs stored (occupied buckets)" << d.idCount << endl;
+        engineOut() << left << setw(40) << "Batches stored" << d.batchCount << endl;
+        engineOut() << left << setw(40) << "Load factor" << d.loadFactor << endl;
+        
+        engineOut() << "\n-- Successful lookups (buckets examined) --" << endl;
+        engineOut() << left << setw(40) << "Average probe length" << d.averageProbeLength
+             << "  (ideal hash at this load: " << d.expectedProbeLength << ")" << endl;
+        engineOut() << left << setw(40) << "Maximum probe length" << d.maxProbeLength << endl;
+        engineOut() << left << setw(40) << "IDs outside their hash bucket" << d.displacedIds << endl;
+        engineOut() << left << setw(40) << "Probe length 1 / 2 / 3 / 4 / 5+";
+        for (int i = 0; i < HashDiagnostics::PROBE_HISTOGRAM; i++) {
+            engineOut() << (i > 0 ? " / " : "") << d.probeLengthCounts[i];
+        }
+        engineOut() << endl;
+        
+        engineOut() << "\n-- Unsuccessful lookups --" << endl;
+        engineOut() << left << setw(40) << "Probe length (whole sequence)" << d.missProbeLength << endl;
+        engineOut() << left << setw(40) << "Average if stopped at first empty" << d.missProbeIfStopAtEmpty << endl;
+        engineOut() << left << setw(40) << "Buckets reachable per probe sequence" << d.reachableBuckets
+             << " of " << d.tableSize << endl;
+        
+        engineOut() << "\n-- Hash values --" << endl;
+        engineOut() << left << setw(40) << "Distinct hash values" << d.distinctHashValues << endl;
+        engineOut() << left << setw(40) << "Collisions (observed / expected)" << d.observedCollisions
+             << " / " << d.expectedCollisions << endl;
+        engineOut() << left << setw(40) << "Most IDs sharing one hash value" << d.maxIdsPerHashValue << endl;
+        engineOut() << left << setw(40) << "Clusters (count / longest run)" << d.clusterCount
+             << " / " << d.longestCluster << endl;
+        
+        engineOut() << "\n-- Chains (batches per occupied bucket) --" << endl;
+        engineOut() << left << setw(40) << "Min / average / max" << d.minChainLength << " / "
+             << d.averageChainLength << " / " << d.maxChainLength << endl;
+        engineOut() << left << setw(40) << "1 / 2-4 / 5-16 / 17-64 / 65-256 / 257+";
+        for (int i = 0; i < HashDiagnostics::CHAIN_HISTOGRAM; i++) {
+            engineOut() << (i > 0 ? " / " : "") << d.chainLengthCounts[i];
+        }
+        engineOut() << endl;
+        
+        engineOut() << "\n-- Placement --" << endl;
+        engineOut() << left << setw(40) << "IDs split across buckets" << d.splitIds << endl;
+        engineOut() << left << setw(40) << "Batches in another ID's bucket" << d.strayBatches << endl;
+        printFooter();
+        
+        if (d.observedCollisions > d.expectedCollisions * 1.5 + 2) {
+            engineOut() << "Warning: the stored IDs collide noticeably more often than a uniform hash would." << endl;
+        }
+        if (d.loadFactor > 0.5) {
+            engineOut() << "Warning: load factor above 0.5; a probe sequence reaches only " << d.reachableBuckets
+                 << " buckets, so adding a new ID may fail while buckets are still free." << endl;
+        }
+        if (d.splitIds > 0 || d.strayBatches > 0) {
+            engineOut() << "Warning: some batches are not stored in their ID's home bucket." << endl;
+        }
+    }
+
+    // Consume a food item by ID without printing anything
+    // Parameters: id - the ID of the food item to consume
+    //             amount - the quantity to consume
+    //             remaining - if given, receives the stock left afterwards (the stock found if nothing was consumed)
+    //             itemName - if given, receives the name of the item (empty if it was not found)
+    // Returns: USE_OK if consumed, otherwise why nothing was consumed
+    // Note: Like useFoodItems, the home bucket is looked up again if the ID was used up and
+    //       placed elsewhere before its lock was taken
+    UseResult consumeFoodItem(const ItemID& id, int amount, int* remaining = nullptr, string* itemName = nullptr) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.consumeFoodItem");
+        RESTAURANT_LATENCY_SCOPE(LAT_USE_FOOD);
+        TraceSpan span("useFoodItem", "inventory", id, amount);
+        SharedScope scope(*this);
+        string name = "";
+        int totalQuantity = 0;
+        bool found = false;
+        
+        // All batches of this ID live in its home bucket
+        int home;
+        while ((home = findHome(id)) != -1) {
+            // Check and consume under the bucket lock, so no other terminal can take the same stock
+            lock_guard<mutex> bucketLock(bucketLocks[home]);
+            if (bucketOwner[home].load(memory_order_relaxed) != id.getCode()) {
+                continue;
+            }
+            found = true;
+            
+            // First pass: Find the item and calculate total quantity
+            for (const FoodItem& item : *hashTable[home]) {
+                if (item.id == id) {
+                    if (name.empty()) {
+                        name = item.name;
+                    }
+                    totalQuantity += item.quantity;
+                }
+            }
+            
+            // Second pass: consume in FIFO order
+            if (totalQuantity > 0 && totalQuantity >= amount) {
+                TraceSpan consumeSpan("consume", "inventory", id, amount);
+                ADTLinkedQueue* edited = editBucket(home);
+                edited->consume(id, amount);
+                commitBucket(home, edited);
+                releaseIfEmpty(home);
+            }
+            break;
+        }
+        
+        UseResult result = !found ? USE_NOT_FOUND
+                         : (totalQuantity == 0) ? USE_OUT_OF_STOCK
+                         : (totalQuantity < amount) ? USE_NOT_ENOUGH : USE_OK;
+        if (remaining != nullptr) {
+            *remaining = (result == USE_OK) ? totalQuantity - amount : totalQuantity;
+        }
+        if (itemName != nullptr) {
+            *itemName = name;
+        }
+        return result;
+    }
+
+    // Use (consume) a food item by ID - improved implementation for duplicate IDs
+    // Parameters: id - the ID of the food item to consume
+    //             amount - the quantity to consume (default: 1)
+    // Returns: true if successfully consumed, false if item not found, out of stock or not enough quantity
+    bool useFoodItem(const ItemID& id, int amount = 1) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.useFoodItem");
+        try {
+            string itemName;
+            int remaining = 0;
+            switch (consumeFoodItem(id, amount, &remaining, &itemName)) {
+                case USE_NOT_FOUND:
+                    engineOut() << "Error: Food item with ID " << id << " not found." << endl;
+                    return false;
+                case USE_OUT_OF_STOCK:
+                    engineOut() << "Error: " << itemName << " (ID " << id << ") is out of stock." << endl;
+                    return false;
+                case USE_NOT_ENOUGH:
+                    engineOut() << "Error: Not enough quantity available. Only " << remaining << " units of " << itemName << " in stock." << endl;
+                    return false;
+                case USE_OK:
+                    break;
+            }
+            
+            // Display success message with consumption details
+            engineOut() << "Successfully used " << amount << " units of " << itemName << ". Remaining: " << remaining << endl;
+            return true;
+        } catch (const bad_alloc& e) {
+            // Handle memory allocation errors
+            engineOut() << "Memory allocation error in useFoodItem: " << e.what() << endl;
+            return false;
+        } catch (const exception& e) {
+            // Handle standard exceptions
+            engineOut() << "Error in useFoodItem: " << e.what() << endl;
+            return false;
+        } catch (...) {
+            // Handle any other unexpected errors
+            engineOut() << "Unknown error in useFoodItem" << endl;
+            return false;
+        }
+    }
+    
+    // Use (consume) several food items as one order, all or nothing
+    // Parameters: order - food IDs and quantities to consume (an ID may appear more than once)
+    //             errorMessage - if given, receives the error instead of it being printed
+    //             itemNames - if given, an array of order.getSize() strings that receives the
+    //                         name of each ingredient (for logging without another lookup)
+    // Returns: true if every ingredient was available and consumed, false if nothing was consumed
+    // Note: The home buckets are locked together in ascending index order, so concurrent
+    //       orders can never deadlock and no other terminal sees a half-prepared order
+    bool useFoodItems(const IngredientList& order, string* errorMessage = nullptr, string* itemNames = nullptr) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.useFoodItems");
+        RESTAURANT_LATENCY_SCOPE(LAT_USE_ORDER);
+        TraceSpan span("useFoodItems", "inventory");
+        int count = order.getSize();
+        if (count == 0) {
+            return true;
+        }
+        SharedScope scope(*this);
+        
+        // Home bucket of each ingredient, followed by the distinct buckets in ascending order
+        // Small orders keep both lists on the stack
+        const int INLINE_INGREDIENTS = 16;
+        int inlineBuffer[INLINE_INGREDIENTS * 2];
+        int* buffer = (count <= INLINE_INGREDIENTS) ? inlineBuffer
+                                                    : MemoryTracker::allocateArray<int>(MEM_SORT_SCRATCH, count * 2);
+        int* homes = buffer;
+        int* buckets = buffer + count;
+        
+        bool success = false;
+        string error = "";
+        
+        while (true) {
+            // Resolve each ingredient's home bucket and keep the distinct buckets sorted
+            int bucketCount = 0;
+            int missing = -1;
+            for (int i = 0; i < count; i++) {
+                homes[i] = findHome(order[i].foodId);
+                if (homes[i] == -1) {
+                    missing = i;
+                    break;
+                }
+                
+                int j = bucketCount;
+                while (j > 0 && buckets[j - 1] > homes[i]) {
+                    j--;
+                }
+                if (j > 0 && buckets[j - 1] == homes[i]) {
+                    continue; // Already in the list
+                }
+                for (int k = bucketCount; k > j; k--) {
+                    buckets[k] = buckets[k - 1];
+                }
+                buckets[j] = homes[i];
+                bucketCount++;
+            }
+            
+            if (missing != -1) {
+                error = "Error: Food item with ID " + order[missing].foodId.toString() + " not found.";
+                break;
+            }
+            
+            // Lock every bucket in the order, always in ascending index order
+            for (int b = 0; b < bucketCount; b++) {
+                bucketLocks[buckets[b]].lock();
+            }
+            
+            // An ingredient may have been used up and placed elsewhere before we got the locks
+            bool moved = false;
+            for (int i = 0; i < count && !moved; i++) {
+                moved = bucketOwner[homes[i]].load(memory_order_relaxed) != order[i].foodId.getCode();
+            }
+            
+            if (!moved) {
+                // Check every ingredient first, adding up repeated IDs
+                bool enough = true;
+                for (int i = 0; i < count && enough; i++) {
+                    const ItemID& id = order[i].foodId;
+                    bool firstOccurrence = true;
+                    int required = 0;
+                    for (int j = 0; j < count; j++) {
+                        if (order[j].foodId == id) {
+                            if (j < i) {
+                                firstOccurrence = false;
+                                break;
+                            }
+                            required += order[j].quantity;
+                        }
+                    }
+                    if (!firstOccurrence) continue;
+                    
+                    int available = 0;
+                    string itemName = "";
+                    for (const FoodItem& item : *hashTable[homes[i]]) {
+                        if (item.id == id) {
+                            available += item.quantity;
+                            itemName = item.name;
+                        }
+                    }
+                    
+                    if (available < required) {
+                        enough = false;
+                        error = "Error: Not enough quantity available. Only " + to_string(available) +
+                                       " units of " + itemName + " in stock.";
+                    }
+                }
+                
+                // Then consume them all in FIFO order, one change per bucket
+                // (repeated IDs in the order are consumed from the same draft)
+                if (enough) {
+                    if (itemNames != nullptr) {
+                        for (int i = 0; i < count; i++) {
+                            itemNames[i] = hashTable[homes[i]]->peek().name;
+                        }
+                    }
+                    for (int b = 0; b < bucketCount; b++) {
+                        ADTLinkedQueue* edited = editBucket(buckets[b]);
+                        for (int i = 0; i < count; i++) {
+                            if (homes[i] == buckets[b]) {
+                                TraceSpan consumeSpan("consume", "inventory", order[i].foodId, order[i].quantity);
+                                edited->consume(order[i].foodId, order[i].quantity);
+                            }
+                        }
+                        commitBucket(buckets[b], edited);
+                        releaseIfEmpty(buckets[b]);
+                    }
+                    success = true;
+                }
+            }
+            
+            for (int b = bucketCount - 1; b >= 0; b--) {
+                bucketLocks[buckets[b]].unlock();
+            }
+            
+            if (!moved) {
+                break;
+            }
+        }
+        
+        if (buffer != inlineBuffer) {
+            MemoryTracker::freeArray(MEM_SORT_SCRATCH, buffer, count * 2);
+        }
+        
+        if (!success) {
+            if (errorMessage != nullptr) {
+                *errorMessage = error;
+            } else {
+                engineOut() << error << endl;
+            }
+        }
+        return success;
+    }
+    
+    // Log usage of food items to a history file
+    // Parameters: id - the ID of the food item that was used
+    //             amount - the quantity that was used
+    //             purpose - description of why the item was used
+    // Note: Looks the name up first; use the overload taking the name when the caller already has it
+    void logItemUsage(const ItemID& id, int amount, const string& purpose) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.logItemUsage");
+        // Retrieve the item details for complete logging
+        // (a copy, the item may be changed by another terminal meanwhile)
+        FoodItem* item = copyFoodItem(id);
+        if (item == nullptr) {
+            engineOut() << "Warning: Could not find item details for logging." << endl;
+            return;
+        }
+        string itemName = item->name;
+        delete item;
+        
+        logItemUsage(id, itemName, amount, purpose);
+    }
+    
+    // Log usage of food items to a history file
+    // Parameters: id, name - the food item that was used
+    //             amount - the quantity that was used
+    //             purpose - description of why the item was used
+    // Note: Only queues the record, the background logger writes it with the next group
+    void logItemUsage(const ItemID& id, const string& name, int amount, const string& purpose) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.logItemUsage");
+        TraceSpan span("logItemUsage", "inventory", id, amount);
+        try {
+            usageLogger.log(id, name, amount, purpose);
+        } catch (const exception& e) {
+            // Handle standard exceptions
+            engineOut() << "Error in logItemUsage: " << e.what() << endl;
+        } catch (...) {
+            // Handle any unexpected errors
+            engineOut() << "Unknown error in logItemUsage" << endl;
+        }
+    }
+    
+    // Waits until every logged usage has been written to the usage history file
+    // Returns: false if some records could not be written
+    bool flushUsageLog() {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.flushUsageLog");
+        return usageLogger.flush();
+    }
+    
+    // Syncs the usage history file to disk after every group, so logged usage survives a power loss
+    // Off by default: each group then costs a disk flush (see --sync-usage-log)
+    void setUsageLogSync(bool enabled) {
+        usageLogger.setSyncEachBatch(enabled);
+    }
+    
+    // Display usage history from log file
+    // Shows all recorded item usage in a formatted table
+    void displayUsageHistory() {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.displayUsageHistory");
+        // Make sure usage logged so far is in the file
+        usageLogger.flush();
+        
+        // Try to open the history file
+        TrackedFileStream<ifstream> historyFile;
+        historyFile.open(usageHistoryFile);
+        if (!historyFile.is_open()) {
+            engineOut() << "No usage history found." << endl;
+            return;
+        }
+        
+        // Display the table header
+        printHeader("Food Usage History");
+        engineOut() << left << setw(25) << "Date/Time" 
+             << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Amount" 
+             << setw(30) << "Purpose" << endl;
+        printFooter();
+        
+        // Read and parse each line in the history file
+        string line;
+        while (getline(historyFile, line)) {
+            string dateTime, id, name, amount, purpose;
+            
+            // Parse TXT line format: timestamp,id,name,amount,purpose
+            size_t pos = 0;
+            
+            // Extract Date/Time
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            dateTime = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract ID
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            id = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Name
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            name = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Amount
+            pos = line.find(",");
+            if (pos == string::npos) continue; // Skip malformed lines
+            amount = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // The rest is purpose
+            purpose = line;
+            
+            // Display the entry in a formatted row
+            engineOut() << left << setw(25) << dateTime 
+                 << setw(10) << id 
+                 << setw(30) << name 
+                 << setw(10) << amount 
+                 << setw(30) << purpose << endl;
+        }
+        
+        // Close the file when done
+        historyFile.close();
+    }
+
+    // Add an existing food item with its current state
+    // Unlike insertFoodItem, this doesn't try to merge quantities
+    // Parameters: item - the food item to add
+    // Returns: true if successful, false if failed
+    bool addExistingFoodItem(const FoodItem& item) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.addExistingFoodItem");
+        // Validate the item ID
+        if (item.id.empty()) {
+            engineOut() << "Error: Food item ID cannot be empty." << endl;
+            return false;
+        }
+        if (!item.id.isValid()) {
+            engineOut() << "Error: Food item ID must be at most 4 characters." << endl;
+            return false;
+        }
+        
+        // Always add the new item to the queue with its own timestamp
+        // This ensures FIFO ordering when consuming items
+        // (placeBatch appends to the ID's home bucket and counts the ID if it is new)
+        SharedScope scope(*this);
+        lock_guard<mutex> shardLock(shardLocks[shardOf(item.id)]);
+        if (placeBatch(item) == -1) {
+            engineOut() << "Error: Hash table is full." << endl;
+            return false;
+        }
+        
+        return true;
+    }
+    
+    // Lowercases one ASCII letter without a locale lookup, other bytes are left as they are
+    static char foldCase(char c) {
+        return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+    
+    // Lowercases a search term once so it can be matched against many names
+    static string lowerCaseName(const string& text) {
+        string lower = text;
+        for (size_t i = 0; i < lower.length(); i++) {
+            lower[i] = foldCase(lower[i]);
+        }
+        return lower;
+    }
+    
+    // Case-insensitive partial name match used by every inventory and menu name search
+    // Compares in place, so matching a name allocates nothing
+    // Parameters: name - the name to look in; lowerQuery - the search term after lowerCaseName
+    static bool nameMatches(const string& name, const string& lowerQuery) {
+        if (lowerQuery.length() > name.length()) {
+            return false;
+        }
+        if (lowerQuery.empty()) {
+            return true;
+        }
+        const char* text = name.data();
+        const char* query = lowerQuery.data();
+        size_t length = lowerQuery.length();
+        size_t last = name.length() - length;
+        for (size_t start = 0; start <= last; start++) {
+            // Cheap first-character test before comparing the rest
+            if (foldCase(text[start]) != query[0]) {
+                continue;
+            }
+            size_t i = 1;
+            while (i < length && foldCase(text[start + i]) == query[i]) {
+                i++;
+            }
+            if (i == length) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Search and display food items by name
+    // Performs a partial string match and displays all matching items
+    // search from the hash table
+    void searchByName(const string& name) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.searchByName");
+        // Print table header
+        printHeader("Search Results by Name");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        // Convert search name to lowercase for case-insensitive search
+        string searchNameLower = lowerCaseName(name);
+        
+        bool found = false;
+        int matchCount = 0;
+        
+        // Search a snapshot of the hash table to see all instances
+        InventorySnapshot snapshot = takeSnapshot();
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            const ADTLinkedQueue& bucket = snapshot.getBucket(i);
+            if (bucket.isEmpty()) continue;
+            
+            // Check each item in this bucket in place
+            for (const FoodItem& item : bucket) {
+                // Check if the item name contains the search string
+                if (nameMatches(item.name, searchNameLower)) {
+                    // Format and display the matching item details
+                    engineOut() << left << setw(10) << item.id 
+                         << setw(30) << item.name 
+                         << setw(10) << fixed << setprecision(2) << item.price
+                         << setw(15) << item.category
+                         << setw(10) << item.quantity 
+                         << setw(25) << item.getReceiveDateString() << endl;
+                    found = true;
+                    matchCount++;
+                }
+            }
+
+        }
+        
+        // Display message if no matches found
+        if (!found) {
+            engineOut() << "No items found matching name \"" << name << "\"." << endl;
+        } else {
+            engineOut() << "\nFound " << matchCount << " item(s) matching \"" << name << "\"." << endl;
+        }
+    }
+    
+    // Search and display food items by price range
+    // Shows all items with price between minPrice and maxPrice (inclusive)
+    // search from the hash table
+    void searchByPrice(double minPrice, double maxPrice) {
+        RESTAURANT_ALLOCATION_SCOPE("inventory.searchByPrice");
+        // Validate price range
+        if (minPrice < 0 || maxPrice < 0) {
+            engineOut() << "Invalid price range. Prices must be non-negative." << endl;
+            return;
+        }
+        
+        // Swap if minPrice is greater than maxPrice
+        if (minPrice > maxPrice) {
+            double temp = minPrice;
+            minPrice = maxPrice;
+            maxPrice = temp;
+        }
+        
+        // Print table header
+        printHeader("Search Results by Price Range");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(15) << "Category" 
+             << setw(10) << "Quantity" 
+             << setw(25) << "Receive Date" << endl;
+        printFooter();
+        
+        bool found = false;
+        int matchCount = 0;
+        
+        // Search a snapshot of the hash table to see all instances
+        InventorySnapshot snapshot = takeSnapshot();
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            const ADTLinkedQueue& bucket = snapshot.getBucket(i);
+            if (bucket.isEmpty()) continue;
+            
+            // Check each item in this bucket in place
+            for (const FoodItem& item : bucket) {
+                if (item.price >= minPrice && item.price <= maxPrice) {
+                    // Format and display the matching item details
+                    engineOut() << left << setw(10) << item.id 
+                         << setw(30) << item.name 
+                         << setw(10) << fixed << setprecision(2) << item.price
+                         << setw(15) << item.category
+                         << setw(10) << item.quantity 
+                         << setw(25) << item.getReceiveDateString() << endl;
+                    found = true;
+                    matchCount++;
+                }
+            }
+
+        }
+        
+        // Display message if no matches found
+        if (!found) {
+            engineOut() << "No items found in the price range " << fixed << setprecision(2) 
+                 << minPrice << " - " << maxPrice << "." << endl;
+        } else {
+            engineOut() << "\nFound " << matchCount << " item(s) in the price range " 
+                 << fixed << setprecision(2) << minPrice << " - " << maxPrice << "." << endl;
+        }
+    }
+};
+
+
+// Utility sorting and searching functions for restaurant menu system
+
+// Merge function (part of Tim Sort) for MenuItem objects
+// Merges two sorted subarrays into one sorted array
+// Parameters: array, left boundary, middle point, right boundary, sort criteria (name, price, or category)
+inline void mergeMenuItems(MenuItem arr[], int left, int mid, int right, const string& sortBy = "name") {
+    int len1 = mid - left + 1;
+    int len2 = right - mid;
+    
+    // Create temporary arrays to hold the two subarrays
+    MenuItem* leftArr = MemoryTracker::allocateArray<MenuItem>(MEM_SORT_SCRATCH, len1);
+    MenuItem* rightArr = MemoryTracker::allocateArray<MenuItem>(MEM_SORT_SCRATCH, len2);
+    
+    // Copy data to temporary arrays
+    for (int i = 0; i < len1; i++)
+        leftArr[i] = arr[left + i];
+    for (int i = 0; i < len2; i++)
+        rightArr[i] = arr[mid + 1 + i];
+    
+    // Merge the temporary arrays back into the original array
+    int i = 0, j = 0, k = left;
+    
+    while (i < len1 && j < len2) {
+        bool compareResult = false;
+        
+        // Compare based on the sort criteria
+        if (sortBy == "price") {
+            // Sort by price (ascending order)
+            compareResult = (leftArr[i].price <= rightArr[j].price);
+        } 
+        else if (sortBy == "category") {
+            // Sort by category (alphabetical order)
+            compareResult = (leftArr[i].category <= rightArr[j].category);
+        }
+        else if (sortBy == "id") {
+            // Sort by id (alphabetical order)
+            compareResult = (leftArr[i].id <= rightArr[j].id);
+        }
+        else {
+            // Default: Sort by name (alphabetical order)
+            compareResult = (leftArr[i].name <= rightArr[j].name);
+        }
+        
+        if (compareResult) {
+            arr[k] = leftArr[i];
+            i++;
+        } else {
+            arr[k] = rightArr[j];
+            j++;
+        }
+        k++;
+    }
+    
+    // Copy any remaining elements from the left subarray
+    while (i < len1) {
+        arr[k] = leftArr[i];
+        i++;
+        k++;
+    }
+    
+    // Copy any remaining elements from the right subarray
+    while (j < len2) {
+        arr[k] = rightArr[j];
+        j++;
+        k++;
+    }
+    
+    // Free allocated memory for temporary arrays
+    MemoryTracker::freeArray(MEM_SORT_SCRATCH, leftArr, len1);
+    MemoryTracker::freeArray(MEM_SORT_SCRATCH, rightArr, len2);
+}
+
+// Insertion sort (part of Tim Sort) for MenuItem objects
+// Efficiently sorts small subarrays using in-place insertion sort
+// Parameters: array, left boundary, right boundary, sort criteria (name, price, or category)
+inline void insertionSortMenuItems(MenuItem arr[], int left, int right, const string& sortBy = "name") {
+    for (int i = left + 1; i <= right; i++) {
+        // Store current element as temporary
+        MenuItem temp = arr[i];
+        int j = i - 1;
+        
+        if (sortBy == "price") {
+            // Sort by price (ascending order)
+            while (j >= left && arr[j].price > temp.price) {
+                arr[j + 1] = arr[j];
+                j--;
+            }
+        } 
+        else if (sortBy == "category") {
+            // Sort by category (alphabetical order)
+            while (j >= left && arr[j].category > temp.category) {
+                arr[j + 1] = arr[j];
+                j--;
+            }
+        }
+        else if (sortBy == "id") {
+            // Sort by id (alphabetical order)
+            while (j >= left && arr[j].id > temp.id) {
+                arr[j + 1] = arr[j];
+                j--;
+            }
+        }
+        else {
+            // Default: Sort by name (alphabetical order)
+            while (j >= left && arr[j].name > temp.name) {
+                arr[j + 1] = arr[j];
+                j--;
+            }
+        }
+        
+        // Place temp in its correct position
+        arr[j + 1] = temp;
+    }
+}
+
+// Tim Sort main function for MenuItem objects
+// A hybrid sorting algorithm combining insertion sort and merge sort
+// Average time complexity: O(n log n)
+// Parameters: array, array size, sort criteria (name, price, or category)
+inline void timSortMenuItems(MenuItem arr[], int n, const string& sortBy = "name") {
+    // Run size for insertion sort (optimal value based on typical array sizes)
+    const int RUN = 32;
+    
+    // First, sort individual subarrays of size RUN using insertion sort
+    // This is efficient for small arrays and creates sorted runs
+    for (int i = 0; i < n; i += RUN) {
+        insertionSortMenuItems(arr, i, min(i + RUN - 1, n - 1), sortBy);
+    }
+    
+    // Start merging sorted runs from size RUN
+    // Each iteration doubles the size of subarrays being merged
+    for (int size = RUN; size < n; size = 2 * size) {
+        // Pick starting points of different subarrays of current size
+        for (int left = 0; left < n; left += 2 * size) {
+            // Find ending points of subarrays
+            int mid = left + size - 1;
+            int right = min(left + 2 * size - 1, n - 1);
+            
+            // Merge subarrays arr[left...mid] and arr[mid+1...right]
+            if (mid < right) {
+                mergeMenuItems(arr, left, mid, right, sortBy);
+            }
+        }
+    }
+}
+
+// Checks if menu item a belongs before (or level with) menu item b for the given sort criteria
+// Parameters: two menu items and the sort criteria (name, price, category or id)
+inline bool menuItemsInOrder(const MenuItem& a, const MenuItem& b, const string& sortBy) {
+    if (sortBy == "price") {
+        return a.price <= b.price;
+    } else if (sortBy == "category") {
+        return a.category <= b.category;
+    } else if (sortBy == "id") {
+        return a.id <= b.id;
+    }
+    // Default: Sort by name (alphabetical order)
+    return a.name <= b.name;
+}
+
+// Merge function (part of Tim Sort) for arrays of menu item pointers
+// Sorting pointers lets callers order the menu without copying any MenuItem
+// Parameters: array, shared temporary buffer, left boundary, middle point, right boundary, sort criteria
+inline void mergeMenuItems(const MenuItem* arr[], const MenuItem* buffer[], int left, int mid, int right, 
+                    const string& sortBy = "name") {
+    // Copy the left run into the temporary buffer, the right run is merged in place
+    int len1 = mid - left + 1;
+    for (int i = 0; i < len1; i++) {
+        buffer[i] = arr[left + i];
+    }
+    
+    int i = 0, j = mid + 1, k = left;
+    while (i < len1 && j <= right) {
+        if (menuItemsInOrder(*buffer[i], *arr[j], sortBy)) {
+            arr[k++] = buffer[i++];
+        } else {
+            arr[k++] = arr[j++];
+        }
+    }
+    
+    // Copy any remaining elements from the left run (the right run is already in place)
+    while (i < len1) {
+        arr[k++] = buffer[i++];
+    }
+}
+
+// Insertion sort (part of Tim Sort) for arrays of menu item pointers
+// Parameters: array, left boundary, right boundary, sort criteria (name, price, category or id)
+inline void insertionSortMenuItems(const MenuItem* arr[], int left, int right, const string& sortBy = "name") {
+    for (int i = left + 1; i <= right; i++) {
+        const MenuItem* temp = arr[i];
+        int j = i - 1;
+        
+        // Move elements that belong after temp one position ahead
+        while (j >= left && !menuItemsInOrder(*arr[j], *temp, sortBy)) {
+            arr[j + 1] = arr[j];
+            j--;
+        }
+        
+        arr[j + 1] = temp;
+    }
+}
+
+// Tim Sort for arrays of menu item pointers
+// Same algorithm as the MenuItem array version, but only pointers are moved around
+// Parameters: array, array size, sort criteria (name, price, category or id)
+inline void timSortMenuItems(const MenuItem* arr[], int n, const string& sortBy = "name") {
+    const int RUN = 32;
+    
+    // Sort individual subarrays of size RUN using insertion sort
+    for (int i = 0; i < n; i += RUN) {
+        insertionSortMenuItems(arr, i, min(i + RUN - 1, n - 1), sortBy);
+    }
+    
+    if (n <= RUN) {
+        return;
+    }
+    
+    // One temporary buffer is shared by all merges
+    const MenuItem** buffer = MemoryTracker::allocateArray<const MenuItem*>(MEM_SORT_SCRATCH, n);
+    
+    // Merge sorted runs, doubling the run size each pass
+    for (int size = RUN; size < n; size = 2 * size) {
+        for (int left = 0; left < n; left += 2 * size) {
+            int mid = left + size - 1;
+            int right = min(left + 2 * size - 1, n - 1);
+            
+            if (mid < right) {
+                mergeMenuItems(arr, buffer, left, mid, right, sortBy);
+            }
+        }
+    }
+    
+    MemoryTracker::freeArray(MEM_SORT_SCRATCH, buffer, n);
+}
+
+// Interpolation Search for MenuItem objects - O(log log n) average case for uniformly distributed data
+// A searching algorithm that works on uniformly distributed sorted data
+// Parameters: sorted array, array size, and ID to search for
+inline int interpolationSearchMenuItems(MenuItem arr[], int n, const ItemID& id) {
+    // Find indexes of two corners (boundary points)
+    int low = 0, high = n - 1;
+    
+    // While elements exist and key is within range of array
+    while (low <= high && id >= arr[low].id && id <= arr[high].id) {
+        // All keys in range are equal, avoid dividing by zero
+        if (arr[high].id == arr[low].id) {
+            return (arr[low].id == id) ? low : -1;
+        }
+        
+        // Probing the position with key value using interpolation formula
+        // This estimates where the element might be based on its value
+        // Packed IDs are integers whose order matches the text, so the distance is a plain subtraction
+        double val1 = (double)id.getCode() - (double)arr[low].id.getCode();
+        double val2 = (double)arr[high].id.getCode() - (double)arr[low].id.getCode();
+        double val3 = high - low;
+        int pos = low + (int)(val3 * (val1 / val2));
+        
+        // If element is found at the estimated position
+        if (arr[pos].id == id)
+            return pos;
+            
+        // If element at pos is smaller, search in right subarray
+        if (arr[pos].id < id)
+            low = pos + 1;
+        else
+            // If element at pos is larger, search in left subarray
+            high = pos - 1;
+    }
+    
+    return -1; // Element not found
+}
+
+// Interpolation Search for arrays of menu item pointers sorted by ID
+// Parameters: sorted array, array size, and ID to search for
+inline int interpolationSearchMenuItems(const MenuItem* arr[], int n, const ItemID& id) {
+    int low = 0, high = n - 1;
+    
+    while (low <= high && id >= arr[low]->id && id <= arr[high]->id) {
+        // All keys in range are equal, avoid dividing by zero
+        if (arr[high]->id == arr[low]->id) {
+            return (arr[low]->id == id) ? low : -1;
+        }
+        
+        // Estimate the position from the numeric distance between packed IDs
+        double val1 = (double)id.getCode() - (double)arr[low]->id.getCode();
+        double val2 = (double)arr[high]->id.getCode() - (double)arr[low]->id.getCode();
+        int pos = low + (int)((high - low) * (val1 / val2));
+        
+        if (arr[pos]->id == id)
+            return pos;
+        
+        if (arr[pos]->id < id)
+            low = pos + 1;
+        else
+            high = pos - 1;
+    }
+    
+    return -1; // Element not found
+}
+
+// Result of checking one menu item against the inventory in a bulk pass
+struct MenuItemCheck {
+    bool available;           // Every ingredient is in stock in the required quantity
+    int servings;             // Servings that current stock allows (0 if any ingredient is short)
+    double ingredientCost;    // Cost of one serving at the price of the oldest batch of each ingredient
+    int missingIngredients;   // Ingredients that refer to food IDs not in the inventory
+    
+    // Default constructor
+    MenuItemCheck() : available(false), servings(0), ingredientCost(0.0), missingIngredients(0) {}
+};
+
+// Restaurant Menu System - manages the restaurant's food menu
+// Handles creation, editing, storage, and retrieval of menu items
+class RestaurantMenuSystem : public Restaurant {
+private:
+    MenuStore menuStore;                   // Contiguous store of menu items with stable handles
+    mutable const MenuItem** sortScratch;  // Reusable pointer buffer for sorted views
+    mutable int sortScratchCapacity;       // Capacity of sortScratch
+    IngredientIndex ingredientIndex;       // Food ID -> menu items using it, guarded by servingsLock
+    
+    // Max-servings cache (see trackServings)
+    // The inventory reports every stock change of an ID; the cache keeps the last stock of each ID
+    // and the servings of each menu item that uses it, so "how many can we make" is a single read.
+    // servingsLock guards the stock table, the servings and, while tracking, changes to the store.
+    // Lock order: inventory bucket, inventory listener lock, then servingsLock.
+    static const int STOCK_TABLE_SIZE = 256;       // Power of two, over twice the inventory's buckets
+    RestaurantInventorySystem* servingsInventory;  // Inventory being followed, nullptr when not tracking
+    int servingsListenerId;                        // Listener registered with servingsInventory
+    mutable mutex servingsLock;
+    uint32_t stockCodes[STOCK_TABLE_SIZE];         // Open-addressing table of food IDs (0 = empty)
+    int stockLevels[STOCK_TABLE_SIZE];             // Last reported stock of each ID in stockCodes
+    int stockEntries;                              // Used cells of stockCodes
+    int* servingsBySlot;                           // Max servings of the item in each store slot
+    MenuHandle* unavailableItems;                  // Items whose servings are 0, in the order they ran out
+    int unavailableCount;                          // Number of entries in unavailableItems
+    int servingsCapacity;                          // Capacity of servingsBySlot and unavailableItems
+    
+    // Kitchens preparing orders from this menu (see KitchenWorkerPool), guarded by servingsLock
+    // Orders read the store without a lock, so the menu cannot be changed while any is open
+    mutable int openKitchens;
+    
+    // Rejects a change to the menu while a kitchen is open, call with servingsLock held
+    bool menuLocked() const {
+        if (openKitchens > 0) {
+            engineOut() << "Error: The menu cannot be changed while the kitchen is open." << endl;
+            return true;
+        }
+        return false;
+    }
+    
+    // Makes sure the scratch buffer holds at least count pointers and returns it
+    const MenuItem** reserveScratch(int count) const {
+        if (sortScratchCapacity < count) {
+            MemoryTracker::freeArray(MEM_SORT_SCRATCH, sortScratch, sortScratchCapacity);
+            sortScratchCapacity = count * 2;
+            sortScratch = MemoryTracker::allocateArray<const MenuItem*>(MEM_SORT_SCRATCH, sortScratchCapacity);
+        }
+        return sortScratch;
+    }
+    
+    // Fills the scratch buffer with pointers to every menu item in menu order and returns it
+    // The pointers are valid until the next add or remove
+    const MenuItem** getItemPointers() const {
+        MenuItemSpan items = menuStore.getItems();
+        reserveScratch(items.getSize());
+        for (int i = 0; i < items.getSize(); i++) {
+            sortScratch[i] = &items[i];
+        }
+        return sortScratch;
+    }
+    
+    // Checks that every ingredient ID fits the 4-character format
+    // Invalid IDs all share one code, so the index and stock table would mistake them for each other
+    static bool hasValidIngredientIds(const MenuItem& item) {
+        for (int i = 0; i < item.ingredients.getSize(); i++) {
+            if (!item.ingredients[i].foodId.isValid()) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Finds the stock table cell of a food ID: its entry or the empty cell to insert into
+    int stockPosition(uint32_t code) const {
+        int position = (int)((code * 2654435761u) >> 24) & (STOCK_TABLE_SIZE - 1);
+        while (stockCodes[position] != 0 && stockCodes[position] != code) {
+            position = (position + 1) & (STOCK_TABLE_SIZE - 1);
+        }
+        return position;
+    }
+    
+    // Last reported stock of a food ID (0 if never reported), hold servingsLock
+    int stockLevel(const ItemID& id) const {
+        int position = stockPosition(id.getCode());
+        return (stockCodes[position] == 0) ? 0 : stockLevels[position];
+    }
+    
+    // Records the stock of a food ID, hold servingsLock
+    void setStockLevel(const ItemID& id, int stock) {
+        int position = stockPosition(id.getCode());
+        if (stockCodes[position] == 0) {
+            if (stock == 0) {
+                return;
+            }
+            // IDs that ran out are dropped when the table fills up; the inventory itself never
+            // holds more IDs than half the table
+            if (stockEntries >= STOCK_TABLE_SIZE / 2) {
+                uint32_t codes[STOCK_TABLE_SIZE];
+                int levels[STOCK_TABLE_SIZE];
+                for (int i = 0; i < STOCK_TABLE_SIZE; i++) {
+                    codes[i] = stockCodes[i];
+                    levels[i] = stockLevels[i];
+                    stockCodes[i] = 0;
+                }
+                stockEntries = 0;
+                for (int i = 0; i < STOCK_TABLE_SIZE; i++) {
+                    if (codes[i] != 0 && levels[i] > 0) {
+                        int cell = stockPosition(codes[i]);
+                        stockCodes[cell] = codes[i];
+                        stockLevels[cell] = levels[i];
+                        stockEntries++;
+                    }
+                }
+                position = stockPosition(id.getCode());
+            }
+            stockCodes[position] = id.getCode();
+            stockEntries++;
+        }
+        stockLevels[position] = stock;
+    }
+    
+    // Servings of a menu item that the recorded stock allows, hold servingsLock
+    // Returns SERVINGS_UNLIMITED for a recipe without (positive) ingredients
+    int computeServings(const MenuItem& item) const {
+        int servings = SERVINGS_UNLIMITED;
+        for (int i = 0; i < item.getIngredientCount(); i++) {
+            // Lines repeating an ID are added into its first line, which divides by the total
+            int required = item.getRequiredQuantityAt(i);
+            if (required <= 0) {
+                continue;
+            }
+            int possible = stockLevel(item.ingredients[i].foodId) / required;
+            if (servings == SERVINGS_UNLIMITED || possible < servings) {
+                servings = possible;
+            }
+        }
+        return servings;
+    }
+    
+    // Takes a slot off the unavailable list, keeping the order of the others, hold servingsLock
+    void removeUnavailable(int slot) {
+        for (int i = 0; i < unavailableCount; i++) {
+            if (unavailableItems[i].slot == slot) {
+                for (int j = i; j < unavailableCount - 1; j++) {
+                    unavailableItems[j] = unavailableItems[j + 1];
+                }
+                unavailableCount--;
+                return;
+            }
+        }
+    }
+    
+    // Stores new servings for an item and keeps the unavailable list in step, hold servingsLock
+    void setServings(MenuHandle handle, int servings) {
+        int previous = servingsBySlot[handle.slot];
+        servingsBySlot[handle.slot] = servings;
+        if (servings == 0 && previous != 0) {
+            unavailableItems[unavailableCount++] = handle;
+        } else if (servings != 0 && previous == 0) {
+            removeUnavailable(handle.slot);
+        }
+    }
+    
+    // Recomputes the cached servings of the item behind a handle, hold servingsLock
+    void refreshServings(MenuHandle handle) {
+        const MenuItem* item = menuStore.get(handle);
+        if (item == nullptr) {
+            return;
+        }
+        if (handle.slot >= servingsCapacity) {
+            int newCapacity = (servingsCapacity == 0) ? 16 : servingsCapacity * 2;
+            while (newCapacity <= handle.slot) {
+                newCapacity *= 2;
+            }
+            int* newServings = MemoryTracker::allocateArray<int>(MEM_MENU, newCapacity);
+            MenuHandle* newUnavailable = MemoryTracker::allocateArray<MenuHandle>(MEM_MENU, newCapacity);
+            for (int i = 0; i < servingsCapacity; i++) {
+                newServings[i] = servingsBySlot[i];
+            }
+            for (int i = servingsCapacity; i < newCapacity; i++) {
+                newServings[i] = SERVINGS_UNKNOWN;
+            }
+            for (int i = 0; i < unavailableCount; i++) {
+                newUnavailable[i] = unavailableItems[i];
+            }
+            MemoryTracker::freeArray(MEM_MENU, servingsBySlot, servingsCapacity);
+            MemoryTracker::freeArray(MEM_MENU, unavailableItems, servingsCapacity);
+            servingsBySlot = newServings;
+            unavailableItems = newUnavailable;
+            servingsCapacity = newCapacity;
+        }
+        setServings(handle, computeServings(*item));
+    }
+    
+    // Drops the cached servings of a slot whose item is being removed, hold servingsLock
+    void forgetServings(MenuHandle handle) {
+        if (handle.slot >= 0 && handle.slot < servingsCapacity) {
+            setServings(handle, SERVINGS_UNKNOWN);
+        }
+    }
+    
+    // Stock listener: records the new stock and refreshes the menu items that use the ID
+    // The ingredient index hands over exactly those items, so the menu size does not matter
+    void onStockChanged(const ItemID& id, int stock) {
+        lock_guard<mutex> guard(servingsLock);
+        if (stockLevel(id) == stock) {
+            return;
+        }
+        setStockLevel(id, stock);
+        
+        for (const IngredientUse& use : ingredientIndex.getUses(id)) {
+            refreshServings(use.handle);
+        }
+    }
+    
+    // Formats cached servings for display ("-" when the recipe is not limited by stock)
+    static string servingsText(int servings) {
+        return (servings == SERVINGS_UNLIMITED) ? "-" : to_string(servings);
+    }
+    
+    // Prints one menu item as a row of the standard menu table
+    static void printMenuRow(const MenuItem& item) {
+        engineOut() << left << setw(10) << item.id 
+             << setw(30) << item.name 
+             << setw(10) << fixed << setprecision(2) << item.price
+             << setw(20) << item.category
+             << setw(30) << item.description << endl;
+    }
+
+public:
+    // Values of getMaxServings besides a count
+    static const int SERVINGS_UNLIMITED = -1;   // The recipe has no ingredients
+    static const int SERVINGS_UNKNOWN = -2;     // Not tracking an inventory, or no such menu item
+    
+    // Constructor - initializes an empty menu system
+    RestaurantMenuSystem() : Restaurant(), sortScratch(nullptr), sortScratchCapacity(0),
+                             servingsInventory(nullptr), servingsListenerId(-1), stockEntries(0),
+                             servingsBySlot(nullptr), unavailableItems(nullptr), unavailableCount(0),
+                             servingsCapacity(0), openKitchens(0) {
+        for (int i = 0; i < STOCK_TABLE_SIZE; i++) {
+            stockCodes[i] = 0;
+            stockLevels[i] = 0;
+        }
+    }
+    
+    // Destructor - the menu store handles its own memory cleanup
+    virtual ~RestaurantMenuSystem() override {
+        stopTrackingServings();
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, sortScratch, sortScratchCapacity);
+        MemoryTracker::freeArray(MEM_MENU, servingsBySlot, servingsCapacity);
+        MemoryTracker::freeArray(MEM_MENU, unavailableItems, servingsCapacity);
+    }
+    
+    /**
+     * Keeps the max servings of every menu item up to date with an inventory
+     * Max servings is the minimum over the ingredients of floor(stock / required quantity). The
+     * inventory reports each stock change, and only menu items using that ingredient are
+     * recomputed, so getMaxServings and the Servings column of displayAll need no inventory lookups.
+     * Parameters: inventory - Inventory to follow; it must outlive the tracking (the destructor and
+     *             stopTrackingServings end it)
+     * Return: true if tracking started
+     */
+    bool trackServings(RestaurantInventorySystem& inventory) {
+        stopTrackingServings();
+        {
+            lock_guard<mutex> guard(servingsLock);
+            servingsInventory = &inventory;
+            for (int i = 0; i < STOCK_TABLE_SIZE; i++) {
+                stockCodes[i] = 0;
+            }
+            stockEntries = 0;
+            for (int i = 0; i < servingsCapacity; i++) {
+                servingsBySlot[i] = SERVINGS_UNKNOWN;
+            }
+            unavailableCount = 0;
+            for (int i = 0; i < menuStore.getSize(); i++) {
+                refreshServings(menuStore.handleAt(i));
+            }
+        }
+        
+        // Registering replays the current stock of every ID through the listener
+        int listenerId = inventory.addStockListener([this](const ItemID& id, int stock) {
+            onStockChanged(id, stock);
+        });
+        lock_guard<mutex> guard(servingsLock);
+        servingsListenerId = listenerId;
+        if (listenerId == -1) {
+            servingsInventory = nullptr;
+            return false;
+        }
+        return true;
+    }
+    
+    // Stops following the inventory given to trackServings
+    void stopTrackingServings() {
+        RestaurantInventorySystem* inventory;
+        int listenerId;
+        {
+            lock_guard<mutex> guard(servingsLock);
+            inventory = servingsInventory;
+            listenerId = servingsListenerId;
+            servingsInventory = nullptr;
+            servingsListenerId = -1;
+            unavailableCount = 0;
+        }
+        if (inventory != nullptr) {
+            inventory->removeStockListener(listenerId);
+        }
+    }
+    
+    // Called by KitchenWorkerPool when it starts and after it has stopped
+    // While any kitchen is open, adding, updating and removing menu items fails
+    void openKitchen() const {
+        lock_guard<mutex> guard(servingsLock);
+        openKitchens++;
+    }
+    
+    void closeKitchen() const {
+        lock_guard<mutex> guard(servingsLock);
+        openKitchens--;
+    }
+    
+    // Checks if a kitchen is preparing orders from this menu
+    bool isKitchenOpen() const {
+        lock_guard<mutex> guard(servingsLock);
+        return openKitchens > 0;
+    }
+    
+    // Checks if trackServings is active
+    bool isTrackingServings() const {
+        lock_guard<mutex> guard(servingsLock);
+        return servingsInventory != nullptr;
+    }
+    
+    // Returns how many servings of a menu item the current stock allows
+    // Returns SERVINGS_UNLIMITED for a recipe without ingredients, and SERVINGS_UNKNOWN if the
+    // item does not exist or no inventory is being tracked
+    int getMaxServings(const ItemID& id) const {
+        lock_guard<mutex> guard(servingsLock);
+        MenuHandle handle = menuStore.findHandle(id);
+        if (servingsInventory == nullptr || handle.isNull()) {
+            return SERVINGS_UNKNOWN;
+        }
+        return servingsBySlot[handle.slot];
+    }
+    
+    /**
+     * Lists the menu items whose recipes use a food item
+     * Reads the ingredient index, so the cost depends on the number of matches, not the menu size
+     * Parameters: foodId - ID of the food item
+     * Return: Read-only list of the menu items using it (in no particular order)
+     * Note: The list is valid until the next add or remove, or the next search, sort or filter
+     */
+    MenuItemRefSpan getMenuItemsUsing(const ItemID& foodId) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.getMenuItemsUsing");
+        lock_guard<mutex> guard(servingsLock);
+        IngredientUseSpan uses = ingredientIndex.getUses(foodId);
+        const MenuItem** results = reserveScratch(uses.getSize());
+        for (int i = 0; i < uses.getSize(); i++) {
+            results[i] = menuStore.get(uses[i].handle);
+        }
+        return MenuItemRefSpan(results, uses.getSize());
+    }
+    
+    /**
+     * Lists the menu items that cannot be made with the current stock ("86'd" items)
+     * The list is kept up to date by trackServings as stock changes, oldest first
+     * Return: Read-only list of the items with 0 servings; empty when no inventory is tracked
+     * Note: The list is valid until the next add or remove, or the next search, sort or filter
+     */
+    MenuItemRefSpan getUnavailableItems() const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.getUnavailableItems");
+        lock_guard<mutex> guard(servingsLock);
+        const MenuItem** results = reserveScratch(unavailableCount);
+        for (int i = 0; i < unavailableCount; i++) {
+            results[i] = menuStore.get(unavailableItems[i]);
+        }
+        return MenuItemRefSpan(results, unavailableCount);
+    }
+    
+    // Returns the current number of menu items in the system
+    virtual int getItemCount() const override {
+        return Restaurant::getItemCount();
+    }
+    
+    // Adds a new menu item to the system
+    // Parameters: item - the menu item to add
+    // Returns: true if successfully added, false if failed (e.g., duplicate ID)
+    bool addMenuItem(const MenuItem& item) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.addMenuItem");
+        // Validate menu item ID
+        if (item.id.empty()) {
+            engineOut() << "Error: Menu item ID cannot be empty." << endl;
+            return false;
+        }
+        if (!item.id.isValid()) {
+            engineOut() << "Error: Menu item ID must be at most 4 characters." << endl;
+            return false;
+        }
+        if (!hasValidIngredientIds(item)) {
+            engineOut() << "Error: Ingredient IDs must be at most 4 characters." << endl;
+            return false;
+        }
+        
+        lock_guard<mutex> guard(servingsLock);
+        if (menuLocked()) {
+            return false;
+        }
+        
+        // Check if item with this ID already exists (prevent duplicates)
+        if (menuStore.findById(item.id) != nullptr) {
+            engineOut() << "Error: Menu item with ID " << item.id << " already exists." << endl;
+            return false;
+        }
+        
+        // Add the item to the end of the menu
+        MenuHandle handle = menuStore.add(item);
+        ingredientIndex.addItem(handle, item);
+        this->itemCount++;
+        if (servingsInventory != nullptr) {
+            refreshServings(handle);
+        }
+        
+        return true;
+    }
+    
+    // Finds a menu item by its ID
+    // Parameters: id - the ID to search for
+    // Returns: pointer to the stored item or nullptr if not found
+    // Note: The pointer is valid until the next add or remove, do not delete it
+    const MenuItem* findMenuItem(const ItemID& id) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.findMenuItem");
+        return menuStore.findById(id);
+    }
+    
+    // Finds a menu item by its ID and returns an owning copy
+    // Parameters: id - the ID to search for
+    // Returns: pointer to a copy of the found item or nullptr if not found
+    // Note: Caller is responsible for deleting the returned pointer
+    MenuItem* copyMenuItem(const ItemID& id) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.copyMenuItem");
+        const MenuItem* item = menuStore.findById(id);
+        return (item != nullptr) ? new MenuItem(*item) : nullptr;
+    }
+    
+    // Returns the stable handle of a menu item, or a null handle if not found
+    MenuHandle getMenuHandle(const ItemID& id) const {
+        return menuStore.findHandle(id);
+    }
+    
+    // Returns the menu item behind a handle without copying it
+    // Returns nullptr if the item has been removed since the handle was issued
+    const MenuItem* getMenuItem(MenuHandle handle) const {
+        return menuStore.get(handle);
+    }
+    
+    // Removes a menu item by its ID
+    // Parameters: id - the ID of the item to remove
+    // Returns: true if found and removed, false if not found or the kitchen is open
+    bool removeMenuItem(const ItemID& id) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.removeMenuItem");
+        lock_guard<mutex> guard(servingsLock);
+        if (menuLocked()) {
+            return false;
+        }
+        MenuHandle handle = menuStore.findHandle(id);
+        const MenuItem* item = menuStore.get(handle);
+        if (item == nullptr) {
+            return false;
+        }
+        
+        // Unindex the recipe while the item is still stored
+        ingredientIndex.removeItem(handle, *item);
+        forgetServings(handle);
+        menuStore.remove(id);
+        this->itemCount--;
+        return true;
+    }
+    
+    // Updates an existing menu item with new data
+    // The item is replaced in place, so it keeps its position in the menu
+    // Parameters: item - the updated menu item (ID must match an existing item)
+    // Returns: true if found and updated, false if not found
+    bool updateMenuItem(const MenuItem& item) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.updateMenuItem");
+        if (!hasValidIngredientIds(item)) {
+            engineOut() << "Error: Ingredient IDs must be at most 4 characters." << endl;
+            return false;
+        }
+        lock_guard<mutex> guard(servingsLock);
+        if (menuLocked()) {
+            return false;
+        }
+        MenuHandle handle = menuStore.findHandle(item.id);
+        const MenuItem* existing = menuStore.get(handle);
+        if (existing == nullptr) {
+            engineOut() << "Error: Menu item with ID " << item.id << " not found." << endl;
+            return false;
+        }
+        
+        // Swap the old recipe for the new one in the ingredient index
+        ingredientIndex.removeItem(handle, *existing);
+        menuStore.update(item);
+        ingredientIndex.addItem(handle, item);
+        if (servingsInventory != nullptr) {
+            refreshServings(handle);
+        }
+        return true;
+    }
+    
+    // Loads menu items from a TXT file
+    // Parameters: filename - path to the file to load from
+    // Returns: true if successful, false if file couldn't be opened
+    virtual bool loadFromFile(const string& filename) override {
+        RESTAURANT_ALLOCATION_SCOPE("menu.loadFromFile");
+        TrackedFileStream<ifstream> file;
+        file.open(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for reading" << endl;
+            return false;
+        }
+        
+        string line;
+        int itemsLoaded = 0;
+        
+        // Read file line by line
+        while (getline(file, line)) {
+            string id, name, description, category, ingredientData;
+            double price;
+            
+            // Parse TXT line (format: id,name,price,description,category,ingredientData)
+            size_t pos = 0;
+            string token;
+            
+            // Extract ID
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            id = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Name
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            name = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Price
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            price = stod(line.substr(0, pos));
+            line.erase(0, pos + 1);
+            
+            // Extract Description
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            description = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            // Extract Category
+            pos = line.find(",");
+            if (pos == string::npos) {
+                category = line;
+                ingredientData = ""; // No ingredients in file
+            } else {
+                category = line.substr(0, pos);
+                line.erase(0, pos + 1);
+                // Extract Ingredient Data
+                ingredientData = line;
+            }
+            
+            // Create menu item
+            MenuItem item(id, name, price, description, category);
+            
+            // Process ingredients if present
+            if (!ingredientData.empty()) {
+                // Ingredients are in format "foodId1:qty1|foodId2:qty2|..."
+                size_t startPos = 0;
+                size_t pipePos = ingredientData.find("|");
+                
+                while (pipePos != string::npos || startPos < ingredientData.length()) {
+                    string ingredientPair;
+                    
+                    if (pipePos != string::npos) {
+                        ingredientPair = ingredientData.substr(startPos, pipePos - startPos);
+                        startPos = pipePos + 1;
+                    } else {
+                        ingredientPair = ingredientData.substr(startPos);
+                        startPos = ingredientData.length();
+                    }
+                    
+                    // Process each ingredient pair (foodId:qty)
+                    size_t colonPos = ingredientPair.find(":");
+                    if (colonPos != string::npos) {
+                        string foodId = ingredientPair.substr(0, colonPos);
+                        int quantity = stoi(ingredientPair.substr(colonPos + 1));
+                        item.addIngredient(foodId, quantity);
+                    }
+                    
+                    if (startPos < ingredientData.length()) {
+                        pipePos = ingredientData.find("|", startPos);
+                    } else {
+                        break;
+                    }
+                }
+            }
+            
+            // Add the menu item
+            if (addMenuItem(item)) {
+                itemsLoaded++;
+            }
+        }
+        
+        file.close();
+        engineOut() << "Successfully loaded " << itemsLoaded << " menu items from " << filename << endl;
+        return itemsLoaded > 0;
+    }
+    
+    // Saves menu items to a TXT file
+    // Parameters: filename - path to the file to save to
+    //             sorted - if true, items will be sorted before saving
+    //             sortBy - criteria to sort by ("name", "price", or "category")
+    // Returns: true if successful, false if failed to open file
+    // Implementation of the pure virtual method from base class
+    virtual bool saveToFile(const string& filename, bool sorted = false) override {
+        return saveToFile(filename, sorted, "name");
+    }
+    
+    // Overloaded version with additional sortBy parameter
+    bool saveToFile(const string& filename, bool sorted, const string& sortBy) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.saveToFile");
+        RESTAURANT_LATENCY_SCOPE(LAT_MENU_SAVE);
+        TraceSpan span("saveMenu", "menu");
+        TrackedFileStream<ofstream> file;
+        file.open(filename);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open file " << filename << " for writing" << endl;
+            return false;
+        }
+        
+        int count = menuStore.getSize();
+        if (count > 0) {
+            // Order pointers to the stored items, no menu item is copied
+            const MenuItem** items = getItemPointers();
+            if (sorted) {
+                // Use Tim Sort with the specified sort criteria
+                timSortMenuItems(items, count, sortBy);
+            }
+            
+            // Write items to file in TXT format
+            for (int i = 0; i < count; i++) {
+                const MenuItem& item = *items[i];
+                
+                // Write basic properties in TXT format
+                file << item.id << ","
+                     << item.name << ","
+                     << item.price << ","
+                     << item.description << ","
+                     << item.category;
+                
+                // Add ingredients if any in our special format
+                if (item.getIngredientCount() > 0) {
+                    file << ",";
+                    for (int j = 0; j < item.getIngredientCount(); j++) {
+                        file << item.ingredients[j].foodId << ":" << item.ingredients[j].quantity;
+                        if (j < item.getIngredientCount() - 1) {
+                            file << "|"; // Separate ingredients with pipe
+                        }
+                    }
+                }
+                
+                file << endl;
+            }
+        } else {
+            // Write an empty file if no items
+            engineOut() << "No menu items to save to file." << endl;
+        }
+        
+        file.close();
+        engineOut() << "Successfully saved " << count << " menu items to " << filename << endl;
+        return true;
+    }
+    
+    // Displays all menu items in a formatted table
+    // Shows ID, name, price, category, and description for each item, and the servings the
+    // current stock allows while an inventory is tracked (see trackServings)
+    virtual void displayAll() override {
+        RESTAURANT_ALLOCATION_SCOPE("menu.displayAll");
+        lock_guard<mutex> guard(servingsLock);
+        bool withServings = (servingsInventory != nullptr);
+        
+        // Print table header using base class method
+        printHeader("Restaurant Menu System - All Items");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(20) << "Category";
+        if (withServings) {
+            engineOut() << setw(10) << "Servings";
+        }
+        engineOut() << setw(30) << "Description" << endl;
+        printFooter();
+        
+        // Walk the contiguous store directly
+        MenuItemSpan items = menuStore.getItems();
+        
+        // Handle empty menu case
+        if (items.isEmpty()) {
+            engineOut() << "No items in the menu." << endl;
+        } else if (!withServings) {
+            // Display each item with formatted columns
+            for (const MenuItem& item : items) {
+                printMenuRow(item);
+            }
+        } else {
+            for (int i = 0; i < items.getSize(); i++) {
+                const MenuItem& item = items[i];
+                engineOut() << left << setw(10) << item.id 
+                     << setw(30) << item.name 
+                     << setw(10) << fixed << setprecision(2) << item.price
+                     << setw(20) << item.category
+                     << setw(10) << servingsText(servingsBySlot[menuStore.handleAt(i).slot])
+                     << setw(30) << item.description << endl;
+            }
+        }
+    }
+    
+    // Displays all menu items sorted by specified criteria
+    // Implementation of pure virtual method from base class
+    virtual void displaySorted(bool byName = true) override {
+        if (byName) {
+            displaySortedByName();
+        } else {
+            displaySortedByPrice();
+        }
+    }
+    
+    // Displays all menu items sorted by the given criteria ("name", "price" or "category")
+    // Sorts pointers to the stored items, so the menu itself is neither copied nor reordered
+    void displaySortedBy(const string& sortBy, const string& title) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.displaySortedBy");
+        // Print table header using base class method
+        printHeader(title);
+        
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(20) << "Category" 
+             << setw(30) << "Description" << endl;
+        printFooter();
+        
+        int count = menuStore.getSize();
+        
+        // Handle empty menu case
+        if (count == 0) {
+            engineOut() << "No items in the menu." << endl;
+            return;
+        }
+        
+        // Sort item pointers using Tim Sort algorithm
+        const MenuItem** items = getItemPointers();
+        timSortMenuItems(items, count, sortBy);
+        
+        // Display each item with formatted columns
+        for (int i = 0; i < count; i++) {
+            printMenuRow(*items[i]);
+        }
+    }
+    
+    // Displays all menu items sorted by name
+    // Items are sorted alphabetically by name
+    void displaySortedByName() {
+        displaySortedBy("name", "Restaurant Menu System - Sorted by Name");
+    }
+    
+    // Displays all menu items sorted by price (low to high)
+    // Items are sorted in ascending order by price
+    void displaySortedByPrice() {
+        displaySortedBy("price", "Restaurant Menu System - Sorted by Price (Low to High)");
+    }
+    
+    // Displays all menu items sorted by category
+    // Items are sorted alphabetically by category name
+    void displaySortedByCategory() {
+        displaySortedBy("category", "Restaurant Menu System - Sorted by Category");
+    }
+    
+    // Copies all menu items into a dynamically allocated array
+    // Use getItems() for read-only access without copying
+    // Caller is responsible for deleting the returned array
+    MenuItem* copyAllItems() const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.copyAllItems");
+        MenuItemSpan items = menuStore.getItems();
+        if (items.isEmpty()) {
+            return nullptr;
+        }
+        
+        MenuItem* copies = new MenuItem[items.getSize()];
+        for (int i = 0; i < items.getSize(); i++) {
+            copies[i] = items[i];
+        }
+        return copies;
+    }
+    
+    // Returns a read-only view of all menu items in menu order
+    // The view is valid until the next add or remove
+    MenuItemSpan getItems() const {
+        return menuStore.getItems();
+    }
+    
+    // Searches for and displays a menu item by its ID
+    // Parameters: id - the ID of the menu item to find
+    // using the ID index of the menu store
+    void searchById(const ItemID& id) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.searchById");
+        // Find the menu item
+        const MenuItem* item = menuStore.findById(id);
+        
+        // Print table header
+        printHeader("Menu Item Search Result");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(20) << "Category" 
+             << setw(30) << "Description" << endl;
+        printFooter();
+        
+        // Display item if found, or show not found message
+        if (item != nullptr) {
+            // Display the basic menu item information
+            printMenuRow(*item);
+                 
+            // Display ingredients if any
+            if (item->getIngredientCount() > 0) {
+                engineOut() << "\nIngredients Required:\n";
+                engineOut() << left << setw(15) << "Food ID" << setw(10) << "Quantity" << endl;
+                engineOut() << string(25, '-') << endl;
+                
+                // Display each ingredient
+                for (int i = 0; i < item->getIngredientCount(); i++) {
+                    const Ingredient& ingredient = item->ingredients[i];
+                    engineOut() << left << setw(15) << ingredient.foodId << setw(10) << ingredient.quantity << endl;
+                }
+            }
+        } else {
+            engineOut() << "Menu item with ID " << id << " not found." << endl;
+        }
+    }
+    
+    /**
+     * Displays detailed information about a menu item including its ingredients
+     * This method provides a comprehensive view of a menu item with real-time inventory status
+     * Parameters: id - The unique identifier of the menu item to display
+     * Parameters: inventory - Reference to the inventory system to check ingredients availability
+     */
+    void displayMenuItem(const ItemID& id, RestaurantInventorySystem& inventory) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.displayMenuItem");
+        // Retrieve the menu item by its ID
+        const MenuItem* item = menuStore.findById(id);
+        
+        // Validate if the item exists in the menu
+        if (item == nullptr) {
+            engineOut() << "Menu item with ID " << id << " not found." << endl;
+            return;
+        }
+        
+        // Display the header and basic information about the menu item
+        printHeader("Menu Item Details");
+        engineOut() << "ID: " << item->id << endl;
+        engineOut() << "Name: " << item->name << endl;
+        engineOut() << "Price: $" << fixed << setprecision(2) << item->price << endl;
+        engineOut() << "Category: " << item->category << endl;
+        engineOut() << "Description: " << item->description << endl;
+        int servings = getMaxServings(id);
+        if (servings != SERVINGS_UNKNOWN) {
+            engineOut() << "Servings available: " << servingsText(servings) << endl;
+        }
+        
+        // Check if the menu item has ingredients and display them
+        if (item->getIngredientCount() > 0) {
+            engineOut() << "\nIngredients Required:\n";
+            // Create a well-formatted table header for ingredients information
+            engineOut() << left << setw(10) << "ID" 
+                 << setw(30) << "Name" 
+                 << setw(10) << "Quantity" 
+                 << setw(15) << "Available" 
+                 << setw(15) << "Status" << endl;
+            engineOut() << string(80, '-') << endl;
+            
+            // Process and display each ingredient with its availability status
+            for (int i = 0; i < item->getIngredientCount(); i++) {
+                // Food ID and required quantity of this ingredient
+                const ItemID& foodId = item->ingredients[i].foodId;
+                int quantity = item->ingredients[i].quantity;
+                
+                // Query the inventory system for real-time information about this ingredient
+                FoodItemView foodItem = inventory.findFoodItem(foodId);
+                
+                if (!foodItem.isNull()) {
+                    // Ingredient exists in inventory - calculate availability status
+                    int available = foodItem.totalQuantity;
+                    string status = (available >= quantity) ? "Sufficient" : "Insufficient";
+                    
+                    // Display formatted ingredient details with availability
+                    engineOut() << left << setw(10) << foodId 
+                         << setw(30) << foodItem->name 
+                         << setw(10) << quantity 
+                         << setw(15) << available 
+                         << setw(15) << status << endl;
+                } else {
+                    // Ingredient not found in inventory - mark as missing
+                    engineOut() << left << setw(10) << foodId 
+                         << setw(30) << "Not found" 
+                         << setw(10) << quantity 
+                         << setw(15) << "0" 
+                         << setw(15) << "Missing" << endl;
+                }
+            }
+        } else {
+            // Handle the case when menu item has no ingredients defined
+            engineOut() << "\nNo ingredients specified for this menu item." << endl;
+        }
+    }
+    
+    /**
+     * Verifies if all ingredients for a menu item are available in sufficient quantities
+     * This method performs pre-checks before menu item preparation
+     * Parameters: id - The unique identifier of the menu item to check
+     * Parameters: inventory - Reference to the inventory system
+     * Return: true if all ingredients are available in sufficient quantities, false otherwise
+     */
+    bool checkIngredientsAvailability(const ItemID& id, RestaurantInventorySystem& inventory) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.checkIngredientsAvailability");
+        RESTAURANT_LATENCY_SCOPE(LAT_MENU_CHECK);
+        TraceSpan span("checkIngredientsAvailability", "menu", id);
+        // Retrieve the menu item by its ID
+        const MenuItem* item = menuStore.findById(id);
+        
+        // Validate if the item exists in the menu
+        if (item == nullptr) {
+            engineOut() << "Menu item with ID " << id << " not found." << endl;
+            return false;
+        }
+        
+        // Flag to track overall availability status
+        bool allAvailable = true;
+        
+        // Iterate through each ingredient and check its availability
+        for (int i = 0; i < item->getIngredientCount(); i++) {
+            // Food ID and required quantity of this ingredient (lines repeating an ID are checked together)
+            const ItemID& foodId = item->ingredients[i].foodId;
+            if (item->ingredients.indexOf(foodId) != i) {
+                continue;
+            }
+            int quantity = item->getRequiredQuantityAt(i);
+            
+            // Query the inventory system for real-time information about this ingredient
+            FoodItemView foodItem = inventory.findFoodItem(foodId);
+            
+            // Check if the ingredient exists and is available in sufficient quantity
+            if (foodItem.isNull() || foodItem.totalQuantity < quantity) {
+                allAvailable = false;
+                // Provide detailed feedback about the missing or insufficient ingredient
+                if (foodItem.isNull()) {
+                    engineOut() << "Missing ingredient: " << foodId << endl;
+                } else {
+                    engineOut() << "Insufficient quantity of " << foodItem->name 
+                         << " (ID: " << foodId << "). Required: " << quantity 
+                         << ", Available: " << foodItem.totalQuantity << endl;
+                }
+            }
+        }
+        
+        return allAvailable;
+    }
+    
+    /**
+     * Prepares a menu item by consuming all required ingredients from inventory
+     * This method performs a transaction that updates inventory quantities
+     * Parameters: id - The unique identifier of the menu item to prepare
+     * Parameters: inventory - Reference to the inventory system for ingredient consumption
+     * Parameters: purpose - Description of why the item is being prepared (for logging)
+     * Return: true if preparation was successful, false otherwise
+     */
+    bool prepareMenuItem(const ItemID& id, RestaurantInventorySystem& inventory, const string& purpose = "Menu Order") {
+        RESTAURANT_ALLOCATION_SCOPE("menu.prepareMenuItem");
+        RESTAURANT_LATENCY_SCOPE(LAT_MENU_PREPARE);
+        TraceSpan span("prepareMenuItem", "menu", id);
+        // First perform a pre-check to ensure all ingredients are available
+        if (!checkIngredientsAvailability(id, inventory)) {
+            engineOut() << "Cannot prepare menu item due to missing or insufficient ingredients." << endl;
+            return false;
+        }
+        
+        // Retrieve the menu item by its ID
+        const MenuItem* item = menuStore.findById(id);
+        if (item == nullptr) {
+            return false;
+        }
+        
+        // Consume all ingredients as one transaction, so another terminal cannot take
+        // the stock between the check above and the usage
+        string message;
+        bool success = prepareOrder(id, inventory, purpose, message);
+        
+        // Provide feedback on the preparation outcome
+        if (!success) {
+            engineOut() << message << endl;
+        }
+        if (success) {
+            engineOut() << "Successfully prepared " << item->name << endl;
+        } else {
+            engineOut() << "Error occurred while preparing " << item->name << endl;
+        }
+        
+        return success;
+    }
+    
+    /**
+     * Prepares a menu item without any console output, for use from kitchen worker threads
+     * All ingredients are consumed as one transaction and each usage is logged
+     * Parameters: id - The unique identifier of the menu item to prepare
+     * Parameters: inventory - Reference to the inventory system for ingredient consumption
+     * Parameters: purpose - Description of why the item is being prepared (for logging)
+     * Parameters: message - Receives a short description of the outcome
+     * Return: true if preparation was successful, false otherwise
+     * Note: Safe to call from several threads as long as the menu itself is not being changed;
+     *       a KitchenWorkerPool guarantees this by keeping the menu locked while it is open
+     */
+    bool prepareOrder(const ItemID& id, RestaurantInventorySystem& inventory, const string& purpose, string& message) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.prepareOrder");
+        RESTAURANT_LATENCY_SCOPE(LAT_MENU_ORDER);
+        TraceSpan span("prepareOrder", "menu", id);
+        const MenuItem* item = menuStore.findById(id);
+        if (item == nullptr) {
+            message = "Menu item with ID " + id.toString() + " not found.";
+            return false;
+        }
+        
+        // Ingredient names come back from the consumption itself, so logging needs no lookups
+        // Typical recipes keep the names on the stack
+        const int INLINE_NAMES = 16;
+        string inlineNames[INLINE_NAMES];
+        int count = item->getIngredientCount();
+        string* names = (count <= INLINE_NAMES) ? inlineNames
+                                                : MemoryTracker::allocateArray<string>(MEM_SORT_SCRATCH, count);
+        if (!inventory.useFoodItems(item->ingredients, &message, names)) {
+            if (names != inlineNames) {
+                MemoryTracker::freeArray(MEM_SORT_SCRATCH, names, count);
+            }
+            return false;
+        }
+        
+        // Log each ingredient usage with meaningful context
+        string logPurpose = purpose + ": " + item->name;
+        for (int i = 0; i < count; i++) {
+            const Ingredient& ingredient = item->ingredients[i];
+            inventory.logItemUsage(ingredient.foodId, names[i], ingredient.quantity, logPurpose);
+        }
+        if (names != inlineNames) {
+            MemoryTracker::freeArray(MEM_SORT_SCRATCH, names, count);
+        }
+        
+        message = "Prepared " + item->name;
+        return true;
+    }
+    
+    /**
+     * Checks every menu item against one inventory snapshot in parallel
+     * Covers availability, servings, ingredient cost and ingredient references of the whole menu.
+     * Menu items are split into chunks that run on the scheduler's workers; each item only reads
+     * the snapshot and writes its own result, so no locks are taken during the pass.
+     * Parameters: snapshot - Inventory state to check against
+     * Parameters: results - Array of at least getItemCount() entries, filled in menu order
+     * Parameters: scheduler - Scheduler to run the chunks on
+     * Note: The menu itself must not be changed while the check runs
+     */
+    void checkAllMenuItems(const InventorySnapshot& snapshot, MenuItemCheck* results, TaskScheduler& scheduler) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.checkAllMenuItems");
+        MenuItemSpan items = menuStore.getItems();
+        
+        scheduler.parallel_for(0, items.getSize(), scheduler.suggestGrain(items.getSize()), [&](int first, int last) {
+            for (int i = first; i < last; i++) {
+                const MenuItem& item = items[i];
+                MenuItemCheck check;
+                check.available = true;
+                check.servings = -1;
+                
+                for (int j = 0; j < item.getIngredientCount(); j++) {
+                    const Ingredient& ingredient = item.ingredients[j];
+                    FoodItemView foodItem = snapshot.findFoodItem(ingredient.foodId);
+                    
+                    if (foodItem.isNull()) {
+                        check.missingIngredients++;
+                        check.available = false;
+                        check.servings = 0;
+                        continue;
+                    }
+                    
+                    check.ingredientCost += foodItem->price * ingredient.quantity;
+                    int required = item.getRequiredQuantityAt(j);
+                    if (foodItem.totalQuantity < required) {
+                        check.available = false;
+                    }
+                    if (required > 0) {
+                        int possible = foodItem.totalQuantity / required;
+                        if (check.servings == -1 || possible < check.servings) {
+                            check.servings = possible;
+                        }
+                    }
+                }
+                
+                // A recipe without (positive) ingredients is not limited by stock
+                if (check.servings == -1) {
+                    check.servings = 0;
+                }
+                results[i] = check;
+            }
+        });
+    }
+    
+    /**
+     * Runs the bulk checks over the whole menu and prints one row per menu item
+     * Parameters: inventory - Reference to the inventory system to check against
+     */
+    void displayBulkChecks(const RestaurantInventorySystem& inventory) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.displayBulkChecks");
+        MenuItemSpan items = menuStore.getItems();
+        if (items.isEmpty()) {
+            engineOut() << "No menu items to check." << endl;
+            return;
+        }
+        
+        TaskScheduler& scheduler = TaskScheduler::shared();
+        MenuItemCheck* results = MemoryTracker::allocateArray<MenuItemCheck>(MEM_SORT_SCRATCH, items.getSize());
+        
+        // One snapshot for the whole pass, so every row reflects the same moment
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        InventorySnapshot snapshot = inventory.takeSnapshot();
+        checkAllMenuItems(snapshot, results, scheduler);
+        double stockValue = inventory.computeStockValue(snapshot, scheduler);
+        double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        
+        printHeader("Bulk Menu Checks");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(10) << "Cost" 
+             << setw(10) << "Margin" 
+             << setw(12) << "Available" 
+             << setw(10) << "Servings" 
+             << setw(10) << "Missing" << endl;
+        engineOut() << string(100, '-') << endl;
+        
+        int availableCount = 0;
+        int brokenCount = 0;
+        for (int i = 0; i < items.getSize(); i++) {
+            const MenuItemCheck& check = results[i];
+            engineOut() << left << setw(10) << items[i].id 
+                 << setw(30) << items[i].name 
+                 << setw(10) << fixed << setprecision(2) << items[i].price
+                 << setw(10) << check.ingredientCost
+                 << setw(10) << (items[i].price - check.ingredientCost)
+                 << setw(12) << (check.available ? "Yes" : "No")
+                 << setw(10) << check.servings
+                 << setw(10) << check.missingIngredients << endl;
+            if (check.available) {
+                availableCount++;
+            }
+            if (check.missingIngredients > 0) {
+                brokenCount++;
+            }
+        }
+        
+        engineOut() << string(100, '-') << endl;
+        engineOut() << availableCount << " of " << items.getSize() << " menu items can be prepared now." << endl;
+        if (brokenCount > 0) {
+            engineOut() << brokenCount << " menu item(s) refer to ingredients that are not in the inventory." << endl;
+        }
+        engineOut() << "Inventory stock value: $" << fixed << setprecision(2) << stockValue << endl;
+        engineOut() << "Checked in " << setprecision(3) << elapsedMs << " ms using " 
+             << (scheduler.getWorkerCount() + 1) << " threads." << endl;
+        
+        MemoryTracker::freeArray(MEM_SORT_SCRATCH, results, items.getSize());
+    }
+    
+    /**
+     * Displays the menu items that cannot be made with the current stock ("86'd" items)
+     * Each row names the ingredients that are short; the list itself comes from the servings
+     * cache, so no recipe or inventory bucket is scanned
+     */
+    void displayUnavailableItems() const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.displayUnavailableItems");
+        lock_guard<mutex> guard(servingsLock);
+        if (servingsInventory == nullptr) {
+            engineOut() << "Servings are not being tracked, so availability is unknown." << endl;
+            return;
+        }
+        
+        printHeader("Unavailable Menu Items (86'd)");
+        if (unavailableCount == 0) {
+            engineOut() << "Every menu item can be made with the current stock." << endl;
+            return;
+        }
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(20) << "Category" 
+             << setw(40) << "Short Of" << endl;
+        printFooter();
+        
+        for (int i = 0; i < unavailableCount; i++) {
+            const MenuItem* item = menuStore.get(unavailableItems[i]);
+            if (item == nullptr) {
+                continue;
+            }
+            
+            // Ingredients whose recorded stock does not cover one serving
+            string shortOf;
+            for (int j = 0; j < item->getIngredientCount(); j++) {
+                const Ingredient& ingredient = item->ingredients[j];
+                int required = item->getRequiredQuantityAt(j);
+                int stock = stockLevel(ingredient.foodId);
+                if (stock < required) {
+                    if (!shortOf.empty()) {
+                        shortOf += ", ";
+                    }
+                    shortOf += ingredient.foodId.toString() + " (" + to_string(stock) + "/" + 
+                               to_string(required) + ")";
+                }
+            }
+            
+            engineOut() << left << setw(10) << item->id 
+                 << setw(30) << item->name 
+                 << setw(20) << item->category 
+                 << setw(40) << shortOf << endl;
+        }
+        
+        printFooter();
+        engineOut() << unavailableCount << " of " << menuStore.getSize() << " menu items are unavailable." << endl;
+    }
+    
+    /**
+     * Displays which menu items depend on a food item and what running out of it would mean
+     * Uses the ingredient index, so only the dishes that use the food item are visited
+     * Parameters: foodId - ID of the food item to analyse
+     */
+    void displayIngredientImpact(const ItemID& foodId) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.displayIngredientImpact");
+        lock_guard<mutex> guard(servingsLock);
+        IngredientUseSpan uses = ingredientIndex.getUses(foodId);
+        bool withServings = (servingsInventory != nullptr);
+        
+        printHeader("Ingredient Impact - " + foodId.toString());
+        if (uses.isEmpty()) {
+            engineOut() << "No menu item uses " << foodId << "." << endl;
+            return;
+        }
+        
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(12) << "Needed";
+        if (withServings) {
+            engineOut() << setw(10) << "Servings" 
+                 << setw(12) << "Limiting";
+        }
+        engineOut() << endl;
+        printFooter();
+        
+        // Dishes that can be made now but would not be without this food item
+        int wouldLose = 0;
+        int stock = withServings ? stockLevel(foodId) : 0;
+        for (const IngredientUse& use : uses) {
+            const MenuItem* item = menuStore.get(use.handle);
+            if (item == nullptr) {
+                continue;
+            }
+            engineOut() << left << setw(10) << item->id 
+                 << setw(30) << item->name 
+                 << setw(12) << use.quantity;
+            if (withServings) {
+                int servings = servingsBySlot[use.handle.slot];
+                bool limiting = use.quantity > 0 && servings != SERVINGS_UNLIMITED && 
+                                stock / use.quantity == servings;
+                engineOut() << setw(10) << servingsText(servings) 
+                     << setw(12) << (limiting ? "Yes" : "No");
+                if (use.quantity > 0 && servings != 0) {
+                    wouldLose++;
+                }
+            }
+            engineOut() << endl;
+        }
+        
+        printFooter();
+        engineOut() << uses.getSize() << " menu item(s) use " << foodId << "." << endl;
+        if (withServings) {
+            engineOut() << "Current stock: " << stock << ". Running out would make " << wouldLose 
+                 << " more menu item(s) unavailable." << endl;
+        }
+    }
+    
+    /**
+     * Searches for menu items by name or description
+     * This utility method powers the text search functionality
+     * Parameters: query - The search term to look for in names and descriptions (case-insensitive)
+     * Return: Read-only list of the matching menu items in menu order
+     * Note: The list is valid until the next add or remove, or the next search, sort or filter
+     */
+    MenuItemRefSpan searchMenuItems(const string& query) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.searchMenuItems");
+        int count = menuStore.getSize();
+        if (count == 0) {
+            return MenuItemRefSpan();
+        }
+        
+        // Results are collected in the reusable pointer buffer, nothing is allocated per item
+        const MenuItem** results = getItemPointers();
+        
+        // Exact ID matches are an O(1) lookup in the menu store's ID index
+        if (query.length() == 4 && ValidationCheck::isValidID(query)) {
+            const MenuItem* match = menuStore.findById(query);
+            if (match != nullptr) {
+                // Found exactly one match
+                results[0] = match;
+                return MenuItemRefSpan(results, 1);
+            }
+        }
+        
+        // For non-ID searches or ID not found, use traditional search approach
+        // Keep matching pointers at the front of the buffer, preserving menu order
+        string queryLower = RestaurantInventorySystem::lowerCaseName(query);
+        int resultCount = 0;
+        for (int i = 0; i < count; i++) {
+            // Case-insensitive search in both name and description fields
+            if (RestaurantInventorySystem::nameMatches(results[i]->name, queryLower) || 
+                RestaurantInventorySystem::nameMatches(results[i]->description, queryLower)) {
+                results[resultCount++] = results[i];
+            }
+        }
+        
+        return MenuItemRefSpan(results, resultCount);
+    }
+    
+    /**
+     * Filters menu items by category
+     * This method is useful for menu organization and filtered views
+     * Parameters: category - The category to filter by (exact match)
+     * Return: Read-only list of the menu items in this category in menu order
+     * Note: The list is valid until the next add or remove, or the next search, sort or filter
+     */
+    MenuItemRefSpan getMenuItemsByCategory(const string& category) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.getMenuItemsByCategory");
+        int count = menuStore.getSize();
+        const MenuItem** results = getItemPointers();
+        
+        // Keep matching pointers at the front of the buffer, preserving menu order
+        int resultCount = 0;
+        for (int i = 0; i < count; i++) {
+            // Exact category match (case sensitive)
+            if (results[i]->category == category) {
+                results[resultCount++] = results[i];
+            }
+        }
+        
+        return MenuItemRefSpan(results, resultCount);
+    }
+    
+    // Finds a menu item by its ID using Interpolation Search
+    // Sorts pointers to the stored items by ID and probes them, no menu item is copied
+    // Parameters: id - the ID to search for
+    // Returns: pointer to the stored item or nullptr if not found
+    // Note: The pointer is valid until the next add or remove, do not delete it
+    const MenuItem* findMenuItemById(const ItemID& id) const {
+        RESTAURANT_ALLOCATION_SCOPE("menu.findMenuItemById");
+        int count = menuStore.getSize();
+        
+        // First check if we have items to search
+        if (count == 0) {
+            return nullptr;
+        }
+        
+        // Sort item pointers by ID to enable interpolation search using Tim Sort
+        const MenuItem** items = getItemPointers();
+        timSortMenuItems(items, count, "id");
+        
+        // Apply interpolation search on the sorted pointers
+        int position = interpolationSearchMenuItems(items, count, id);
+        
+        return (position != -1) ? items[position] : nullptr;
+    }
+    
+    /**
+     * Case-insensitive search for menu items by name (partial matching)
+     * This method provides a user-friendly search experience with fuzzy matching
+     * Using hash-based approach to improve performance
+     * Parameters: searchName - The partial or complete name to search for
+     */
+    void searchByName(const string& searchName) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.searchByName");
+        // For exact ID matches, we can use our optimized search
+        if (searchName.length() == 4 && ValidationCheck::isValidID(searchName)) {
+            searchById(searchName);
+            return;
+        }
+        
+        // Convert search term to lowercase once for case-insensitive comparison
+        string searchLower = RestaurantInventorySystem::lowerCaseName(searchName);
+        
+        // Format and display results in a tabular format
+        printHeader("Menu Items Search Result - Name containing '" + searchName + "'");
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(20) << "Category" 
+             << setw(30) << "Description" << endl;
+        printFooter();
+        
+        MenuItemSpan items = menuStore.getItems();
+        int matchCount = 0;
+        
+        // Perform the search and display matching items
+        if (!items.isEmpty()) {
+            for (const MenuItem& item : items) {
+                // Check if the current item name contains the search term (partial match)
+                if (RestaurantInventorySystem::nameMatches(item.name, searchLower)) {
+                    // Display the matching menu item in a formatted row
+                    printMenuRow(item);
+                    matchCount++;
+                }
+            }
+            
+            // Display a summary of search results
+            if (matchCount == 0) {
+                engineOut() << "No menu items found containing '" << searchName << "' in the name." << endl;
+            } else {
+                engineOut() << "\nFound " << matchCount << " menu item(s) matching the search criteria." << endl;
+            }
+        } else {
+            engineOut() << "No items in the menu." << endl;
+        }
+    }
+    
+    /**
+     * Searches for menu items within a specific price range
+     * This method facilitates price-based filtering of menu items using an optimized approach
+     * Parameters: minPrice - The minimum price in the range (inclusive)
+     * Parameters: maxPrice - The maximum price in the range (inclusive)
+     */
+    void searchByPriceRange(double minPrice, double maxPrice) {
+        RESTAURANT_ALLOCATION_SCOPE("menu.searchByPriceRange");
+        // Ensure minimum is less than maximum by swapping if necessary
+        if (minPrice > maxPrice) {
+            swap(minPrice, maxPrice);
+        }
+        
+        // Format prices with 2 decimal places
+        stringstream ss1, ss2;
+        ss1 << fixed << setprecision(2) << minPrice;
+        ss2 << fixed << setprecision(2) << maxPrice;
+        
+        // Format and display results in a tabular format
+        printHeader("Menu Items Search Result - Price Range $" + 
+                    ss1.str() + " to $" + ss2.str());
+        engineOut() << left << setw(10) << "ID" 
+             << setw(30) << "Name" 
+             << setw(10) << "Price" 
+             << setw(20) << "Category" 
+             << setw(30) << "Description" << endl;
+        printFooter();
+        
+        int matchCount = 0;
+        
+        // If we have items, use an optimized approach with Tim Sort
+        if (this->itemCount > 0) {
+            // Sort pointers to the stored items by price
+            const MenuItem** sortedItems = getItemPointers();
+            timSortMenuItems(sortedItems, this->itemCount, "price");
+            
+            // Interpolation search to find the lower and upper bounds of our price range
+            int lowerBound = -1;
+            int upperBound = -1;
+            
+            // Find lower bound (first item >= minPrice)
+            int low = 0;
+            int high = this->itemCount - 1;
+            
+            // First check if we have valid array and range
+            if (high >= 0 && sortedItems[high]->price >= minPrice && sortedItems[low]->price <= maxPrice) {
+                // Find lower bound using interpolation search
+                while (low <= high) {
+                    // Prevent division by zero and handle equal values
+                    if (sortedItems[high]->price == sortedItems[low]->price) {
+                        if (sortedItems[low]->price >= minPrice) {
+                            lowerBound = low;
+                        }
+                        break;
+                    }
+                    
+                    // Calculate probe position using interpolation formula with float precision
+                    float ratio = (float)(minPrice - sortedItems[low]->price) / 
+                                 (float)(sortedItems[high]->price - sortedItems[low]->price);
+                    int pos = low + (int)(ratio * (high - low));
+                    
+                    // Ensure pos is within bounds
+                    if (pos < low) pos = low;
+                    if (pos > high) pos = high;
+                    
+                    if (sortedItems[pos]->price >= minPrice) {
+                        lowerBound = pos;
+                        high = pos - 1; // Look in lower portion
+                    } else {
+                        low = pos + 1; // Look in upper portion
+                    }
+                    
+                    // If positions don't change, break to avoid infinite loop
+                    if (low == high) break;
+                }
+            }
+            
+            // Reset for upper bound search
+            low = 0;
+            high = this->itemCount - 1;
+            
+            // Find upper bound (last item <= maxPrice)
+            if (high >= 0 && sortedItems[high]->price >= minPrice && sortedItems[low]->price <= maxPrice) {
+                while (low <= high) {
+                    // Prevent division by zero and handle equal values
+                    if (sortedItems[high]->price == sortedItems[low]->price) {
+                        if (sortedItems[high]->price <= maxPrice) {
+                            upperBound = high;
+                        }
+                        break;
+                    }
+                    
+                    // Calculate probe position using interpolation formula with float precision
+                    float ratio = (float)(maxPrice - sortedItems[low]->price) / 
+                                 (float)(sortedItems[high]->price - sortedItems[low]->price);
+                    int pos = low + (int)(ratio * (high - low));
+                    
+                    // Ensure pos is within bounds
+                    if (pos < low) pos = low;
+                    if (pos > high) pos = high;
+                    
+                    if (sortedItems[pos]->price <= maxPrice) {
+                        upperBound = pos;
+                        low = pos + 1; // Look in upper portion
+                    } else {
+                        high = pos - 1; // Look in lower portion
+                    }
+                    
+                    // If positions don't change, break to avoid infinite loop
+                    if (low == high) break;
+                }
+            }
+            
+            // If we found valid bounds, display matching items
+            if (lowerBound != -1 && upperBound != -1 && lowerBound <= upperBound) {
+                for (int i = lowerBound; i <= upperBound; i++) {
+                    // Display the matching menu item in a formatted row
+                    engineOut() << left << setw(10) << sortedItems[i]->id 
+                         << setw(30) << sortedItems[i]->name 
+                         << setw(10) << fixed << setprecision(2) << sortedItems[i]->price
+                         << setw(20) << sortedItems[i]->category
+                         << setw(30) << sortedItems[i]->description << endl;
+                    matchCount++;
+                }
+            }
+
+        } else {
+            engineOut() << "No items in the menu." << endl;
+        }
+    }
+};
+
+/**
+ * Order ticket passed from front-of-house to the kitchen
+ */
+struct OrderTicket;
+
+// Completion callback of an order, called on the kitchen thread that handled it
+typedef function<void(const OrderTicket& ticket, bool success, const string& message)> OrderCallback;
+
+struct OrderTicket {
+    unsigned long long orderNumber;  // Assigned by the kitchen when the order is submitted
+    ItemID menuItemId;               // Menu item to prepare
+    string purpose;                  // Logged with each ingredient usage
+    OrderCallback onComplete;        // Optional, called once the order is prepared or rejected
+    
+    OrderTicket() : orderNumber(0) {}
+};
+
+/**
+ * Bounded lock-free multi-producer multi-consumer queue (Vyukov ring buffer)
+ * Every cell carries a sequence number telling producers and consumers whose turn it is,
+ * so a push or pop is one compare-and-swap on a shared position plus one store on the cell.
+ * tryPush fails instead of waiting when the ring is full, which gives callers backpressure.
+ * @time_complexity O(1) per push and pop
+ * @space_complexity O(capacity), rounded up to a power of two
+ */
+template <typename T>
+class BoundedMPMCQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;  // Position this cell is ready for (pos: free for push, pos + 1: ready to pop)
+        T data;
+    };
+    
+    Cell* cells;
+    size_t capacity;
+    size_t mask;
+    
+    // Producers and consumers each get their own cache line
+    alignas(64) atomic<size_t> enqueuePos;
+    alignas(64) atomic<size_t> dequeuePos;
+    
+public:
+    explicit BoundedMPMCQueue(size_t requestedCapacity) : capacity(2) {
+        while (capacity < requestedCapacity) {
+            capacity <<= 1;
+        }
+        mask = capacity - 1;
+        
+        cells = MemoryTracker::allocateArray<Cell>(MEM_ORDER_QUEUE, capacity);
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+        enqueuePos.store(0, memory_order_relaxed);
+        dequeuePos.store(0, memory_order_relaxed);
+    }
+    
+    ~BoundedMPMCQueue() {
+        MemoryTracker::freeArray(MEM_ORDER_QUEUE, cells, capacity);
+    }
+    
+    // The ring owns its cells, copying is not supported
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+    
+    // Adds a value at the tail
+    // Returns: false if the queue is full
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)pos;
+            
+            if (difference == 0) {
+                // Cell is free for this position, try to claim it
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // Cell still holds a value from one lap ago, the queue is full
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed); // Another producer got here first
+            }
+        }
+    }
+    
+    // Removes the value at the head
+    // Returns: false if the queue is empty
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)(pos + 1);
+            
+            if (difference == 0) {
+                // Cell holds the value for this position, try to claim it
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    value = move(cell.data);
+                    cell.data = T();
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // Nothing published at this position yet, the queue is empty
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed); // Another consumer got here first
+            }
+        }
+    }
+    
+    // Number of queued values, only approximate while other threads are pushing or popping
+    size_t approximateSize() const {
+        size_t tail = enqueuePos.load(memory_order_relaxed);
+        size_t head = dequeuePos.load(memory_order_relaxed);
+        return (tail > head) ? tail - head : 0;
+    }
+    
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
+
+/**
+ * Pool of kitchen worker threads that prepare orders taken from a lock-free intake queue
+ * Front-of-house threads call submit, which never blocks: when the kitchen is backed up
+ * the order is rejected and the caller decides whether to retry, so intake latency stays flat.
+ * Workers prepare each order against the shared inventory and then run its completion callback.
+ * The menu cannot be changed while the kitchen is open: the pool opens the kitchen on the menu
+ * system when it starts, and adding, updating or removing menu items fails until it stops.
+ */
+class KitchenWorkerPool {
+private:
+    const RestaurantMenuSystem& menuSystem;
+    RestaurantInventorySystem& inventory;
+    BoundedMPMCQueue<OrderTicket> queue;
+    thread* workers;
+    int workerCount;
+    
+    atomic<bool> running;
+    atomic<unsigned long long> nextOrderNumber;
+    atomic<long long> acceptedOrders;
+    atomic<long long> rejectedOrders;
+    atomic<long long> completedOrders;
+    atomic<long long> failedOrders;
+    
+    // Prepares one order and reports the outcome
+    void process(const OrderTicket& ticket) {
+        TraceSpan span("kitchenOrder", "kitchen", ticket.menuItemId);
+        string message;
+        bool success = false;
+        try {
+            success = menuSystem.prepareOrder(ticket.menuItemId, inventory, ticket.purpose, message);
+        } catch (const exception& e) {
+            message = string("Error while preparing order: ") + e.what();
+        }
+        
+        if (success) {
+            completedOrders++;
+        } else {
+            failedOrders++;
+        }
+        
+        if (ticket.onComplete) {
+            try {
+                ticket.onComplete(ticket, success, message);
+            } catch (...) {
+                // A failing callback must not take the worker down
+            }
+        }
+    }
+    
+    // Worker thread body: take orders until the kitchen closes and the queue is empty
+    void workerLoop() {
+        OrderTicket ticket;
+        int idleRounds = 0;
+        
+        while (true) {
+            if (queue.tryPop(ticket)) {
+                idleRounds = 0;
+                process(ticket);
+                continue;
+            }
+            
+            if (!running.load(memory_order_acquire)) {
+                break;
+            }
+            
+            // Back off while idle: yield for a while, then sleep briefly between polls
+            if (++idleRounds < 64) {
+                this_thread::yield();
+            } else {
+                this_thread::sleep_for(chrono::microseconds(200));
+            }
+        }
+    }
+    
+public:
+    // Starts the workers
+    // Parameters: workers - number of kitchen threads, queueCapacity - maximum orders waiting
+    KitchenWorkerPool(const RestaurantMenuSystem& menu, RestaurantInventorySystem& inv,
+                      int workers = 2, size_t queueCapacity = 256)
+        : menuSystem(menu), inventory(inv), queue(queueCapacity), workers(nullptr),
+          workerCount(workers < 1 ? 1 : workers), running(true), nextOrderNumber(1),
+          acceptedOrders(0), rejectedOrders(0), completedOrders(0), failedOrders(0) {
+        this->workers = new thread[workerCount];
+        menuSystem.openKitchen();
+        for (int i = 0; i < workerCount; i++) {
+            this->workers[i] = thread(&KitchenWorkerPool::workerLoop, this);
+        }
+    }
+    
+    // Closes the kitchen, finishing every order already accepted
+    ~KitchenWorkerPool() {
+        stop();
+    }
+    
+    KitchenWorkerPool(const KitchenWorkerPool&) = delete;
+    KitchenWorkerPool& operator=(const KitchenWorkerPool&) = delete;
+    
+    // Queues an order for the kitchen without blocking
+    // Returns: the order number, or 0 if the order was rejected (queue full or kitchen closed)
+    unsigned long long submit(const ItemID& menuItemId, const string& purpose,
+                              const OrderCallback& onComplete = OrderCallback()) {
+        if (!running.load(memory_order_acquire)) {
+            rejectedOrders++;
+            return 0;
+        }
+        
+        OrderTicket ticket;
+        ticket.orderNumber = nextOrderNumber++;
+        ticket.menuItemId = menuItemId;
+        ticket.purpose = purpose;
+        ticket.onComplete = onComplete;
+        
+        if (!queue.tryPush(ticket)) {
+            rejectedOrders++;
+            return 0;
+        }
+        
+        acceptedOrders++;
+        return ticket.orderNumber;
+    }
+    
+    // Stops taking orders, waits for the workers and prepares anything still queued
+    // Call once no other thread is submitting any more
+    void stop() {
+        if (workers == nullptr) {
+            return;
+        }
+        
+        running.store(false, memory_order_release);
+        for (int i = 0; i < workerCount; i++) {
+            workers[i].join();
+        }
+        delete[] workers;
+        workers = nullptr;
+        
+        OrderTicket ticket;
+        while (queue.tryPop(ticket)) {
+            process(ticket);
+        }
+        menuSystem.closeKitchen();
+    }
+    
+    // Kitchen statistics
+    int getWorkerCount() const { return workerCount; }
+    size_t getQueueCapacity() const { return queue.getCapacity(); }
+    size_t getQueueDepth() const { return queue.approximateSize(); }
+    long long getAcceptedCount() const { return acceptedOrders.load(); }
+    long long getRejectedCount() const { return rejectedOrders.load(); }
+    long long getCompletedCount() const { return completedOrders.load(); }
+    long long getFailedCount() const { return failedOrders.load(); }
+};
+
+/**
+ * Base User class for authentication and user management
+ * Provides common functionality for all user types
+ * @time_complexity Varies by method
+ * @space_complexity Varies by method
+ */
+class User {
+protected:
+    string username;
+    string password;
+    bool isLoggedIn;
+    
+    // Protected constructor to prevent direct instantiation
+    User(const string& _username = "", const string& _password = "") 
+        : username(_username), password(_password), isLoggedIn(false) {}
+    
+public:
+    // Virtual destructor for proper cleanup in derived classes
+    virtual ~User() {}
+    
+    // Account objects are charged to the auth subsystem
+    // The virtual destructor makes delete pass the size of the derived class
+    static void* operator new(size_t bytes) {
+        void* memory = ::operator new(bytes);
+        MemoryTracker::recordAllocation(MEM_AUTH, bytes);
+        return memory;
+    }
+    
+    static void operator delete(void* memory, size_t bytes) {
+        MemoryTracker::recordFree(MEM_AUTH, bytes);
+        ::operator delete(memory);
+    }
+    
+    // Getter for login status
+    bool getLoginStatus() const {
+        return isLoggedIn;
+    }
+    
+    // Getter for username 
+    string getUsername() const {
+        return username;
+    }
+    
+    // Virtual login function to be overridden by derived classes
+    virtual bool login(const string& _username, const string& _password) {
+        // Base implementation (will be overridden)
+        if (username == _username && password == _password) {
+            isLoggedIn = true;
+            return true;
+        }
+        return false;
+    }
+    
+    // Virtual logout function to be overridden by derived classes
+    virtual void logout() {
+        isLoggedIn = false;
+        engineOut() << "Logged out successfully." << endl;
+    }
+    
+    // Virtual register account function to be overridden by derived classes
+    virtual bool registerAccount(const string& _username, const string& _password) {
+        // Base implementation (will be overridden)
+        username = _username;
+        password = _password;
+        return true;
+    }
+    
+    // Overloaded version of registerAccount that takes a role parameter
+    virtual bool registerAccount(const string& _username, const string& _password, const string& role) {
+        // Call the base version
+        return registerAccount(_username, _password);
+    }
+    
+    // Friend function declaration
+    friend void displayUserInfo(const User& user);
+};
+
+// Friend function implementation
+inline void displayUserInfo(const User& user) {
+    engineOut() << "Username: " << user.username << endl;
+    engineOut() << "Login Status: " << (user.isLoggedIn ? "Logged In" : "Logged Out") << endl;
+}
+
+/**
+ * Staff class for regular staff users
+ * Manages staff-specific functionality and authentication
+ */
+class Staff : public User {
+private:
+    ItemID staffId;
+    string position;
+    
+public:
+    // Constructor
+    Staff(const string& _username = "", const string& _password = "", 
+          const ItemID& _staffId = ItemID(), const string& _position = "")
+        : User(_username, _password), staffId(_staffId), position(_position) {}
+    
+    // Getter for staff ID
+    ItemID getStaffId() const {
+        return staffId;
+    }
+    
+    // Getter for position
+    string getPosition() const {
+        return position;
+    }
+    
+    // Setters
+    void setStaffId(const ItemID& _staffId) {
+        staffId = _staffId;
+    }
+    
+    void setPosition(const string& _position) {
+        position = _position;
+    }
+    
+    // Override login to check against staff.txt file
+    virtual bool login(const string& _username, const string& _password) override {
+        ifstream file("staff.txt");
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open staff credentials file." << endl;
+            return false;
+        }
+        
+        string line;
+        bool found = false;
+        
+        // Format: username,password,staffId,position
+        while (getline(file, line)) {
+            size_t pos = line.find(",");
+            if (pos == string::npos) continue;
+            
+            string fileUsername = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            
+            string filePassword = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            
+            string fileStaffId = line.substr(0, pos);
+            string filePosition = line.substr(pos + 1);
+            
+            if (fileUsername == _username && filePassword == _password) {
+                username = fileUsername;
+                password = filePassword;
+                staffId = fileStaffId;
+                position = filePosition;
+                isLoggedIn = true;
+                found = true;
+                break;
+            }
+        }
+        
+        file.close();
+        
+        if (!found) {
+            engineOut() << "Invalid username or password for staff login." << endl;
+        } else {
+            engineOut() << "Staff login successful. Welcome " << username << "!" << endl;
+        }
+        
+        return found;
+    }
+    
+    // Override logout with staff-specific message
+    virtual void logout() override {
+        isLoggedIn = false;
+        engineOut() << "Staff member " << username << " logged out successfully." << endl;
+    }
+    
+    // Override register to save to staff.txt file
+    virtual bool registerAccount(const string& _username, const string& _password) override {
+        return registerAccount(_username, _password, ItemID(), "Default");
+    }
+    
+    // Override overloaded registerAccount with staff-specific parameters
+    virtual bool registerAccount(const string& _username, const string& _password, 
+                                const ItemID& _staffId, const string& _position) {
+        // Check if username already exists
+        ifstream checkFile("staff.txt");
+        if (checkFile.is_open()) {
+            string line;
+            while (getline(checkFile, line)) {
+                size_t pos = line.find(",");
+                if (pos != string::npos) {
+                    string existingUsername = line.substr(0, pos);
+                    if (existingUsername == _username) {
+                        engineOut() << "Error: Username already exists." << endl;
+                        checkFile.close();
+                        return false;
+                    }
+                }
+            }
+            checkFile.close();
+        }
+        
+        // Save to staff.txt
+        ofstream file("staff.txt", ios::app);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open staff credentials file for writing." << endl;
+            return false;
+        }
+        
+        // Update member variables
+        username = _username;
+        password = _password;
+        staffId = _staffId;
+        position = _position;
+        
+        // Write to file
+        file << username << "," << password << "," << staffId << "," << position << endl;
+        file.close();
+        
+        engineOut() << "Staff account registered successfully." << endl;
+        return true;
+    }
+    
+    // Overload the original virtual registerAccount with role parameter
+    virtual bool registerAccount(const string& _username, const string& _password, const string& role) override {
+        // For staff, we ignore the role parameter and use default position
+        return registerAccount(_username, _password, ItemID(), "Default");
+    }
+};
+
+/**
+ * Admin class for administrator users
+ * Manages admin-specific functionality and authentication
+ */
+class Admin : public User {
+private:
+    ItemID adminId;
+    string accessLevel;
+    
+public:
+    // Constructor
+    Admin(const string& _username = "", const string& _password = "", 
+          const ItemID& _adminId = ItemID(), const string& _accessLevel = "")
+        : User(_username, _password), adminId(_adminId), accessLevel(_accessLevel) {}
+    
+    // Getter for admin ID
+    ItemID getAdminId() const {
+        return adminId;
+    }
+    
+    // Getter for access level
+    string getAccessLevel() const {
+        return accessLevel;
+    }
+    
+    // Setters
+    void setAdminId(const ItemID& _adminId) {
+        adminId = _adminId;
+    }
+    
+    void setAccessLevel(const string& _accessLevel) {
+        accessLevel = _accessLevel;
+    }
+    
+    // Override login to check against admin.txt file
+    virtual bool login(const string& _username, const string& _password) override {
+        ifstream file("admin.txt");
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open admin credentials file." << endl;
+            return false;
+        }
+        
+        string line;
+        bool found = false;
+        
+        // Format: username,password,adminId,accessLevel
+        while (getline(file, line)) {
+            size_t pos = line.find(",");
+            if (pos == string::npos) continue;
+            
+            string fileUsername = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            
+            string filePassword = line.substr(0, pos);
+            line.erase(0, pos + 1);
+            
+            pos = line.find(",");
+            if (pos == string::npos) continue;
+            
+            string fileAdminId = line.substr(0, pos);
+            string fileAccessLevel = line.substr(pos + 1);
+            
+            if (fileUsername == _username && filePassword == _password) {
+                username = fileUsername;
+                password = filePassword;
+                adminId = fileAdminId;
+                accessLevel = fileAccessLevel;
+                isLoggedIn = true;
+                found = true;
+                break;
+            }
+        }
+        
+        file.close();
+        
+        if (!found) {
+            engineOut() << "Invalid username or password for admin login." << endl;
+        } else {
+            engineOut() << "Admin login successful. Welcome " << username << "!" << endl;
+        }
+        
+        return found;
+    }
+    
+    // Override logout with admin-specific message
+    virtual void logout() override {
+        isLoggedIn = false;
+        engineOut() << "Administrator " << username << " logged out successfully." << endl;
+    }
+    
+    // Override register to save to admin.txt file
+    virtual bool registerAccount(const string& _username, const string& _password) override {
+        return registerAccount(_username, _password, ItemID(), "Standard");
+    }
+    
+    // Override overloaded registerAccount with admin-specific parameters
+    virtual bool registerAccount(const string& _username, const string& _password, 
+                                const ItemID& _adminId, const string& _accessLevel) {
+        // Check if username already exists
+        ifstream checkFile("admin.txt");
+        if (checkFile.is_open()) {
+            string line;
+            while (getline(checkFile, line)) {
+                size_t pos = line.find(",");
+                if (pos != string::npos) {
+                    string existingUsername = line.substr(0, pos);
+                    if (existingUsername == _username) {
+                        engineOut() << "Error: Username already exists." << endl;
+                        checkFile.close();
+                        return false;
+                    }
+                }
+            }
+            checkFile.close();
+        }
+        
+        // Save to admin.txt
+        ofstream file("admin.txt", ios::app);
+        if (!file.is_open()) {
+            engineOut() << "Error: Could not open admin credentials file for writing." << endl;
+            return false;
+        }
+        
+        // Update member variables
+        username = _username;
+        password = _password;
+        adminId = _adminId;
+        accessLevel = _accessLevel;
+        
+        // Write to file
+        file << username << "," << password << "," << adminId << "," << accessLevel << endl;
+        file.close();
+        
+        engineOut() << "Admin account registered successfully." << endl;
+        return true;
+    }
+    
+    // Overload the original virtual registerAccount with role parameter
+    virtual bool registerAccount(const string& _username, const string& _password, const string& role) override {
+        // For admin, we ignore the role parameter and use default access level
+        return registerAccount(_username, _password, ItemID(), "Standard");
+    }
+    
+    // Friend function to display admin details with access to private members
+    friend void displayAdminDetails(const Admin& admin);
+};
+
+// Friend function implementation for Admin class
+inline void displayAdminDetails(const Admin& admin) {
+    engineOut() << "=== Admin Details ===" << endl;
+    engineOut() << "Username: " << admin.username << endl;
+    engineOut() << "Admin ID: " << admin.adminId << endl;
+    engineOut() << "Access Level: " << admin.accessLevel << endl;
+    engineOut() << "Login Status: " << (admin.isLoggedIn ? "Logged In" : "Logged Out") << endl;
+}
+
+/**
+ * Authentication Manager class to handle user login and registration
+ * Manages both Staff and Admin users in a unified interface
+ */
+class AuthManager {
+private:
+    Staff* currentStaff;
+    Admin* currentAdmin;
+    bool isAdminMode;
+    
+public:
+    // Constructor
+    AuthManager() : currentStaff(nullptr), currentAdmin(nullptr), isAdminMode(false) {}
+    
+    // Destructor - clean up dynamically allocated objects
+    ~AuthManager() {
+        if (currentStaff != nullptr) {
+            delete currentStaff;
+        }
+        if (currentAdmin != nullptr) {
+            delete currentAdmin;
+        }
+    }
+    
+    // Check if any user is logged in
+    bool isLoggedIn() const {
+        return (currentStaff != nullptr && currentStaff->getLoginStatus()) || 
+               (currentAdmin != nullptr && currentAdmin->getLoginStatus());
+    }
+    
+    // Check if current user is an admin
+    bool isAdminLoggedIn() const {
+        return isAdminMode && currentAdmin != nullptr && currentAdmin->getLoginStatus();
+    }
+    
+    // Get current user username
+    string getCurrentUsername() const {
+        if (isAdminMode && currentAdmin != nullptr) {
+            return currentAdmin->getUsername();
+        } else if (!isAdminMode && currentStaff != nullptr) {
+            return currentStaff->getUsername();
+        }
+        return "";
+    }
+    
+    // Handle login process
+    bool login(const string& username, const string& password, bool adminLogin) {
+        if (adminLogin) {
+            // Admin login
+            if (currentAdmin == nullptr) {
+                currentAdmin = new Admin();
+            }
+            if (currentAdmin->login(username, password)) {
+                isAdminMode = true;
+                return true;
+            }
+        } else {
+            // Staff login
+            if (currentStaff == nullptr) {
+                currentStaff = new Staff();
+            }
+            if (currentStaff->login(username, password)) {
+                isAdminMode = false;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Handle logout process
+    void logout() {
+        if (isAdminMode && currentAdmin != nullptr) {
+            currentAdmin->logout();
+        } else if (!isAdminMode && currentStaff != nullptr) {
+            currentStaff->logout();
+        } else {
+            engineOut() << "No user is currently logged in." << endl;
+        }
+    }
+    
+    // Handle staff registration
+    bool registerStaff(const string& username, const string& password, 
+                      const string& staffId, const string& position) {
+        Staff staff;
+        return staff.registerAccount(username, password, staffId, position);
+    }
+    
+    // Handle admin registration
+    bool registerAdmin(const string& username, const string& password, 
+                       const string& adminId, const string& accessLevel) {
+        Admin admin;
+        return admin.registerAccount(username, password, adminId, accessLevel);
+    }
+    
+    // Overloaded function to register either staff or admin based on role
+    bool registerUser(const string& username, const string& password, const string& role) {
+        if (role == "admin") {
+            Admin admin;
+            return admin.registerAccount(username, password, role);
+        } else {
+            Staff staff;
+            return staff.registerAccount(username, password, role);
+        }
+    }
+
+    // Check if current user is a full admin
+    bool isFullAdmin() const {
+        return isAdminMode && currentAdmin != nullptr && currentAdmin->getAccessLevel() == "Full";
+    }
+};
+
+#if defined(RESTAURANT_COUNT_ALLOCATIONS) && defined(RESTAURANT_ALLOCATION_HOOK_IMPLEMENTATION)
+// Replacement global allocation functions that report to AllocationStats
+// Defined only in the one source file that defines RESTAURANT_ALLOCATION_HOOK_IMPLEMENTATION.
+// Over-aligned (align_val_t) forms are left to the standard library and are not counted.
+// They are kept out of line so GCC does not pair the inlined malloc with a class operator delete
+// and report a mismatched deallocation.
+#if defined(__GNUC__)
+#define RESTAURANT_ALLOCATION_HOOK __attribute__((noinline))
+#else
+#define RESTAURANT_ALLOCATION_HOOK
+#endif
+
+RESTAURANT_ALLOCATION_HOOK void* operator new(size_t size) {
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    AllocationStats::onAllocate(size);
+    return memory;
+}
+
+RESTAURANT_ALLOCATION_HOOK void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+RESTAURANT_ALLOCATION_HOOK void* operator new(size_t size, const nothrow_t&) noexcept {
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory != nullptr) {
+        AllocationStats::onAllocate(size);
+    }
+    return memory;
+}
+
+RESTAURANT_ALLOCATION_HOOK void* operator new[](size_t size, const nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+RESTAURANT_ALLOCATION_HOOK void operator delete(void* memory) noexcept {
+    if (memory != nullptr) {
+        AllocationStats::onFree();
+        free(memory);
+    }
+}
+
+RESTAURANT_ALLOCATION_HOOK void operator delete[](void* memory) noexcept {
+    operator delete(memory);
+}
+
+RESTAURANT_ALLOCATION_HOOK void operator delete(void* memory, const nothrow_t&) noexcept {
+    operator delete(memory);
+}
+
+RESTAURANT_ALLOCATION_HOOK void operator delete[](void* memory, const nothrow_t&) noexcept {
+    operator delete(memory);
+}
+
+#if __cplusplus >= 201402L
+RESTAURANT_ALLOCATION_HOOK void operator delete(void* memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+RESTAURANT_ALLOCATION_HOOK void operator delete[](void* memory, size_t) noexcept {
+    operator delete(memory);
+}
+#endif
+#undef RESTAURANT_ALLOCATION_HOOK
+#endif // RESTAURANT_ALLOCATION_HOOK_IMPLEMENTATION
+
+
+#endif // RESTAURANT_CORE_H
@@ -0,0 +1,630 @@
+// Benchmark regression gate for the restaurant engines
+// Runs bench/RestaurantBench.cpp several times (or reads result files), pools the samples and
+// compares ns/op, allocations/op and peak tracked memory with a committed baseline JSON.
+// Allocations and memory are compared everywhere; ns/op only fails the gate when the results come
+// from the same host fingerprint (CPU, CPU count, compiler) as the baseline.
+// Prints a regression table and exits with 1 when a metric got worse past its tolerance, so it can
+// guard a build script or a pre-push hook.
+//
+// Build:  g++ -std=c++11 -O2 bench/BenchCompare.cpp -o bench_compare
+// Run:    bench_compare --baseline bench/baseline.json --bench ./restaurant_bench
+//         bench_compare --baseline bench/baseline.json --current after.json
+//         bench_compare --baseline bench/baseline.json --bench ./restaurant_bench --update-baseline
+//
+// Exit status: 0 = no regression, 1 = regression (or a baseline benchmark is missing at a size that
+//              was run; sizes that were not run are skipped), 2 = error
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <ctime>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+// Settings of one comparison, filled from the command line
+struct CompareOptions {
+    string baselineFile = "bench/baseline.json";
+    string currentFiles[16];          // Result files to compare instead of running the benchmark
+    int currentFileCount = 0;
+    string benchCommand = "";         // Benchmark executable to run
+    int runs = 3;                     // Benchmark processes whose samples are pooled
+    string sizes = "";                // Sizes to run (default: the sizes in the baseline)
+    int repetitions = 0;              // Repetitions per run (default: as in the baseline)
+    string filter = "";               // Only compare benchmarks whose name contains this text
+    double timeTolerance = 0.15;      // Allowed ns/op slowdown (fraction of the baseline median); separate
+                                      // processes on one machine differ by up to about 10%
+    double allocTolerance = 0.0;      // Allowed allocs/op increase (fraction, plus 0.01 allocs/op)
+    double memoryTolerance = 0.05;    // Allowed peak memory increase (fraction, plus 1 KB)
+    double confidence = 0.95;         // Confidence level of the median intervals
+    bool updateBaseline = false;      // Write the pooled results as the new baseline
+    bool verbose = false;             // Show the benchmark's own progress table
+    bool gateTime = false;            // Fail on ns/op (set when baseline and current share a host)
+};
+
+// One benchmark at one size, as read from a result file (samples pooled over all files)
+struct BenchRecord {
+    string name;
+    int size = 0;
+    long long ops = 0;
+    double allocsPerOp = 0;
+    long long peakBytes = -1;         // -1 if the file predates peak tracking
+    int fileCount = 0;                // Result files this record was pooled from
+    vector<double> samples;           // ns/op of every repetition
+};
+
+/**
+ * BenchResults holds the results of one or more benchmark runs
+ * Reads the JSON written by RestaurantBench (one result object per line) and pools the samples
+ * of records with the same name and size.
+ */
+class BenchResults {
+private:
+    vector<BenchRecord> records;
+    int repetitions;
+    string allocSource;
+    string host;                      // Host fingerprint, empty if unknown, "mixed" if the files differ
+
+    // Finds "key": in text starting at from; returns the position after it or string::npos
+    static size_t findKey(const string& text, const string& key, size_t from = 0) {
+        size_t position = text.find("\"" + key + "\":", from);
+        return (position == string::npos) ? position : position + key.length() + 3;
+    }
+
+    static bool readNumber(const string& text, const string& key, double& value) {
+        size_t position = findKey(text, key);
+        if (position == string::npos) {
+            return false;
+        }
+        value = strtod(text.c_str() + position, nullptr);
+        return true;
+    }
+
+    static bool readString(const string& text, const string& key, string& value) {
+        size_t position = findKey(text, key);
+        if (position == string::npos) {
+            return false;
+        }
+        size_t open = text.find('"', position);
+        size_t close = (open == string::npos) ? open : text.find('"', open + 1);
+        if (close == string::npos) {
+            return false;
+        }
+        value = text.substr(open + 1, close - open - 1);
+        return true;
+    }
+
+    static bool readNumbers(const string& text, const string& key, vector<double>& values) {
+        size_t position = findKey(text, key);
+        if (position == string::npos) {
+            return false;
+        }
+        size_t open = text.find('[', position);
+        size_t close = (open == string::npos) ? open : text.find(']', open);
+        if (close == string::npos) {
+            return false;
+        }
+        stringstream list(text.substr(open + 1, close - open - 1));
+        string field;
+        while (getline(list, field, ',')) {
+            values.push_back(strtod(field.c_str(), nullptr));
+        }
+        return true;
+    }
+
+public:
+    BenchResults() : repetitions(0), allocSource("tracker") {}
+
+    const vector<BenchRecord>& getRecords() const { return records; }
+    int getRepetitions() const { return repetitions; }
+    const string& getAllocSource() const { return allocSource; }
+    const string& getHost() const { return host; }
+
+    // True if any benchmark was run at this size
+    bool hasSize(int size) const {
+        for (size_t i = 0; i < records.size(); i++) {
+            if (records[i].size == size) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    BenchRecord* find(const string& name, int size) {
+        for (size_t i = 0; i < records.size(); i++) {
+            if (records[i].name == name && records[i].size == size) {
+                return &records[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // Adds the results of one file
+    // Returns: true if the file was read, false if it is missing or not a benchmark result file
+    bool loadFromFile(const string& filename) {
+        ifstream file(filename);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open file " << filename << endl;
+            return false;
+        }
+
+        string line;
+        int loaded = 0;
+        while (getline(file, line)) {
+            double number = 0;
+            if (line.find("\"results\"") != string::npos) {
+                continue;
+            }
+            if (line.find("\"name\":") == string::npos) {
+                if (readNumber(line, "repetitions", number)) {
+                    repetitions = (int)number;
+                }
+                readString(line, "alloc_source", allocSource);
+                string fileHost;
+                if (readString(line, "host", fileHost)) {
+                    host = (host.empty() || host == fileHost) ? fileHost : "mixed";
+                }
+                continue;
+            }
+
+            BenchRecord parsed;
+            vector<double> samples;
+            if (!readString(line, "name", parsed.name) || !readNumber(line, "size", number) ||
+                !readNumbers(line, "samples_ns_per_op", samples) || samples.empty()) {
+                cerr << "Error: Malformed result in " << filename << ": " << line << endl;
+                return false;
+            }
+            parsed.size = (int)number;
+            if (readNumber(line, "ops", number)) {
+                parsed.ops = (long long)number;
+            }
+            readNumber(line, "allocs_per_op", parsed.allocsPerOp);
+            if (readNumber(line, "peak_bytes", number)) {
+                parsed.peakBytes = (long long)number;
+            }
+
+            // Pool with the same benchmark from earlier files: samples are appended, allocations
+            // averaged and the highest peak kept
+            BenchRecord* record = find(parsed.name, parsed.size);
+            if (record == nullptr) {
+                records.push_back(parsed);
+                record = &records.back();
+            } else {
+                record->allocsPerOp = (record->allocsPerOp * record->fileCount + parsed.allocsPerOp) /
+                                      (record->fileCount + 1);
+                record->peakBytes = max(record->peakBytes, parsed.peakBytes);
+            }
+            record->samples.insert(record->samples.end(), samples.begin(), samples.end());
+            record->fileCount++;
+            loaded++;
+        }
+
+        if (loaded == 0) {
+            cerr << "Error: No benchmark results in " << filename << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Writes the pooled results in the benchmark's own format (used for --update-baseline)
+    bool saveToFile(const string& filename) const;
+};
+
+/**
+ * MedianInterval is the median of a set of samples with a distribution-free confidence interval
+ * The interval is bounded by order statistics chosen from the binomial(n, 1/2) distribution, so it
+ * needs no assumption about the shape of the timing noise. With few samples it widens to the
+ * smallest and largest sample.
+ */
+struct MedianInterval {
+    double median = 0;
+    double low = 0;
+    double high = 0;
+
+    MedianInterval(vector<double> samples, double confidence) {
+        if (samples.empty()) {
+            return;
+        }
+        sort(samples.begin(), samples.end());
+        int n = (int)samples.size();
+        median = (n % 2 == 1) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+
+        // Largest j with P(B <= j) <= alpha / 2 gives the interval [x(j), x(n-1-j)]
+        double tail = (1.0 - confidence) / 2.0;
+        double cumulative = 0;
+        int j = -1;
+        for (int i = 0; i < n / 2; i++) {
+            cumulative += exp(lgamma(n + 1.0) - lgamma(i + 1.0) - lgamma(n - i + 1.0) - n * log(2.0));
+            if (cumulative > tail) {
+                break;
+            }
+            j = i;
+        }
+        if (j < 0) {
+            j = 0;
+        }
+        low = samples[j];
+        high = samples[n - 1 - j];
+    }
+};
+
+bool BenchResults::saveToFile(const string& filename) const {
+    ofstream out(filename);
+    if (!out.is_open()) {
+        cerr << "Error: Could not open file " << filename << " for writing" << endl;
+        return false;
+    }
+
+    out << "{" << endl;
+    out << "  \"schema\": 1," << endl;
+    out << "  \"timestamp\": " << (long long)time(0) << "," << endl;
+    out << "  \"repetitions\": " << repetitions << "," << endl;
+    out << "  \"alloc_source\": \"" << allocSource << "\"," << endl;
+    if (!host.empty()) {
+        out << "  \"host\": \"" << host << "\"," << endl;
+    }
+    out << "  \"results\": [" << endl;
+    for (size_t i = 0; i < records.size(); i++) {
+        const BenchRecord& record = records[i];
+        double median = MedianInterval(record.samples, 0.5).median;
+        out << "    {\"name\": \"" << record.name << "\", \"size\": " << record.size
+            << ", \"ops\": " << record.ops
+            << fixed << setprecision(3)
+            << ", \"ns_per_op\": " << median
+            << ", \"ops_per_sec\": " << 1e9 / median
+            << ", \"allocs_per_op\": " << record.allocsPerOp;
+        if (record.peakBytes >= 0) {
+            out << ", \"peak_bytes\": " << record.peakBytes;
+        }
+        out << ", \"samples_ns_per_op\": [";
+        for (size_t s = 0; s < record.samples.size(); s++) {
+            out << (s > 0 ? ", " : "") << record.samples[s];
+        }
+        out << "]}" << (i + 1 < records.size() ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+    return true;
+}
+
+/**
+ * BenchComparison compares current results with the baseline and prints the regression table
+ * ns/op regresses only when the median is slower than the tolerance allows AND the confidence
+ * intervals of the two medians do not overlap; a slowdown that is within the noise is shown as
+ * "noisy" and does not fail. Timings from another host are shown but never fail. Allocations/op
+ * and peak memory are deterministic, so they regress as soon as they grow past their tolerance.
+ */
+class BenchComparison {
+private:
+    const CompareOptions& options;
+    int compared;
+    int regressions;
+    int improvements;
+    int noisy;
+    int skipped;
+
+    static string formatInterval(const MedianInterval& interval) {
+        stringstream text;
+        text << fixed << setprecision(interval.median < 10000 ? 1 : 0)
+             << interval.median << " [" << interval.low << "-" << interval.high << "]";
+        return text.str();
+    }
+
+    static string formatChange(double before, double after) {
+        if (before <= 0) {
+            return "-";
+        }
+        stringstream text;
+        text << showpos << fixed << setprecision(1) << (after / before - 1.0) * 100.0 << "%";
+        return text.str();
+    }
+
+    static string formatPair(double before, double after, int precision) {
+        stringstream text;
+        text << fixed << setprecision(precision) << before << " -> " << after;
+        return text.str();
+    }
+
+    static void addStatus(string& status, const string& text) {
+        status += (status.empty() ? "" : ",") + text;
+    }
+
+    void printRow(const BenchRecord& record, const string& baseTime, const string& currentTime,
+                  const string& change, const string& allocs, const string& peak, const string& status) const {
+        cout << left << setw(38) << record.name
+             << setw(9) << record.size
+             << setw(30) << baseTime
+             << setw(30) << currentTime
+             << setw(9) << change
+             << setw(16) << allocs
+             << setw(18) << peak
+             << status << endl;
+    }
+
+public:
+    // True if now is slower than base by more than the time tolerance and outside the noise
+    static bool isSlower(const BenchRecord& base, const BenchRecord& now, const CompareOptions& options) {
+        MedianInterval baseTime(base.samples, options.confidence);
+        MedianInterval nowTime(now.samples, options.confidence);
+        return nowTime.median > baseTime.median * (1.0 + options.timeTolerance) && nowTime.low > baseTime.high;
+    }
+
+    BenchComparison(const CompareOptions& _options)
+        : options(_options), compared(0), regressions(0), improvements(0), noisy(0), skipped(0) {}
+
+    // Compares every baseline benchmark that matches the filter
+    // Returns: the number of regressions (benchmarks missing at a size that was run count as regressions)
+    int compare(BenchResults& baseline, BenchResults& current) {
+        cout << left << setw(38) << "Benchmark"
+             << setw(9) << "Size"
+             << setw(30) << "Baseline ns/op [CI]"
+             << setw(30) << "Current ns/op [CI]"
+             << setw(9) << "Change"
+             << setw(16) << "Allocs/op"
+             << setw(18) << "Peak KB"
+             << "Status" << endl;
+        cout << string(158, '-') << endl;
+
+        const vector<BenchRecord>& baseRecords = baseline.getRecords();
+        for (size_t i = 0; i < baseRecords.size(); i++) {
+            const BenchRecord& base = baseRecords[i];
+            if (!options.filter.empty() && base.name.find(options.filter) == string::npos) {
+                continue;
+            }
+
+            MedianInterval baseTime(base.samples, options.confidence);
+            const BenchRecord* now = current.find(base.name, base.size);
+            if (now == nullptr && !current.hasSize(base.size)) {
+                // This size was not run (--sizes, or the results come from a smaller run)
+                printRow(base, formatInterval(baseTime), "-", "-", "-", "-", "skipped");
+                skipped++;
+                continue;
+            }
+            compared++;
+            if (now == nullptr) {
+                printRow(base, formatInterval(baseTime), "-", "-", "-", "-", "MISSING");
+                regressions++;
+                continue;
+            }
+
+            MedianInterval nowTime(now->samples, options.confidence);
+            string status;
+            bool regressed = false;
+
+            // Time: must be past the tolerance and outside the noise, and measured on the baseline's host
+            bool slower = nowTime.median > baseTime.median * (1.0 + options.timeTolerance);
+            bool faster = nowTime.median < baseTime.median * (1.0 - options.timeTolerance);
+            if (!options.gateTime) {
+                // Shown for reference only
+            } else if (isSlower(base, *now, options)) {
+                addStatus(status, "SLOWER");
+                regressed = true;
+            } else if (faster && nowTime.high < baseTime.low) {
+                addStatus(status, "faster");
+                improvements++;
+            } else if (slower || faster) {
+                addStatus(status, "noisy");
+                noisy++;
+            }
+
+            // Allocations per operation
+            if (now->allocsPerOp > base.allocsPerOp * (1.0 + options.allocTolerance) + 0.01) {
+                addStatus(status, "MORE ALLOCS");
+                regressed = true;
+            }
+
+            // Peak tracked memory (skipped if either file has no peak)
+            string peak = "-";
+            if (base.peakBytes >= 0 && now->peakBytes >= 0) {
+                peak = formatPair(base.peakBytes / 1024.0, now->peakBytes / 1024.0, 0);
+                if (now->peakBytes > base.peakBytes * (1.0 + options.memoryTolerance) + 1024) {
+                    addStatus(status, "MORE MEMORY");
+                    regressed = true;
+                }
+            }
+
+            if (regressed) {
+                regressions++;
+            }
+            printRow(base, formatInterval(baseTime), formatInterval(nowTime),
+                     formatChange(baseTime.median, nowTime.median),
+                     formatPair(base.allocsPerOp, now->allocsPerOp, 2), peak, status.empty() ? "ok" : status);
+        }
+
+        // Benchmarks that are not in the baseline yet are listed but never fail
+        const vector<BenchRecord>& nowRecords = current.getRecords();
+        for (size_t i = 0; i < nowRecords.size(); i++) {
+            const BenchRecord& now = nowRecords[i];
+            if (baseline.find(now.name, now.size) == nullptr &&
+                (options.filter.empty() || now.name.find(options.filter) != string::npos)) {
+                printRow(now, "-", formatInterval(MedianInterval(now.samples, options.confidence)), "-", "-", "-", "new");
+            }
+        }
+
+        cout << string(158, '-') << endl;
+        cout << compared << " benchmarks compared: " << regressions << " regressed, " << improvements
+             << " faster, " << noisy << " changed within the noise ("
+             << (int)(options.confidence * 100 + 0.5) << "% median intervals, time tolerance "
+             << options.timeTolerance * 100 << "%)";
+        if (skipped > 0) {
+            cout << ", " << skipped << " skipped (size not run)";
+        }
+        cout << endl;
+        if (!options.gateTime) {
+            cout << "ns/op was not gated: the baseline was recorded on \""
+                 << (baseline.getHost().empty() ? "an unknown host" : baseline.getHost())
+                 << "\", these results come from \""
+                 << (current.getHost().empty() ? "an unknown host" : current.getHost())
+                 << "\" (allocations and memory were still checked; record a baseline on this host"
+                 << " with --update-baseline to gate timings)" << endl;
+        }
+        return regressions;
+    }
+};
+
+// Distinct sizes of a result set as a --sizes list ("1000,10000")
+string sizeList(const BenchResults& results) {
+    vector<int> sizes;
+    const vector<BenchRecord>& records = results.getRecords();
+    for (size_t i = 0; i < records.size(); i++) {
+        if (find(sizes.begin(), sizes.end(), records[i].size) == sizes.end()) {
+            sizes.push_back(records[i].size);
+        }
+    }
+    string list;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        list += (i > 0 ? "," : "") + to_string(sizes[i]);
+    }
+    return list;
+}
+
+// Runs the benchmarks matching filter options.runs times and pools the results
+// Returns: true if every run succeeded
+bool runBenchmark(const CompareOptions& options, const string& sizes, int repetitions, const string& filter,
+                  BenchResults& current) {
+    for (int run = 1; run <= options.runs; run++) {
+        string output = "bench_compare_run" + to_string(run) + ".json";
+        string command = options.benchCommand + " --sizes " + sizes + " --repetitions " + to_string(repetitions) +
+                         " --json " + output;
+        if (!filter.empty()) {
+            command += " --filter '" + filter + "'";
+        }
+        if (!options.verbose) {
+            command += " 2>/dev/null";
+        }
+
+        cerr << "Run " << run << "/" << options.runs << ": " << command << endl;
+        int status = system(command.c_str());
+        bool loaded = (status == 0) && current.loadFromFile(output);
+        remove(output.c_str());
+        if (!loaded) {
+            cerr << "Error: Benchmark run failed (status " << status << ")" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    CompareOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (option == "--update-baseline") {
+            options.updateBaseline = true;
+        } else if (option == "--verbose") {
+            options.verbose = true;
+        } else if (option == "--baseline" && hasValue) {
+            options.baselineFile = argv[++i];
+        } else if (option == "--current" && hasValue && options.currentFileCount < 16) {
+            options.currentFiles[options.currentFileCount++] = argv[++i];
+        } else if (option == "--bench" && hasValue) {
+            options.benchCommand = argv[++i];
+        } else if (option == "--runs" && hasValue) {
+            options.runs = atoi(argv[++i]);
+        } else if (option == "--sizes" && hasValue) {
+            options.sizes = argv[++i];
+        } else if (option == "--repetitions" && hasValue) {
+            options.repetitions = atoi(argv[++i]);
+        } else if (option == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (option == "--time-tolerance" && hasValue) {
+            options.timeTolerance = atof(argv[++i]);
+        } else if (option == "--alloc-tolerance" && hasValue) {
+            options.allocTolerance = atof(argv[++i]);
+        } else if (option == "--memory-tolerance" && hasValue) {
+            options.memoryTolerance = atof(argv[++i]);
+        } else if (option == "--confidence" && hasValue) {
+            options.confidence = atof(argv[++i]);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--baseline file] (--bench executable [--runs 3] [--sizes list]"
+                 << " [--repetitions n] | --current file ...) [--filter text] [--time-tolerance 0.15]"
+                 << " [--alloc-tolerance 0] [--memory-tolerance 0.05] [--confidence 0.95]"
+                 << " [--update-baseline] [--verbose]" << endl;
+            return 2;
+        }
+    }
+    if (options.benchCommand.empty() == (options.currentFileCount == 0)) {
+        cerr << "Error: give either --bench or --current" << endl;
+        return 2;
+    }
+    if (options.runs < 1 || options.confidence <= 0 || options.confidence >= 1 ||
+        options.timeTolerance < 0 || options.allocTolerance < 0 || options.memoryTolerance < 0) {
+        cerr << "Error: need at least one run, a confidence between 0 and 1 and non-negative tolerances" << endl;
+        return 2;
+    }
+
+    // The baseline may be absent only when it is about to be created
+    BenchResults baseline;
+    bool haveBaseline = baseline.loadFromFile(options.baselineFile);
+    if (!haveBaseline && !options.updateBaseline) {
+        return 2;
+    }
+
+    // Collect the current results
+    BenchResults current;
+    if (!options.benchCommand.empty()) {
+        string sizes = !options.sizes.empty() ? options.sizes : haveBaseline ? sizeList(baseline) : "1000,10000";
+        int repetitions = (options.repetitions > 0) ? options.repetitions
+                        : (haveBaseline && baseline.getRepetitions() > 0) ? baseline.getRepetitions() : 5;
+        if (!runBenchmark(options, sizes, repetitions, options.filter, current)) {
+            return 2;
+        }
+    } else {
+        for (int i = 0; i < options.currentFileCount; i++) {
+            if (!current.loadFromFile(options.currentFiles[i])) {
+                return 2;
+            }
+        }
+    }
+
+    if (options.updateBaseline) {
+        if (!current.saveToFile(options.baselineFile)) {
+            return 2;
+        }
+        cout << "Baseline written to " << options.baselineFile << " (" << current.getRecords().size()
+             << " benchmarks)" << endl;
+        return 0;
+    }
+
+    // Tracker and heap allocation counts are not comparable
+    if (baseline.getAllocSource() != current.getAllocSource()) {
+        cerr << "Error: baseline counts " << baseline.getAllocSource() << " allocations but the current results count "
+             << current.getAllocSource() << " allocations; build both the same way" << endl;
+        return 2;
+    }
+
+    // Timings are only comparable between runs on the same machine and build
+    options.gateTime = !baseline.getHost().empty() && baseline.getHost() != "mixed" &&
+                       baseline.getHost() == current.getHost();
+
+    // A slowdown caused by other load on the machine rarely repeats, so every benchmark that looks
+    // slower is measured again on its own and only the second measurement is compared
+    if (!options.benchCommand.empty() && options.gateTime) {
+        const vector<BenchRecord>& baseRecords = baseline.getRecords();
+        for (size_t i = 0; i < baseRecords.size(); i++) {
+            const BenchRecord& base = baseRecords[i];
+            BenchRecord* now = current.find(base.name, base.size);
+            if (now == nullptr || !BenchComparison::isSlower(base, *now, options)) {
+                continue;
+            }
+            cerr << "Confirming " << base.name << " at size " << base.size << endl;
+            BenchResults retry;
+            BenchRecord* confirmed = nullptr;
+            if (runBenchmark(options, to_string(base.size), current.getRepetitions(), base.name, retry)) {
+                confirmed = retry.find(base.name, base.size);
+            }
+            if (confirmed != nullptr) {
+                now->samples = confirmed->samples;
+            }
+        }
+    }
+
+    BenchComparison comparison(options);
+    return (comparison.compare(baseline, current) > 0) ? 1 : 0;
+}
@@ -0,0 +1,704 @@
+// Micro-benchmarks for the restaurant engines
+// Times the inventory, menu, sort and search engines on synthetic data of several sizes and
+// reports ns/op, ops/s, allocations/op and peak tracked memory as a table and as JSON that can be
+// compared between builds (see bench/BenchCompare.cpp).
+//
+// Build:  g++ -std=c++11 -O2 -pthread bench/RestaurantBench.cpp -o restaurant_bench
+// Run:    restaurant_bench [--sizes 1000,10000,100000,1000000] [--repetitions 5] [--json bench.json]
+//                          [--filter text]
+//
+// By default allocations/op counts the tracked allocations of the engines (MemoryTracker). Build
+// with -DRESTAURANT_COUNT_ALLOCATIONS to count every heap allocation (strings, vectors, shared_ptr)
+// through the allocation hook instead.
+#define RESTAURANT_ALLOCATION_HOOK_IMPLEMENTATION
+#include "../RestaurantCore.h"
+
+// Stream buffer that throws away everything written to it (engine messages are not timed output)
+class DiscardBuffer : public streambuf {
+protected:
+    int overflow(int c) override {
+        return c;
+    }
+};
+
+/**
+ * BenchmarkSuite runs every benchmark at every size and collects the results
+ * Each repetition builds fresh data (not timed), then times one body that performs `ops`
+ * operations. The median over the repetitions is reported; every sample is kept in the JSON.
+ */
+class BenchmarkSuite {
+public:
+    static const int MAX_REPETITIONS = 32;
+    static const int ID_COUNT = 50;           // Distinct food IDs: at a load factor of 0.5 quadratic
+                                              // probing can place every ID in the 101 buckets
+
+    // Body of a benchmark: sets up its data, then calls timer.start() right before the timed part
+    // and returns the number of operations performed
+    class Timer {
+    private:
+        chrono::steady_clock::time_point begin;
+        long long allocationsAtStart;
+
+    public:
+        static long long totalAllocations() {
+#ifdef RESTAURANT_COUNT_ALLOCATIONS
+            return (long long)AllocationStats::getTotalAllocations();
+#else
+            long long total = 0;
+            for (int i = 0; i < MEM_TAG_COUNT; i++) {
+                total += MemoryTracker::getAllocationCount((MemoryTag)i);
+            }
+            return total;
+#endif
+        }
+        
+        // What totalAllocations() counts, recorded in the JSON so results are only compared like for like
+        static const char* allocationSource() {
+#ifdef RESTAURANT_COUNT_ALLOCATIONS
+            return "heap";
+#else
+            return "tracker";
+#endif
+        }
+
+        // The machine and build the timings come from (CPU model, logical CPUs, compiler, optimization),
+        // recorded in the JSON so ns/op is only gated against results from the same host
+        static string hostFingerprint() {
+            string cpu = "unknown cpu";
+            ifstream cpuInfo("/proc/cpuinfo");
+            string line;
+            while (getline(cpuInfo, line)) {
+                size_t start = line.find_first_not_of(" \t", line.find(':') + 1);
+                if (line.compare(0, 10, "model name") == 0 && start != string::npos) {
+                    cpu = line.substr(start);
+                    break;
+                }
+            }
+            
+            stringstream text;
+            for (size_t i = 0; i < cpu.length(); i++) {
+                // Keep the text a plain JSON string
+                if (cpu[i] != '"' && cpu[i] != '\\') {
+                    text << cpu[i];
+                }
+            }
+            text << ", " << thread::hardware_concurrency() << " cpus, ";
+#if defined(__clang__)
+            text << "clang " << __clang_major__ << "." << __clang_minor__;
+#elif defined(__GNUC__)
+            text << "gcc " << __GNUC__ << "." << __GNUC_MINOR__;
+#elif defined(_MSC_VER)
+            text << "msvc " << _MSC_VER;
+#else
+            text << "unknown compiler";
+#endif
+#ifdef __OPTIMIZE__
+            text << " optimized";
+#else
+            text << " unoptimized";
+#endif
+            return text.str();
+        }
+
+        // Tracked bytes in use, and the sum of the subsystem peaks since the last MemoryTracker::resetPeaks()
+        static long long totalCurrentBytes() {
+            long long total = 0;
+            for (int i = 0; i < MEM_TAG_COUNT; i++) {
+                total += MemoryTracker::getCurrentBytes((MemoryTag)i);
+            }
+            return total;
+        }
+
+        static long long totalPeakBytes() {
+            long long total = 0;
+            for (int i = 0; i < MEM_TAG_COUNT; i++) {
+                total += MemoryTracker::getPeakBytes((MemoryTag)i);
+            }
+            return total;
+        }
+
+        void start() {
+            allocationsAtStart = totalAllocations();
+            begin = chrono::steady_clock::now();
+        }
+
+        double elapsedNs() const {
+            return chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count();
+        }
+
+        long long allocations() const {
+            return totalAllocations() - allocationsAtStart;
+        }
+    };
+    typedef function<long long(int size, Timer& timer)> Body;
+
+    static const int MAX_SIZES = 16;
+    static const int MAX_BENCHMARKS = 32;     // Benchmarks registered in runAllBenchmarks, with room to grow
+    static const char* const HISTORY_FILE;    // Scratch usage history of the order benchmarks, removed at exit
+
+private:
+    static const int MAX_RESULTS = MAX_BENCHMARKS * MAX_SIZES;
+    static const int OPS_CAP = 10000;         // Most operations timed per sample for per-item operations
+
+    // Outcome of one benchmark at one size
+    struct Result {
+        string name;
+        int size;
+        long long ops;
+        double samples[MAX_REPETITIONS];      // ns/op of each repetition
+        double nsPerOp;                       // Median of the samples
+        double allocsPerOp;
+        long long peakBytes;                  // Highest tracked memory of a repetition (setup included)
+    };
+
+    Result* results;                          // MAX_RESULTS entries, too many for the stack
+    int resultCount;
+    bool overflowed;                          // A result was dropped because results was full
+    int repetitions;
+    string filter;
+
+
+    static double median(double values[], int count) {
+        double sorted[MAX_REPETITIONS];
+        for (int i = 0; i < count; i++) {
+            sorted[i] = values[i];
+        }
+        // Insertion sort, there are only a handful of samples
+        for (int i = 1; i < count; i++) {
+            double value = sorted[i];
+            int j = i - 1;
+            while (j >= 0 && sorted[j] > value) {
+                sorted[j + 1] = sorted[j];
+                j--;
+            }
+            sorted[j + 1] = value;
+        }
+        return (count % 2 == 1) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    }
+
+public:
+    // Synthetic data helpers, shared by the benchmarks
+
+    // Food ID number i (0 <= i < ID_COUNT)
+    static ItemID foodId(int i) {
+        char text[5];
+        snprintf(text, sizeof(text), "B%03d", i);
+        return ItemID(text);
+    }
+
+    // Four-character base-36 menu ID number i (up to 36^4 items)
+    static ItemID menuId(int i) {
+        const char* digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        char text[5];
+        for (int position = 3; position >= 0; position--) {
+            text[position] = digits[i % 36];
+            i /= 36;
+        }
+        text[4] = '\0';
+        return ItemID(text);
+    }
+
+    // Batch number i: IDs cycle so every ID gets size / ID_COUNT batches with spread dates
+    static FoodItem batch(int i) {
+        static const char* names[] = {"Rice", "Chicken Breast", "Tomatoes", "Onions", "Potatoes",
+                                      "Beef", "Garlic", "Salt", "Pepper", "Flour"};
+        int idNumber = i % ID_COUNT;
+        return FoodItem(foodId(idNumber), string(names[idNumber % 10]) + " " + to_string(idNumber),
+                        1.0 + (idNumber % 50) * 0.25, "Bench", 1000,
+                        (int64_t)1700000000 + (int64_t)(i * 7919LL % 31536000));
+    }
+
+    // Fills an inventory with size batches
+    static void fillInventory(RestaurantInventorySystem& inventory, int size) {
+        for (int i = 0; i < size; i++) {
+            inventory.addExistingFoodItem(batch(i));
+        }
+    }
+
+    // Menu item number i, with three ingredients from the inventory IDs
+    static MenuItem menuItem(int i) {
+        MenuItem item(menuId(i), "Dish " + to_string((i * 7919) % 1000003), 5.0 + (i * 31 % 2000) / 100.0,
+                      "Generated dish", (i % 3 == 0) ? "Main Course" : (i % 3 == 1) ? "Appetizer" : "Dessert");
+        item.addIngredient(foodId(i % ID_COUNT), 1);
+        item.addIngredient(foodId((i * 7 + 3) % ID_COUNT), 1);
+        item.addIngredient(foodId((i * 13 + 5) % ID_COUNT), 1);
+        return item;
+    }
+
+    static int capOps(int size) {
+        return (size < OPS_CAP) ? size : OPS_CAP;
+    }
+
+    // Constructor
+    BenchmarkSuite(int _repetitions, const string& _filter)
+        : results(new Result[MAX_RESULTS]), resultCount(0), overflowed(false),
+          repetitions(_repetitions), filter(_filter) {}
+
+    ~BenchmarkSuite() {
+        delete[] results;
+    }
+
+    BenchmarkSuite(const BenchmarkSuite&) = delete;
+    BenchmarkSuite& operator=(const BenchmarkSuite&) = delete;
+
+    // Checks if a result was dropped (more benchmarks registered than MAX_BENCHMARKS)
+    bool hasOverflowed() const {
+        return overflowed;
+    }
+
+    // Runs one benchmark at one size and records the result
+    void run(const string& name, int size, const Body& body) {
+        if (!filter.empty() && name.find(filter) == string::npos) {
+            return;
+        }
+        if (resultCount == MAX_RESULTS) {
+            if (!overflowed) {
+                cerr << "Error: more than " << MAX_RESULTS << " results, raise BenchmarkSuite::MAX_BENCHMARKS" << endl;
+            }
+            overflowed = true;
+            return;
+        }
+
+        Result& result = results[resultCount++];
+        result.name = name;
+        result.size = size;
+        result.ops = 0;
+        result.peakBytes = 0;
+        long long totalAllocations = 0;
+
+        for (int rep = 0; rep < repetitions; rep++) {
+            Timer timer;
+            MemoryTracker::resetPeaks();
+            long long bytesBefore = Timer::totalCurrentBytes();
+            timer.start();
+            long long ops = body(size, timer);
+            double elapsed = timer.elapsedNs();
+            totalAllocations += timer.allocations();
+            result.peakBytes = max(result.peakBytes, Timer::totalPeakBytes() - bytesBefore);
+            result.ops = (ops > 0) ? ops : 1;
+            result.samples[rep] = elapsed / result.ops;
+        }
+
+        result.nsPerOp = median(result.samples, repetitions);
+        result.allocsPerOp = (double)totalAllocations / repetitions / result.ops;
+
+        cerr << left << setw(40) << name
+             << setw(10) << size
+             << setw(10) << result.ops
+             << setw(14) << fixed << setprecision(1) << result.nsPerOp
+             << setw(16) << setprecision(0) << 1e9 / result.nsPerOp
+             << setw(10) << setprecision(2) << result.allocsPerOp << endl;
+    }
+
+    // Prints the column headings of the progress table
+    static void printTableHeader() {
+        cerr << left << setw(40) << "Benchmark"
+             << setw(10) << "Size"
+             << setw(10) << "Ops"
+             << setw(14) << "ns/op"
+             << setw(16) << "ops/s"
+             << setw(10) << "allocs/op" << endl;
+        cerr << string(100, '-') << endl;
+    }
+
+    // Writes all results as JSON
+    void writeJson(ostream& out) const {
+        out << "{" << endl;
+        out << "  \"schema\": 1," << endl;
+        out << "  \"timestamp\": " << (long long)time(0) << "," << endl;
+        out << "  \"repetitions\": " << repetitions << "," << endl;
+        out << "  \"alloc_source\": \"" << Timer::allocationSource() << "\"," << endl;
+        out << "  \"host\": \"" << Timer::hostFingerprint() << "\"," << endl;
+        out << "  \"results\": [" << endl;
+        for (int i = 0; i < resultCount; i++) {
+            const Result& result = results[i];
+            out << "    {\"name\": \"" << result.name << "\", \"size\": " << result.size
+                << ", \"ops\": " << result.ops
+                << fixed << setprecision(3)
+                << ", \"ns_per_op\": " << result.nsPerOp
+                << ", \"ops_per_sec\": " << 1e9 / result.nsPerOp
+                << ", \"allocs_per_op\": " << result.allocsPerOp
+                << ", \"peak_bytes\": " << result.peakBytes
+                << ", \"samples_ns_per_op\": [";
+            for (int rep = 0; rep < repetitions; rep++) {
+                out << (rep > 0 ? ", " : "") << result.samples[rep];
+            }
+            out << "]}" << (i < resultCount - 1 ? "," : "") << endl;
+        }
+        out << "  ]" << endl;
+        out << "}" << endl;
+    }
+};
+
+const char* const BenchmarkSuite::HISTORY_FILE = "bench_usage_history.txt";
+
+// Registers and runs every benchmark for one data size
+void runAllBenchmarks(BenchmarkSuite& suite, int size) {
+    typedef BenchmarkSuite S;
+
+    // ---- Inventory: changes ----
+    suite.run("inventory.insertFoodItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        timer.start();
+        for (int i = 0; i < n; i++) {
+            inventory.insertFoodItem(S::batch(i));
+        }
+        return n;
+    });
+
+    suite.run("inventory.addExistingFoodItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        timer.start();
+        S::fillInventory(inventory, n);
+        return n;
+    });
+
+    suite.run("inventory.useFoodItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        int ops = S::capOps(n);
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            inventory.useFoodItem(S::foodId(i % S::ID_COUNT), 1);
+        }
+        return ops;
+    });
+
+    // Usage while the reorder heap follows the stock: every change moves one heap entry
+    suite.run("inventory.useFoodItem.reorderTracked", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        inventory.trackReorderLevels();
+        int ops = S::capOps(n);
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            inventory.useFoodItem(S::foodId(i % S::ID_COUNT), 1);
+        }
+        return ops;
+    });
+
+    // "What should we reorder": the 10 items with the least stock above their threshold
+    suite.run("inventory.getLowestStock", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        inventory.trackReorderLevels();
+        for (int i = 0; i < S::ID_COUNT; i++) {
+            inventory.setReorderThreshold(S::foodId(i), (i * 37) % 100);
+        }
+        int ops = 10000;
+        long long total = 0;
+        ReorderLevel levels[10];
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            total += inventory.getLowestStock(10, levels);
+        }
+        return (total >= 0) ? ops : 0;
+    });
+
+    suite.run("inventory.removeFoodItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        int ops = (n < S::ID_COUNT) ? n : S::ID_COUNT;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            inventory.removeFoodItem(S::foodId(i));
+        }
+        return ops;
+    });
+
+    // ---- Inventory: lookups and searches ----
+    suite.run("inventory.findFoodItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        int ops = S::capOps(n);
+        long long found = 0;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            found += inventory.findFoodItem(S::foodId(i % S::ID_COUNT)).totalQuantity;
+        }
+        return (found > 0) ? ops : 0;
+    });
+
+    suite.run("inventory.searchByName", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        int ops = 20;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            inventory.searchByName((i % 2 == 0) ? "Rice" : "Garlic 1");
+        }
+        return ops;
+    });
+
+    suite.run("inventory.searchByPrice", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        int ops = 20;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            inventory.searchByPrice(2.0, 4.0);
+        }
+        return ops;
+    });
+
+    // ---- Inventory: files (ns per batch) ----
+    suite.run("inventory.saveToFile", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        timer.start();
+        inventory.saveToFile("bench_food_items.txt");
+        return n;
+    });
+
+    suite.run("inventory.loadFromFile", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem source;
+        S::fillInventory(source, n);
+        source.saveToFile("bench_food_items.txt");
+        RestaurantInventorySystem inventory;
+        timer.start();
+        inventory.loadFromFile("bench_food_items.txt");
+        return n;
+    });
+
+    // ---- Sorting (ns per element) ----
+    suite.run("sort.timSort.foodByName", size, [](int n, S::Timer& timer) -> long long {
+        FoodItem* items = new FoodItem[n];
+        for (int i = 0; i < n; i++) {
+            items[i] = S::batch((int)((i * 2654435761u) % (unsigned)n));
+        }
+        timer.start();
+        RestaurantInventorySystem::timSort(items, n, SORT_BY_NAME);
+        delete[] items;
+        return n;
+    });
+
+    suite.run("sort.timSort.foodByDate", size, [](int n, S::Timer& timer) -> long long {
+        FoodItem* items = new FoodItem[n];
+        for (int i = 0; i < n; i++) {
+            items[i] = S::batch(i);
+        }
+        timer.start();
+        RestaurantInventorySystem::timSort(items, n, SORT_BY_DATE);
+        delete[] items;
+        return n;
+    });
+
+    suite.run("sort.timSortMenuItems.byName", size, [](int n, S::Timer& timer) -> long long {
+        MenuItem* items = new MenuItem[n];
+        for (int i = 0; i < n; i++) {
+            items[i] = S::menuItem(i);
+        }
+        timer.start();
+        timSortMenuItems(items, n, "name");
+        delete[] items;
+        return n;
+    });
+
+    suite.run("sort.timSortMenuItems.byPrice", size, [](int n, S::Timer& timer) -> long long {
+        MenuItem* items = new MenuItem[n];
+        for (int i = 0; i < n; i++) {
+            items[i] = S::menuItem(i);
+        }
+        timer.start();
+        timSortMenuItems(items, n, "price");
+        delete[] items;
+        return n;
+    });
+
+    // ---- Menu ----
+    suite.run("search.interpolationSearchMenuItems", size, [](int n, S::Timer& timer) -> long long {
+        // Menu IDs are generated in ascending order, so the array is sorted by ID
+        MenuItem* items = new MenuItem[n];
+        for (int i = 0; i < n; i++) {
+            items[i] = S::menuItem(i);
+        }
+        int ops = S::capOps(n) * 10;
+        long long hits = 0;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            hits += (interpolationSearchMenuItems(items, n, S::menuId((int)((i * 2654435761u) % (unsigned)n))) != -1);
+        }
+        delete[] items;
+        return (hits > 0) ? ops : 0;
+    });
+
+    suite.run("menu.addMenuItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantMenuSystem menu;
+        timer.start();
+        for (int i = 0; i < n; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        return n;
+    });
+
+    suite.run("menu.findMenuItem", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantMenuSystem menu;
+        for (int i = 0; i < n; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        int ops = S::capOps(n) * 10;
+        long long hits = 0;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            hits += (menu.findMenuItem(S::menuId((int)((i * 2654435761u) % (unsigned)n))) != nullptr);
+        }
+        return (hits > 0) ? ops : 0;
+    });
+
+    suite.run("menu.searchMenuItems", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantMenuSystem menu;
+        for (int i = 0; i < n; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        int ops = 20;
+        long long matches = 0;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            matches += menu.searchMenuItems("Dish 42").getSize();
+        }
+        return (matches >= 0) ? ops : 0;
+    });
+
+    // prepareMenuItem is prepareOrder plus console checks and file saves; the transaction is timed
+    suite.run("menu.prepareOrder", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory(S::HISTORY_FILE);
+        S::fillInventory(inventory, n);
+        RestaurantMenuSystem menu;
+        for (int i = 0; i < 1000; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        int ops = S::capOps(n);
+        string message;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            menu.prepareOrder(S::menuId(i % 1000), inventory, "Bench", message);
+        }
+        inventory.flushUsageLog();
+        return ops;
+    });
+
+    // Orders against a menu that tracks its servings: every consumed ingredient refreshes the
+    // servings of the dishes using it
+    suite.run("menu.prepareOrder.trackedServings", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory(S::HISTORY_FILE);
+        S::fillInventory(inventory, n);
+        RestaurantMenuSystem menu;
+        for (int i = 0; i < 1000; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        menu.trackServings(inventory);
+        int ops = S::capOps(n);
+        string message;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            menu.prepareOrder(S::menuId(i % 1000), inventory, "Bench", message);
+        }
+        inventory.flushUsageLog();
+        return ops;
+    });
+
+    // "How many can we make": a cached read per menu item
+    suite.run("menu.getMaxServings", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantInventorySystem inventory;
+        S::fillInventory(inventory, n);
+        RestaurantMenuSystem menu;
+        for (int i = 0; i < 1000; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        menu.trackServings(inventory);
+        int ops = 10000;
+        long long total = 0;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            total += menu.getMaxServings(S::menuId(i % 1000));
+        }
+        return (total >= 0) ? ops : 0;
+    });
+
+    // "Which dishes use this ingredient": a lookup in the ingredient index
+    suite.run("menu.getMenuItemsUsing", size, [](int n, S::Timer& timer) -> long long {
+        RestaurantMenuSystem menu;
+        for (int i = 0; i < 1000; i++) {
+            menu.addMenuItem(S::menuItem(i));
+        }
+        int ops = S::capOps(n);
+        long long total = 0;
+        timer.start();
+        for (int i = 0; i < ops; i++) {
+            total += menu.getMenuItemsUsing(S::foodId(i % S::ID_COUNT)).getSize();
+        }
+        return (total >= 0) ? ops : 0;
+    });
+}
+
+// Parses a comma-separated list of sizes into sizes[], returns the number parsed
+int parseSizes(const string& text, int sizes[], int maxSizes) {
+    int count = 0;
+    stringstream stream(text);
+    string token;
+    while (count < maxSizes && getline(stream, token, ',')) {
+        int size = atoi(token.c_str());
+        if (size > 0 && size <= 36 * 36 * 36 * 36) {
+            sizes[count++] = size;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    int sizes[BenchmarkSuite::MAX_SIZES] = {1000, 10000, 100000};
+    int sizeCount = 3;
+    int repetitions = 5;
+    string jsonFile = "";
+    string filter = "";
+
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "--sizes" && i + 1 < argc) {
+            sizeCount = parseSizes(argv[++i], sizes, BenchmarkSuite::MAX_SIZES);
+        } else if (option == "--repetitions" && i + 1 < argc) {
+            repetitions = atoi(argv[++i]);
+        } else if (option == "--json" && i + 1 < argc) {
+            jsonFile = argv[++i];
+        } else if (option == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0] << " [--sizes 1000,10000,100000,1000000] [--repetitions 5]"
+                 << " [--json file] [--filter text]" << endl;
+            return 2;
+        }
+    }
+    if (sizeCount == 0 || repetitions < 1 || repetitions > BenchmarkSuite::MAX_REPETITIONS) {
+        cerr << "Error: need at least one size and 1-" << BenchmarkSuite::MAX_REPETITIONS << " repetitions" << endl;
+        return 2;
+    }
+
+    // Engine messages would dominate the timings of the printing operations, so they are discarded.
+    // Usage history of the order benchmarks goes to a scratch file, not the real usage_history.txt.
+    DiscardBuffer discardBuffer;
+    ostream discard(&discardBuffer);
+    Restaurant::setOutput(discard);
+
+    BenchmarkSuite suite(repetitions, filter);
+    BenchmarkSuite::printTableHeader();
+    for (int i = 0; i < sizeCount; i++) {
+        runAllBenchmarks(suite, sizes[i]);
+    }
+    remove("bench_food_items.txt");
+    remove(BenchmarkSuite::HISTORY_FILE);
+    if (suite.hasOverflowed()) {
+        return 1;
+    }
+
+    if (jsonFile.empty()) {
+        suite.writeJson(cout);
+    } else {
+        ofstream out(jsonFile);
+        if (!out.is_open()) {
+            cerr << "Error: Could not open file " << jsonFile << " for writing" << endl;
+            return 1;
+        }
+        suite.writeJson(out);
+    }
+    return 0;
+}
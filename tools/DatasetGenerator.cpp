@@ -0,0 +1,509 @@
+// Synthetic dataset generator for the restaurant system
+// Writes food_items.txt, menu_items.txt, usage_history.txt, staff.txt and admin.txt in the formats
+// the application loads, at any size, so the engines can be measured on production-sized data.
+// The same seed and --end time always produce the same files.
+//
+// Build:  g++ -std=c++11 -O2 tools/DatasetGenerator.cpp -o dataset_generator
+// Run:    dataset_generator --batches 1000000 --menu-items 5000 --usage 2000000 --output data
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <ctime>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+using namespace std;
+
+// Settings of one run, filled from the command line
+struct GeneratorOptions {
+    unsigned long long seed = 42;
+    long long batches = 10000;        // Rows in food_items.txt
+    int foodIds = 50;                 // Distinct food IDs (see the range check in main)
+    int menuItems = 200;              // Rows in menu_items.txt
+    long long usage = 10000;          // Rows in usage_history.txt
+    int staff = 20;                   // Rows in staff.txt (IDs S001-S999)
+    int admins = 3;                   // Rows in admin.txt (IDs A001-A999)
+    int days = 90;                    // Receive dates and usage are spread over this many past days
+    long long endTime = 0;            // Latest date in the files (epoch seconds, 0 = now)
+    double zipfExponent = 1.1;        // Skew of ingredient and dish popularity
+    string outputDir = ".";
+    bool force = false;               // Overwrite existing files
+};
+
+/**
+ * ZipfDistribution draws ranks 0..n-1 where rank k has weight 1 / (k+1)^s
+ * A few ranks are drawn very often and most ranks rarely, like ingredient and dish popularity.
+ * The cumulative weights are computed once, so each draw is a binary search.
+ */
+class ZipfDistribution {
+private:
+    double* cumulative;
+    int size;
+
+public:
+    ZipfDistribution(int n, double exponent) : cumulative(new double[n]), size(n) {
+        double total = 0.0;
+        for (int k = 0; k < n; k++) {
+            total += 1.0 / pow(k + 1.0, exponent);
+            cumulative[k] = total;
+        }
+        for (int k = 0; k < n; k++) {
+            cumulative[k] /= total;
+        }
+    }
+
+    ~ZipfDistribution() {
+        delete[] cumulative;
+    }
+
+    // Copying would share the table
+    ZipfDistribution(const ZipfDistribution&) = delete;
+    ZipfDistribution& operator=(const ZipfDistribution&) = delete;
+
+    int operator()(mt19937_64& random) const {
+        double u = uniform_real_distribution<double>(0.0, 1.0)(random);
+        int low = 0;
+        int high = size - 1;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            if (cumulative[middle] < u) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+};
+
+/**
+ * DatasetGenerator writes every file row by row through a large stream buffer
+ * Nothing but the food and menu catalogs is kept in memory, so the row counts are only limited
+ * by disk space. Popular food IDs get more batches and appear in more recipes and more usage.
+ */
+class DatasetGenerator {
+private:
+    static const int IO_BUFFER_SIZE = 1 << 20;
+
+    // A food ID as written to the files
+    struct FoodInfo {
+        string id;
+        string name;
+        string category;
+        double price;
+    };
+
+    // The parts of a menu item the usage history needs
+    struct DishInfo {
+        string name;
+        int ingredientCount;
+        int ingredients[6];           // Indexes into foods
+        int quantities[6];
+    };
+
+    GeneratorOptions options;
+    mt19937_64 random;
+    FoodInfo* foods;
+    DishInfo* dishes;
+    char* ioBuffer;
+    long long bytesWritten;
+    time_t now;
+
+    // Without --force, makes sure none of the output files exist yet, so a refused run
+    // leaves the directory untouched instead of half-regenerated. Reports every file that exists.
+    bool checkOutputs() const {
+        static const char* outputFiles[] = {"food_items.txt", "menu_items.txt", "usage_history.txt",
+                                            "staff.txt", "admin.txt"};
+        if (options.force) {
+            return true;
+        }
+        bool clear = true;
+        for (const char* fileName : outputFiles) {
+            string path = options.outputDir + "/" + fileName;
+            ifstream existing(path);
+            if (existing.is_open()) {
+                cerr << "Error: " << path << " already exists (use --force to overwrite)" << endl;
+                clear = false;
+            }
+        }
+        return clear;
+    }
+
+    // Opens an output file with the shared buffer, returns false if it cannot be written
+    bool openOutput(ofstream& file, const string& fileName) {
+        string path = options.outputDir + "/" + fileName;
+        file.rdbuf()->pubsetbuf(ioBuffer, IO_BUFFER_SIZE);
+        file.open(path);
+        if (!file.is_open()) {
+            cerr << "Error: Could not open file " << path << " for writing" << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Closes an output file and adds its size to the total
+    bool closeOutput(ofstream& file, const string& fileName) {
+        bytesWritten += (long long)file.tellp();
+        file.close();
+        if (file.fail()) {
+            cerr << "Error: Could not finish writing " << fileName << endl;
+            return false;
+        }
+        return true;
+    }
+
+    int uniformInt(int low, int high) {
+        return uniform_int_distribution<int>(low, high)(random);
+    }
+
+    // Rounds a price to whole cents (the application requires two decimal places)
+    static double toCents(double value) {
+        return floor(value * 100.0 + 0.5) / 100.0;
+    }
+
+    // Timestamp text in the format ctime() writes, without the newline ("Sun Oct 18 13:16:21 2026")
+    static string ctimeText(time_t when) {
+        static const char* dayNames[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+        static const char* monthNames[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                           "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+        tm* local = localtime(&when);
+        char text[32];
+        snprintf(text, sizeof(text), "%s %s %2d %02d:%02d:%02d %d", dayNames[local->tm_wday],
+                 monthNames[local->tm_mon], local->tm_mday, local->tm_hour, local->tm_min,
+                 local->tm_sec, local->tm_year + 1900);
+        return text;
+    }
+
+    // Builds the food catalog; rank 0 is the most popular ingredient
+    void buildFoodCatalog() {
+        // Base ingredient per category, with a typical unit price range
+        static const struct { const char* category; const char* names[6]; double minPrice; double maxPrice; } kinds[] = {
+            {"Grain",     {"Rice", "Flour", "Noodles", "Oats", "Bread Crumbs", "Cornmeal"},                  1.00, 4.00},
+            {"Meat",      {"Chicken Breast", "Beef", "Pork Belly", "Lamb", "Duck", "Sausage"},              4.00, 15.00},
+            {"Vegetable", {"Tomatoes", "Onions", "Potatoes", "Carrots", "Lettuce", "Bell Peppers"},         1.00, 3.50},
+            {"Spice",     {"Garlic", "Salt", "Pepper", "Ginger", "Chili", "Cumin"},                         1.00, 3.00},
+            {"Dairy",     {"Milk", "Butter", "Cheese", "Cream", "Yogurt", "Eggs"},                          1.50, 6.00},
+            {"Seafood",   {"Shrimp", "Salmon", "Squid", "Cod", "Mussels", "Crab"},                          6.00, 20.00},
+            {"Fruit",     {"Lemons", "Apples", "Mangoes", "Bananas", "Pineapple", "Strawberries"},         1.00, 5.00},
+            {"Oil",       {"Vegetable Oil", "Olive Oil", "Sesame Oil", "Soy Sauce", "Vinegar", "Fish Sauce"}, 1.50, 8.00}
+        };
+        const int kindCount = sizeof(kinds) / sizeof(kinds[0]);
+
+        foods = new FoodInfo[options.foodIds];
+        for (int i = 0; i < options.foodIds; i++) {
+            int kind = i % kindCount;
+            int variant = (i / kindCount) % 6;
+            int round = i / (kindCount * 6);
+            char id[16];
+            snprintf(id, sizeof(id), "F%03d", i + 1);
+            foods[i].id = id;
+            foods[i].name = kinds[kind].names[variant];
+            if (round > 0) {
+                foods[i].name += " Grade " + to_string(round + 1);
+            }
+            foods[i].category = kinds[kind].category;
+            foods[i].price = toCents(uniform_real_distribution<double>(kinds[kind].minPrice, kinds[kind].maxPrice)(random));
+        }
+    }
+
+    // Menu ID number i: M001-M999, then four base-36 characters starting at a letter
+    static string menuId(int i) {
+        if (i < 999) {
+            char text[16];
+            snprintf(text, sizeof(text), "M%03d", i + 1);
+            return text;
+        }
+        const char* digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        int value = i - 999 + 10 * 36 * 36 * 36;   // Skip the IDs that start with a digit
+        char text[5];
+        for (int position = 3; position >= 0; position--) {
+            text[position] = digits[value % 36];
+            value /= 36;
+        }
+        text[4] = '\0';
+        return text;
+    }
+
+    // Writes food_items.txt: batches in receive order, popular IDs receive more often
+    bool writeFoodItems() {
+        ofstream file;
+        if (!openOutput(file, "food_items.txt")) {
+            return false;
+        }
+
+        ZipfDistribution popularity(options.foodIds, options.zipfExponent);
+        geometric_distribution<int> extraQuantity(0.04);
+        long long span = (long long)options.days * 86400;
+        long long start = (long long)now - span;
+
+        for (long long row = 0; row < options.batches; row++) {
+            // Every ID gets at least one batch, the rest follow the popularity
+            int food = (row < options.foodIds) ? (int)row : popularity(random);
+
+            // Most deliveries are small, a few are large (1-999 units)
+            int quantity = 1 + extraQuantity(random);
+            if (quantity > 999) {
+                quantity = 999;
+            }
+
+            // Receive dates increase through the file with some jitter, like real deliveries
+            long long received = start + span * row / (options.batches > 1 ? options.batches : 1) + uniformInt(0, 3600);
+            if (received > (long long)now) {
+                received = (long long)now;
+            }
+
+            file << foods[food].id << ',' << foods[food].name << ',' << foods[food].price << ','
+                 << foods[food].category << ',' << quantity << ',' << received << '\n';
+        }
+        return closeOutput(file, "food_items.txt");
+    }
+
+    // Writes menu_items.txt: 2-6 distinct ingredients per recipe, chosen by popularity
+    bool writeMenuItems() {
+        ofstream file;
+        if (!openOutput(file, "menu_items.txt")) {
+            return false;
+        }
+
+        static const char* styles[] = {"Fried", "Grilled", "Steamed", "Braised", "Roasted", "Spicy", "Creamy", "Smoked"};
+        static const char* forms[] = {"Rice", "Noodles", "Soup", "Salad", "Curry", "Stew", "Wrap", "Platter", "Bowl", "Pie"};
+        static const char* categories[] = {"Main Course", "Main Course", "Appetizer", "Dessert", "Beverage", "Side Dish"};
+
+        ZipfDistribution popularity(options.foodIds, options.zipfExponent);
+        dishes = new DishInfo[options.menuItems];
+
+        for (int i = 0; i < options.menuItems; i++) {
+            DishInfo& dish = dishes[i];
+            int maxIngredients = (options.foodIds < 6) ? options.foodIds : 6;
+            dish.ingredientCount = uniformInt((maxIngredients < 2) ? maxIngredients : 2, maxIngredients);
+
+            double cost = 0.0;
+            for (int j = 0; j < dish.ingredientCount; j++) {
+                // Draw until the ingredient is not already in the recipe
+                int food;
+                bool repeated;
+                do {
+                    food = popularity(random);
+                    repeated = false;
+                    for (int k = 0; k < j; k++) {
+                        repeated = repeated || dish.ingredients[k] == food;
+                    }
+                } while (repeated);
+                dish.ingredients[j] = food;
+                dish.quantities[j] = uniformInt(1, 3);
+                cost += foods[food].price * dish.quantities[j];
+            }
+
+            int mainFood = dish.ingredients[0];
+            dish.name = string(styles[uniformInt(0, 7)]) + " " + foods[mainFood].name + " " + forms[uniformInt(0, 9)];
+            if (i >= 80) {
+                dish.name += " No." + to_string(i + 1);   // Keep names distinct on large menus
+            }
+
+            // Menu price is the ingredient cost with a 20%-80% markup, at least 1.00
+            double price = toCents(cost * uniform_real_distribution<double>(1.2, 1.8)(random));
+            if (price < 1.0) {
+                price = 1.0;
+            }
+
+            file << menuId(i) << ',' << dish.name << ',' << price << ','
+                 << "House " << forms[uniformInt(0, 9)] << " with " << foods[mainFood].name << ','
+                 << categories[uniformInt(0, 5)] << ',';
+            for (int j = 0; j < dish.ingredientCount; j++) {
+                file << (j > 0 ? "|" : "") << foods[dish.ingredients[j]].id << ':' << dish.quantities[j];
+            }
+            file << '\n';
+        }
+        return closeOutput(file, "menu_items.txt");
+    }
+
+    // Writes usage_history.txt: mostly orders (one row per ingredient), plus prep and waste
+    bool writeUsageHistory() {
+        ofstream file;
+        if (!openOutput(file, "usage_history.txt")) {
+            return false;
+        }
+
+        ZipfDistribution dishPopularity(options.menuItems, options.zipfExponent);
+        ZipfDistribution foodPopularity(options.foodIds, options.zipfExponent);
+        long long span = (long long)options.days * 86400;
+        long long start = (long long)now - span;
+
+        // The timestamp text only changes once a second, so it is formatted once per second
+        long long cachedSecond = -1;
+        string cachedText;
+
+        long long row = 0;
+        while (row < options.usage) {
+            long long when = start + span * row / (options.usage > 1 ? options.usage : 1);
+            if (when != cachedSecond) {
+                cachedSecond = when;
+                cachedText = ctimeText((time_t)when);
+            }
+
+            if (options.menuItems > 0 && uniformInt(0, 9) < 8) {
+                // An order uses every ingredient of one dish at the same moment
+                const DishInfo& dish = dishes[dishPopularity(random)];
+                for (int j = 0; j < dish.ingredientCount && row < options.usage; j++, row++) {
+                    const FoodInfo& food = foods[dish.ingredients[j]];
+                    file << cachedText << ',' << food.id << ',' << food.name << ','
+                         << dish.quantities[j] << ",Order: " << dish.name << '\n';
+                }
+            } else {
+                const FoodInfo& food = foods[foodPopularity(random)];
+                file << cachedText << ',' << food.id << ',' << food.name << ','
+                     << uniformInt(1, 10) << ',' << (uniformInt(0, 3) == 0 ? "Waste" : "Prep") << '\n';
+                row++;
+            }
+        }
+        return closeOutput(file, "usage_history.txt");
+    }
+
+    // Random password of letters and digits
+    string password() {
+        const char* characters = "abcdefghijkmnpqrstuvwxyz23456789";
+        string text;
+        for (int i = 0; i < 8; i++) {
+            text += characters[uniformInt(0, 31)];
+        }
+        return text;
+    }
+
+    // Writes staff.txt and admin.txt; the first accounts keep the sample logins
+    // (staff01 / admin01 with password pass123)
+    bool writeAccounts() {
+        static const char* positions[] = {"Cook", "Waiter", "Cashier", "Dishwasher", "Host", "Barista", "Manager"};
+
+        ofstream staffFile;
+        if (!openOutput(staffFile, "staff.txt")) {
+            return false;
+        }
+        for (int i = 0; i < options.staff; i++) {
+            char line[64];
+            snprintf(line, sizeof(line), "staff%02d,%s,S%03d,%s\n", i + 1,
+                     (i == 0) ? "pass123" : password().c_str(), i + 1, positions[(i == 0) ? 0 : uniformInt(0, 6)]);
+            staffFile << line;
+        }
+        if (!closeOutput(staffFile, "staff.txt")) {
+            return false;
+        }
+
+        ofstream adminFile;
+        if (!openOutput(adminFile, "admin.txt")) {
+            return false;
+        }
+        for (int i = 0; i < options.admins; i++) {
+            char line[64];
+            snprintf(line, sizeof(line), "admin%02d,%s,A%03d,%s\n", i + 1,
+                     (i == 0) ? "pass123" : password().c_str(), i + 1, (i == 0) ? "Full" : "Standard");
+            adminFile << line;
+        }
+        return closeOutput(adminFile, "admin.txt");
+    }
+
+public:
+    DatasetGenerator(const GeneratorOptions& _options)
+        : options(_options), random(_options.seed), foods(nullptr), dishes(nullptr),
+          ioBuffer(new char[IO_BUFFER_SIZE]), bytesWritten(0),
+          now((_options.endTime > 0) ? (time_t)_options.endTime : time(0)) {}
+
+    ~DatasetGenerator() {
+        delete[] foods;
+        delete[] dishes;
+        delete[] ioBuffer;
+    }
+
+    // Writes every file, returns false on the first error
+    bool run() {
+        if (!checkOutputs()) {
+            return false;
+        }
+        auto started = chrono::steady_clock::now();
+
+        buildFoodCatalog();
+        if (!writeFoodItems() || !writeMenuItems() || !writeUsageHistory() || !writeAccounts()) {
+            return false;
+        }
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+        cout << "Generated " << options.batches << " batches of " << options.foodIds << " food IDs, "
+             << options.menuItems << " menu items, " << options.usage << " usage records, "
+             << options.staff << " staff and " << options.admins << " admins (seed " << options.seed << ")" << endl;
+        cout << "Wrote " << bytesWritten / (1024.0 * 1024.0) << " MB to " << options.outputDir
+             << " in " << seconds << " s" << endl;
+        return true;
+    }
+};
+
+// Prints the command line options
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]" << endl
+         << "  --seed N          random seed (default 42)" << endl
+         << "  --batches N       rows in food_items.txt (default 10000)" << endl
+         << "  --food-ids N      distinct food IDs, 1-100 (default 50; above 50 the inventory" << endl
+         << "                    may not find a bucket for every ID)" << endl
+         << "  --menu-items N    rows in menu_items.txt, 1-" << 999 + 26 * 36 * 36 * 36 << " (default 200)" << endl
+         << "  --usage N         rows in usage_history.txt (default 10000)" << endl
+         << "  --staff N         rows in staff.txt, 1-999 (default 20)" << endl
+         << "  --admins N        rows in admin.txt, 1-999 (default 3)" << endl
+         << "  --days N          spread dates over the last N days (default 90)" << endl
+         << "  --end EPOCH       latest date in epoch seconds (default now)" << endl
+         << "  --zipf S          popularity skew exponent (default 1.1)" << endl
+         << "  --output DIR      existing directory to write to (default .)" << endl
+         << "  --force           overwrite existing files" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (option == "--force") {
+            options.force = true;
+        } else if (option == "--seed" && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (option == "--batches" && hasValue) {
+            options.batches = atoll(argv[++i]);
+        } else if (option == "--food-ids" && hasValue) {
+            options.foodIds = atoi(argv[++i]);
+        } else if (option == "--menu-items" && hasValue) {
+            options.menuItems = atoi(argv[++i]);
+        } else if (option == "--usage" && hasValue) {
+            options.usage = atoll(argv[++i]);
+        } else if (option == "--staff" && hasValue) {
+            options.staff = atoi(argv[++i]);
+        } else if (option == "--admins" && hasValue) {
+            options.admins = atoi(argv[++i]);
+        } else if (option == "--days" && hasValue) {
+            options.days = atoi(argv[++i]);
+        } else if (option == "--end" && hasValue) {
+            options.endTime = atoll(argv[++i]);
+        } else if (option == "--zipf" && hasValue) {
+            options.zipfExponent = atof(argv[++i]);
+        } else if (option == "--output" && hasValue) {
+            options.outputDir = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    // The inventory hash table has 101 buckets and quadratic probing only reaches 51 of them from any
+    // start, so only up to 50 IDs are certain to fit; menu IDs are 4 characters
+    if (options.foodIds < 1 || options.foodIds > 100 || options.batches < options.foodIds
+        || options.menuItems < 1 || options.menuItems > 999 + 26 * 36 * 36 * 36
+        || options.usage < 0 || options.staff < 1 || options.staff > 999
+        || options.admins < 1 || options.admins > 999 || options.days < 1 || options.endTime < 0 || options.zipfExponent <= 0.0) {
+        cerr << "Error: option out of range (batches must be at least the number of food IDs)" << endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    DatasetGenerator generator(options);
+    return generator.run() ? 0 : 1;
+}